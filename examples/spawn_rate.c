@@ -0,0 +1,194 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the rate at which a DVM can accept and run many small jobs.
+ * Start a DVM with "prte --system-server", optionally setting
+ * pmix_server_spawn_batch_size, and then run:
+ *
+ *     spawn_rate [-n njobs] [-np procs-per-job] [-w max-outstanding] [cmd]
+ *
+ * The tool submits the jobs without waiting for each one to be
+ * launched, and reports how many jobs/sec were launched and completed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include <pmix_tool.h>
+#include "examples.h"
+
+static pmix_proc_t myproc;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static int nlaunched = 0;
+static int nfailed = 0;
+static int ncompleted = 0;
+static int noutstanding = 0;
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+}
+
+static void spawn_cbfunc(pmix_status_t status, pmix_nspace_t nspace, void *cbdata)
+{
+    pthread_mutex_lock(&mutex);
+    if (PMIX_SUCCESS == status) {
+        ++nlaunched;
+    } else {
+        ++nfailed;
+        /* it will never complete */
+        --noutstanding;
+    }
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&mutex);
+}
+
+static void notification_fn(size_t evhdlr_registration_id,
+                            pmix_status_t status,
+                            const pmix_proc_t *source,
+                            pmix_info_t info[], size_t ninfo,
+                            pmix_info_t results[], size_t nresults,
+                            pmix_event_notification_cbfunc_fn_t cbfunc,
+                            void *cbdata)
+{
+    pthread_mutex_lock(&mutex);
+    ++ncompleted;
+    --noutstanding;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&mutex);
+
+    /* we _always_ have to execute the evhandler callback or
+     * else the event progress engine will hang */
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_SUCCESS, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+static void evhandler_reg_callbk(pmix_status_t status,
+                                 size_t evhandler_ref,
+                                 void *cbdata)
+{
+    mylock_t *lock = (mylock_t*)cbdata;
+
+    lock->status = status;
+    lock->evhandler_ref = evhandler_ref;
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_info_t info, jinfo;
+    pmix_app_t app;
+    mylock_t mylock;
+    pmix_status_t code = PMIX_ERR_JOB_TERMINATED;
+    int njobs = 1000, nprocs = 1, window = 0;
+    char *cmd = "/bin/true";
+    double start, tlaunch, tdone;
+    bool flag;
+    int n;
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp(argv[n], "-n") && n+1 < argc) {
+            njobs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-np") && n+1 < argc) {
+            nprocs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-w") && n+1 < argc) {
+            window = strtol(argv[++n], NULL, 10);
+        } else if ('-' != argv[n][0]) {
+            cmd = argv[n];
+        } else {
+            fprintf(stderr, "Usage: %s [-n njobs] [-np procs-per-job] [-w max-outstanding] [cmd]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (0 >= window) {
+        window = njobs;
+    }
+
+    /* connect to the system server */
+    flag = true;
+    PMIX_INFO_LOAD(&info, PMIX_CONNECT_TO_SYSTEM, &flag, PMIX_BOOL);
+    if (PMIX_SUCCESS != (rc = PMIx_tool_init(&myproc, &info, 1))) {
+        fprintf(stderr, "PMIx_tool_init failed: %d\n", rc);
+        exit(rc);
+    }
+    PMIX_INFO_DESTRUCT(&info);
+
+    /* count the jobs as they complete */
+    DEBUG_CONSTRUCT_LOCK(&mylock);
+    PMIx_Register_event_handler(&code, 1, NULL, 0,
+                                notification_fn, evhandler_reg_callbk, (void*)&mylock);
+    DEBUG_WAIT_THREAD(&mylock);
+    rc = mylock.status;
+    DEBUG_DESTRUCT_LOCK(&mylock);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "[%s:%d] Default handler registration failed\n", myproc.nspace, myproc.rank);
+        goto done;
+    }
+
+    PMIX_APP_CONSTRUCT(&app);
+    app.cmd = strdup(cmd);
+    app.argv = (char**)malloc(2*sizeof(char*));
+    app.argv[0] = strdup(cmd);
+    app.argv[1] = NULL;
+    app.maxprocs = nprocs;
+    PMIX_INFO_LOAD(&jinfo, PMIX_NOTIFY_COMPLETION, &flag, PMIX_BOOL);
+
+    start = now();
+    for (n=0; n < njobs; n++) {
+        pthread_mutex_lock(&mutex);
+        while (noutstanding >= window) {
+            pthread_cond_wait(&cond, &mutex);
+        }
+        ++noutstanding;
+        pthread_mutex_unlock(&mutex);
+        rc = PMIx_Spawn_nb(&jinfo, 1, &app, 1, spawn_cbfunc, NULL);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "PMIx_Spawn_nb failed: %d\n", rc);
+            pthread_mutex_lock(&mutex);
+            ++nfailed;
+            --noutstanding;
+            pthread_mutex_unlock(&mutex);
+        }
+    }
+
+    /* wait for all the launches to be acknowledged */
+    pthread_mutex_lock(&mutex);
+    while (nlaunched + nfailed < njobs) {
+        pthread_cond_wait(&cond, &mutex);
+    }
+    tlaunch = now() - start;
+    /* and for the jobs to complete */
+    while (ncompleted < nlaunched) {
+        pthread_cond_wait(&cond, &mutex);
+    }
+    tdone = now() - start;
+    pthread_mutex_unlock(&mutex);
+
+    fprintf(stdout, "%d jobs of %d procs (%d failed)\n", njobs, nprocs, nfailed);
+    fprintf(stdout, "launched:  %.3f sec  %.1f jobs/sec\n", tlaunch,
+            (0.0 < tlaunch) ? (double)nlaunched / tlaunch : 0.0);
+    fprintf(stdout, "completed: %.3f sec  %.1f jobs/sec\n", tdone,
+            (0.0 < tdone) ? (double)ncompleted / tdone : 0.0);
+
+    PMIX_INFO_DESTRUCT(&jinfo);
+    PMIX_APP_DESTRUCT(&app);
+
+  done:
+    PMIx_tool_finalize();
+    return(0);
+}
@@ -110,6 +110,17 @@ PRTE_EXPORT int prte_event_assign(struct event *ev, prte_event_base_t *evbase,
 
 #define prte_event_set(b, x, fd, fg, cb, arg) prte_event_assign((x), (b), (fd), (fg), (event_callback_fn) (cb), (arg))
 
+/* Event profiler - when enabled, one-shot events used to shift work
+ * onto prte_event_base are wrapped so the time each spends waiting
+ * in the queue and running its callback is recorded by callback */
+PRTE_EXPORT extern bool prte_event_profile_enabled;
+
+PRTE_EXPORT int prte_event_profile_assign(struct event *ev, prte_event_base_t *evbase,
+                                          event_callback_fn cbfn, void *cbd,
+                                          const char *site);
+
+#define prte_event_shift_set(b, x, cb, arg) prte_event_profile_assign((x), (b), (event_callback_fn) (cb), (arg), #cb)
+
 #if PRTE_HAVE_LIBEV
 PRTE_EXPORT int prte_event_add(struct event *ev, struct timeval *tv);
 PRTE_EXPORT int prte_event_del(struct event *ev);
@@ -109,19 +109,45 @@ typedef struct {
 } prte_hwloc_obj_data_t;
 PRTE_CLASS_DECLARATION(prte_hwloc_obj_data_t);
 
+/* the objects found at one level of a topology, in logical order */
 typedef struct {
-    prte_list_item_t super;
     hwloc_obj_type_t type;
     unsigned cache_level;
     unsigned int num_objs;
-    prte_list_t sorted_by_dist_list;
-} prte_hwloc_summary_t;
-PRTE_CLASS_DECLARATION(prte_hwloc_summary_t);
+    hwloc_obj_t *objs;
+} prte_hwloc_topo_level_t;
+
+/* the NUMA nodes sorted by their distance from a device */
+typedef struct {
+    prte_list_item_t super;
+    char *device;
+    unsigned int num_nodes;
+    int *index;
+    float *dist;
+} prte_hwloc_numa_sort_t;
+PRTE_CLASS_DECLARATION(prte_hwloc_numa_sort_t);
+
+/* Compiled index of a topology. Topologies are shared by all nodes
+ * with the same signature, so this is built once per signature the
+ * first time it is needed and lets the mappers find objects by type
+ * and instance with an array access instead of a tree search */
+typedef struct {
+    prte_object_t super;
+    unsigned int num_levels;
+    prte_hwloc_topo_level_t *levels;
+    /* NUMA latency matrix, num_numa x num_numa, if the
+     * topology provided one */
+    unsigned int num_numa;
+    float *numa_dist;
+    /* list of prte_hwloc_numa_sort_t */
+    prte_list_t numa_sorts;
+} prte_hwloc_topo_index_t;
+PRTE_CLASS_DECLARATION(prte_hwloc_topo_index_t);
 
 typedef struct {
     prte_object_t super;
     hwloc_cpuset_t available;
-    prte_list_t summaries;
+    prte_hwloc_topo_index_t *index;
 
     /** \brief Additional space for custom data */
     void *userdata;
@@ -215,6 +241,7 @@ extern char* prte_hwloc_print_null;
 PRTE_EXPORT char* prte_hwloc_base_print_locality(prte_hwloc_locality_t locality);
 
 PRTE_EXPORT extern char *prte_hwloc_base_topo_file;
+PRTE_EXPORT extern char *prte_hwloc_base_topo_cache_dir;
 
 /* convenience macro for debugging */
 #define PRTE_HWLOC_SHOW_BINDING(n, v, t)                                \
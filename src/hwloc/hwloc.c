@@ -37,6 +37,7 @@ prte_hwloc_base_mbfa_t prte_hwloc_base_mbfa = PRTE_HWLOC_BASE_MBFA_WARN;
 prte_binding_policy_t prte_hwloc_default_binding_policy=0;
 char *prte_hwloc_default_cpu_list=NULL;
 char *prte_hwloc_base_topo_file = NULL;
+char *prte_hwloc_base_topo_cache_dir = NULL;
 int prte_hwloc_base_output = -1;
 bool prte_hwloc_default_use_hwthread_cpus = false;
 
@@ -193,6 +194,15 @@ int prte_hwloc_base_register(void)
                                  PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE, PRTE_INFO_LVL_9,
                                  PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_hwloc_base_topo_file);
 
+    prte_hwloc_base_topo_cache_dir = NULL;
+    (void) prte_mca_base_var_register("prte", "hwloc", "base", "topo_cache_dir",
+                                 "Node-local directory in which to cache the discovered topology so that "
+                                 "later daemons on the node can load it instead of rediscovering it. Entries "
+                                 "are keyed by the node's boot id and the cgroup/cpus available to the daemon "
+                                 "(default: none - always discover the topology)",
+                                 PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE, PRTE_INFO_LVL_9,
+                                 PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_hwloc_base_topo_cache_dir);
+
     /* register parameters */
     return PRTE_SUCCESS;
 }
@@ -375,39 +385,72 @@ PRTE_CLASS_INSTANCE(prte_hwloc_obj_data_t,
                    prte_object_t,
                    obj_data_const, NULL);
 
-static void sum_const(prte_hwloc_summary_t *ptr)
+static void numa_sort_const(prte_hwloc_numa_sort_t *ptr)
 {
-    ptr->num_objs = 0;
-    PRTE_CONSTRUCT(&ptr->sorted_by_dist_list, prte_list_t);
+    ptr->device = NULL;
+    ptr->num_nodes = 0;
+    ptr->index = NULL;
+    ptr->dist = NULL;
 }
-static void sum_dest(prte_hwloc_summary_t *ptr)
+static void numa_sort_dest(prte_hwloc_numa_sort_t *ptr)
 {
-    prte_list_item_t *item;
-    while (NULL != (item = prte_list_remove_first(&ptr->sorted_by_dist_list))) {
-        PRTE_RELEASE(item);
+    if (NULL != ptr->device) {
+        free(ptr->device);
+    }
+    if (NULL != ptr->index) {
+        free(ptr->index);
+    }
+    if (NULL != ptr->dist) {
+        free(ptr->dist);
     }
-    PRTE_DESTRUCT(&ptr->sorted_by_dist_list);
 }
-PRTE_CLASS_INSTANCE(prte_hwloc_summary_t,
+PRTE_CLASS_INSTANCE(prte_hwloc_numa_sort_t,
                    prte_list_item_t,
-                   sum_const, sum_dest);
+                   numa_sort_const, numa_sort_dest);
+
+static void topo_index_const(prte_hwloc_topo_index_t *ptr)
+{
+    ptr->num_levels = 0;
+    ptr->levels = NULL;
+    ptr->num_numa = 0;
+    ptr->numa_dist = NULL;
+    PRTE_CONSTRUCT(&ptr->numa_sorts, prte_list_t);
+}
+static void topo_index_dest(prte_hwloc_topo_index_t *ptr)
+{
+    unsigned n;
+
+    for (n=0; n < ptr->num_levels; n++) {
+        if (NULL != ptr->levels[n].objs) {
+            free(ptr->levels[n].objs);
+        }
+    }
+    if (NULL != ptr->levels) {
+        free(ptr->levels);
+    }
+    if (NULL != ptr->numa_dist) {
+        free(ptr->numa_dist);
+    }
+    PRTE_LIST_DESTRUCT(&ptr->numa_sorts);
+}
+PRTE_CLASS_INSTANCE(prte_hwloc_topo_index_t,
+                   prte_object_t,
+                   topo_index_const, topo_index_dest);
+
 static void topo_data_const(prte_hwloc_topo_data_t *ptr)
 {
     ptr->available = NULL;
-    PRTE_CONSTRUCT(&ptr->summaries, prte_list_t);
+    ptr->index = NULL;
     ptr->userdata = NULL;
 }
 static void topo_data_dest(prte_hwloc_topo_data_t *ptr)
 {
-    prte_list_item_t *item;
-
     if (NULL != ptr->available) {
         hwloc_bitmap_free(ptr->available);
     }
-    while (NULL != (item = prte_list_remove_first(&ptr->summaries))) {
-        PRTE_RELEASE(item);
+    if (NULL != ptr->index) {
+        PRTE_RELEASE(ptr->index);
     }
-    PRTE_DESTRUCT(&ptr->summaries);
     ptr->userdata = NULL;
 }
 PRTE_CLASS_INSTANCE(prte_hwloc_topo_data_t,
@@ -289,9 +289,211 @@ static void fill_cache_line_size(void)
     }
 }
 
+/* read a small file into a NULL-terminated string */
+static char* topo_cache_read(const char *path)
+{
+    FILE *fp;
+    char *buf, *tmp;
+    size_t n, len = 0, sz = 1024;
+
+    if (NULL == (fp = fopen(path, "r"))) {
+        return NULL;
+    }
+    buf = (char*)malloc(sz);
+    while (NULL != buf && 0 < (n = fread(buf + len, 1, sz - len - 1, fp))) {
+        len += n;
+        if (len == sz - 1) {
+            sz *= 2;
+            if (NULL == (tmp = (char*)realloc(buf, sz))) {
+                free(buf);
+            }
+            buf = tmp;
+        }
+    }
+    fclose(fp);
+    if (NULL != buf) {
+        buf[len] = '\0';
+    }
+    return buf;
+}
+
+/* the key identifying the topology we would discover: the boot id
+ * changes every time the node is rebooted (and so whenever its
+ * hardware could have changed), while the cgroup and allowed cpus
+ * capture the part of the node we were given */
+static char* topo_cache_key(void)
+{
+    char *bootid, *cgroup, *status, *cpus = NULL, *mems = NULL;
+    char *key = NULL, *ptr;
+
+    /* without a boot id we cannot tell if the node has changed */
+    if (NULL == (bootid = topo_cache_read("/proc/sys/kernel/random/boot_id"))) {
+        return NULL;
+    }
+    cgroup = topo_cache_read("/proc/self/cgroup");
+    status = topo_cache_read("/proc/self/status");
+    if (NULL != status) {
+        /* find both lines before terminating either of them */
+        cpus = strstr(status, "Cpus_allowed_list:");
+        mems = strstr(status, "Mems_allowed_list:");
+        if (NULL != cpus && NULL != (ptr = strchr(cpus, '\n'))) {
+            *ptr = '\0';
+        }
+        if (NULL != mems && NULL != (ptr = strchr(mems, '\n'))) {
+            *ptr = '\0';
+        }
+    }
+    prte_asprintf(&key, "hwloc %x\nboot %s\ncgroup %s\n%s\n%s\n",
+                  (unsigned)hwloc_get_api_version(), bootid,
+                  (NULL == cgroup) ? "" : cgroup,
+                  (NULL == cpus) ? "" : cpus,
+                  (NULL == mems) ? "" : mems);
+    free(bootid);
+    if (NULL != cgroup) {
+        free(cgroup);
+    }
+    if (NULL != status) {
+        free(status);
+    }
+    return key;
+}
+
+/* the cache files are named by a hash of the key - the key itself
+ * is stored in the ".sig" file along with the topology signature */
+static char* topo_cache_path(const char *key, const char *suffix)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char *c;
+    char *path = NULL;
+
+    for (c = (const unsigned char*)key; '\0' != *c; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
+    }
+    prte_asprintf(&path, "%s/topo.%016llx.%s", prte_hwloc_base_topo_cache_dir,
+                  (unsigned long long)hash, suffix);
+    return path;
+}
+
+static int topo_cache_load(const char *key)
+{
+    char *xmlfile, *sigfile, *contents, *sig;
+    size_t klen;
+    int rc = PRTE_ERR_NOT_FOUND;
+
+    xmlfile = topo_cache_path(key, "xml");
+    sigfile = topo_cache_path(key, "sig");
+    if (NULL == xmlfile || NULL == sigfile) {
+        goto cleanup;
+    }
+    /* check that this entry is for us before touching the xml */
+    contents = topo_cache_read(sigfile);
+    klen = strlen(key);
+    if (NULL == contents || 0 != strncmp(contents, key, klen)) {
+        if (NULL != contents) {
+            free(contents);
+        }
+        goto cleanup;
+    }
+    if (PRTE_SUCCESS != prte_hwloc_base_set_topology(xmlfile)) {
+        free(contents);
+        goto cleanup;
+    }
+    /* make sure what we loaded is what was stored - anything
+     * else means the files are damaged or were written by an
+     * incompatible version */
+    sig = prte_hwloc_base_get_topo_signature(prte_hwloc_topology);
+    if (NULL == sig || 0 != strcmp(contents + klen, sig)) {
+        prte_output_verbose(1, prte_hwloc_base_output,
+                            "hwloc:base cached topology %s does not match its signature",
+                            xmlfile);
+        hwloc_topology_destroy(prte_hwloc_topology);
+        prte_hwloc_topology = NULL;
+        unlink(xmlfile);
+        unlink(sigfile);
+    } else {
+        prte_output_verbose(1, prte_hwloc_base_output,
+                            "hwloc:base loaded cached topology %s", xmlfile);
+        rc = PRTE_SUCCESS;
+    }
+    if (NULL != sig) {
+        free(sig);
+    }
+    free(contents);
+
+  cleanup:
+    if (NULL != xmlfile) {
+        free(xmlfile);
+    }
+    if (NULL != sigfile) {
+        free(sigfile);
+    }
+    return rc;
+}
+
+static void topo_cache_store(const char *key)
+{
+    char *xmlfile, *sigfile, *tmp = NULL, *sig;
+    FILE *fp;
+
+    if (PRTE_SUCCESS != prte_os_dirpath_create(prte_hwloc_base_topo_cache_dir, S_IRWXU)) {
+        return;
+    }
+    xmlfile = topo_cache_path(key, "xml");
+    sigfile = topo_cache_path(key, "sig");
+    sig = prte_hwloc_base_get_topo_signature(prte_hwloc_topology);
+    if (NULL == xmlfile || NULL == sigfile || NULL == sig) {
+        goto cleanup;
+    }
+
+    /* other daemons on this node may be doing the same thing, so
+     * write into private files and rename them into place - the
+     * xml goes first so a matching .sig always has its xml */
+    prte_asprintf(&tmp, "%s.%lu", xmlfile, (unsigned long)getpid());
+#if HWLOC_API_VERSION < 0x20000
+    if (0 != hwloc_topology_export_xml(prte_hwloc_topology, tmp)) {
+#else
+    if (0 != hwloc_topology_export_xml(prte_hwloc_topology, tmp, 0)) {
+#endif
+        unlink(tmp);
+        goto cleanup;
+    }
+    if (0 != rename(tmp, xmlfile)) {
+        unlink(tmp);
+        goto cleanup;
+    }
+    free(tmp);
+    prte_asprintf(&tmp, "%s.%lu", sigfile, (unsigned long)getpid());
+    if (NULL == (fp = fopen(tmp, "w"))) {
+        goto cleanup;
+    }
+    if (0 > fprintf(fp, "%s%s", key, sig) || 0 != fclose(fp) ||
+        0 != rename(tmp, sigfile)) {
+        unlink(tmp);
+        goto cleanup;
+    }
+    prte_output_verbose(1, prte_hwloc_base_output,
+                        "hwloc:base cached topology in %s", xmlfile);
+
+  cleanup:
+    if (NULL != tmp) {
+        free(tmp);
+    }
+    if (NULL != xmlfile) {
+        free(xmlfile);
+    }
+    if (NULL != sigfile) {
+        free(sigfile);
+    }
+    if (NULL != sig) {
+        free(sig);
+    }
+}
+
 int prte_hwloc_base_get_topology(void)
 {
     int rc;
+    char *key = NULL;
 
     prte_output_verbose(2, prte_hwloc_base_output,
                          "hwloc:base:get_topology");
@@ -302,13 +504,30 @@ int prte_hwloc_base_get_topology(void)
     }
 
     if (NULL == prte_hwloc_base_topo_file) {
-        prte_output_verbose(1, prte_hwloc_base_output,
-                            "hwloc:base discovering topology");
-        if (0 != hwloc_topology_init(&prte_hwloc_topology) ||
-            0 != prte_hwloc_base_topology_set_flags(prte_hwloc_topology, 0, true) ||
-            0 != hwloc_topology_load(prte_hwloc_topology)) {
-            PRTE_ERROR_LOG(PRTE_ERR_NOT_SUPPORTED);
-            return PRTE_ERR_NOT_SUPPORTED;
+        /* see if a previous daemon on this node left us a copy */
+        if (NULL != prte_hwloc_base_topo_cache_dir &&
+            NULL != (key = topo_cache_key()) &&
+            PRTE_SUCCESS == topo_cache_load(key)) {
+            free(key);
+            key = NULL;
+        } else {
+            prte_output_verbose(1, prte_hwloc_base_output,
+                                "hwloc:base discovering topology");
+            if (0 != hwloc_topology_init(&prte_hwloc_topology) ||
+                0 != prte_hwloc_base_topology_set_flags(prte_hwloc_topology, 0, true) ||
+                0 != hwloc_topology_load(prte_hwloc_topology)) {
+                PRTE_ERROR_LOG(PRTE_ERR_NOT_SUPPORTED);
+                if (NULL != key) {
+                    free(key);
+                }
+                return PRTE_ERR_NOT_SUPPORTED;
+            }
+            /* save it for the next daemon - do this before we
+             * filter the cpus as that can change between runs */
+            if (NULL != key) {
+                topo_cache_store(key);
+                free(key);
+            }
         }
     } else {
         prte_output_verbose(1, prte_hwloc_base_output,
@@ -346,12 +565,15 @@ int prte_hwloc_base_set_topology(char *topofile)
 
    if (NULL != prte_hwloc_topology) {
         hwloc_topology_destroy(prte_hwloc_topology);
+        prte_hwloc_topology = NULL;
     }
     if (0 != hwloc_topology_init(&prte_hwloc_topology)) {
+        prte_hwloc_topology = NULL;
         return PRTE_ERR_NOT_SUPPORTED;
     }
     if (0 != hwloc_topology_set_xml(prte_hwloc_topology, topofile)) {
         hwloc_topology_destroy(prte_hwloc_topology);
+        prte_hwloc_topology = NULL;
         PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
                              "hwloc:base:set_topology bad topo file"));
         return PRTE_ERR_NOT_SUPPORTED;
@@ -363,10 +585,12 @@ int prte_hwloc_base_set_topology(char *topofile)
                                                 HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM,
                                                 true)) {
         hwloc_topology_destroy(prte_hwloc_topology);
+        prte_hwloc_topology = NULL;
         return PRTE_ERR_NOT_SUPPORTED;
     }
     if (0 != hwloc_topology_load(prte_hwloc_topology)) {
         hwloc_topology_destroy(prte_hwloc_topology);
+        prte_hwloc_topology = NULL;
         PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
                              "hwloc:base:set_topology failed to load"));
         return PRTE_ERR_NOT_SUPPORTED;
@@ -560,51 +784,205 @@ unsigned int prte_hwloc_base_get_npus(hwloc_topology_t topo,
     return cnt;
 }
 
-unsigned int prte_hwloc_base_get_obj_idx(hwloc_topology_t topo,
-                                         hwloc_obj_t obj)
+/* the special depths that hold objects outside of the main tree */
+static const int special_depths[] = {
+#if HWLOC_API_VERSION >= 0x20000
+    HWLOC_TYPE_DEPTH_NUMANODE,
+    HWLOC_TYPE_DEPTH_MISC,
+#endif
+    HWLOC_TYPE_DEPTH_BRIDGE,
+    HWLOC_TYPE_DEPTH_PCI_DEVICE,
+    HWLOC_TYPE_DEPTH_OS_DEVICE
+};
+
+static void load_numa_distances(hwloc_topology_t topo,
+                                prte_hwloc_topo_index_t *idx)
 {
-    unsigned cache_level=0;
-    prte_hwloc_obj_data_t *data;
-    hwloc_obj_t ptr;
-    unsigned int nobjs, i;
+    struct hwloc_distances_s* distances;
+    unsigned j;
+#if HWLOC_API_VERSION < 0x20000
+    hwloc_obj_t root, obj;
+    int depth;
+    unsigned i;
+#else
+    unsigned distances_nr = 0;
+#endif
 
-    PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
-                         "hwloc:base:get_idx"));
+#if HWLOC_API_VERSION < 0x20000
+    distances = (struct hwloc_distances_s*)hwloc_get_whole_distance_matrix_by_type(topo, HWLOC_OBJ_NODE);
+    if (NULL ==  distances) {
+        /* we can try to find distances under group object. This info can be there. */
+        depth = hwloc_get_type_depth(topo, HWLOC_OBJ_NODE);
+        if (HWLOC_TYPE_DEPTH_UNKNOWN == depth) {
+            return;
+        }
+        root = hwloc_get_root_obj(topo);
+        for (i = 0; i < root->arity; i++) {
+            obj = root->children[i];
+            if (obj->distances_count > 0) {
+                for(j = 0; j < obj->distances_count; j++) {
+                    if (obj->distances[j]->relative_depth + 1 == (unsigned) depth) {
+                        distances = obj->distances[j];
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    if ((NULL == distances) || (0 == distances->nbobjs)) {
+        return;
+    }
+    idx->num_numa = distances->nbobjs;
+    idx->numa_dist = (float*)malloc(idx->num_numa * idx->num_numa * sizeof(float));
+    for (j = 0; j < idx->num_numa * idx->num_numa; j++) {
+        idx->numa_dist[j] = distances->latency[j];
+    }
+#else
+    distances_nr = 1;
+    if (0 != hwloc_distances_get_by_type(topo, HWLOC_OBJ_NODE, &distances_nr, &distances,
+                                         HWLOC_DISTANCES_KIND_MEANS_LATENCY, 0) || 0 == distances_nr) {
+        return;
+    }
+    if (0 < distances->nbobjs) {
+        idx->num_numa = distances->nbobjs;
+        idx->numa_dist = (float*)malloc(idx->num_numa * idx->num_numa * sizeof(float));
+        for (j = 0; j < idx->num_numa * idx->num_numa; j++) {
+            idx->numa_dist[j] = distances->values[j];
+        }
+    }
+    hwloc_distances_release(topo, distances);
+#endif
+}
 
-    /* see if we already have the info */
-    data = (prte_hwloc_obj_data_t*)obj->userdata;
+static void index_level(hwloc_topology_t topo, prte_hwloc_topo_level_t *lvl,
+                        int depth, unsigned nobjs)
+{
+    unsigned i;
 
+    lvl->type = hwloc_get_depth_type(topo, depth);
+    lvl->cache_level = 0;
+    lvl->num_objs = nobjs;
+    lvl->objs = (hwloc_obj_t*)malloc(nobjs * sizeof(hwloc_obj_t));
+    for (i=0; i < nobjs; i++) {
+        lvl->objs[i] = hwloc_get_obj_by_depth(topo, depth, i);
+    }
+#if HWLOC_API_VERSION < 0x20000
+    /* hwloc treats cache objects as special
+     * cases. Instead of having a unique type for each cache level,
+     * there is a single cache object type, and the level is encoded
+     * in an attribute union */
+    if (HWLOC_OBJ_CACHE == lvl->type) {
+        lvl->cache_level = lvl->objs[0]->attr->cache.depth;
+    }
+#endif
+}
+
+/* get the compiled index for this topology, building it if necessary */
+static prte_hwloc_topo_index_t* get_topo_index(hwloc_topology_t topo)
+{
+    hwloc_obj_t root;
+    prte_hwloc_topo_data_t *data;
+    prte_hwloc_topo_index_t *idx;
+    int depth, d;
+    unsigned n, nobjs;
+
+    root = hwloc_get_root_obj(topo);
+    data = (prte_hwloc_topo_data_t*)root->userdata;
     if (NULL == data) {
-        data = PRTE_NEW(prte_hwloc_obj_data_t);
-        obj->userdata = (void*)data;
+        data = PRTE_NEW(prte_hwloc_topo_data_t);
+        root->userdata = (void*)data;
+    }
+    if (NULL != data->index) {
+        return data->index;
     }
 
-    if (data->idx < UINT_MAX) {
-        PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
-                             "hwloc:base:get_idx already have data: %u",
-                             data->idx));
-        return data->idx;
+    idx = PRTE_NEW(prte_hwloc_topo_index_t);
+    depth = hwloc_topology_get_depth(topo);
+    n = sizeof(special_depths) / sizeof(int);
+    idx->levels = (prte_hwloc_topo_level_t*)calloc(depth + n, sizeof(prte_hwloc_topo_level_t));
+    for (d=0; d < depth; d++) {
+        nobjs = hwloc_get_nbobjs_by_depth(topo, d);
+        if (0 < nobjs) {
+            index_level(topo, &idx->levels[idx->num_levels], d, nobjs);
+            ++idx->num_levels;
+        }
+    }
+    for (n=0; n < sizeof(special_depths) / sizeof(int); n++) {
+        nobjs = hwloc_get_nbobjs_by_depth(topo, special_depths[n]);
+        if (0 < nobjs) {
+            index_level(topo, &idx->levels[idx->num_levels], special_depths[n], nobjs);
+            ++idx->num_levels;
+        }
     }
+    load_numa_distances(topo, idx);
 
+    PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                         "hwloc:base:get_topo_index indexed %u levels %u numa distances",
+                         idx->num_levels, idx->num_numa));
+
+    data->index = idx;
+    return idx;
+}
+
+/* find the level holding objects of the given type - returns
+ * NULL if there is no such level, or if objects of that type
+ * are found at more than one level */
+static prte_hwloc_topo_level_t* find_level(prte_hwloc_topo_index_t *idx,
+                                      hwloc_obj_type_t target,
+                                      unsigned cache_level)
+{
+    prte_hwloc_topo_level_t *lvl = NULL;
+    unsigned n;
+
+    for (n=0; n < idx->num_levels; n++) {
+        if (target != idx->levels[n].type) {
+            continue;
+        }
 #if HWLOC_API_VERSION < 0x20000
-    /* determine the number of objects of this type */
-    if (HWLOC_OBJ_CACHE == obj->type) {
-        cache_level = obj->attr->cache.depth;
-    }
+        if (HWLOC_OBJ_CACHE == target &&
+            cache_level != idx->levels[n].cache_level) {
+            continue;
+        }
 #endif
+        if (NULL != lvl) {
+            PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                                 "hwloc:base:find_level multiple levels of %s:%u",
+                                 hwloc_obj_type_string(target), cache_level));
+            return NULL;
+        }
+        lvl = &idx->levels[n];
+    }
+    return lvl;
+}
 
-    nobjs = prte_hwloc_base_get_nbobjs_by_type(topo, obj->type, cache_level);
+unsigned int prte_hwloc_base_get_obj_idx(hwloc_topology_t topo,
+                                         hwloc_obj_t obj)
+{
+    unsigned cache_level=0;
+    prte_hwloc_topo_level_t *lvl;
+    unsigned int i;
 
     PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
-                         "hwloc:base:get_idx found %u objects of type %s:%u",
-                         nobjs, hwloc_obj_type_string(obj->type), cache_level));
+                         "hwloc:base:get_idx"));
 
-    /* find this object */
-    for (i=0; i < nobjs; i++) {
-        ptr = prte_hwloc_base_get_obj_by_type(topo, obj->type, cache_level, i);
-        if (ptr == obj) {
-            data->idx = i;
-            return i;
+#if HWLOC_API_VERSION < 0x20000
+    if (HWLOC_OBJ_CACHE == obj->type) {
+        cache_level = obj->attr->cache.depth;
+    }
+#endif
+
+    lvl = find_level(get_topo_index(topo), obj->type, cache_level);
+    if (NULL != lvl) {
+        /* the logical index is the answer unless the
+         * object lives at a different level */
+        if (obj->logical_index < lvl->num_objs &&
+            lvl->objs[obj->logical_index] == obj) {
+            return obj->logical_index;
+        }
+        for (i=0; i < lvl->num_objs; i++) {
+            if (lvl->objs[i] == obj) {
+                return i;
+            }
         }
     }
     /* if we get here, it wasn't found */
@@ -614,46 +992,11 @@ unsigned int prte_hwloc_base_get_obj_idx(hwloc_topology_t topo,
     return UINT_MAX;
 }
 
-#if HWLOC_API_VERSION < 0x20000
-/* hwloc treats cache objects as special
- * cases. Instead of having a unique type for each cache level,
- * there is a single cache object type, and the level is encoded
- * in an attribute union. So looking for cache objects involves
- * a multi-step test :-(
- */
-static hwloc_obj_t df_search(hwloc_topology_t topo,
-                             hwloc_obj_t start,
-                             hwloc_obj_type_t target,
-                             unsigned cache_level,
-                             unsigned int nobj,
-                             unsigned int *num_objs)
-{
-    int search_depth;
-    
-    search_depth = hwloc_get_type_depth(topo, target);
-    if (HWLOC_TYPE_DEPTH_MULTIPLE == search_depth) {
-        /* either v1.x Cache, or Groups */
-        if (cache_level != HWLOC_OBJ_CACHE) {
-            return NULL;
-        }
-        search_depth = hwloc_get_cache_type_depth(topo, cache_level, (hwloc_obj_cache_type_t) -1);
-    }
-    if (HWLOC_TYPE_DEPTH_UNKNOWN == search_depth) {
-        return NULL;
-    }
-    
-    if (num_objs) {
-        *num_objs = hwloc_get_nbobjs_by_depth(topo, search_depth);
-    }
-    return hwloc_get_obj_by_depth(topo, search_depth, nobj);
-}
-#endif
-
 unsigned int prte_hwloc_base_get_nbobjs_by_type(hwloc_topology_t topo,
                                                 hwloc_obj_type_t target,
                                                 unsigned cache_level)
 {
-    int rc;
+    prte_hwloc_topo_level_t *lvl;
 
     /* bozo check */
     if (NULL == topo) {
@@ -662,68 +1005,10 @@ unsigned int prte_hwloc_base_get_nbobjs_by_type(hwloc_topology_t topo,
         return 0;
     }
 
-#if HWLOC_API_VERSION >= 0x20000
-    if (0 > (rc = hwloc_get_nbobjs_by_type(topo, target))) {
-        prte_output(0, "UNKNOWN HWLOC ERROR");
+    if (NULL == (lvl = find_level(get_topo_index(topo), target, cache_level))) {
         return 0;
     }
-    return rc;
-#else
-    unsigned int num_objs;
-    hwloc_obj_t obj;
-    prte_hwloc_summary_t *sum;
-    prte_hwloc_topo_data_t *data;
-
-    /* we can just use the hwloc accessor to get it,
-     * unless it is a CACHE as these are treated as special cases
-     */
-    if (HWLOC_OBJ_CACHE != target) {
-        /* we should not get an error back, but just in case... */
-        if (0 > (rc = hwloc_get_nbobjs_by_type(topo, target))) {
-            prte_output(0, "UNKNOWN HWLOC ERROR");
-            return 0;
-        }
-        return rc;
-    }
-
-    /* for everything else, we have to do some work */
-    num_objs = 0;
-    obj = hwloc_get_root_obj(topo);
-
-    /* first see if the topology already has this summary */
-    data = (prte_hwloc_topo_data_t*)obj->userdata;
-    if (NULL == data) {
-        data = PRTE_NEW(prte_hwloc_topo_data_t);
-        obj->userdata = (void*)data;
-    } else {
-        PRTE_LIST_FOREACH(sum, &data->summaries, prte_hwloc_summary_t) {
-            if (target == sum->type &&
-                cache_level == sum->cache_level) {
-                /* yep - return the value */
-                PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
-                                     "hwloc:base:get_nbojbs pre-existing data %u of %s:%u",
-                                     sum->num_objs, hwloc_obj_type_string(target), cache_level));
-                return sum->num_objs;
-            }
-        }
-    }
-
-    /* don't already know it - go get it */
-    df_search(topo, obj, target, cache_level, 0, &num_objs);
-
-    /* cache the results for later */
-    sum = PRTE_NEW(prte_hwloc_summary_t);
-    sum->type = target;
-    sum->cache_level = cache_level;
-    sum->num_objs = num_objs;
-    prte_list_append(&data->summaries, &sum->super);
-
-    PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
-                         "hwloc:base:get_nbojbs computed data %u of %s:%u",
-                         num_objs, hwloc_obj_type_string(target), cache_level));
-
-    return num_objs;
-#endif
+    return lvl->num_objs;
 }
 
 /* as above, only return the Nth instance of the specified object
@@ -734,28 +1019,18 @@ hwloc_obj_t prte_hwloc_base_get_obj_by_type(hwloc_topology_t topo,
                                             unsigned cache_level,
                                             unsigned int instance)
 {
+    prte_hwloc_topo_level_t *lvl;
+
     /* bozo check */
     if (NULL == topo) {
         return NULL;
     }
 
-
-#if HWLOC_API_VERSION >= 0x20000
-    return hwloc_get_obj_by_type(topo, target, instance);
-#else
-    hwloc_obj_t obj;
-
-    /* we can just use the hwloc accessor to get it, unless it is a CACHE
-     * as these are treated as special cases
-     */
-    if (HWLOC_OBJ_CACHE != target) {
-        return hwloc_get_obj_by_type(topo, target, instance);
+    lvl = find_level(get_topo_index(topo), target, cache_level);
+    if (NULL == lvl || lvl->num_objs <= instance) {
+        return NULL;
     }
-
-    /* for everything else, we have to do some work */
-    obj = hwloc_get_root_obj(topo);
-    return df_search(topo, obj, target, cache_level, instance, NULL);
-#endif
+    return lvl->objs[instance];
 }
 
 static void df_clear(hwloc_topology_t topo,
@@ -1522,22 +1797,14 @@ static int dist_cmp_fn (prte_list_item_t **a, prte_list_item_t **b)
     }
 }
 
-static void sort_by_dist(hwloc_topology_t topo, char* device_name, prte_list_t *sorted_list)
+static void sort_by_dist(hwloc_topology_t topo, prte_hwloc_topo_index_t *idx,
+                         char* device_name, prte_list_t *sorted_list)
 {
     hwloc_obj_t device_obj = NULL;
     hwloc_obj_t obj = NULL;
-    struct hwloc_distances_s* distances;
     prte_rmaps_numa_node_t *numa_node;
     int close_node_index;
-    float latency;
     unsigned int j;
-#if HWLOC_API_VERSION < 0x20000
-    hwloc_obj_t root = NULL;
-    int depth;
-    unsigned i;
-#else
-    unsigned distances_nr = 0;
-#endif
 
     for (device_obj = hwloc_get_obj_by_type(topo, HWLOC_OBJ_OS_DEVICE, 0); device_obj; device_obj = hwloc_get_next_osdev(topo, device_obj)) {
         if (device_obj->attr->osdev.type == HWLOC_OBJ_OSDEV_OPENFABRICS
@@ -1566,62 +1833,22 @@ static void sort_by_dist(hwloc_topology_t topo, char* device_name, prte_list_t *
                     close_node_index = obj->logical_index;
                 }
 
-                /* find distance matrix for all numa nodes */
-#if HWLOC_API_VERSION < 0x20000
-                distances = (struct hwloc_distances_s*)hwloc_get_whole_distance_matrix_by_type(topo, HWLOC_OBJ_NODE);
-                if (NULL ==  distances) {
-                    /* we can try to find distances under group object. This info can be there. */
-                    depth = hwloc_get_type_depth(topo, HWLOC_OBJ_NODE);
-                    if (HWLOC_TYPE_DEPTH_UNKNOWN == depth) {
-                        prte_output_verbose(5, prte_hwloc_base_output,
-                                "hwloc:base:get_sorted_numa_list: There is no information about distances on the node.");
-                        return;
-                    }
-                    root = hwloc_get_root_obj(topo);
-                    for (i = 0; i < root->arity; i++) {
-                        obj = root->children[i];
-                        if (obj->distances_count > 0) {
-                            for(j = 0; j < obj->distances_count; j++) {
-                                if (obj->distances[j]->relative_depth + 1 == (unsigned) depth) {
-                                    distances = obj->distances[j];
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                }
-                /* find all distances for our close node with logical index = close_node_index as close_node_index + nbobjs*j */
-                if ((NULL == distances) || (0 == distances->nbobjs)) {
+                /* the distance matrix for all numa nodes was
+                 * captured when we indexed the topology */
+                if (NULL == idx->numa_dist) {
                     prte_output_verbose(5, prte_hwloc_base_output,
                             "hwloc:base:get_sorted_numa_list: There is no information about distances on the node.");
                     return;
                 }
-                /* fill list of numa nodes */
-                for (j = 0; j < distances->nbobjs; j++) {
-                    latency = distances->latency[close_node_index + distances->nbobjs * j];
+                /* fill list of numa nodes with all distances for our close
+                 * node with logical index = close_node_index as
+                 * close_node_index + nbobjs*j */
+                for (j = 0; j < idx->num_numa; j++) {
                     numa_node = PRTE_NEW(prte_rmaps_numa_node_t);
                     numa_node->index = j;
-                    numa_node->dist_from_closed = latency;
+                    numa_node->dist_from_closed = idx->numa_dist[close_node_index + idx->num_numa * j];
                     prte_list_append(sorted_list, &numa_node->super);
                 }
-#else
-                distances_nr = 1;
-                if (0 != hwloc_distances_get_by_type(topo, HWLOC_OBJ_NODE, &distances_nr, &distances,
-                                                     HWLOC_DISTANCES_KIND_MEANS_LATENCY, 0) || 0 == distances_nr) {
-                    prte_output_verbose(5, prte_hwloc_base_output,
-                            "hwloc:base:get_sorted_numa_list: There is no information about distances on the node.");
-                    return;
-                }
-                /* fill list of numa nodes */
-                for (j = 0; j < distances->nbobjs; j++) {
-                    latency = distances->values[close_node_index + distances->nbobjs * j];
-                    numa_node = PRTE_NEW(prte_rmaps_numa_node_t);
-                    numa_node->index = j;
-                    numa_node->dist_from_closed = latency;
-                    prte_list_append(sorted_list, &numa_node->super);
-                }
-                hwloc_distances_release(topo, distances);
-#endif
                 /* sort numa nodes by distance from the closest one to PCI */
                 prte_list_sort(sorted_list, dist_cmp_fn);
                 return;
@@ -1646,63 +1873,66 @@ static int find_devices(hwloc_topology_t topo, char** device_name)
 
 int prte_hwloc_get_sorted_numa_list(hwloc_topology_t topo, char* device_name, prte_list_t *sorted_list)
 {
-    hwloc_obj_t obj;
-    prte_hwloc_summary_t *sum;
-    prte_hwloc_topo_data_t *data;
-    prte_rmaps_numa_node_t *numa, *copy_numa;
+    prte_hwloc_topo_index_t *idx;
+    prte_hwloc_numa_sort_t *sort;
+    prte_rmaps_numa_node_t *numa;
+    unsigned int n;
     int count;
-
-    obj = hwloc_get_root_obj(topo);
-
-    /* first see if the topology already has this info */
-    /* we call prte_hwloc_base_get_nbobjs_by_type() before it to fill summary object so it should exist*/
-    data = (prte_hwloc_topo_data_t*)obj->userdata;
-    if (NULL != data) {
-        PRTE_LIST_FOREACH(sum, &data->summaries, prte_hwloc_summary_t) {
-            if (HWLOC_OBJ_NODE == sum->type) {
-                if (prte_list_get_size(&sum->sorted_by_dist_list) > 0) {
-                    PRTE_LIST_FOREACH(numa, &(sum->sorted_by_dist_list), prte_rmaps_numa_node_t) {
-                        copy_numa = PRTE_NEW(prte_rmaps_numa_node_t);
-                        copy_numa->index = numa->index;
-                        copy_numa->dist_from_closed = numa->dist_from_closed;
-                        prte_list_append(sorted_list, &copy_numa->super);
-                    }
-                    return PRTE_SUCCESS;
-                }else {
-                    /* don't already know it - go get it */
-                    /* firstly we check if we need to autodetect OpenFabrics  devices or we have the specified one */
-                    bool free_device_name = false;
-                    if (!strcmp(device_name, "auto")) {
-                        count = find_devices(topo, &device_name);
-                        if (count > 1) {
-                            free(device_name);
-                            return count;
-                        }
-                        free_device_name = true;
-                    }
-                    if (!device_name) {
-                        return PRTE_ERR_NOT_FOUND;
-                    } else if (free_device_name && (0 == strlen(device_name))) {
-                        free(device_name);
-                        return PRTE_ERR_NOT_FOUND;
-                    }
-                    sort_by_dist(topo, device_name, sorted_list);
-                    if (free_device_name) {
-                        free(device_name);
-                    }
-                    /* store this info in summary object for later usage */
-                    PRTE_LIST_FOREACH(numa, sorted_list, prte_rmaps_numa_node_t) {
-                        copy_numa = PRTE_NEW(prte_rmaps_numa_node_t);
-                        copy_numa->index = numa->index;
-                        copy_numa->dist_from_closed = numa->dist_from_closed;
-                        prte_list_append(&(sum->sorted_by_dist_list), &copy_numa->super);
-                    }
-                    return PRTE_SUCCESS;
-                }
+    char *requested = device_name;
+    bool free_device_name = false;
+
+    idx = get_topo_index(topo);
+
+    /* first see if we already sorted the numa nodes for this device */
+    PRTE_LIST_FOREACH(sort, &idx->numa_sorts, prte_hwloc_numa_sort_t) {
+        if (0 == strcmp(sort->device, requested)) {
+            for (n=0; n < sort->num_nodes; n++) {
+                numa = PRTE_NEW(prte_rmaps_numa_node_t);
+                numa->index = sort->index[n];
+                numa->dist_from_closed = sort->dist[n];
+                prte_list_append(sorted_list, &numa->super);
             }
+            return PRTE_SUCCESS;
         }
     }
-    return PRTE_ERR_NOT_FOUND;
+
+    /* don't already know it - go get it */
+    /* firstly we check if we need to autodetect OpenFabrics  devices or we have the specified one */
+    if (!strcmp(device_name, "auto")) {
+        device_name = NULL;
+        count = find_devices(topo, &device_name);
+        if (count > 1) {
+            free(device_name);
+            return count;
+        }
+        free_device_name = true;
+    }
+    if (!device_name) {
+        return PRTE_ERR_NOT_FOUND;
+    } else if (free_device_name && (0 == strlen(device_name))) {
+        free(device_name);
+        return PRTE_ERR_NOT_FOUND;
+    }
+    sort_by_dist(topo, idx, device_name, sorted_list);
+    if (free_device_name) {
+        free(device_name);
+    }
+    /* store this info for later usage */
+    sort = PRTE_NEW(prte_hwloc_numa_sort_t);
+    sort->device = strdup(requested);
+    sort->num_nodes = prte_list_get_size(sorted_list);
+    if (0 < sort->num_nodes) {
+        sort->index = (int*)malloc(sort->num_nodes * sizeof(int));
+        sort->dist = (float*)malloc(sort->num_nodes * sizeof(float));
+        n = 0;
+        PRTE_LIST_FOREACH(numa, sorted_list, prte_rmaps_numa_node_t) {
+            sort->index[n] = numa->index;
+            sort->dist[n] = numa->dist_from_closed;
+            ++n;
+        }
+    }
+    prte_list_append(&idx->numa_sorts, &sort->super);
+    return PRTE_SUCCESS;
 }
 
 char* prte_hwloc_base_get_topo_signature(hwloc_topology_t topo)
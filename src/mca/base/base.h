@@ -74,6 +74,9 @@ PRTE_EXPORT extern char *prte_mca_base_component_path;
 PRTE_EXPORT extern bool prte_mca_base_component_show_load_errors;
 PRTE_EXPORT extern bool prte_mca_base_component_track_load_errors;
 PRTE_EXPORT extern bool prte_mca_base_component_disable_dlopen;
+PRTE_EXPORT extern char *prte_mca_base_component_manifest;
+PRTE_EXPORT extern bool prte_mca_base_component_manifest_select;
+PRTE_EXPORT extern bool prte_mca_base_component_manifest_generate;
 PRTE_EXPORT extern char *prte_mca_base_system_default_path;
 PRTE_EXPORT extern char *prte_mca_base_user_default_path;
 
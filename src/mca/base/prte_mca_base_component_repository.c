@@ -36,6 +36,9 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
 
 #include "src/class/prte_list.h"
 #include "src/mca/mca.h"
@@ -44,9 +47,11 @@
 #include "src/mca/prtedl/base/base.h"
 #include "constants.h"
 #include "src/class/prte_hash_table.h"
+#include "src/util/argv.h"
 #include "src/util/basename.h"
 #include "src/util/string_copy.h"
 #include "src/util/printf.h"
+#include "src/util/proc_info.h"
 
 #if PRTE_HAVE_DL_SUPPORT
 
@@ -98,36 +103,88 @@ static prte_hash_table_t prte_mca_base_component_repository;
 #define STRINGIFYX(x) #x
 #define STRINGIFY(x) STRINGIFYX(x)
 
-static int process_repository_item (const char *filename, void *data)
+/*
+ * The component manifest records the components found in each
+ * directory of the component path, along with the mtime of the
+ * directory, so later processes can skip scanning (and stat'ing
+ * every file in) directories that have not changed. It also records
+ * the files that turned out not to be valid components, with their
+ * own mtime and size, so they need not be dlopen'd again until they
+ * change. Files that failed to dlopen are not recorded - that can
+ * depend on the environment of the process.
+ *
+ * For frameworks that select a single component, the priority each
+ * component returned when queried is recorded per type of process
+ * (the proc_type of the process that made the selection), or "-" if
+ * it declined to run. When asked to, a process of the same type skips
+ * opening the components that declined, so they are never dlopen'd.
+ *
+ * Only the HNP writes the manifest, unless a process is explicitly
+ * asked to generate it - this is how the selections made by daemons
+ * are recorded. The file is plain text:
+ *
+ *   prte-component-manifest-3 <prte version>
+ *   dir <mtime> <directory>
+ *   comp <framework> <component> <invalid> <mtime> <size> <path>
+ *   ...
+ *   sel <proc type> <framework> <component> <priority>
+ *   ...
+ *
+ * with the comp lines following the dir they belong to.
+ */
+#define MANIFEST_TAG "prte-component-manifest-3 "
+typedef struct {
+    prte_list_item_t super;
+    char *dir;
+    long mtime;
+    /* "<framework> <component> <invalid> <mtime> <size> <path>" */
+    char **entries;
+    /* the repository now holds this directory's components */
+    bool used;
+} manifest_dir_t;
+static void md_con(manifest_dir_t *p)
 {
-    char name[PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN + 1];
+    p->dir = NULL;
+    p->mtime = 0;
+    p->entries = NULL;
+    p->used = false;
+}
+static void md_des(manifest_dir_t *p)
+{
+    if (NULL != p->dir) {
+        free(p->dir);
+    }
+    if (NULL != p->entries) {
+        prte_argv_free(p->entries);
+    }
+}
+static PRTE_CLASS_INSTANCE(manifest_dir_t, prte_list_item_t,
+                           md_con, md_des);
+
+/* the priority a component returned when it was queried
+ * by a given type of process */
+typedef struct {
+    prte_list_item_t super;
+    int role;
     char type[PRTE_MCA_BASE_MAX_TYPE_NAME_LEN + 1];
+    char name[PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN + 1];
+    bool declined;
+    int priority;
+} manifest_sel_t;
+static PRTE_CLASS_INSTANCE(manifest_sel_t, prte_list_item_t,
+                           NULL, NULL);
+
+static prte_list_t manifest_dirs;
+static prte_list_t manifest_sels;
+static bool manifest_dirty = false;
+
+static int add_repository_item (char *base, const char *type, const char *name,
+                                const char *path, bool invalid, long mtime, long size)
+{
     prte_mca_base_component_repository_item_t *ri;
     prte_list_t *component_list;
-    char *base;
     int ret;
 
-    base = prte_basename (filename);
-    if (NULL == base) {
-        return PRTE_ERROR;
-    }
-
-    /* check if the plugin has the appropriate prefix */
-    if (0 != strncmp (base, "mca_", 4)) {
-        free (base);
-        return PRTE_SUCCESS;
-    }
-
-    /* read framework and component names. framework names may not include an _
-     * but component names may */
-    ret = sscanf (base, "mca_%" STRINGIFY(PRTE_MCA_BASE_MAX_TYPE_NAME_LEN) "[^_]_%"
-                  STRINGIFY(PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN) "s", type, name);
-    if (0 > ret) {
-        /* does not patch the expected template. skip */
-        free(base);
-        return PRTE_SUCCESS;
-    }
-
     /* lookup the associated framework list and create if it doesn't already exist */
     ret = prte_hash_table_get_value_ptr (&prte_mca_base_component_repository, type,
                                          strlen (type), (void **) &component_list);
@@ -164,8 +221,12 @@ static int process_repository_item (const char *filename, void *data)
     }
 
     ri->ri_base = base;
+    ri->ri_load_failed = invalid;
+    ri->ri_invalid = invalid;
+    ri->ri_mtime = mtime;
+    ri->ri_size = size;
 
-    ri->ri_path = strdup (filename);
+    ri->ri_path = strdup (path);
     if (NULL == ri->ri_path) {
         PRTE_RELEASE(ri);
         return PRTE_ERR_OUT_OF_RESOURCE;
@@ -179,6 +240,287 @@ static int process_repository_item (const char *filename, void *data)
     return PRTE_SUCCESS;
 }
 
+static int process_repository_item (const char *filename, void *data)
+{
+    char name[PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN + 1];
+    char type[PRTE_MCA_BASE_MAX_TYPE_NAME_LEN + 1];
+    char *base;
+    int ret;
+
+    base = prte_basename (filename);
+    if (NULL == base) {
+        return PRTE_ERROR;
+    }
+
+    /* check if the plugin has the appropriate prefix */
+    if (0 != strncmp (base, "mca_", 4)) {
+        free (base);
+        return PRTE_SUCCESS;
+    }
+
+    /* read framework and component names. framework names may not include an _
+     * but component names may */
+    ret = sscanf (base, "mca_%" STRINGIFY(PRTE_MCA_BASE_MAX_TYPE_NAME_LEN) "[^_]_%"
+                  STRINGIFY(PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN) "s", type, name);
+    if (0 > ret) {
+        /* does not patch the expected template. skip */
+        free(base);
+        return PRTE_SUCCESS;
+    }
+
+    return add_repository_item (base, type, name, filename, false, 0, 0);
+}
+
+static void manifest_load (void)
+{
+    char type[PRTE_MCA_BASE_MAX_TYPE_NAME_LEN + 1];
+    char name[PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN + 1];
+    char priority[16];
+    FILE *fp;
+    char line[PRTE_PATH_MAX + 256], *ptr;
+    manifest_dir_t *md = NULL;
+    manifest_sel_t *ms;
+    long mtime;
+    int n, role;
+
+    PRTE_CONSTRUCT(&manifest_dirs, prte_list_t);
+    PRTE_CONSTRUCT(&manifest_sels, prte_list_t);
+    if (NULL == (fp = fopen (prte_mca_base_component_manifest, "r"))) {
+        return;
+    }
+    /* a manifest from another version of PRRTE is of no use */
+    n = strlen (MANIFEST_TAG);
+    if (NULL == fgets (line, sizeof(line), fp) ||
+        0 != strncmp (line, MANIFEST_TAG, n) ||
+        0 != strncmp (line + n, PRTE_VERSION, strlen(PRTE_VERSION)) ||
+        '\n' != line[n + strlen(PRTE_VERSION)]) {
+        fclose (fp);
+        return;
+    }
+    while (NULL != fgets (line, sizeof(line), fp)) {
+        if (NULL != (ptr = strchr (line, '\n'))) {
+            *ptr = '\0';
+        }
+        if (0 == strncmp (line, "dir ", 4)) {
+            if (1 != sscanf (line + 4, "%ld %n", &mtime, &n) ||
+                '\0' == line[4 + n]) {
+                continue;
+            }
+            md = PRTE_NEW(manifest_dir_t);
+            md->mtime = mtime;
+            md->dir = strdup (line + 4 + n);
+            prte_list_append (&manifest_dirs, &md->super);
+        } else if (0 == strncmp (line, "comp ", 5) && NULL != md) {
+            prte_argv_append_nosize (&md->entries, line + 5);
+        } else if (0 == strncmp (line, "sel ", 4)) {
+            if (4 != sscanf (line + 4, "%d %" STRINGIFY(PRTE_MCA_BASE_MAX_TYPE_NAME_LEN) "s %"
+                             STRINGIFY(PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN) "s %15s",
+                             &role, type, name, priority)) {
+                continue;
+            }
+            ms = PRTE_NEW(manifest_sel_t);
+            ms->role = role;
+            prte_string_copy (ms->type, type, sizeof(ms->type));
+            prte_string_copy (ms->name, name, sizeof(ms->name));
+            ms->declined = (0 == strcmp (priority, "-"));
+            ms->priority = ms->declined ? 0 : (int) strtol (priority, NULL, 10);
+            prte_list_append (&manifest_sels, &ms->super);
+        }
+    }
+    fclose (fp);
+}
+
+static manifest_sel_t *manifest_find_sel (int role, const char *type, const char *name)
+{
+    manifest_sel_t *ms;
+
+    PRTE_LIST_FOREACH(ms, &manifest_sels, manifest_sel_t) {
+        if (ms->role == role && 0 == strcmp (ms->type, type) &&
+            0 == strcmp (ms->name, name)) {
+            return ms;
+        }
+    }
+    return NULL;
+}
+
+static manifest_dir_t *manifest_find_dir (const char *dir)
+{
+    manifest_dir_t *md;
+
+    PRTE_LIST_FOREACH(md, &manifest_dirs, manifest_dir_t) {
+        if (0 == strcmp (md->dir, dir)) {
+            return md;
+        }
+    }
+    return NULL;
+}
+
+/* add the components in the given directory from the manifest,
+ * provided the directory hasn't changed since it was recorded */
+static int manifest_add_dir (const char *dir)
+{
+    char type[PRTE_MCA_BASE_MAX_TYPE_NAME_LEN + 1];
+    char name[PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN + 1];
+    manifest_dir_t *md;
+    struct stat buf;
+    char *base, *path;
+    long mtime, size;
+    int i, n, invalid, ret;
+
+    if (NULL == (md = manifest_find_dir (dir))) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+    if (md->used) {
+        /* already in the repository */
+        return PRTE_SUCCESS;
+    }
+    if (0 != stat (dir, &buf) || (long) buf.st_mtime != md->mtime) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    for (i = 0 ; NULL != md->entries && NULL != md->entries[i] ; ++i) {
+        ret = sscanf (md->entries[i], "%" STRINGIFY(PRTE_MCA_BASE_MAX_TYPE_NAME_LEN) "s %"
+                      STRINGIFY(PRTE_MCA_BASE_MAX_COMPONENT_NAME_LEN) "s %d %ld %ld %n",
+                      type, name, &invalid, &mtime, &size, &n);
+        if (5 != ret || '\0' == md->entries[i][n]) {
+            continue;
+        }
+        path = md->entries[i] + n;
+        /* an invalid component gets another chance once the
+         * file has been replaced */
+        if (invalid && (0 != stat (path, &buf) || (long) buf.st_mtime != mtime ||
+                        (long) buf.st_size != size)) {
+            invalid = 0;
+            manifest_dirty = true;
+        }
+        base = prte_basename (path);
+        if (NULL == base) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        ret = add_repository_item (base, type, name, path, (bool) invalid, mtime, size);
+        if (PRTE_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    md->used = true;
+
+    prte_output_verbose (PRTE_MCA_BASE_VERBOSE_INFO, 0, "mca_base_component_repository_add: "
+                         "using manifest for %s", dir);
+    return PRTE_SUCCESS;
+}
+
+/* note that we just scanned this directory so it is written
+ * to the manifest */
+static void manifest_scanned_dir (const char *dir)
+{
+    manifest_dir_t *md;
+    struct stat buf;
+
+    if (0 != stat (dir, &buf)) {
+        return;
+    }
+    if (NULL == (md = manifest_find_dir (dir))) {
+        md = PRTE_NEW(manifest_dir_t);
+        md->dir = strdup (dir);
+        prte_list_append (&manifest_dirs, &md->super);
+    }
+    md->mtime = (long) buf.st_mtime;
+    md->used = true;
+    manifest_dirty = true;
+}
+
+/* the file is not a valid component - record it with the file's
+ * mtime and size so the manifest notices when it is replaced */
+static void mark_invalid (prte_mca_base_component_repository_item_t *ri)
+{
+    struct stat buf;
+
+    if (0 != stat (ri->ri_path, &buf)) {
+        return;
+    }
+    ri->ri_invalid = true;
+    ri->ri_mtime = (long) buf.st_mtime;
+    ri->ri_size = (long) buf.st_size;
+    manifest_dirty = true;
+}
+
+static void manifest_write_dir (FILE *fp, manifest_dir_t *md)
+{
+    prte_mca_base_component_repository_item_t *ri;
+    prte_list_t *component_list;
+    void *node, *key;
+    size_t key_size, len;
+    int i, ret;
+
+    fprintf (fp, "dir %ld %s\n", md->mtime, md->dir);
+    if (!md->used) {
+        /* not looked at by this process - keep what we had */
+        for (i = 0 ; NULL != md->entries && NULL != md->entries[i] ; ++i) {
+            fprintf (fp, "comp %s\n", md->entries[i]);
+        }
+        return;
+    }
+
+    len = strlen (md->dir);
+    ret = prte_hash_table_get_first_key_ptr (&prte_mca_base_component_repository, &key, &key_size,
+                                             (void **) &component_list, &node);
+    while (PRTE_SUCCESS == ret) {
+        PRTE_LIST_FOREACH(ri, component_list, prte_mca_base_component_repository_item_t) {
+            if (0 == strncmp (ri->ri_path, md->dir, len) &&
+                PRTE_PATH_SEP[0] == ri->ri_path[len] &&
+                NULL == strchr (ri->ri_path + len + 1, PRTE_PATH_SEP[0])) {
+                fprintf (fp, "comp %s %s %d %ld %ld %s\n", ri->ri_type, ri->ri_name,
+                         (int) ri->ri_invalid, ri->ri_invalid ? ri->ri_mtime : 0L,
+                         ri->ri_invalid ? ri->ri_size : 0L, ri->ri_path);
+            }
+        }
+        ret = prte_hash_table_get_next_key_ptr (&prte_mca_base_component_repository, &key,
+                                                &key_size, (void **) &component_list,
+                                                node, &node);
+    }
+}
+
+static void manifest_write (void)
+{
+    manifest_dir_t *md;
+    manifest_sel_t *ms;
+    char *tmp = NULL;
+    FILE *fp;
+
+    /* leave the file to the HNP so that a large job's daemons
+     * don't all rewrite it */
+    if (!manifest_dirty ||
+        !(PRTE_PROC_IS_MASTER || prte_mca_base_component_manifest_generate)) {
+        return;
+    }
+    /* many processes may be doing this at once, so write a private
+     * copy and rename it into place */
+    if (0 > prte_asprintf (&tmp, "%s.%lu", prte_mca_base_component_manifest,
+                           (unsigned long) getpid ())) {
+        return;
+    }
+    if (NULL == (fp = fopen (tmp, "w"))) {
+        free (tmp);
+        return;
+    }
+    fprintf (fp, "%s%s\n", MANIFEST_TAG, PRTE_VERSION);
+    PRTE_LIST_FOREACH(md, &manifest_dirs, manifest_dir_t) {
+        manifest_write_dir (fp, md);
+    }
+    PRTE_LIST_FOREACH(ms, &manifest_sels, manifest_sel_t) {
+        if (ms->declined) {
+            fprintf (fp, "sel %d %s %s -\n", ms->role, ms->type, ms->name);
+        } else {
+            fprintf (fp, "sel %d %s %s %d\n", ms->role, ms->type, ms->name, ms->priority);
+        }
+    }
+    if (0 != fclose (fp) ||
+        0 != rename (tmp, prte_mca_base_component_manifest)) {
+        unlink (tmp);
+    }
+    free (tmp);
+}
+
 static int file_exists(const char *filename, const char *ext)
 {
     char *final;
@@ -228,9 +570,18 @@ int prte_mca_base_component_repository_add (const char *path)
             dir = prte_mca_base_system_default_path;
         }
 
+        if (NULL != prte_mca_base_component_manifest &&
+            PRTE_SUCCESS == manifest_add_dir (dir)) {
+            continue;
+        }
+
         if (0 != prte_dl_foreachfile(dir, process_repository_item, NULL)) {
             break;
         }
+
+        if (NULL != prte_mca_base_component_manifest) {
+            manifest_scanned_dir (dir);
+        }
     } while (NULL != (dir = strtok_r (NULL, sep, &ctx)));
 
     free (path_to_use);
@@ -267,9 +618,17 @@ int prte_mca_base_component_repository_init(void)
         return ret;
     }
 
+    if (NULL != prte_mca_base_component_manifest) {
+        manifest_load ();
+    }
+
     ret = prte_mca_base_component_repository_add (prte_mca_base_component_path);
     if (PRTE_SUCCESS != ret) {
         prte_output(0, "ERROR ON REPO ADD");
+        if (NULL != prte_mca_base_component_manifest) {
+            PRTE_LIST_DESTRUCT(&manifest_dirs);
+            PRTE_LIST_DESTRUCT(&manifest_sels);
+        }
         PRTE_DESTRUCT(&prte_mca_base_component_repository);
         (void) prte_mca_base_framework_close (&prte_prtedl_base_framework);
         return ret;
@@ -366,6 +725,31 @@ int prte_mca_base_component_repository_retain_component (const char *type, const
 #endif
 }
 
+void prte_mca_base_component_repository_record_selection (const char *type, const char *name,
+                                                          bool declined, int priority)
+{
+#if PRTE_HAVE_DL_SUPPORT
+    manifest_sel_t *ms;
+    int role = (int) prte_process_info.proc_type;
+
+    if (!initialized || NULL == prte_mca_base_component_manifest) {
+        return;
+    }
+    if (NULL == (ms = manifest_find_sel (role, type, name))) {
+        ms = PRTE_NEW(manifest_sel_t);
+        ms->role = role;
+        prte_string_copy (ms->type, type, sizeof(ms->type));
+        prte_string_copy (ms->name, name, sizeof(ms->name));
+        prte_list_append (&manifest_sels, &ms->super);
+    } else if (ms->declined == declined && (declined || ms->priority == priority)) {
+        return;
+    }
+    ms->declined = declined;
+    ms->priority = declined ? 0 : priority;
+    manifest_dirty = true;
+#endif
+}
+
 int prte_mca_base_component_repository_open (prte_mca_base_framework_t *framework,
                                               prte_mca_base_component_repository_item_t *ri)
 {
@@ -409,6 +793,27 @@ int prte_mca_base_component_repository_open (prte_mca_base_framework_t *framewor
         return PRTE_SUCCESS;
     }
 
+    /* don't bother with components we already know can't be
+     * loaded unless the user wants to know why */
+    if (ri->ri_load_failed && !prte_mca_base_component_show_load_errors &&
+        !prte_mca_base_component_track_load_errors) {
+        prte_output_verbose (PRTE_MCA_BASE_VERBOSE_INFO, 0, "mca_base_component_repository_open: "
+                             "previously failed to load (ignored)");
+        return PRTE_ERR_BAD_PARAM;
+    }
+
+    /* don't open components that declined to run the last time
+     * a process of our type selected from this framework */
+    if (prte_mca_base_component_manifest_select && NULL != prte_mca_base_component_manifest) {
+        manifest_sel_t *ms = manifest_find_sel ((int) prte_process_info.proc_type,
+                                                ri->ri_type, ri->ri_name);
+        if (NULL != ms && ms->declined) {
+            prte_output_verbose (PRTE_MCA_BASE_VERBOSE_INFO, 0, "mca_base_component_repository_open: "
+                                 "declined selection according to the manifest (ignored)");
+            return PRTE_ERR_NOT_FOUND;
+        }
+    }
+
     if (0 != strcmp (ri->ri_type, framework->framework_name)) {
         /* shouldn't happen. attempting to open a component belonging to
          * another framework. if this happens it is likely a MCA base
@@ -437,6 +842,9 @@ int prte_mca_base_component_repository_open (prte_mca_base_framework_t *framewor
         }
         prte_output_verbose(vl, 0, "prte_mca_base_component_repository_open: unable to open %s: %s (ignored)",
                             ri->ri_base, err_msg);
+        /* whether a dlopen works can depend on the environment
+         * (e.g., LD_LIBRARY_PATH), so this is not recorded */
+        ri->ri_load_failed = true;
 
         if( prte_mca_base_component_track_load_errors ) {
             prte_mca_base_failed_component_t *f_comp = PRTE_NEW(prte_mca_base_failed_component_t);
@@ -516,6 +924,11 @@ int prte_mca_base_component_repository_open (prte_mca_base_framework_t *framewor
 
         ri->ri_component_struct = mitem->cli_component = component_struct;
         ri->ri_refcnt = 1;
+        ri->ri_load_failed = false;
+        if (ri->ri_invalid) {
+            ri->ri_invalid = false;
+            manifest_dirty = true;
+        }
         prte_list_append(&framework->framework_components, &mitem->super);
 
         prte_output_verbose (PRTE_MCA_BASE_VERBOSE_INFO, 0, "mca_base_component_repository_open: opened dynamic %s MCA "
@@ -535,6 +948,13 @@ int prte_mca_base_component_repository_open (prte_mca_base_framework_t *framewor
     prte_dl_close (ri->ri_dlhandle);
     ri->ri_dlhandle = NULL;
 
+    if (PRTE_ERR_BAD_PARAM == ret) {
+        ri->ri_load_failed = true;
+        if (!ri->ri_invalid) {
+            mark_invalid (ri);
+        }
+    }
+
     return ret;
 #else
 
@@ -560,6 +980,12 @@ void prte_mca_base_component_repository_finalize(void)
     size_t key_size;
     int ret;
 
+    if (NULL != prte_mca_base_component_manifest) {
+        manifest_write ();
+        PRTE_LIST_DESTRUCT(&manifest_dirs);
+        PRTE_LIST_DESTRUCT(&manifest_sels);
+    }
+
     ret = prte_hash_table_get_first_key_ptr (&prte_mca_base_component_repository, &key, &key_size,
                                              (void **) &component_list, &node);
     while (PRTE_SUCCESS == ret) {
@@ -585,6 +1011,10 @@ static void ri_constructor (prte_mca_base_component_repository_item_t *ri)
     ri->ri_dlhandle = NULL;
     ri->ri_component_struct = NULL;
     ri->ri_path = NULL;
+    ri->ri_load_failed = false;
+    ri->ri_invalid = false;
+    ri->ri_mtime = 0;
+    ri->ri_size = 0;
 }
 
 
@@ -57,6 +57,15 @@ struct prte_mca_base_component_repository_item_t {
     const prte_mca_base_component_t *ri_component_struct;
 
     int ri_refcnt;
+
+    /* component could not be loaded by this process */
+    bool ri_load_failed;
+    /* the file is not a valid component. Unlike a failed dlopen,
+     * which can depend on the environment, this is recorded in the
+     * component manifest along with the file's mtime and size */
+    bool ri_invalid;
+    long ri_mtime;
+    long ri_size;
 };
 typedef struct prte_mca_base_component_repository_item_t prte_mca_base_component_repository_item_t;
 
@@ -120,6 +129,19 @@ int prte_mca_base_component_repository_open (prte_mca_base_framework_t *framewor
                                               prte_mca_base_component_repository_item_t *ri);
 
 
+/**
+ * @brief record the result of querying a component during selection
+ *
+ * @param[in] type        framework name
+ * @param[in] name        component name
+ * @param[in] declined    the component declined to run
+ * @param[in] priority    priority returned by the component
+ *
+ * The result is kept in the component manifest for this type of process.
+ */
+PRTE_EXPORT void prte_mca_base_component_repository_record_selection (const char *type, const char *name,
+                                                                      bool declined, int priority);
+
 /**
  * @brief Reduce the reference count of a component and dlclose it if necessary
  */
@@ -84,6 +84,8 @@ int prte_mca_base_select(const char *type_name, int output_id,
              return rc;
         } else if (PRTE_SUCCESS != rc) {
             /* silently skip this component */
+            prte_mca_base_component_repository_record_selection (type_name, component->mca_component_name,
+                                                                 true, 0);
             continue;
         }
 
@@ -94,8 +96,12 @@ int prte_mca_base_select(const char *type_name, int output_id,
             prte_output_verbose (PRTE_MCA_BASE_VERBOSE_COMPONENT, output_id,
                                  "mca:base:select:(%5s) Skipping component [%s]. Query failed to return a module",
                                  type_name, component->mca_component_name );
+            prte_mca_base_component_repository_record_selection (type_name, component->mca_component_name,
+                                                                 true, 0);
             continue;
         }
+        prte_mca_base_component_repository_record_selection (type_name, component->mca_component_name,
+                                                             false, priority);
 
         /*
          * Determine if this is the best module we have seen by looking the priority
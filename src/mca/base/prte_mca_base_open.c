@@ -59,6 +59,9 @@ bool prte_mca_base_component_show_load_errors =
     (bool) PRTE_SHOW_LOAD_ERRORS_DEFAULT;
 bool prte_mca_base_component_track_load_errors = false;
 bool prte_mca_base_component_disable_dlopen = false;
+char *prte_mca_base_component_manifest = NULL;
+bool prte_mca_base_component_manifest_select = false;
+bool prte_mca_base_component_manifest_generate = false;
 
 static char *prte_mca_base_verbose = NULL;
 
@@ -145,6 +148,40 @@ int prte_mca_base_open(void)
                                 PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                 &prte_mca_base_component_disable_dlopen);
 
+    prte_mca_base_component_manifest = NULL;
+    prte_mca_base_var_register("prte", "mca", "base", "component_manifest",
+                                "File in which to cache the list of dynamic components found in each "
+                                "directory of the component path (and the files that are not valid components) so that "
+                                "unchanged directories need not be scanned again, along with the priority each component "
+                                "returned when selected. Only the HNP writes the file (default: none)",
+                                PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0,
+                                PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                PRTE_INFO_LVL_9,
+                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prte_mca_base_component_manifest);
+
+    prte_mca_base_component_manifest_select = false;
+    prte_mca_base_var_register("prte", "mca", "base", "component_manifest_select",
+                                "Do not open dynamic components that the component manifest records as having "
+                                "declined to run when this type of process last selected from their framework. "
+                                "Only use this when the environment the manifest was generated in matches this "
+                                "one (default: false)",
+                                PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                PRTE_INFO_LVL_9,
+                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prte_mca_base_component_manifest_select);
+
+    prte_mca_base_component_manifest_generate = false;
+    prte_mca_base_var_register("prte", "mca", "base", "component_manifest_generate",
+                                "Write the component manifest from this process even though it is not the HNP, "
+                                "e.g., to record the selections made by daemons (default: false)",
+                                PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                PRTE_INFO_LVL_9,
+                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prte_mca_base_component_manifest_generate);
+
     /* What verbosity level do we want for the default 0 stream? */
     char *str = getenv("PRTE_OUTPUT_INTERNAL_TO_STDOUT");
     if (NULL != str && str[0] == '1') {
@@ -80,11 +80,25 @@ prte_errmgr_base_module_t prte_errmgr_detector_module = {
 /* local storage */
 static prte_errmgr_detector_t prte_errmgr_world_detector = {0};
 
+/* failures reported through the event handler are shifted
+ * into the detector's event base */
+typedef struct {
+    prte_object_t super;
+    prte_event_t ev;
+    pmix_rank_t vpid;
+} fd_caddy_t;
+static PRTE_CLASS_INSTANCE(fd_caddy_t,
+                           prte_object_t,
+                           NULL, NULL);
+
 /*
  * Local functions
  */
-static int fd_heartbeat_request(prte_errmgr_detector_t* detector);
+static int fd_heartbeat_request(prte_errmgr_detector_t* detector, pmix_rank_t vpid);
 static void fd_heartbeat_send(prte_errmgr_detector_t* detector);
+static void fd_heartbeat_send_to(prte_errmgr_detector_t* detector, pmix_rank_t vpid);
+static void fd_update_peers(prte_errmgr_detector_t* detector, bool request);
+static bool fd_daemon_failed(prte_errmgr_detector_t* detector, pmix_rank_t vpid);
 
 static void fd_heartbeat_request_cb(int status,
         pmix_proc_t* sender,
@@ -102,6 +116,7 @@ static double Wtime(void );
 static prte_event_base_t* fd_event_base = NULL;
 
 static void fd_event_cb(int fd, short flags, void* pdetector);
+static void fd_failure_cb(int fd, short flags, void* cbdata);
 
 
 static int pack_state_for_proc(pmix_data_buffer_t *alert, prte_proc_t *child)
@@ -169,6 +184,15 @@ static void error_notify_cbfunc(size_t evhdlr_registration_id,
                                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&proc),
                                      info[n].key, PRTE_NAME_PRINT(source)));
 
+                if (PMIX_CHECK_NSPACE(proc.nspace, PRTE_PROC_MY_NAME->nspace)) {
+                    /* a daemon failed - make sure our part of the
+                     * ring no longer depends on it */
+                    fd_caddy_t *cd = PRTE_NEW(fd_caddy_t);
+                    cd->vpid = proc.rank;
+                    PRTE_THREADSHIFT(cd, fd_event_base, fd_failure_cb, PRTE_ERROR_PRI);
+                    continue;
+                }
+
                 if( prte_get_proc_daemon_vpid(&proc) != PRTE_PROC_MY_NAME->rank){
                     PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
                                 "%s errmgr:detector:error_notify_callback vpid mismatch - ignoring error",
@@ -260,11 +284,10 @@ int finalize(void) {
     if (PRTE_PROC_IS_DAEMON) {
         prte_errmgr_detector_t* detector = &prte_errmgr_world_detector;
 
-        if (detector->hb_observer != (int)PMIX_RANK_INVALID) {
-            detector->hb_observer = prte_process_info.myproc.rank;
+        if (0 < detector->hb_nobservers) {
             PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
                                  "errmgr:detector: send last heartbeat message"));
-            fd_heartbeat_send(detector);
+            fd_heartbeat_send_to(detector, prte_process_info.myproc.rank);
             detector->hb_period = INFINITY;
         }
         prte_event_del(&prte_errmgr_world_detector.fd_event);
@@ -273,9 +296,26 @@ int finalize(void) {
         if (prte_sync_event_base != fd_event_base) {
             prte_event_base_free(fd_event_base);
         }
-        /* set heartbeat peroid to infinity and observer to invalid */
+        /* set heartbeat peroid to infinity and drop the observers */
         prte_errmgr_world_detector.hb_period = INFINITY;
-        prte_errmgr_world_detector.hb_observer = PMIX_RANK_INVALID;
+        prte_errmgr_world_detector.hb_nobservers = 0;
+        prte_errmgr_world_detector.hb_nrequesters = 0;
+        prte_errmgr_world_detector.hb_nobserving = 0;
+        if (NULL != detector->hb_observing) {
+            free(detector->hb_observing);
+            free(detector->hb_observers);
+            free(detector->hb_requesters);
+            detector->hb_observing = NULL;
+            detector->hb_observers = NULL;
+            detector->hb_requesters = NULL;
+            if (NULL != detector->gossip) {
+                free(detector->gossip);
+                free(detector->gossip_rounds);
+                detector->gossip = NULL;
+                detector->gossip_rounds = NULL;
+            }
+            PRTE_DESTRUCT(&detector->daemons_state);
+        }
     }
     return PRTE_SUCCESS;
 }
@@ -283,20 +323,14 @@ int finalize(void) {
 bool errmgr_get_daemon_status(pmix_proc_t daemon)
 {
     prte_errmgr_detector_t* detector = &prte_errmgr_world_detector;
-    int i;
 
-    for (i=0; i<detector->failed_node_count; i++) {
-        if ( *(detector->daemons_state +i) == (int)daemon.rank) {
-            return false;
-        }
-    }
-    return true;
+    return !prte_bitmap_is_set_bit(&detector->daemons_state, daemon.rank);
 }
 
 void errmgr_set_daemon_status(pmix_proc_t daemon)
 {
     prte_errmgr_detector_t* detector = &prte_errmgr_world_detector;
-    *(detector->daemons_state + detector->failed_node_count) = daemon.rank;
+    prte_bitmap_set_bit(&detector->daemons_state, daemon.rank);
 }
 
 static double Wtime(void)
@@ -311,6 +345,41 @@ static double Wtime(void)
     return wtime;
 }
 
+/* daemons are arranged in a ring over vpids [1~n] */
+static inline pmix_rank_t ring_pred(pmix_rank_t vpid)
+{
+    return (1 == vpid) ? (pmix_rank_t)(prte_process_info.num_daemons - 1) : vpid - 1;
+}
+
+static inline pmix_rank_t ring_succ(pmix_rank_t vpid)
+{
+    return ((pmix_rank_t)(prte_process_info.num_daemons - 1) == vpid) ? 1 : vpid + 1;
+}
+
+/* distance from us to vpid when walking the ring forward */
+static inline int ring_dist(pmix_rank_t vpid)
+{
+    int ndmns = prte_process_info.num_daemons - 1;
+    return (ndmns + (int)vpid - (int)prte_process_info.myproc.rank) % ndmns;
+}
+
+/* the number of daemons each daemon observes - we cannot
+ * have more observers than there are other daemons */
+static inline int fd_num_peers(void)
+{
+    int k = prte_errmgr_detector_component.num_observers;
+
+    if (k > (int)prte_process_info.num_daemons - 2) {
+        k = (2 < prte_process_info.num_daemons) ? (int)prte_process_info.num_daemons - 2 : 1;
+    }
+    return k;
+}
+
+static inline bool daemon_failed(prte_errmgr_detector_t* detector, pmix_rank_t vpid)
+{
+    return prte_bitmap_is_set_bit(&detector->daemons_state, vpid);
+}
+
 static void enable_detector(bool enable_flag)
 {
     PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
@@ -319,8 +388,7 @@ static void enable_detector(bool enable_flag)
 
     if (PRTE_PROC_IS_DAEMON && enable_flag) {
         prte_errmgr_detector_t* detector = &prte_errmgr_world_detector;
-        int  ndmns, i;
-        uint32_t vpid;
+        int  ndmns, k, i;
 
         pmix_status_t pcode = prte_pmix_convert_rc(PRTE_ERR_PROC_ABORTED);
 
@@ -332,31 +400,49 @@ static void enable_detector(bool enable_flag)
 
         /* num of daemon in this jobid */
         ndmns = prte_process_info.num_daemons - 1;
-        vpid = prte_process_info.myproc.rank;
-        /*  we observing somebody {n,1,2,...n-1}, the ring */
-        if (0 != (vpid - 1)) {
-            detector->hb_observing = vpid - 1;
-        } else {
-            detector->hb_observing = ndmns;
-        }
-        /* someone is observing us: range [1~n], the observing ring */
-        detector->hb_observer = (ndmns+vpid) % ndmns + 1 ;
+        k = fd_num_peers();
+        detector->hb_observing = (prte_errmgr_detector_peer_t*)calloc(k, sizeof(prte_errmgr_detector_peer_t));
+        detector->hb_observers = (pmix_rank_t*)calloc(k, sizeof(pmix_rank_t));
+        detector->hb_requesters = (pmix_rank_t*)calloc(k, sizeof(pmix_rank_t));
+        detector->hb_nobserving = 0;
+        detector->hb_nobservers = 0;
+        detector->hb_nrequesters = 0;
         detector->hb_period = prte_errmgr_detector_component.heartbeat_period;
         detector->hb_timeout = prte_errmgr_detector_component.heartbeat_timeout;
         detector->hb_sstamp = 0.;
-        /* give some slack for MPI_Init */
-        detector->hb_rstamp = Wtime()+(double)ndmns;
 
-        detector->daemons_state = malloc(8* sizeof(int));
-        for (i=0; i<8; i++) {
-            *(detector->daemons_state + i) = -1;
+        PRTE_CONSTRUCT(&detector->daemons_state, prte_bitmap_t);
+        prte_bitmap_init(&detector->daemons_state, ndmns + 1);
+        detector->failed_node_count = 0;
+
+        detector->ngossip = 0;
+        if (0 < prte_errmgr_detector_component.gossip_size) {
+            detector->gossip = (pmix_rank_t*)calloc(prte_errmgr_detector_component.gossip_size,
+                                                    sizeof(pmix_rank_t));
+            detector->gossip_rounds = (int*)calloc(prte_errmgr_detector_component.gossip_size,
+                                                   sizeof(int));
         }
 
-        PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
-                             "errmgr:detector daemon %d observing %d; observed by %d",
-                             vpid,
-                             detector->hb_observing,
-                             detector->hb_observer));
+        /* we observe the closest k daemons before us on the ring and
+         * the closest k daemons after us observe us */
+        fd_update_peers(detector, false);
+        /* give some slack for MPI_Init */
+        for (i=0; i < detector->hb_nobserving; i++) {
+            detector->hb_observing[i].hb_rstamp = Wtime()+(double)ndmns;
+        }
+
+        for (i=0; i < detector->hb_nobserving; i++) {
+            PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
+                                 "errmgr:detector daemon %d observing %d",
+                                 prte_process_info.myproc.rank,
+                                 detector->hb_observing[i].vpid));
+        }
+        for (i=0; i < detector->hb_nobservers; i++) {
+            PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
+                                 "errmgr:detector daemon %d observed by %d",
+                                 prte_process_info.myproc.rank,
+                                 detector->hb_observers[i]));
+        }
 
         prte_event_set(fd_event_base, &detector->fd_event, -1,
                        PRTE_EV_TIMEOUT | PRTE_EV_PERSIST, fd_event_cb, detector);
@@ -367,74 +453,179 @@ static void enable_detector(bool enable_flag)
     }
 }
 
-static int fd_heartbeat_request(prte_errmgr_detector_t* detector) {
-
-    int rc,  ndmns;
-    uint32_t vpid;
-
-    pmix_proc_t temp_proc_name;
+/*
+ * recompute the daemons we observe and that observe us from our
+ * current knowledge of failed daemons. Observation state is kept
+ * for daemons we were already observing - new ones are asked to
+ * start sending us heartbeats if requested
+ */
+static void fd_update_peers(prte_errmgr_detector_t* detector, bool request)
+{
+    prte_errmgr_detector_peer_t *old;
+    int nold, k, i, j, n;
+    pmix_rank_t vpid;
+    double now = Wtime();
 
-    PMIX_LOAD_PROCID(&temp_proc_name, prte_process_info.myproc.nspace, detector->hb_observing);
+    k = fd_num_peers();
 
-    if (errmgr_get_daemon_status(temp_proc_name)) {
-        /* already observing a live process, so nothing to do. */
-        return PRTE_SUCCESS;
+    /* the daemons we observe */
+    nold = detector->hb_nobserving;
+    old = NULL;
+    if (0 < nold) {
+        old = (prte_errmgr_detector_peer_t*)malloc(nold * sizeof(prte_errmgr_detector_peer_t));
+        memcpy(old, detector->hb_observing, nold * sizeof(prte_errmgr_detector_peer_t));
     }
-
-    ndmns = prte_process_info.num_daemons-1;
-
-    pmix_data_buffer_t *buffer = NULL;
-    pmix_proc_t daemon;
-    PMIX_LOAD_NSPACE(daemon.nspace, prte_process_info.myproc.nspace);
-
-    for (vpid = (ndmns+detector->hb_observing) % ndmns;
-         vpid != prte_process_info.myproc.rank;
-         vpid = (ndmns+vpid-1) % ndmns ) {
-
-        if (0 != vpid) {
-            daemon.rank = vpid;
-        } else {
-            daemon.rank = ndmns;
-        }
+    n = 0;
+    for (vpid = ring_pred(prte_process_info.myproc.rank);
+         vpid != prte_process_info.myproc.rank && n < k;
+         vpid = ring_pred(vpid)) {
         // this daemon is not alive
-        if (!errmgr_get_daemon_status(daemon)) {
+        if (daemon_failed(detector, vpid)) {
             continue;
         }
+        for (j=0; j < nold; j++) {
+            if (old[j].vpid == vpid) {
+                break;
+            }
+        }
+        if (j < nold) {
+            detector->hb_observing[n] = old[j];
+        } else {
+            detector->hb_observing[n].vpid = vpid;
+            detector->hb_observing[n].hb_mean = detector->hb_period;
+            detector->hb_observing[n].hb_dev = 0.;
+            detector->hb_observing[n].hb_timeout = detector->hb_timeout;
+            /* we add one timeout slack to account for the send time */
+            detector->hb_observing[n].hb_rstamp = now + detector->hb_timeout;
+            if (request) {
+                PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
+                                     "errmgr:detector hb request updating ring"));
+                fd_heartbeat_request(detector, vpid);
+            }
+        }
+        n++;
+    }
+    detector->hb_nobserving = n;
+    if (NULL != old) {
+        free(old);
+    }
 
-        /* everyone is gone, i dont need to monitor myself */
-        if (daemon.rank == prte_process_info.myproc.rank) {
-            detector->hb_observer = detector->hb_observing = PMIX_RANK_INVALID;
-            detector->hb_rstamp = INFINITY;
-            detector->hb_period = INFINITY;
-            return PRTE_SUCCESS;
+    /* the daemons that observe us */
+    n = 0;
+    for (vpid = ring_succ(prte_process_info.myproc.rank);
+         vpid != prte_process_info.myproc.rank && n < k;
+         vpid = ring_succ(vpid)) {
+        if (!daemon_failed(detector, vpid)) {
+            detector->hb_observers[n++] = vpid;
         }
+    }
+    detector->hb_nobservers = n;
 
-        PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
-                             "errmgr:detector hb request updating ring"));
-        detector->hb_observing = daemon.rank;
-        PMIX_DATA_BUFFER_CREATE(buffer);
-        rc = PMIx_Data_pack(NULL, buffer, &prte_process_info.myproc.nspace, 1, PMIX_PROC_NSPACE);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
+    /* drop requesters that failed or are now regular observers */
+    for (i=0, j=0; i < detector->hb_nrequesters; i++) {
+        vpid = detector->hb_requesters[i];
+        if (daemon_failed(detector, vpid)) {
+            continue;
         }
-        rc = PMIx_Data_pack(NULL, buffer, &prte_process_info.myproc.rank, 1, PMIX_PROC_RANK);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
+        for (n=0; n < detector->hb_nobservers; n++) {
+            if (vpid == detector->hb_observers[n]) {
+                break;
+            }
         }
-        if (0 > (rc = prte_rml.send_buffer_nb(&daemon, buffer,
-                                               PRTE_RML_TAG_HEARTBEAT_REQUEST,
-                                               prte_rml_send_callback, NULL))) {
-            PRTE_ERROR_LOG(rc);
+        if (n == detector->hb_nobservers) {
+            detector->hb_requesters[j++] = vpid;
         }
-        break;
     }
+    detector->hb_nrequesters = j;
+
+    if (0 == detector->hb_nobserving && 0 == detector->hb_nobservers) {
+        /* everyone is gone, i dont need to monitor myself */
+        detector->hb_period = INFINITY;
+    }
+
     PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
-                         "errmgr:detector updated ring daemon %d observing %d; observed by %d",
+                         "errmgr:detector updated ring daemon %d observing %d daemons; observed by %d",
                          PRTE_PROC_MY_NAME->rank,
-                         detector->hb_observing,
-                         detector->hb_observer));
-    /* we add one timeout slack to account for the send time */
-    detector->hb_rstamp = Wtime()+detector->hb_timeout;
+                         detector->hb_nobserving,
+                         detector->hb_nobservers + detector->hb_nrequesters));
+}
+
+/*
+ * record a failed daemon, returning true if we did not already know
+ */
+static bool fd_daemon_failed(prte_errmgr_detector_t* detector, pmix_rank_t vpid)
+{
+    pmix_proc_t temp_proc_name;
+    int i;
+
+    if (NULL == detector->hb_observing || 0 == vpid ||
+        vpid == prte_process_info.myproc.rank || daemon_failed(detector, vpid)) {
+        return false;
+    }
+
+    PMIX_LOAD_PROCID(&temp_proc_name, prte_process_info.myproc.nspace, vpid);
+    errmgr_set_daemon_status(temp_proc_name);
+    /* increase the number of failed nodes */
+    detector->failed_node_count++;
+
+    /* gossip about it on our next heartbeats, displacing the
+     * entry that has been spread the most if we are full */
+    if (0 < prte_errmgr_detector_component.gossip_size) {
+        if (detector->ngossip < prte_errmgr_detector_component.gossip_size) {
+            i = detector->ngossip++;
+        } else {
+            int j;
+            for (i=0, j=1; j < detector->ngossip; j++) {
+                if (detector->gossip_rounds[j] < detector->gossip_rounds[i]) {
+                    i = j;
+                }
+            }
+        }
+        detector->gossip[i] = vpid;
+        /* stay on enough heartbeats to survive the loss of
+         * all but one of our observers */
+        detector->gossip_rounds[i] = prte_errmgr_detector_component.num_observers + 1;
+    }
+    return true;
+}
+
+static void fd_failure_cb(int fd, short flags, void* cbdata)
+{
+    fd_caddy_t *cd = (fd_caddy_t*)cbdata;
+    prte_errmgr_detector_t* detector = &prte_errmgr_world_detector;
+
+    PRTE_ACQUIRE_OBJECT(cd);
+    if (fd_daemon_failed(detector, cd->vpid)) {
+        PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
+                             "errmgr:detector %d notified daemon %d failed",
+                             prte_process_info.myproc.rank, cd->vpid));
+        fd_update_peers(detector, true);
+    }
+    PRTE_RELEASE(cd);
+}
+
+static int fd_heartbeat_request(prte_errmgr_detector_t* detector, pmix_rank_t vpid)
+{
+    int rc;
+    pmix_data_buffer_t *buffer = NULL;
+    pmix_proc_t daemon;
+
+    PMIX_LOAD_PROCID(&daemon, prte_process_info.myproc.nspace, vpid);
+    PMIX_DATA_BUFFER_CREATE(buffer);
+    rc = PMIx_Data_pack(NULL, buffer, &prte_process_info.myproc.nspace, 1, PMIX_PROC_NSPACE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    rc = PMIx_Data_pack(NULL, buffer, &prte_process_info.myproc.rank, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    if (0 > (rc = prte_rml.send_buffer_nb(&daemon, buffer,
+                                           PRTE_RML_TAG_HEARTBEAT_REQUEST,
+                                           prte_rml_send_callback, NULL))) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buffer);
+    }
     return PRTE_SUCCESS;
 }
 
@@ -443,12 +634,11 @@ static void fd_heartbeat_request_cb(int status, pmix_proc_t* sender,
                                     prte_rml_tag_t tg, void *cbdata)
 {
     prte_errmgr_detector_t* detector = &prte_errmgr_world_detector;
-    int ndmns, rr, ro;
     pmix_nspace_t jobid;
     pmix_rank_t vpid;
     int temp;
     temp =1;
-    int rc;
+    int rc, n;
 
     rc = PMIx_Data_unpack(NULL, buffer, &jobid, &temp, PMIX_PROC_NSPACE);
     if (PMIX_SUCCESS != rc) {
@@ -459,21 +649,38 @@ static void fd_heartbeat_request_cb(int status, pmix_proc_t* sender,
         PMIX_ERROR_LOG(rc);
     }
     PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
-                         "errmgr:detector %d receive %d",
-                         prte_process_info.myproc.rank,
-                         detector->hb_observer));
-    ndmns = prte_process_info.num_nodes;
-    rr = (ndmns - prte_process_info.myproc.rank + vpid) % ndmns; /* translate msg->from in circular space so that myrank==0 */
-    ro = (ndmns - prte_process_info.myproc.rank + detector->hb_observer) % ndmns; /* same for the observer rank */
-    if (rr < ro) {
-        return; /* never forward on the rbcast */
+                         "errmgr:detector %d receive request from %d",
+                         prte_process_info.myproc.rank, vpid));
+    if (NULL == detector->hb_observers) {
+        return;
+    }
+    /* already observing us? */
+    for (n=0; n < detector->hb_nobservers; n++) {
+        if (vpid == detector->hb_observers[n]) {
+            return;
+        }
+    }
+    for (n=0; n < detector->hb_nrequesters; n++) {
+        if (vpid == detector->hb_requesters[n]) {
+            return;
+        }
+    }
+    /* a requester closer than our furthest observer should already
+     * be one of them, so never forward on the rbcast */
+    if (0 < detector->hb_nobservers &&
+        ring_dist(vpid) < ring_dist(detector->hb_observers[detector->hb_nobservers-1])) {
+        return;
     }
 
-    detector->hb_observer = vpid;
-    detector->hb_sstamp = 0.;
-
-    fd_heartbeat_send(detector);
-    return;
+    /* the requester knows of failures we have not heard of yet - keep
+     * it until we catch up, dropping the oldest request if full */
+    if (detector->hb_nrequesters == fd_num_peers()) {
+        memmove(detector->hb_requesters, detector->hb_requesters + 1,
+                (detector->hb_nrequesters - 1) * sizeof(pmix_rank_t));
+        detector->hb_nrequesters--;
+    }
+    detector->hb_requesters[detector->hb_nrequesters++] = vpid;
+    fd_heartbeat_send_to(detector, vpid);
 }
 
 /*
@@ -485,6 +692,9 @@ static void fd_event_cb(int fd, short flags, void* pdetector)
     // need to find a new time func
     double stamp = Wtime();
     prte_errmgr_detector_t* detector = pdetector;
+    prte_errmgr_detector_peer_t *peer;
+    bool changed = false;
+    int i;
 
     // temp proc name for get the prte object
     pmix_proc_t temp_proc_name;
@@ -492,31 +702,28 @@ static void fd_event_cb(int fd, short flags, void* pdetector)
     if ((stamp - detector->hb_sstamp) >= detector->hb_period) {
         fd_heartbeat_send(detector);
     }
-    if (INFINITY == detector->hb_rstamp) {
-        return;
-    }
 
-    if( (stamp - detector->hb_rstamp) > detector->hb_timeout ) {
+    for (i=0; i < detector->hb_nobserving; i++) {
+        peer = &detector->hb_observing[i];
+        if (INFINITY == peer->hb_rstamp ||
+            (stamp - peer->hb_rstamp) <= peer->hb_timeout) {
+            continue;
+        }
         /* this process is now suspected dead. */
-        PMIX_LOAD_PROCID(&temp_proc_name, prte_process_info.myproc.nspace, detector->hb_observing);
+        PMIX_LOAD_PROCID(&temp_proc_name, prte_process_info.myproc.nspace, peer->vpid);
         /* if first time detected */
-        if (errmgr_get_daemon_status(temp_proc_name)) {
+        if (fd_daemon_failed(detector, peer->vpid)) {
             PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
-                                 "errmgr:detector %d detected daemon %d failed, heartbeat delay",
-                                 prte_process_info.myproc.rank, detector->hb_observing));
+                                 "errmgr:detector %d detected daemon %d failed, heartbeat delay %.1e over timeout %.1e",
+                                 prte_process_info.myproc.rank, peer->vpid,
+                                 stamp - peer->hb_rstamp, peer->hb_timeout));
             prte_propagate.prp(temp_proc_name.nspace, NULL, &temp_proc_name, PRTE_ERR_PROC_ABORTED);
-
-            /* with every 8 failed nodes realloc 8 more slots to store the vpid of failed nodes */
-            if ((detector->failed_node_count / 8) > 0 && (detector->failed_node_count % 8) == 0) {
-                detector->daemons_state = realloc( detector->daemons_state, detector->failed_node_count+8);
-            }
-
-            errmgr_set_daemon_status(temp_proc_name);
-            /* increase the number of failed nodes */
-            detector->failed_node_count++;
-            fd_heartbeat_request(detector);
+            changed = true;
         }
     }
+    if (changed) {
+        fd_update_peers(detector, true);
+    }
 }
 
 /*
@@ -524,6 +731,7 @@ static void fd_event_cb(int fd, short flags, void* pdetector)
  */
 static void fd_heartbeat_send(prte_errmgr_detector_t* detector)
 {
+    int i;
 
     double now = Wtime();
     if (0. != detector->hb_sstamp &&
@@ -537,12 +745,34 @@ static void fd_heartbeat_send(prte_errmgr_detector_t* detector)
     }
     detector->hb_sstamp = now;
 
+    for (i=0; i < detector->hb_nobservers; i++) {
+        fd_heartbeat_send_to(detector, detector->hb_observers[i]);
+    }
+    for (i=0; i < detector->hb_nrequesters; i++) {
+        fd_heartbeat_send_to(detector, detector->hb_requesters[i]);
+    }
+
+    /* age the gossip - each entry rides on a bounded number of rounds */
+    for (i=0; i < detector->ngossip; ) {
+        if (0 >= --detector->gossip_rounds[i]) {
+            detector->ngossip--;
+            detector->gossip[i] = detector->gossip[detector->ngossip];
+            detector->gossip_rounds[i] = detector->gossip_rounds[detector->ngossip];
+        } else {
+            i++;
+        }
+    }
+}
+
+static void fd_heartbeat_send_to(prte_errmgr_detector_t* detector, pmix_rank_t vpid)
+{
     pmix_data_buffer_t *buffer = NULL;
     int rc;
+    int32_t ngossip;
 
     PMIX_DATA_BUFFER_CREATE(buffer);
     pmix_proc_t daemon;
-    PMIX_LOAD_PROCID(&daemon, prte_process_info.myproc.nspace, detector->hb_observer);
+    PMIX_LOAD_PROCID(&daemon, prte_process_info.myproc.nspace, vpid);
     rc = PMIx_Data_pack(NULL, buffer, &prte_process_info.myproc.nspace, 1, PMIX_PROC_NSPACE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
@@ -551,6 +781,18 @@ static void fd_heartbeat_send(prte_errmgr_detector_t* detector)
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
     }
+    /* piggy-back the failures we are gossiping about */
+    ngossip = detector->ngossip;
+    rc = PMIx_Data_pack(NULL, buffer, &ngossip, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    if (0 < ngossip) {
+        rc = PMIx_Data_pack(NULL, buffer, detector->gossip, ngossip, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+    }
     /* send the heartbeat with eager send */
     if (0 > (rc  = prte_rml.send_buffer_nb(&daemon, buffer,
                                             PRTE_RML_TAG_HEARTBEAT,
@@ -559,6 +801,7 @@ static void fd_heartbeat_send(prte_errmgr_detector_t* detector)
                              "errmgr:detector:failed to send heartbeat to %s",
                              PRTE_NAME_PRINT(&daemon)));
         PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buffer);
     }
 }
 
@@ -567,9 +810,12 @@ static void fd_heartbeat_recv_cb(int status, pmix_proc_t* sender,
                                  prte_rml_tag_t tg, void *cbdata)
 {
     prte_errmgr_detector_t* detector = &prte_errmgr_world_detector;
-    int rc;
-    int32_t cnt;
-    uint32_t vpid, jobid;
+    prte_errmgr_detector_peer_t *peer = NULL;
+    int rc, i;
+    int32_t cnt, ngossip;
+    pmix_rank_t vpid, gossip[32];
+    pmix_nspace_t jobid;
+    bool changed = false;
 
     if (sender->rank == prte_process_info.myproc.rank) {
         /* this is a quit msg from observed process, stop detector */
@@ -578,8 +824,9 @@ static void fd_heartbeat_recv_cb(int status, pmix_proc_t* sender,
                              "which is myself, quit msg to close detector",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)
                              ,__func__, sender->rank));
-        detector->hb_observing = detector->hb_observer = PMIX_RANK_INVALID;
-        detector->hb_rstamp = INFINITY;
+        detector->hb_nobserving = 0;
+        detector->hb_nobservers = 0;
+        detector->hb_nrequesters = 0;
         detector->hb_period = INFINITY;
         return;
     }
@@ -595,16 +842,45 @@ static void fd_heartbeat_recv_cb(int status, pmix_proc_t* sender,
         PMIX_ERROR_LOG(rc);
     }
 
-    if ((int)vpid != detector->hb_observing) {
+    /* learn of any failures our observed daemon knows about */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &ngossip, &cnt, PMIX_INT32);
+    while (PMIX_SUCCESS == rc && 0 < ngossip) {
+        cnt = (ngossip < 32) ? ngossip : 32;
+        ngossip -= cnt;
+        rc = PMIx_Data_unpack(NULL, buffer, gossip, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        for (i=0; i < cnt; i++) {
+            if (fd_daemon_failed(detector, gossip[i])) {
+                PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
+                                     "errmgr:detector %d learned from %d that daemon %d failed",
+                                     prte_process_info.myproc.rank, vpid, gossip[i]));
+                changed = true;
+            }
+        }
+    }
+    if (changed) {
+        fd_update_peers(detector, true);
+    }
+
+    for (i=0; i < detector->hb_nobserving; i++) {
+        if (vpid == detector->hb_observing[i].vpid) {
+            peer = &detector->hb_observing[i];
+            break;
+        }
+    }
+    if (NULL == peer) {
         PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
                              "errmgr:detector: daemon %s receive heartbeat from vpid %d, "
-                             "but I am monitoring vpid %d ",
+                             "but I am not monitoring it",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                             vpid,
-                             detector->hb_observing));
+                             vpid));
     } else {
         double stamp = Wtime();
-        double grace = detector->hb_timeout - (stamp - detector->hb_rstamp);
+        double grace = peer->hb_timeout - (stamp - peer->hb_rstamp);
         PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
                     "errmgr:detector: daemon %s receive heartbeat from vpid %d tag %d at timestamp %g (remained %.1e of %.1e before suspecting)",
                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -612,14 +888,30 @@ static void fd_heartbeat_recv_cb(int status, pmix_proc_t* sender,
                     tg,
                     stamp,
                     grace,
-                    detector->hb_timeout));
-        detector->hb_rstamp = stamp;
+                    peer->hb_timeout));
         if ( grace < 0.0 ) {
             PRTE_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
                         "errmgr:detector: daemon %s  MISSED (%.1e)",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         grace));
         }
+        if (prte_errmgr_detector_component.adaptive_timeout && stamp > peer->hb_rstamp) {
+            /* track the arrival interval and its jitter the way TCP
+             * tracks round-trip times, and suspect the daemon once a
+             * heartbeat is late by more than the observed jitter allows */
+            double err = (stamp - peer->hb_rstamp) - peer->hb_mean;
+            peer->hb_mean += err / 8.;
+            peer->hb_dev += (fabs(err) - peer->hb_dev) / 4.;
+            peer->hb_timeout = peer->hb_mean + prte_errmgr_detector_component.jitter_factor * peer->hb_dev;
+            /* never suspect on a single late heartbeat */
+            if (peer->hb_timeout < 2. * detector->hb_period) {
+                peer->hb_timeout = 2. * detector->hb_period;
+            }
+            if (peer->hb_timeout > detector->hb_timeout) {
+                peer->hb_timeout = detector->hb_timeout;
+            }
+        }
+        peer->hb_rstamp = stamp;
     }
     return;
 }
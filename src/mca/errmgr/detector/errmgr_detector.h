@@ -22,20 +22,35 @@
 
 #include "prte_config.h"
 
+#include "src/class/prte_bitmap.h"
 #include "src/mca/errmgr/errmgr.h"
 
 BEGIN_C_DECLS
 
 typedef struct {
-    prte_event_t fd_event; /* to trigger timeouts with prte_events */
-    int hb_observing;      /* the deamon vpid of the process we observe */
-    int hb_observer;       /* the daemon vpid of the process that observes us */
+    pmix_rank_t vpid;      /* the daemon vpid of the process we observe */
     double hb_rstamp;      /* the date of the last hb reception */
-    double hb_timeout;     /* the timeout before we start suspecting observed process as dead (delta) */
-    double hb_period;      /* the time spacing between heartbeat emission (eta) */
-    double hb_sstamp;      /* the date at which the last hb emission was done */
-    int failed_node_count; /* the number of failed nodes in the ring */
-    int *daemons_state;    /* a list of failed daemons' vpid */
+    double hb_mean;        /* smoothed interval between hb receptions */
+    double hb_dev;         /* smoothed deviation of that interval */
+    double hb_timeout;     /* the timeout before we start suspecting this process as dead */
+} prte_errmgr_detector_peer_t;
+
+typedef struct {
+    prte_event_t fd_event;  /* to trigger timeouts with prte_events */
+    int hb_nobserving;      /* the number of daemons we observe */
+    prte_errmgr_detector_peer_t *hb_observing; /* the daemons we observe */
+    int hb_nobservers;      /* the number of daemons that observe us */
+    pmix_rank_t *hb_observers; /* the daemons that observe us */
+    int hb_nrequesters;     /* daemons that asked to observe us before we learned why */
+    pmix_rank_t *hb_requesters;
+    double hb_timeout;      /* the timeout before we start suspecting observed process as dead (delta) */
+    double hb_period;       /* the time spacing between heartbeat emission (eta) */
+    double hb_sstamp;       /* the date at which the last hb emission was done */
+    int failed_node_count;  /* the number of failed nodes in the ring */
+    prte_bitmap_t daemons_state; /* the vpids of failed daemons */
+    int ngossip;            /* recently failed daemons piggy-backed on our heartbeats */
+    pmix_rank_t *gossip;
+    int *gossip_rounds;     /* the number of heartbeats each entry remains on */
 } prte_errmgr_detector_t;
 
 /*
@@ -46,6 +61,10 @@ typedef struct {
     prte_errmgr_base_component_t super;
     double heartbeat_period;
     double heartbeat_timeout;
+    int num_observers;
+    bool adaptive_timeout;
+    double jitter_factor;
+    int gossip_size;
 } prte_errmgr_detector_component_t;
 
 PRTE_MODULE_EXPORT extern prte_errmgr_detector_component_t prte_errmgr_detector_component;
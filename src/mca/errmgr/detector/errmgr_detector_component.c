@@ -60,7 +60,11 @@ prte_errmgr_detector_component_t prte_errmgr_detector_component = {
         },
     },
     .heartbeat_period = 5.0,
-    .heartbeat_timeout = 10.0
+    .heartbeat_timeout = 10.0,
+    .num_observers = 1,
+    .adaptive_timeout = false,
+    .jitter_factor = 4.0,
+    .gossip_size = 8
 };
 
 static int my_priority;
@@ -93,6 +97,43 @@ static int errmgr_detector_register(void)
             PRTE_INFO_LVL_9,
             PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_errmgr_detector_component.heartbeat_timeout);
 
+    (void) prte_mca_base_component_var_register(c, "num_observers",
+            "Number of daemons observing each daemon (1 = ring detector). Each daemon sends "
+            "this many heartbeats per period regardless of the size of the DVM",
+            PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+            PRTE_MCA_BASE_VAR_FLAG_NONE,
+            PRTE_INFO_LVL_9,
+            PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_errmgr_detector_component.num_observers);
+
+    (void) prte_mca_base_component_var_register(c, "adaptive_timeout",
+            "Adapt the timeout for each observed daemon to the jitter of its heartbeats, "
+            "using heartbeat_timeout as the upper bound",
+            PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+            PRTE_MCA_BASE_VAR_FLAG_NONE,
+            PRTE_INFO_LVL_9,
+            PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_errmgr_detector_component.adaptive_timeout);
+
+    (void) prte_mca_base_component_var_register(c, "jitter_factor",
+            "Number of deviations of the heartbeat interval allowed before suspecting "
+            "a daemon when adaptive timeouts are enabled",
+            PRTE_MCA_BASE_VAR_TYPE_DOUBLE, NULL, 0,
+            PRTE_MCA_BASE_VAR_FLAG_NONE,
+            PRTE_INFO_LVL_9,
+            PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_errmgr_detector_component.jitter_factor);
+
+    (void) prte_mca_base_component_var_register(c, "gossip_size",
+            "Maximum number of recently failed daemons piggy-backed on each heartbeat (0 = disable)",
+            PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+            PRTE_MCA_BASE_VAR_FLAG_NONE,
+            PRTE_INFO_LVL_9,
+            PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_errmgr_detector_component.gossip_size);
+    if (prte_errmgr_detector_component.num_observers < 1) {
+        prte_errmgr_detector_component.num_observers = 1;
+    }
+    if (prte_errmgr_detector_component.gossip_size < 0) {
+        prte_errmgr_detector_component.gossip_size = 0;
+    }
+
     return PRTE_SUCCESS;
 }
 
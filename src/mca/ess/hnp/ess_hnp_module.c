@@ -368,6 +368,7 @@ static int rte_init(int argc, char **argv)
     aptr = prte_argv_join(prte_process_info.aliases, ',');
     prte_set_attribute(&node->attributes, PRTE_NODE_ALIAS, PRTE_ATTR_LOCAL, aptr, PMIX_STRING);
     free(aptr);
+    prte_node_index_names(node);
     /* record that the daemon job is running */
     jdata->num_procs = 1;
     jdata->state = PRTE_JOB_STATE_RUNNING;
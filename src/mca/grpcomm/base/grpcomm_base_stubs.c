@@ -33,6 +33,7 @@
 #include "prte_config.h"
 
 #include "src/util/proc_info.h"
+#include "src/util/compress.h"
 #include "src/util/error_strings.h"
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/odls/base/base.h"
@@ -155,7 +156,7 @@ int prte_grpcomm_API_rbcast(prte_grpcomm_signature_t *sig,
     /* setup the payload */
     if (PRTE_SUCCESS != (rc = pack_xcast(sig, buf, msg, tag))) {
         PRTE_ERROR_LOG(rc);
-        PRTE_RELEASE(buf);
+        PMIX_DATA_BUFFER_RELEASE(buf);
         return rc;
     }
     /* cycle thru the actives and see who can send it */
@@ -166,6 +167,7 @@ int prte_grpcomm_API_rbcast(prte_grpcomm_signature_t *sig,
             }
         }
     }
+    PMIX_DATA_BUFFER_RELEASE(buf);  // if the module needs to keep the buf, it should copy it
 
     return rc;
 }
@@ -540,8 +542,8 @@ static int pack_xcast(prte_grpcomm_signature_t *sig,
     }
 
     /* see if we want to compress this message */
-    if (PMIx_Data_compress((uint8_t*)data.base_ptr, data.bytes_used,
-                           (uint8_t**)&bo.bytes, &sz)) {
+    if (prte_compress((uint8_t*)data.base_ptr, data.bytes_used,
+                      (uint8_t**)&bo.bytes, &sz)) {
         /* the data was compressed - mark that we compressed it */
         compressed = true;
         bo.size = sz;
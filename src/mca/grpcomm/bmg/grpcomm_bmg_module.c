@@ -17,7 +17,6 @@
 #include "constants.h"
 #include "types.h"
 
-#include <math.h>
 #include <string.h>
 
 #include "src/class/prte_list.h"
@@ -28,6 +27,7 @@
 #include "src/mca/rml/base/rml_contact.h"
 #include "src/mca/routed/base/base.h"
 #include "src/mca/state/state.h"
+#include "src/util/compress.h"
 #include "src/util/name_fns.h"
 #include "src/util/nidmap.h"
 #include "src/util/proc_info.h"
@@ -58,9 +58,38 @@ prte_grpcomm_base_module_t prte_grpcomm_bmg_module = {
 static void rbcast_recv(int status, pmix_proc_t* sender,
                        pmix_data_buffer_t* buffer, prte_rml_tag_t tag,
                        void* cbdata);
+static int bmg_forward(pmix_data_buffer_t *buf, pmix_rank_t origin,
+                       pmix_rank_t sender);
 /* internal variables */
 static prte_list_t tracker;
 
+/*
+ * The binomial graph: daemon v is connected to v +/- 2^k (mod n)
+ * for 2^k < n. The neighbour set only depends on the number of
+ * daemons, so it is computed once and recomputed only when the
+ * DVM changes size.
+ */
+static pmix_rank_t *neighbors = NULL;
+static int num_neighbors = 0;
+static int neighbors_nprocs = -1;
+
+/*
+ * Deduplication window. Every rbcast carries the (origin, seq) of
+ * the daemon that started it. We track, per origin, the highest
+ * sequence number seen plus a bitmask of the BMG_WINDOW preceding
+ * ones so that messages arriving out of order over different
+ * paths are still recognized. Anything older than the window is
+ * treated as already delivered.
+ */
+#define BMG_WINDOW 64
+typedef struct {
+    uint32_t last;
+    uint64_t mask;
+} bmg_window_t;
+static bmg_window_t *windows = NULL;
+static int num_windows = 0;
+static uint32_t my_seq = 0;
+
 /*
  * registration of callbacks
  */
@@ -109,54 +138,189 @@ static void bmg_finalize(void)
     /* cancel the rbcast recv */
     prte_rml.recv_cancel(PRTE_NAME_WILDCARD, PRTE_RML_TAG_RBCAST);
     PRTE_LIST_DESTRUCT(&tracker);
+    if (NULL != neighbors) {
+        free(neighbors);
+        neighbors = NULL;
+    }
+    num_neighbors = 0;
+    neighbors_nprocs = -1;
+    if (NULL != windows) {
+        free(windows);
+        windows = NULL;
+    }
+    num_windows = 0;
     return;
 }
 
-static int rbcast(pmix_data_buffer_t *buf)
+static void compute_neighbors(void)
 {
-    int rc = false;
-
-    /* number of "daemons" equal 1hnp + num of daemons, so here pass ndmns -1 */
-    int nprocs = prte_process_info.num_daemons;// -1;
-    int vpid;
-    int i, d;
-    pmix_proc_t daemon;
-    vpid = prte_process_info.myproc.rank;
+    int nprocs = (int)prte_process_info.num_daemons;
+    int vpid = (int)prte_process_info.myproc.rank;
+    int i, n, k, d, idx;
 
-    int log2no = (int)(log(nprocs));
-    int start_i, increase_val;
+    if (nprocs == neighbors_nprocs) {
+        return;
+    }
+    if (NULL != neighbors) {
+        free(neighbors);
+        neighbors = NULL;
+    }
+    num_neighbors = 0;
+    neighbors_nprocs = nprocs;
+    if (nprocs < 2) {
+        return;
+    }
 
-    if (vpid%2==0) {
-        start_i = 1;
-        increase_val = 1;
-    } else {
-        start_i = log2no;
-        increase_val = -1;
+    /* at most two neighbours per power of two below nprocs */
+    n = 0;
+    for (k = 1; k < nprocs; k <<= 1) {
+        n += 2;
     }
-    for (i=start_i; i <= log2no+1 && i >0; i=i+increase_val) {
-        for (d=1; d >= -1; d-=2) {
-    //for(i=1; i <= nprocs/2; i*=2) for(d=1; d >= -1; d-=2) {
-            int idx = (nprocs + vpid + d * ((int)pow(2,i)-1)) % nprocs;
-
-            /* daemon.vpid cannot be 0, because daemond id ranges 1-nprocs, thus if idx==0, change it to NO.nprocs */
-            /*if (idx ==0 ){
-                idx = nprocs;
-            }*/
-            PMIX_LOAD_PROCID(&daemon, prte_process_info.myproc.nspace, idx);
-            PRTE_RETAIN(buf);
-
-            PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
-                                 "%s grpcomm:bmg: broadcast message in %d daemons to %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nprocs,
-                                 PRTE_NAME_PRINT(&daemon)));
-            if (0 > (rc = prte_rml.send_buffer_nb(&daemon, buf,
-                                                  PRTE_RML_TAG_RBCAST,
-                                                  prte_rml_send_callback, NULL))) {
-                PRTE_ERROR_LOG(rc);
+    neighbors = (pmix_rank_t*)malloc(n * sizeof(pmix_rank_t));
+    if (NULL == neighbors) {
+        neighbors_nprocs = -1;
+        return;
+    }
+    /* nearest neighbours first, alternating directions */
+    for (k = 1; k < nprocs; k <<= 1) {
+        for (d = 1; d >= -1; d -= 2) {
+            idx = (nprocs + vpid + d * k) % nprocs;
+            if (idx == vpid) {
+                continue;
+            }
+            /* for small DVMs +k and -k can land on the same daemon */
+            for (i = 0; i < num_neighbors; i++) {
+                if (neighbors[i] == (pmix_rank_t)idx) {
+                    break;
+                }
             }
+            if (i == num_neighbors) {
+                neighbors[num_neighbors++] = idx;
+            }
+        }
+    }
+
+    PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:bmg: %d neighbours in a DVM of %d daemons",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), num_neighbors, nprocs));
+}
+
+/* returns true if (origin, seq) was already seen, and records it
+ * otherwise */
+static bool check_seen(pmix_rank_t origin, uint32_t seq)
+{
+    bmg_window_t *w;
+    int32_t diff;
+    int n;
+
+    if (num_windows <= (int)origin) {
+        n = (int)prte_process_info.num_daemons;
+        if (n <= (int)origin) {
+            /* cannot be a daemon we know about - drop it */
+            return true;
+        }
+        w = (bmg_window_t*)realloc(windows, n * sizeof(bmg_window_t));
+        if (NULL == w) {
+            return true;
+        }
+        memset(&w[num_windows], 0, (n - num_windows) * sizeof(bmg_window_t));
+        windows = w;
+        num_windows = n;
+    }
+    w = &windows[origin];
+
+    if (0 == w->mask) {
+        w->last = seq;
+        w->mask = 1;
+        return false;
+    }
+    diff = (int32_t)(seq - w->last);
+    if (0 < diff) {
+        /* newer than anything seen so far - slide the window */
+        w->mask = (BMG_WINDOW <= diff) ? 1 : (w->mask << diff) | 1;
+        w->last = seq;
+        return false;
+    }
+    diff = -diff;
+    if (BMG_WINDOW <= diff) {
+        return true;
+    }
+    if (w->mask & ((uint64_t)1 << diff)) {
+        return true;
+    }
+    w->mask |= ((uint64_t)1 << diff);
+    return false;
+}
+
+/* send the buffer as-is to our neighbours, skipping the daemon we
+ * got it from, the daemon that started it, and any daemon known to
+ * have failed. The RML takes its own copy of the payload, so the
+ * same buffer is handed to every send */
+static int bmg_forward(pmix_data_buffer_t *buf, pmix_rank_t origin,
+                       pmix_rank_t sender)
+{
+    int rc = PRTE_SUCCESS, ret;
+    int i;
+    pmix_proc_t daemon;
+
+    compute_neighbors();
+
+    for (i = 0; i < num_neighbors; i++) {
+        if (neighbors[i] == origin || neighbors[i] == sender) {
+            continue;
+        }
+        PMIX_LOAD_PROCID(&daemon, prte_process_info.myproc.nspace, neighbors[i]);
+        if (!errmgr_get_daemon_status(daemon)) {
+            continue;
         }
+
+        PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:bmg: broadcast message from %u in %d daemons to %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), origin,
+                             neighbors_nprocs, PRTE_NAME_PRINT(&daemon)));
+        if (0 > (ret = prte_rml.send_buffer_nb(&daemon, buf,
+                                               PRTE_RML_TAG_RBCAST,
+                                               prte_rml_send_callback, NULL))) {
+            PRTE_ERROR_LOG(ret);
+            rc = ret;
+        }
+    }
+
+    return rc;
+}
+
+static int rbcast(pmix_data_buffer_t *buf)
+{
+    int rc;
+    pmix_data_buffer_t hdr;
+    uint32_t seq;
+
+    /* prefix the payload with our (origin, seq) */
+    PMIX_DATA_BUFFER_CONSTRUCT(&hdr);
+    seq = my_seq++;
+    rc = PMIx_Data_pack(NULL, &hdr, &PRTE_PROC_MY_NAME->rank, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&hdr);
+        return prte_pmix_convert_status(rc);
     }
+    rc = PMIx_Data_pack(NULL, &hdr, &seq, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&hdr);
+        return prte_pmix_convert_status(rc);
+    }
+    rc = PMIx_Data_copy_payload(&hdr, buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&hdr);
+        return prte_pmix_convert_status(rc);
+    }
+    /* we have obviously seen our own message */
+    (void)check_seen(PRTE_PROC_MY_NAME->rank, seq);
 
+    rc = bmg_forward(&hdr, PRTE_PROC_MY_NAME->rank, PRTE_PROC_MY_NAME->rank);
+    PMIX_DATA_BUFFER_DESTRUCT(&hdr);
     return rc;
 }
 
@@ -165,39 +329,49 @@ static void rbcast_recv(int status, pmix_proc_t* sender,
                        void* cbdata)
 {
     int ret, cnt;
-    pmix_data_buffer_t datbuf,*relay, *rly, *data;
+    pmix_data_buffer_t datbuf, *data;
     prte_grpcomm_signature_t sig;
     prte_rml_tag_t tag;
     int cbtype;
-    size_t inlen, cmplen;
-    uint8_t *packed_data, *cmpdata;
     int8_t flag;
     pmix_byte_object_t bo, pbo;
+    pmix_rank_t origin;
+    uint32_t seq;
+    char *payload;
 
     PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
                          "%s grpcomm:bmg:rbcast:recv: with %d bytes",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          (int)buffer->bytes_used));
-    /* we need a passthru buffer to forward and to the callback */
-    PMIX_DATA_BUFFER_CREATE(rly);
-    PMIX_DATA_BUFFER_CREATE(relay);
-    ret = PMIx_Data_copy_payload(rly, buffer);
+
+    /* check the (origin, seq) before doing anything else so that
+     * duplicates arriving over other paths are dropped cheaply */
+    cnt = 1;
+    ret = PMIx_Data_unpack(NULL, buffer, &origin, &cnt, PMIX_PROC_RANK);
     if (PMIX_SUCCESS != ret) {
-        PMIX_DATA_BUFFER_RELEASE(rly);
-        PMIX_DATA_BUFFER_RELEASE(relay);
+        PMIX_ERROR_LOG(ret);
+        return;
+    }
+    cnt = 1;
+    ret = PMIx_Data_unpack(NULL, buffer, &seq, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        return;
+    }
+    if (check_seen(origin, seq)) {
+        PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:bmg:rbcast:recv: dropping duplicate %u:%u from %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), origin, seq,
+                             PRTE_NAME_PRINT(sender)));
         return;
     }
-
     PMIX_DATA_BUFFER_CONSTRUCT(&datbuf);
     /* unpack the flag to see if this payload is compressed */
     cnt=1;
     ret = PMIx_Data_unpack(NULL, buffer, &flag, &cnt, PMIX_INT8);
     if (PMIX_SUCCESS != ret) {
         PMIX_ERROR_LOG(ret);
-        PMIX_DATA_BUFFER_RELEASE(rly);
-        PMIX_DATA_BUFFER_RELEASE(relay);
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-        PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         return;
      }
     /* unpack the data blob */
@@ -206,41 +380,35 @@ static void rbcast_recv(int status, pmix_proc_t* sender,
     if (PMIX_SUCCESS != ret) {
         PMIX_ERROR_LOG(ret);
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-        PMIX_DATA_BUFFER_RELEASE(rly);
         return;
     }
     if (flag) {
         /* decompress the data */
-        if (PMIx_Data_decompress((uint8_t**)&bo.bytes, &bo.size,
-                                 (uint8_t*)pbo.bytes, pbo.size)) {
+        if (prte_decompress((uint8_t**)&bo.bytes, &bo.size,
+                            (uint8_t*)pbo.bytes, pbo.size)) {
             /* the data has been uncompressed */
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
             ret = PMIx_Data_load(&datbuf, &bo);
             if (PMIX_SUCCESS != ret) {
-                PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+                PMIX_BYTE_OBJECT_DESTRUCT(&bo);
                 PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-                PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
-                PMIX_DATA_BUFFER_RELEASE(rly);
                 return;
             }
         } else {
             PMIX_ERROR_LOG(PMIX_ERROR);
             PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-            PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
-            PMIX_DATA_BUFFER_RELEASE(rly);
             return;
         }
     } else {
+        /* the buffer takes ownership of the blob */
         ret = PMIx_Data_load(&datbuf, &pbo);
         if (PMIX_SUCCESS != ret) {
             PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-            PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
-            PMIX_DATA_BUFFER_RELEASE(rly);
             return;
         }
     }
-    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
     data = &datbuf;
 
     /* get the signature that we need to create the dmns*/
@@ -248,7 +416,6 @@ static void rbcast_recv(int status, pmix_proc_t* sender,
     ret = PMIx_Data_unpack(NULL, data, &sig.sz, &cnt, PMIX_SIZE);
     if (PMIX_SUCCESS != ret) {
         PMIX_ERROR_LOG(ret);
-        PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         goto CLEANUP;
     }
@@ -257,7 +424,6 @@ static void rbcast_recv(int status, pmix_proc_t* sender,
     ret = PMIx_Data_unpack(NULL, data, sig.signature, &cnt, PMIX_PROC);
     if (PMIX_SUCCESS != ret) {
         PMIX_ERROR_LOG(ret);
-        PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         PMIX_PROC_FREE(sig.signature, sig.sz);
         goto CLEANUP;
@@ -270,37 +436,32 @@ static void rbcast_recv(int status, pmix_proc_t* sender,
     ret = PMIx_Data_unpack(NULL, data, &tag, &cnt, PMIX_UINT32);
     if (PMIX_SUCCESS != ret) {
         PMIX_ERROR_LOG(ret);
-        PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         goto CLEANUP;
     }
 
-    /* copy the remaining payload */
-    ret = PMIx_Data_copy_payload(relay, data);
-    if (PMIX_SUCCESS != ret) {
-        PMIX_ERROR_LOG(ret);
-        PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
-        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-        goto CLEANUP;
-    }
-
-    /* get the cbtype */
+    /* peek at the cbtype - the callback unpacks it again, so
+     * rewind rather than copying the rest of the payload */
+    payload = data->unpack_ptr;
     cnt=1;
     ret = PMIx_Data_unpack(NULL, data, &cbtype, &cnt, PMIX_INT32);
     if (PMIX_SUCCESS != ret) {
         PMIX_ERROR_LOG(ret);
-        PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         goto CLEANUP;
     }
-    if( prte_grpcomm_rbcast_cb[cbtype](relay) ) {
-        /* forward the rbcast */
-        if (PRTE_SUCCESS == (ret = rbcast(rly))) {
-        }
+    data->unpack_ptr = payload;
+    if (0 > cbtype || RBCAST_CB_TYPE_MAX < cbtype ||
+        NULL == prte_grpcomm_rbcast_cb[cbtype]) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        goto CLEANUP;
+    }
+    if( prte_grpcomm_rbcast_cb[cbtype](data) ) {
+        /* forward the original message, header included */
+        buffer->unpack_ptr = buffer->base_ptr;
+        ret = bmg_forward(buffer, origin, sender->rank);
     }
 
 CLEANUP:
-    PMIX_DATA_BUFFER_RELEASE(rly);
-    PMIX_DATA_BUFFER_RELEASE(relay);
+    PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
 }
-
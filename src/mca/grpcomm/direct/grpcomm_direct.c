@@ -30,6 +30,7 @@
 #include "src/mca/rml/base/rml_contact.h"
 #include "src/mca/routed/base/base.h"
 #include "src/mca/state/state.h"
+#include "src/util/compress.h"
 #include "src/util/name_fns.h"
 #include "src/util/nidmap.h"
 #include "src/util/proc_info.h"
@@ -408,8 +409,8 @@ static void xcast_recv(int status, pmix_proc_t* sender,
     }
     if (compressed) {
         /* decompress the data */
-        if (PMIx_Data_decompress((uint8_t**)&bo.bytes, &bo.size,
-                                (uint8_t*)pbo.bytes, pbo.size)) {
+        if (prte_decompress((uint8_t**)&bo.bytes, &bo.size,
+                           (uint8_t*)pbo.bytes, pbo.size)) {
             /* the data has been uncompressed */
             ret = PMIx_Data_load(&datbuf, &bo);
             if (PMIX_SUCCESS != ret) {
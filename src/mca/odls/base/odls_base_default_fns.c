@@ -73,6 +73,7 @@
 #include "src/mca/rtc/rtc.h"
 #include "src/mca/schizo/schizo.h"
 #include "src/mca/state/state.h"
+#include "src/mca/state/base/base.h"
 #include "src/mca/filem/filem.h"
 
 #include "src/util/context_fns.h"
@@ -176,6 +177,7 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer,
     prte_proc_t *pptr;
     uint32_t uid;
     uint32_t gid;
+    prte_rmaps_base_map_cache_t *mc;
 
     /* get the job data pointer */
     if (NULL == (jdata = prte_get_job_data_object(job))) {
@@ -280,9 +282,27 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer,
         return rc;
     }
 
+    /* if this job reused a cached map, then the pieces of the
+     * launch message that don't depend on the nspace were already
+     * computed - just reuse them */
+    mc = prte_rmaps_base_map_cache_get(jdata->nspace);
+
     if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PMIX_BOOL)) {
-        /* compute and pack the ppn */
-        if (PRTE_SUCCESS != (rc = prte_util_generate_ppn(jdata, buffer))) {
+        if (NULL != mc) {
+            if (!mc->ppn_valid) {
+                if (PRTE_SUCCESS != (rc = prte_util_generate_ppn(jdata, &mc->ppn))) {
+                    PRTE_ERROR_LOG(rc);
+                    return rc;
+                }
+                mc->ppn_valid = true;
+            }
+            rc = PMIx_Data_copy_payload(buffer, &mc->ppn);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                return rc;
+            }
+        } else if (PRTE_SUCCESS != (rc = prte_util_generate_ppn(jdata, buffer))) {
+            /* compute and pack the ppn */
             PRTE_ERROR_LOG(rc);
             return rc;
         }
@@ -293,6 +313,16 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer,
     procs = NULL;
     cd.ninfo = 5;
     PMIX_INFO_CREATE(cd.info, cd.ninfo);
+    if (NULL != mc && NULL != mc->nodemap && NULL != mc->procmap) {
+#ifdef PMIX_REGEX
+        PMIX_INFO_LOAD(&cd.info[0], PMIX_NODE_MAP, mc->nodemap, PMIX_REGEX);
+        PMIX_INFO_LOAD(&cd.info[1], PMIX_PROC_MAP, mc->procmap, PMIX_REGEX);
+#else
+        PMIX_INFO_LOAD(&cd.info[0], PMIX_NODE_MAP, mc->nodemap, PMIX_STRING);
+        PMIX_INFO_LOAD(&cd.info[1], PMIX_PROC_MAP, mc->procmap, PMIX_STRING);
+#endif
+        goto netinfo;
+    }
     for (i=0; i < map->nodes->size; i++) {
         micro = NULL;
         if (NULL != (node = (prte_node_t*)prte_pointer_array_get_item(map->nodes, i))) {
@@ -332,7 +362,13 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer,
 #else
         PMIX_INFO_LOAD(&cd.info[0], PMIX_NODE_MAP, regex, PMIX_STRING);
 #endif
-        free(regex);
+        if (NULL != mc) {
+            /* the regex may be a binary blob, so keep the original */
+            free(mc->nodemap);
+            mc->nodemap = regex;
+        } else {
+            free(regex);
+        }
     }
 
     /* let the PMIx server generate the procmap regex */
@@ -352,9 +388,16 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer,
 #else
         PMIX_INFO_LOAD(&cd.info[1], PMIX_PROC_MAP, regex, PMIX_STRING);
 #endif
-        free(regex);
+        if (NULL != mc) {
+            free(mc->procmap);
+            mc->procmap = regex;
+        } else {
+            free(regex);
+        }
     }
 
+  netinfo:
+
     /* construct the actual request - we just let them pick the
      * default transport for now. Someday, we will add to prun
      * the ability for transport specifications */
@@ -424,6 +467,7 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer,
     pmix_byte_object_t bo;
     size_t m;
     pmix_envar_t envt;
+    double start;
 
     PRTE_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
                          "%s odls:constructing child list",
@@ -754,6 +798,10 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer,
         }
     }
 
+    /* we now know which apps we will be launching, so get
+     * their files moving while we finish setting up */
+    prte_odls_base_prefetch(jdata);
+
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PMIX_BOOL)) {
         /* reset the mapped flags */
         for (n=0; n < jdata->map->nodes->size; n++) {
@@ -773,10 +821,13 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer,
 
     /* register this job with the PMIx server - need to wait until after we
      * have computed the #local_procs before calling the function */
+    start = prte_state_base_trace_time();
     if (PRTE_SUCCESS != (rc = prte_pmix_server_register_nspace(jdata))) {
         PRTE_ERROR_LOG(rc);
         goto REPORT_ERROR;
     }
+    prte_state_base_trace_stage(jdata->nspace, PMIX_RANK_WILDCARD,
+                                PRTE_STATE_TRACE_PMIX_REGISTER, start);
 
     /* if we have local support setup info, then execute it here - we
      * have to do so AFTER we register the nspace so the PMIx server
@@ -924,6 +975,7 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
     pmix_proc_t pproc;
     pmix_status_t ret;
     char *ptr;
+    double start;
 
     PRTE_ACQUIRE_OBJECT(cd);
 
@@ -1067,11 +1119,14 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
         free(output);
     }
 
+    start = prte_state_base_trace_time();
     if (PRTE_SUCCESS != (rc = cd->fork_local(cd))) {
         /* error message already output */
         state = PRTE_PROC_STATE_FAILED_TO_START;
         goto errorout;
     }
+    prte_state_base_trace_stage(child->name.nspace, child->name.rank,
+                                PRTE_STATE_TRACE_FORK, start);
 
     PRTE_ACTIVATE_PROC_STATE(&child->name, PRTE_PROC_STATE_RUNNING);
     PRTE_RELEASE(cd);
@@ -1084,6 +1139,39 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
     PRTE_RELEASE(cd);
 }
 
+char** prte_odls_base_exec_search_env(char **env)
+{
+    char **argvptr, *pathenv = NULL, *mpiexec_pathenv = NULL;
+    char *full_search;
+
+    /* Search for the OMPI_exec_path and PATH settings in the environment. */
+    for (argvptr = env; NULL != argvptr && NULL != *argvptr; argvptr++) {
+        if (0 == strncmp("OMPI_exec_path=", *argvptr, 15)) {
+            mpiexec_pathenv = *argvptr + 15;
+        }
+        if (0 == strncmp("PATH=", *argvptr, 5)) {
+            pathenv = *argvptr + 5;
+        }
+    }
+    if (NULL == mpiexec_pathenv) {
+        return NULL;
+    }
+
+    /* If OMPI_exec_path is set (meaning --path was used), then create a
+       temporary environment to be used in the search for the executable.
+       The PATH setting in this temporary environment is a combination of
+       the OMPI_exec_path and PATH values. */
+    argvptr = NULL;
+    if (pathenv != NULL) {
+        prte_asprintf(&full_search, "%s:%s", mpiexec_pathenv, pathenv);
+    } else {
+        prte_asprintf(&full_search, "%s", mpiexec_pathenv);
+    }
+    prte_setenv("PATH", full_search, true, &argvptr);
+    free(full_search);
+    return argvptr;
+}
+
 void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
 {
     prte_app_context_t *app;
@@ -1101,8 +1189,6 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
     prte_odls_spawn_caddy_t *cd;
     prte_event_base_t *evb;
     char **argvptr;
-    char *pathenv = NULL, *mpiexec_pathenv = NULL;
-    char *full_search;
 
     PRTE_ACQUIRE_OBJECT(caddy);
 
@@ -1287,37 +1373,12 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             goto GETOUT;
         }
 
-        /* Search for the OMPI_exec_path and PATH settings in the environment. */
-        for (argvptr = app->env; *argvptr != NULL; argvptr++) {
-            if (0 == strncmp("OMPI_exec_path=", *argvptr, 15)) {
-                mpiexec_pathenv = *argvptr + 15;
-            }
-            if (0 == strncmp("PATH=", *argvptr, 5)) {
-                pathenv = *argvptr + 5;
-            }
-        }
-
-        /* If OMPI_exec_path is set (meaning --path was used), then create a
-           temporary environment to be used in the search for the executable.
-           The PATH setting in this temporary environment is a combination of
-           the OMPI_exec_path and PATH values.  If OMPI_exec_path is not set,
-           then just use existing environment with PATH in it.  */
-        if (NULL != mpiexec_pathenv) {
-            argvptr = NULL;
-            if (pathenv != NULL) {
-                prte_asprintf(&full_search, "%s:%s", mpiexec_pathenv, pathenv);
-            } else {
-                prte_asprintf(&full_search, "%s", mpiexec_pathenv);
-            }
-            prte_setenv("PATH", full_search, true, &argvptr);
-            free(full_search);
-        } else {
-            argvptr = app->env;
-        }
-
-        rc = prte_util_check_context_app(app, argvptr);
+        /* If OMPI_exec_path is not set, then just use the existing
+           environment with PATH in it */
+        argvptr = prte_odls_base_exec_search_env(app->env);
+        rc = prte_util_check_context_app(app, (NULL == argvptr) ? app->env : argvptr);
         /* do not ERROR_LOG - it will be reported elsewhere */
-        if (NULL != mpiexec_pathenv) {
+        if (NULL != argvptr) {
             prte_argv_free(argvptr);
         }
         if (PRTE_SUCCESS != rc) {
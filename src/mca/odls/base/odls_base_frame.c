@@ -122,6 +122,19 @@ static int prte_odls_base_register(prte_mca_base_register_flag_t flags)
                                        PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                        &prte_odls_globals.signal_direct_children_only);
 
+    prte_odls_globals.prefetch = 0;
+    (void) prte_mca_base_var_register("prte", "odls", "base", "prefetch",
+                                       "Read the executables of local procs into the page cache in the background "
+                                       "while the job is being setup, so the procs don't all fetch them from a "
+                                       "shared filesystem when they exec (0: no [default], 1: executables, "
+                                       "2: executables and the shared libraries found via their RPATH/RUNPATH "
+                                       "or LD_LIBRARY_PATH)",
+                                       PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                       PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                       &prte_odls_globals.prefetch);
+
     return PRTE_SUCCESS;
 }
 
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Warm the page cache with the executables (and, optionally, the
+ * shared libraries they need) of the apps we are about to launch.
+ * This runs in a separate thread while the daemon finishes setting
+ * up the job so that the ranks don't all fault in the same files
+ * from a shared filesystem when they exec.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_ELF_H
+#include <elf.h>
+#endif
+
+#include "src/mca/mca.h"
+#include "src/mca/base/base.h"
+#include "src/util/argv.h"
+#include "src/util/output.h"
+#include "src/util/path.h"
+#include "src/util/printf.h"
+#include "src/util/name_fns.h"
+#include "src/threads/threads.h"
+#include "src/runtime/prte_globals.h"
+
+#include "src/mca/odls/base/base.h"
+#include "src/mca/odls/base/odls_private.h"
+
+/* don't chase an unreasonable number of libraries */
+#define PRTE_ODLS_PREFETCH_MAX_FILES 128
+
+typedef struct {
+    prte_object_t super;
+    prte_event_t ev;
+    prte_thread_t thread;
+    /* files to prefetch - libraries get appended as they are found */
+    char **files;
+    /* directories to search for libraries */
+    char **libpath;
+    bool libs;
+} prte_odls_prefetch_t;
+static void pfcon(prte_odls_prefetch_t *p)
+{
+    PRTE_CONSTRUCT(&p->thread, prte_thread_t);
+    p->files = NULL;
+    p->libpath = NULL;
+    p->libs = false;
+}
+static void pfdes(prte_odls_prefetch_t *p)
+{
+    PRTE_DESTRUCT(&p->thread);
+    if (NULL != p->files) {
+        prte_argv_free(p->files);
+    }
+    if (NULL != p->libpath) {
+        prte_argv_free(p->libpath);
+    }
+}
+static PRTE_CLASS_INSTANCE(prte_odls_prefetch_t,
+                           prte_object_t,
+                           pfcon, pfdes);
+
+#if defined(HAVE_ELF_H) && defined(HAVE_SYS_MMAN_H)
+/* find a library named in a DT_NEEDED entry using the
+ * RPATH/RUNPATH of the object that needs it, followed by
+ * the app's LD_LIBRARY_PATH. Libraries in the system
+ * directories are left alone - they are local to the node */
+static void find_lib(prte_odls_prefetch_t *pf, const char *name,
+                     const char *rpath, const char *origin)
+{
+    char **dirs = NULL, *dir, *path;
+    int i;
+
+    if (NULL != strchr(name, '/')) {
+        if (0 == access(name, R_OK)) {
+            prte_argv_append_unique_nosize(&pf->files, name);
+        }
+        return;
+    }
+    if (NULL != rpath) {
+        dirs = prte_argv_split(rpath, ':');
+    }
+    for (i=0; NULL != pf->libpath && NULL != pf->libpath[i]; i++) {
+        prte_argv_append_nosize(&dirs, pf->libpath[i]);
+    }
+    for (i=0; NULL != dirs && NULL != dirs[i]; i++) {
+        dir = dirs[i];
+        path = NULL;
+        if (0 == strncmp(dir, "$ORIGIN", 7)) {
+            prte_asprintf(&path, "%s%s/%s", origin, dir + 7, name);
+        } else if (0 == strncmp(dir, "${ORIGIN}", 9)) {
+            prte_asprintf(&path, "%s%s/%s", origin, dir + 9, name);
+        } else if ('\0' != dir[0]) {
+            prte_asprintf(&path, "%s/%s", dir, name);
+        }
+        if (NULL != path && 0 == access(path, R_OK)) {
+            prte_argv_append_unique_nosize(&pf->files, path);
+            free(path);
+            break;
+        }
+        if (NULL != path) {
+            free(path);
+        }
+    }
+    if (NULL != dirs) {
+        prte_argv_free(dirs);
+    }
+}
+
+/* translate a virtual address into a file offset */
+static bool vaddr_to_offset(const Elf64_Phdr *phdr, int nphdr,
+                            Elf64_Addr vaddr, Elf64_Off *offset)
+{
+    int i;
+
+    for (i=0; i < nphdr; i++) {
+        if (PT_LOAD == phdr[i].p_type && phdr[i].p_vaddr <= vaddr &&
+            vaddr < phdr[i].p_vaddr + phdr[i].p_filesz) {
+            *offset = vaddr - phdr[i].p_vaddr + phdr[i].p_offset;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* walk the dynamic section of a 64-bit, native-endian ELF object */
+static void find_needed(prte_odls_prefetch_t *pf, const char *file,
+                        const uint8_t *map, size_t size)
+{
+    const Elf64_Ehdr *ehdr = (const Elf64_Ehdr*)map;
+    const Elf64_Phdr *phdr;
+    const Elf64_Dyn *dyn = NULL;
+    Elf64_Addr strtab = 0;
+    Elf64_Off stroff, off;
+    size_t ndyn = 0, strsz = 0, i;
+    const char *rpath = NULL, *name;
+    char *origin, *ptr;
+    const uint16_t one = 1;
+    int n;
+
+    if (size < sizeof(Elf64_Ehdr) || 0 != memcmp(ehdr->e_ident, ELFMAG, SELFMAG) ||
+        ELFCLASS64 != ehdr->e_ident[EI_CLASS] ||
+        (1 == *(const uint8_t*)&one ? ELFDATA2LSB : ELFDATA2MSB) != ehdr->e_ident[EI_DATA] ||
+        sizeof(Elf64_Phdr) != ehdr->e_phentsize ||
+        size < ehdr->e_phoff + (size_t)ehdr->e_phnum * sizeof(Elf64_Phdr)) {
+        return;
+    }
+    phdr = (const Elf64_Phdr*)(map + ehdr->e_phoff);
+    for (n=0; n < ehdr->e_phnum; n++) {
+        if (PT_DYNAMIC == phdr[n].p_type &&
+            phdr[n].p_offset + phdr[n].p_filesz <= size) {
+            dyn = (const Elf64_Dyn*)(map + phdr[n].p_offset);
+            ndyn = phdr[n].p_filesz / sizeof(Elf64_Dyn);
+            break;
+        }
+    }
+    if (NULL == dyn) {
+        /* statically linked */
+        return;
+    }
+    for (i=0; i < ndyn && DT_NULL != dyn[i].d_tag; i++) {
+        if (DT_STRTAB == dyn[i].d_tag) {
+            strtab = dyn[i].d_un.d_ptr;
+        } else if (DT_STRSZ == dyn[i].d_tag) {
+            strsz = dyn[i].d_un.d_val;
+        }
+    }
+    if (!vaddr_to_offset(phdr, ehdr->e_phnum, strtab, &stroff) ||
+        size < stroff + strsz || 0 == strsz || '\0' != map[stroff + strsz - 1]) {
+        return;
+    }
+    /* RUNPATH takes precedence over RPATH */
+    for (i=0; i < ndyn && DT_NULL != dyn[i].d_tag; i++) {
+        if ((DT_RUNPATH == dyn[i].d_tag || (DT_RPATH == dyn[i].d_tag && NULL == rpath)) &&
+            dyn[i].d_un.d_val < strsz) {
+            rpath = (const char*)(map + stroff + dyn[i].d_un.d_val);
+        }
+    }
+
+    origin = strdup(file);
+    if (NULL != (ptr = strrchr(origin, '/'))) {
+        *ptr = '\0';
+    }
+    for (i=0; i < ndyn && DT_NULL != dyn[i].d_tag; i++) {
+        if (DT_NEEDED != dyn[i].d_tag || strsz <= dyn[i].d_un.d_val) {
+            continue;
+        }
+        off = stroff + dyn[i].d_un.d_val;
+        name = (const char*)(map + off);
+        find_lib(pf, name, rpath, origin);
+    }
+    free(origin);
+}
+#endif
+
+static void prefetch_file(prte_odls_prefetch_t *pf, const char *file)
+{
+    struct stat buf;
+    int fd;
+
+    if (0 > (fd = open(file, O_RDONLY))) {
+        return;
+    }
+    if (0 != fstat(fd, &buf) || !S_ISREG(buf.st_mode)) {
+        close(fd);
+        return;
+    }
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_WILLNEED)
+    (void) posix_fadvise(fd, 0, buf.st_size, POSIX_FADV_WILLNEED);
+#else
+    {
+        /* just read it through */
+        char chunk[65536];
+        ssize_t rc;
+        do {
+            rc = read(fd, chunk, sizeof(chunk));
+        } while (0 < rc || (0 > rc && EINTR == errno));
+    }
+#endif
+
+#if defined(HAVE_ELF_H) && defined(HAVE_SYS_MMAN_H)
+    if (pf->libs && 0 < buf.st_size) {
+        void *map = mmap(NULL, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED != map) {
+            find_needed(pf, file, (const uint8_t*)map, buf.st_size);
+            munmap(map, buf.st_size);
+        }
+    }
+#endif
+    close(fd);
+}
+
+static void prefetch_done(int fd, short args, void *cbdata)
+{
+    prte_odls_prefetch_t *pf = (prte_odls_prefetch_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(pf);
+    prte_thread_join(&pf->thread, NULL);
+    PRTE_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:prefetch completed %d files",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         prte_argv_count(pf->files)));
+    PRTE_RELEASE(pf);
+}
+
+static void* prefetch_thread(prte_object_t *obj)
+{
+    prte_thread_t *t = (prte_thread_t*)obj;
+    prte_odls_prefetch_t *pf = (prte_odls_prefetch_t*)t->t_arg;
+    int i;
+
+    /* libraries found along the way are appended to the list */
+    for (i=0; NULL != pf->files[i] && i < PRTE_ODLS_PREFETCH_MAX_FILES; i++) {
+        prefetch_file(pf, pf->files[i]);
+    }
+    /* let the main thread clean up */
+    PRTE_THREADSHIFT(pf, prte_event_base, prefetch_done, PRTE_MSG_PRI);
+    return NULL;
+}
+
+/* find the executable the same way prte_util_check_context_app
+ * will when we launch it, but without moving to the app's wdir */
+static char* resolve_app(prte_app_context_t *app)
+{
+    char **env, *path = NULL;
+
+    if (NULL == app->app) {
+        return NULL;
+    }
+    if (prte_path_is_absolute(app->app)) {
+        return strdup(app->app);
+    }
+    if (NULL != strchr(app->app, '/')) {
+        if (NULL != app->cwd) {
+            prte_asprintf(&path, "%s/%s", app->cwd, app->app);
+        }
+        return path;
+    }
+
+    /* honor any --path setting */
+    if (NULL != (env = prte_odls_base_exec_search_env(app->env))) {
+        path = prte_path_findv(app->app, X_OK, env, app->cwd);
+        prte_argv_free(env);
+    } else {
+        path = prte_path_findv(app->app, X_OK, app->env, app->cwd);
+    }
+    return path;
+}
+
+void prte_odls_base_prefetch(prte_job_t *jdata)
+{
+    prte_odls_prefetch_t *pf;
+    prte_app_context_t *app;
+    char *path;
+    int i, j;
+
+    if (0 == prte_odls_globals.prefetch || 0 == jdata->num_local_procs) {
+        return;
+    }
+
+    pf = PRTE_NEW(prte_odls_prefetch_t);
+    pf->libs = (1 < prte_odls_globals.prefetch);
+    for (i=0; i < jdata->apps->size; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            continue;
+        }
+        if (!PRTE_FLAG_TEST(app, PRTE_APP_FLAG_USED_ON_NODE)) {
+            continue;
+        }
+        if (NULL == (path = resolve_app(app))) {
+            continue;
+        }
+        prte_argv_append_unique_nosize(&pf->files, path);
+        free(path);
+        if (pf->libs && NULL == pf->libpath) {
+            for (j=0; NULL != app->env && NULL != app->env[j]; j++) {
+                if (0 == strncmp("LD_LIBRARY_PATH=", app->env[j], 16)) {
+                    pf->libpath = prte_argv_split(app->env[j] + 16, ':');
+                    break;
+                }
+            }
+        }
+    }
+    if (NULL == pf->files) {
+        PRTE_RELEASE(pf);
+        return;
+    }
+
+    PRTE_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:prefetch starting with %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), pf->files[0]));
+    pf->thread.t_run = prefetch_thread;
+    pf->thread.t_arg = pf;
+    if (PRTE_SUCCESS != prte_thread_start(&pf->thread)) {
+        /* no harm done - the procs will just read the files themselves */
+        PRTE_RELEASE(pf);
+    }
+}
@@ -68,6 +68,8 @@ typedef struct {
     char** ev_threads;              // event progress thread names
     int next_base;                  // counter to load-level thread use
     bool signal_direct_children_only;
+    /* prefetch executables (1) and their libraries (2) */
+    int prefetch;
     prte_lock_t lock;
 } prte_odls_globals_t;
 
@@ -88,6 +90,15 @@ prte_odls_base_default_construct_child_list(pmix_data_buffer_t *data,
 
 PRTE_EXPORT void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata);
 
+/* environment to search for an app's executable when --path was
+ * given - returns NULL if the app's own environment is to be used,
+ * otherwise an argv the caller must free */
+PRTE_EXPORT char** prte_odls_base_exec_search_env(char **env);
+
+/* start warming the page cache with the files the job's
+ * local procs will need when they exec */
+PRTE_EXPORT void prte_odls_base_prefetch(prte_job_t *jdata);
+
 /* define a function that will fork a local proc */
 typedef int (*prte_odls_base_fork_local_proc_fn_t)(void *cd);
 
@@ -132,6 +132,7 @@
 #include "src/mca/rtc/rtc.h"
 #include "src/util/name_fns.h"
 #include "src/threads/threads.h"
+#include "src/mca/state/base/base.h"
 
 #include "src/mca/odls/base/base.h"
 #include "src/mca/odls/base/odls_private.h"
@@ -667,14 +668,18 @@ int prte_odls_default_launch_local_procs(pmix_data_buffer_t *data)
 {
     int rc;
     pmix_nspace_t job;
+    double start;
 
     /* construct the list of children we are to launch */
+    start = prte_state_base_trace_time();
     if (PRTE_SUCCESS != (rc = prte_odls_base_default_construct_child_list(data, &job))) {
         PRTE_OUTPUT_VERBOSE((2, prte_odls_base_framework.framework_output,
                              "%s odls:default:launch:local failed to construct child list on error %s",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_ERROR_NAME(rc)));
         return rc;
     }
+    prte_state_base_trace_stage(job, PMIX_RANK_WILDCARD,
+                                PRTE_STATE_TRACE_CONSTRUCT_CHILDREN, start);
 
     /* launch the local procs */
     PRTE_ACTIVATE_LOCAL_LAUNCH(job, odls_default_fork_local_proc);
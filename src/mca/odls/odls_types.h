@@ -92,6 +92,12 @@ typedef uint8_t prte_daemon_cmd_flag_t;
 /* tell DVM daemons to cleanup resources from job */
 #define PRTE_DAEMON_DVM_CLEANUP_JOB_CMD     (prte_daemon_cmd_flag_t) 34
 
+/* report launch trace for a job */
+#define PRTE_DAEMON_REPORT_TRACE_CMD        (prte_daemon_cmd_flag_t) 35
+
+/* add procs for several jobs spawned together */
+#define PRTE_DAEMON_ADD_PROCS_BATCH_CMD     (prte_daemon_cmd_flag_t) 36
+
 /*
  * Struct written up the pipe from the child to the parent.
  */
@@ -87,6 +87,8 @@ prte_oob_tcp_module_t prte_oob_tcp_module = {
  * Local utility functions
  */
 static void recv_handler(int sd, short flags, void* user);
+static void accept_handler(int sd, short flags, void* user);
+static void process_ping(int sd, short flags, void* user);
 
 /* Called by prte_oob_tcp_accept() and connection_handler() on
  * a socket that has been accepted.  This call finishes processing the
@@ -139,6 +141,19 @@ static void ping(const pmix_proc_t *proc)
         return;
     }
 
+    /* the peer's state belongs to the event base progressing it */
+    PRTE_ACTIVATE_TCP_CONN_STATE(peer, process_ping);
+}
+
+static void process_ping(int sd, short flags, void *cbdata)
+{
+    prte_oob_tcp_conn_op_t *op = (prte_oob_tcp_conn_op_t*)cbdata;
+    prte_oob_tcp_peer_t *peer = op->peer;
+    pmix_proc_t *proc = &peer->name;
+
+    PRTE_ACQUIRE_OBJECT(op);
+    PRTE_RELEASE(op);
+
     /* if we are already connected, there is nothing to do */
     if (MCA_OOB_TCP_CONNECTED == peer->state) {
         prte_output_verbose(2, prte_oob_base_framework.framework_output,
@@ -197,35 +212,10 @@ static void send_nb(prte_rml_send_t *msg)
                         PRTE_NAME_PRINT(&msg->dst), msg->tag, msg->seq_num,
                         PRTE_NAME_PRINT(&peer->name));
 
-    /* add the msg to the hop's send queue */
-    if (MCA_OOB_TCP_CONNECTED == peer->state) {
-        prte_output_verbose(2, prte_oob_base_framework.framework_output,
-                            "%s tcp:send_nb: already connected to %s - queueing for send",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                            PRTE_NAME_PRINT(&peer->name));
-        MCA_OOB_TCP_QUEUE_SEND(msg, peer);
-        return;
-    }
-
-    /* add the message to the queue for sending after the
-     * connection is formed
-     */
-    MCA_OOB_TCP_QUEUE_PENDING(msg, peer);
-
-    if (MCA_OOB_TCP_CONNECTING != peer->state &&
-        MCA_OOB_TCP_CONNECT_ACK != peer->state) {
-        /* we have to initiate the connection - again, we do not
-         * want to block while the connection is created.
-         * So throw us into an event that will create
-         * the connection via a mini-state-machine :-)
-         */
-        prte_output_verbose(2, prte_oob_base_framework.framework_output,
-                            "%s tcp:send_nb: initiating connection to %s",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                            PRTE_NAME_PRINT(&peer->name));
-        peer->state = MCA_OOB_TCP_CONNECTING;
-        PRTE_ACTIVATE_TCP_CONN_STATE(peer, prte_oob_tcp_peer_try_connect);
-    }
+    /* add the msg to the hop's send queue - the peer's event base
+     * either sends it right away or initiates the connection and
+     * sends it once the connection is formed */
+    MCA_OOB_TCP_QUEUE_SEND(msg, peer);
 }
 
 /*
@@ -238,9 +228,9 @@ static void send_nb(prte_rml_send_t *msg)
 static void recv_handler(int sd, short flg, void *cbdata)
 {
     prte_oob_tcp_conn_op_t *op = (prte_oob_tcp_conn_op_t*)cbdata;
-    int flags;
     prte_oob_tcp_hdr_t hdr;
     prte_oob_tcp_peer_t *peer;
+    ssize_t rc;
 
     PRTE_ACQUIRE_OBJECT(op);
 
@@ -248,18 +238,66 @@ static void recv_handler(int sd, short flg, void *cbdata)
                         "%s:tcp:recv:handler called",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
+    /* peek at the handshake to see who is calling - we only find
+     * or create the peer here, and leave the handshake itself to
+     * the event base that progresses the peer */
+    do {
+        rc = recv(sd, &hdr, sizeof(prte_oob_tcp_hdr_t), MSG_PEEK | MSG_WAITALL);
+    } while ((0 > rc && (EINTR == prte_socket_errno || EAGAIN == prte_socket_errno ||
+                         EWOULDBLOCK == prte_socket_errno)) ||
+             (0 < rc && rc < (ssize_t)sizeof(prte_oob_tcp_hdr_t)));
+    if (rc != (ssize_t)sizeof(prte_oob_tcp_hdr_t)) {
+        /* protect against things like port scanners */
+        CLOSE_THE_SOCKET(sd);
+        goto cleanup;
+    }
+    MCA_OOB_TCP_HDR_NTOH(&hdr);
+
+    if (MCA_OOB_TCP_IDENT != hdr.type) {
+        /* probes (and garbage) do not involve a peer */
+        (void)prte_oob_tcp_peer_recv_connect_ack(NULL, true, sd, NULL);
+        goto cleanup;
+    }
+
+    if (NULL == (peer = prte_oob_tcp_peer_lookup(&hdr.origin))) {
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                            "%s prte_oob_tcp_recv_connect: connection from new peer",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        peer = PRTE_NEW(prte_oob_tcp_peer_t);
+        PMIX_XFER_PROCID(&peer->name, &hdr.origin);
+        peer->state = MCA_OOB_TCP_ACCEPTING;
+        prte_list_append(&prte_oob_tcp_component.peers, &peer->super);
+    }
+    op->peer = peer;
+    op->sd = sd;
+    PRTE_THREADSHIFT(op, peer->ev_base, accept_handler, PRTE_MSG_PRI);
+    return;
+
+ cleanup:
+    PRTE_RELEASE(op);
+}
+
+/*
+ * Complete the handshake on an accepted connection in the event
+ * base that progresses the peer
+ */
+static void accept_handler(int fd, short flg, void *cbdata)
+{
+    prte_oob_tcp_conn_op_t *op = (prte_oob_tcp_conn_op_t*)cbdata;
+    prte_oob_tcp_peer_t *peer = op->peer;
+    int sd = op->sd;
+    int flags;
+    prte_oob_tcp_hdr_t hdr;
+
+    PRTE_ACQUIRE_OBJECT(op);
+
     /* get the handshake */
-    if (PRTE_SUCCESS != prte_oob_tcp_peer_recv_connect_ack(NULL, sd, &hdr)) {
+    if (PRTE_SUCCESS != prte_oob_tcp_peer_recv_connect_ack(peer, true, sd, &hdr)) {
         goto cleanup;
     }
 
     /* finish processing ident */
     if (MCA_OOB_TCP_IDENT == hdr.type) {
-        if (NULL == (peer = prte_oob_tcp_peer_lookup(&hdr.origin))) {
-            /* should never happen */
-            prte_oob_tcp_peer_close(peer);
-            goto cleanup;
-        }
         /* set socket up to be non-blocking */
         if ((flags = fcntl(sd, F_GETFL, 0)) < 0) {
             prte_output(0, "%s prte_oob_tcp_recv_connect: fcntl(F_GETFL) failed: %s (%d)",
@@ -68,6 +68,7 @@
 #include "src/class/prte_list.h"
 #include "src/event/event-internal.h"
 #include "src/runtime/prte_progress_threads.h"
+#include "src/sys/atomic.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ess/ess.h"
@@ -155,6 +156,9 @@ static int tcp_component_open(void)
     prte_oob_tcp_component.ipv6conns = NULL;
     prte_oob_tcp_component.ipv6ports = NULL;
     prte_oob_tcp_component.if_masks = NULL;
+    prte_oob_tcp_component.ev_bases = NULL;
+    prte_oob_tcp_component.ev_threads = NULL;
+    prte_oob_tcp_component.next_base = 0;
 
     /* if_include and if_exclude need to be mutually exclusive */
     if (PRTE_SUCCESS !=
@@ -178,9 +182,24 @@ static int tcp_component_open(void)
  */
 static int tcp_component_close(void)
 {
+    int i;
+
     PRTE_LIST_DESTRUCT(&prte_oob_tcp_component.local_ifs);
     PRTE_LIST_DESTRUCT(&prte_oob_tcp_component.peers);
 
+    /* the peers are gone, so we can release the progress threads */
+    if (NULL != prte_oob_tcp_component.ev_threads) {
+        for (i=0; NULL != prte_oob_tcp_component.ev_threads[i]; i++) {
+            prte_progress_thread_finalize(prte_oob_tcp_component.ev_threads[i]);
+        }
+        prte_argv_free(prte_oob_tcp_component.ev_threads);
+        prte_oob_tcp_component.ev_threads = NULL;
+    }
+    if (NULL != prte_oob_tcp_component.ev_bases) {
+        free(prte_oob_tcp_component.ev_bases);
+        prte_oob_tcp_component.ev_bases = NULL;
+    }
+
     if (NULL != prte_oob_tcp_component.ipv4conns) {
         prte_argv_free(prte_oob_tcp_component.ipv4conns);
     }
@@ -471,6 +490,16 @@ static int tcp_component_register(void)
                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                           &prte_oob_tcp_component.max_recon_attempts);
 
+    prte_oob_tcp_component.num_threads = 0;
+    (void)prte_mca_base_component_var_register(component, "num_threads",
+                                          "Number of dedicated progress threads for TCP socket I/O - peers are "
+                                          "spread across them (0 -> progress sockets on the main event base)",
+                                          PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                          PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                          PRTE_INFO_LVL_5,
+                                          PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prte_oob_tcp_component.num_threads);
+
     return PRTE_SUCCESS;
 }
 
@@ -654,11 +683,35 @@ static int component_available(void)
 static int component_startup(void)
 {
     int rc = PRTE_SUCCESS;
+    int i;
+    char *tmp;
 
     prte_output_verbose(2, prte_oob_base_framework.framework_output,
                         "%s TCP STARTUP",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
+    /* start the progress threads, if requested - peers are
+     * assigned to them round-robin as they are created */
+    if (0 < prte_oob_tcp_component.num_threads) {
+        prte_oob_tcp_component.ev_bases = (prte_event_base_t**)
+            calloc(prte_oob_tcp_component.num_threads, sizeof(prte_event_base_t*));
+        if (NULL == prte_oob_tcp_component.ev_bases) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        for (i=0; i < prte_oob_tcp_component.num_threads; i++) {
+            prte_asprintf(&tmp, "OOB-TCP-%d", i);
+            prte_oob_tcp_component.ev_bases[i] = prte_progress_thread_init(tmp);
+            if (NULL == prte_oob_tcp_component.ev_bases[i]) {
+                PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+                free(tmp);
+                prte_oob_tcp_component.num_threads = i;
+                break;
+            }
+            prte_argv_append_nosize(&prte_oob_tcp_component.ev_threads, tmp);
+            free(tmp);
+        }
+    }
+
     /* if we are a daemon/HNP,
      * then it is possible that someone else may initiate a
      * connection to us. In these cases, we need to start the
@@ -682,6 +735,14 @@ static void component_shutdown(void)
                         "%s TCP SHUTDOWN",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
+    /* stop progressing the sockets - the peers are released,
+     * and the threads finalized, when the component closes */
+    if (NULL != prte_oob_tcp_component.ev_threads) {
+        for (i=0; NULL != prte_oob_tcp_component.ev_threads[i]; i++) {
+            prte_progress_thread_pause(prte_oob_tcp_component.ev_threads[i]);
+        }
+    }
+
     if (PRTE_PROC_IS_MASTER && prte_oob_tcp_component.listen_thread_active) {
         prte_oob_tcp_component.listen_thread_active = false;
         /* tell the thread to exit */
@@ -773,6 +834,16 @@ static char* component_get_addr(void)
     return cptr;
 }
 
+/* add an address to a peer in the event base progressing it */
+static void add_addr(int fd, short args, void *cbdata)
+{
+    prte_oob_tcp_conn_op_t *cop = (prte_oob_tcp_conn_op_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(cop);
+    prte_list_append(&cop->peer->addrs, &cop->addr->super);
+    PRTE_RELEASE(cop);
+}
+
 /* the host in this case is always in "dot" notation, and
  * thus we do not need to do a DNS lookup to convert it */
 static int parse_uri(const uint16_t af_family,
@@ -821,8 +892,9 @@ static int component_set_addr(pmix_proc_t *peer,
     uint16_t af_family = AF_UNSPEC;
     uint64_t ui64;
     bool found;
-    prte_oob_tcp_peer_t *pr;
+    prte_oob_tcp_peer_t *pr, *newpr = NULL;
     prte_oob_tcp_addr_t *maddr;
+    prte_oob_tcp_conn_op_t *cop;
 
     memcpy(&ui64, (char*)peer, sizeof(uint64_t));
     /* cycle across component parts and see if one belongs to us */
@@ -946,6 +1018,7 @@ static int component_set_addr(pmix_proc_t *peer,
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                     PRTE_NAME_PRINT(peer));
                 prte_list_append(&prte_oob_tcp_component.peers, &pr->super);
+                newpr = pr;
             }
 
             maddr = PRTE_NEW(prte_oob_tcp_addr_t);
@@ -953,8 +1026,11 @@ static int component_set_addr(pmix_proc_t *peer,
             if (PRTE_SUCCESS != (rc = parse_uri(af_family, host, ports, (struct sockaddr_storage*) &(maddr->addr)))) {
                 PRTE_ERROR_LOG(rc);
                 PRTE_RELEASE(maddr);
-                prte_list_remove_item(&prte_oob_tcp_component.peers, &pr->super);
-                PRTE_RELEASE(pr);
+                /* a peer we already knew may be in use by its event base */
+                if (pr == newpr) {
+                    prte_list_remove_item(&prte_oob_tcp_component.peers, &pr->super);
+                    PRTE_RELEASE(pr);
+                }
                 return PRTE_ERR_TAKE_NEXT_OPTION;
             }
             maddr->if_mask = atoi(masks[j]);
@@ -965,7 +1041,15 @@ static int component_set_addr(pmix_proc_t *peer,
                                 PRTE_NAME_PRINT(peer),
                                 (NULL == host) ? "NULL" : host,
                                 (NULL == ports) ? "NULL" : ports);
-            prte_list_append(&pr->addrs, &maddr->super);
+            if (pr == newpr || pr->ev_base == prte_event_base) {
+                prte_list_append(&pr->addrs, &maddr->super);
+            } else {
+                /* the peer's addresses belong to the event base progressing it */
+                cop = PRTE_NEW(prte_oob_tcp_conn_op_t);
+                cop->peer = pr;
+                cop->addr = maddr;
+                PRTE_THREADSHIFT(cop, pr->ev_base, add_addr, PRTE_MSG_PRI);
+            }
 
             found = true;
         }
@@ -1300,6 +1384,8 @@ static char **split_and_resolve(char **orig_str, char *name)
 
 static void peer_cons(prte_oob_tcp_peer_t *peer)
 {
+    uint32_t n;
+
     peer->auth_method = NULL;
     peer->sd = -1;
     PRTE_CONSTRUCT(&peer->addrs, prte_list_t);
@@ -1312,6 +1398,17 @@ static void peer_cons(prte_oob_tcp_peer_t *peer)
     peer->send_ev_active = false;
     peer->recv_ev_active = false;
     peer->timer_ev_active = false;
+    /* shard peers across the progress threads, if any - a peer
+     * created before the threads are running stays on the main base */
+    peer->ev_base = prte_event_base;
+    if (0 < prte_oob_tcp_component.num_threads &&
+        NULL != prte_oob_tcp_component.ev_bases) {
+        n = (uint32_t)prte_atomic_fetch_add_32(&prte_oob_tcp_component.next_base, 1) %
+            (uint32_t)prte_oob_tcp_component.num_threads;
+        if (NULL != prte_oob_tcp_component.ev_bases[n]) {
+            peer->ev_base = prte_oob_tcp_component.ev_bases[n];
+        }
+    }
 }
 static void peer_des(prte_oob_tcp_peer_t *peer)
 {
@@ -1374,9 +1471,15 @@ PRTE_CLASS_INSTANCE(prte_oob_tcp_msg_op_t,
                    prte_object_t,
                    NULL, NULL);
 
+static void cop_cons(prte_oob_tcp_conn_op_t *cop)
+{
+    cop->peer = NULL;
+    cop->sd = -1;
+    cop->addr = NULL;
+}
 PRTE_CLASS_INSTANCE(prte_oob_tcp_conn_op_t,
                    prte_object_t,
-                   NULL, NULL);
+                   cop_cons, NULL);
 
 static void nicaddr_cons(prte_oob_tcp_nicaddr_t *ptr)
 {
@@ -38,6 +38,7 @@
 #include "src/class/prte_list.h"
 #include "src/class/prte_pointer_array.h"
 #include "src/event/event-internal.h"
+#include "src/include/prte_stdatomic.h"
 
 #include "src/mca/oob/oob.h"
 #include "oob_tcp.h"
@@ -89,6 +90,12 @@ typedef struct {
     int                keepalive_intvl;        /**< time between keepalives, in seconds */
     int                retry_delay;            /**< time to wait before retrying connection */
     int                max_recon_attempts;     /**< maximum number of times to attempt connect before giving up (-1 for never) */
+
+    /* progress threads */
+    int                num_threads;            /**< number of dedicated progress threads (0 => use the main event base) */
+    prte_event_base_t  **ev_bases;             /**< event bases of the progress threads */
+    char               **ev_threads;           /**< names of the progress threads */
+    prte_atomic_int32_t next_base;             /**< next event base to assign a peer to */
 } prte_oob_tcp_component_t;
 
 PRTE_MODULE_EXPORT extern prte_oob_tcp_component_t prte_oob_tcp_component;
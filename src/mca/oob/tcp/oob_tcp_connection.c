@@ -619,7 +619,7 @@ static void tcp_peer_event_init(prte_oob_tcp_peer_t* peer)
 {
     if (peer->sd >= 0) {
         assert(!peer->send_ev_active && !peer->recv_ev_active);
-        prte_event_set(prte_event_base,
+        prte_event_set(peer->ev_base,
                        &peer->recv_event,
                        peer->sd,
                        PRTE_EV_READ|PRTE_EV_PERSIST,
@@ -631,7 +631,7 @@ static void tcp_peer_event_init(prte_oob_tcp_peer_t* peer)
             peer->recv_ev_active = false;
         }
 
-        prte_event_set(prte_event_base,
+        prte_event_set(peer->ev_base,
                        &peer->send_event,
                        peer->sd,
                        PRTE_EV_WRITE|PRTE_EV_PERSIST,
@@ -826,7 +826,7 @@ static bool retry(prte_oob_tcp_peer_t* peer, int sd, bool fatal)
 }
 
 
-int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
+int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr, bool is_new,
                                       int sd, prte_oob_tcp_hdr_t *dhdr)
 {
     char *msg;
@@ -835,7 +835,6 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
     prte_oob_tcp_hdr_t hdr;
     prte_oob_tcp_peer_t *peer;
     uint16_t ack_flag;
-    bool is_new = (NULL == pr);
 
     prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s RECV CONNECT ACK FROM %s ON SOCKET %d",
@@ -843,9 +842,10 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
                         (NULL == pr) ? "UNKNOWN" : PRTE_NAME_PRINT(&pr->name), sd);
 
     peer = pr;
-    /* get the header */
-    if (tcp_peer_recv_blocking(peer, sd, &hdr, sizeof(prte_oob_tcp_hdr_t))) {
-        if (NULL != peer) {
+    /* get the header - a new connection is not yet the peer's
+     * socket, so any failure only closes the new socket */
+    if (tcp_peer_recv_blocking(is_new ? NULL : peer, sd, &hdr, sizeof(prte_oob_tcp_hdr_t))) {
+        if (!is_new) {
             /* If the peer state is CONNECT_ACK, then we were waiting for
              * the connection to be ack'd
              */
@@ -893,7 +893,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
     if (hdr.type != MCA_OOB_TCP_IDENT) {
         prte_output(0, "tcp_peer_recv_connect_ack: invalid header type: %d\n",
                     hdr.type);
-        if (NULL != peer) {
+        if (!is_new) {
             peer->state = MCA_OOB_TCP_FAILED;
             prte_oob_tcp_peer_close(peer);
         } else {
@@ -902,17 +902,12 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
         return PRTE_ERR_COMM_FAILURE;
     }
 
-    /* if we don't already have it, get the peer */
-    if (NULL == peer) {
-        peer = prte_oob_tcp_peer_lookup(&hdr.origin);
-        if (NULL == peer) {
-            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
-                                "%s prte_oob_tcp_recv_connect: connection from new peer",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-            peer = PRTE_NEW(prte_oob_tcp_peer_t);
-            PMIX_XFER_PROCID(&peer->name, &hdr.origin);
-            peer->state = MCA_OOB_TCP_ACCEPTING;
-            prte_list_append(&prte_oob_tcp_component.peers, &peer->super);
+    if (is_new) {
+        /* the accept path finds or creates the peer on the main
+         * event base and hands the connection to the peer's base */
+        if (NULL == peer || !PMIX_CHECK_PROCID(&peer->name, &hdr.origin)) {
+            CLOSE_THE_SOCKET(sd);
+            return PRTE_ERR_UNREACH;
         }
     } else {
         /* compare the peers name to the expected value */
@@ -939,7 +934,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
         prte_oob_tcp_peer_close(peer);
         return PRTE_ERR_OUT_OF_RESOURCE;
     }
-    if (!tcp_peer_recv_blocking(peer, sd, msg, hdr.nbytes)) {
+    if (!tcp_peer_recv_blocking(is_new ? NULL : peer, sd, msg, hdr.nbytes)) {
         /* unable to complete the recv but should never happen */
         prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s unable to complete recv of connect-ack from %s ON SOCKET %d",
@@ -42,6 +42,8 @@
 typedef struct {
     prte_object_t super;
     prte_oob_tcp_peer_t *peer;
+    int sd;                       /**< socket of an accepted connection */
+    prte_oob_tcp_addr_t *addr;    /**< address being added to the peer */
     prte_event_t ev;
 } prte_oob_tcp_conn_op_t;
 PRTE_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
@@ -62,7 +64,7 @@ PRTE_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
                             PRTE_NAME_PRINT((&(p)->name)));             \
         cop = PRTE_NEW(prte_oob_tcp_conn_op_t);                           \
         cop->peer = (p);                                                \
-        PRTE_THREADSHIFT(cop, prte_event_base, (cbfunc), PRTE_MSG_PRI);    \
+        PRTE_THREADSHIFT(cop, (p)->ev_base, (cbfunc), PRTE_MSG_PRI);    \
     } while(0);
 
 #define PRTE_ACTIVATE_TCP_ACCEPT_STATE(s, a, cbfunc)            \
@@ -86,7 +88,7 @@ PRTE_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
                             PRTE_NAME_PRINT((&(p)->name)));             \
         cop = PRTE_NEW(prte_oob_tcp_conn_op_t);                           \
         cop->peer = (p);                                                \
-        prte_event_evtimer_set(prte_event_base,                            \
+        prte_event_evtimer_set((p)->ev_base,                            \
                                &cop->ev,                                \
                                (cbfunc), cop);                          \
         PRTE_POST_OBJECT(cop);                                          \
@@ -97,7 +99,7 @@ PRTE_MODULE_EXPORT void prte_oob_tcp_peer_try_connect(int fd, short args, void *
 PRTE_MODULE_EXPORT void prte_oob_tcp_peer_dump(prte_oob_tcp_peer_t* peer, const char* msg);
 PRTE_MODULE_EXPORT bool prte_oob_tcp_peer_accept(prte_oob_tcp_peer_t* peer);
 PRTE_MODULE_EXPORT void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t* peer);
-PRTE_MODULE_EXPORT int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* peer,
+PRTE_MODULE_EXPORT int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* peer, bool is_new,
                                                            int sd, prte_oob_tcp_hdr_t *dhdr);
 PRTE_MODULE_EXPORT void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer);
 
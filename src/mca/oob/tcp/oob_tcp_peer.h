@@ -67,6 +67,7 @@ typedef struct {
     prte_list_t send_queue;      /**< list of messages to send */
     prte_oob_tcp_send_t *send_msg; /**< current send in progress */
     prte_oob_tcp_recv_t *recv_msg; /**< current recv in progress */
+    prte_event_base_t *ev_base;    /**< event base progressing this peer's socket */
 } prte_oob_tcp_peer_t;
 PRTE_CLASS_DECLARATION(prte_oob_tcp_peer_t);
 
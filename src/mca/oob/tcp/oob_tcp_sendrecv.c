@@ -80,6 +80,26 @@
 
 #define OOB_SEND_MAX_RETRIES 3
 
+static void send_complete(int sd, short args, void *cbdata)
+{
+    prte_oob_tcp_msg_op_t *mop = (prte_oob_tcp_msg_op_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(mop);
+    PRTE_RML_SEND_COMPLETE(mop->msg);
+    PRTE_RELEASE(mop);
+}
+
+/* the RML callbacks must run in the main event base, so hand the
+ * completion over if this peer is progressed by its own thread */
+static void tcp_send_complete(prte_oob_tcp_peer_t *peer, prte_rml_send_t *msg)
+{
+    if (peer->ev_base == prte_event_base) {
+        PRTE_RML_SEND_COMPLETE(msg);
+    } else {
+        PRTE_ACTIVATE_TCP_POST_SEND(msg, send_complete);
+    }
+}
+
 void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
 {
     prte_oob_tcp_send_t *snd = (prte_oob_tcp_send_t*)cbdata;
@@ -96,17 +116,19 @@ void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
         prte_list_append(&peer->send_queue, &snd->super);
     }
     if (snd->activate) {
-        /* if we aren't connected, then start connecting */
-        if (MCA_OOB_TCP_CONNECTED != peer->state) {
-            peer->state = MCA_OOB_TCP_CONNECTING;
-            PRTE_ACTIVATE_TCP_CONN_STATE(peer, prte_oob_tcp_peer_try_connect);
-        } else {
+        if (MCA_OOB_TCP_CONNECTED == peer->state) {
             /* ensure the send event is active */
             if (!peer->send_ev_active) {
                 peer->send_ev_active = true;
                 PRTE_POST_OBJECT(peer);
                 prte_event_add(&peer->send_event, 0);
             }
+        } else if (MCA_OOB_TCP_CONNECTING != peer->state &&
+                   MCA_OOB_TCP_CONNECT_ACK != peer->state) {
+            /* if we aren't connected, then start connecting - the
+             * message goes out once the connection is complete */
+            peer->state = MCA_OOB_TCP_CONNECTING;
+            PRTE_ACTIVATE_TCP_CONN_STATE(peer, prte_oob_tcp_peer_try_connect);
         }
     }
 }
@@ -253,7 +275,7 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                                         PRTE_NAME_PRINT(&(peer->name)),
                                         (int)ntohl(msg->hdr.nbytes), peer->sd);
                     msg->msg->status = PRTE_SUCCESS;
-                    PRTE_RML_SEND_COMPLETE(msg->msg);
+                    tcp_send_complete(peer, msg->msg);
                     PRTE_RELEASE(msg);
                     peer->send_msg = NULL;
                 }
@@ -269,7 +291,7 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                             PRTE_NAME_PRINT(&(peer->name)), peer->sd);
                 prte_event_del(&peer->send_event);
                 msg->msg->status = rc;
-                PRTE_RML_SEND_COMPLETE(msg->msg);
+                tcp_send_complete(peer, msg->msg);
                 PRTE_RELEASE(msg);
                 peer->send_msg = NULL;
                 PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_COMM_FAILED);
@@ -404,7 +426,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
 
     switch (peer->state) {
     case MCA_OOB_TCP_CONNECT_ACK:
-        if (PRTE_SUCCESS == (rc = prte_oob_tcp_peer_recv_connect_ack(peer, peer->sd, NULL))) {
+        if (PRTE_SUCCESS == (rc = prte_oob_tcp_peer_recv_connect_ack(peer, false, peer->sd, NULL))) {
             prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s:tcp:recv:handler starting send/recv events",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
@@ -66,7 +66,9 @@ typedef struct {
 } prte_oob_tcp_recv_t;
 PRTE_CLASS_DECLARATION(prte_oob_tcp_recv_t);
 
-/* Queue a message to be sent to a specified peer. The macro
+/* Queue a message to be sent to a specified peer. This may be
+ * called from any thread - the message is handed to the event
+ * base that progresses the peer's socket. The macro
  * checks to see if a message is already in position to be
  * sent - if it is, then the message provided is simply added
  * to the peer's message queue. If not, then the provided message
@@ -86,7 +88,7 @@ PRTE_CLASS_DECLARATION(prte_oob_tcp_recv_t);
     do {                                                                \
         (s)->peer = (struct prte_oob_tcp_peer_t*)(p);                    \
         (s)->activate = (f);                                            \
-        PRTE_THREADSHIFT((s), prte_event_base,                             \
+        PRTE_THREADSHIFT((s), (p)->ev_base,                             \
                          prte_oob_tcp_queue_msg, PRTE_MSG_PRI);          \
     } while(0)
 
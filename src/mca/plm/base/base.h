@@ -70,6 +70,10 @@ PRTE_EXPORT void prte_plm_base_send_launch_msg(int fd, short args, void *cbdata)
 PRTE_EXPORT void prte_plm_base_post_launch(int fd, short args, void *cbdata);
 PRTE_EXPORT void prte_plm_base_registered(int fd, short args, void *cbdata);
 
+/* return the jobid of a job object that is being released so it
+ * can be reused - called from the job destructor */
+PRTE_EXPORT void prte_plm_base_release_jobid(prte_job_t *jdata);
+
 END_C_DECLS
 
 #endif
@@ -67,6 +67,18 @@ static int mca_plm_base_register(prte_mca_base_register_flag_t flags)
                                                   PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                                   &prte_plm_globals.node_regex_threshold);
 
+    prte_plm_globals.prelaunch_daemons = 0;
+    (void) prte_mca_base_framework_var_register (&prte_plm_base_framework, "prelaunch_daemons",
+                                                  "Number of idle nodes in the allocation on which to also launch "
+                                                  "daemons when the virtual machine is setup. These daemons are full "
+                                                  "members of the VM, so later jobs using those nodes do not have to "
+                                                  "wait for daemons to be launched (-1: all idle nodes, 0: none [default])",
+                                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                                  PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                                  PRTE_INFO_LVL_9,
+                                                  PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                                  &prte_plm_globals.prelaunch_daemons);
+
     /* Note that we break abstraction rules here by listing a
      specific PLM here in the base.  This is necessary, however,
      due to extraordinary circumstances:
@@ -110,6 +122,15 @@ static int prte_plm_base_close(void)
 
     if (NULL != prte_plm_globals.base_nspace) {
         free(prte_plm_globals.base_nspace);
+        prte_plm_globals.base_nspace = NULL;
+    }
+    if (NULL != prte_plm_globals.nspace_prefix) {
+        free(prte_plm_globals.nspace_prefix);
+        prte_plm_globals.nspace_prefix = NULL;
+    }
+    if (NULL != prte_plm_globals.jobids) {
+        PRTE_RELEASE(prte_plm_globals.jobids);
+        prte_plm_globals.jobids = NULL;
     }
     
     return prte_mca_base_framework_components_close(&prte_plm_base_framework, NULL);
@@ -123,6 +144,10 @@ static int prte_plm_base_open(prte_mca_base_open_flag_t flags)
 {
     /* init the next jobid */
     prte_plm_globals.next_jobid = 1;
+    prte_plm_globals.nspace_prefix = NULL;
+    prte_plm_globals.nspace_prefix_len = 0;
+    prte_plm_globals.jobids = PRTE_NEW(prte_hash_table_t);
+    prte_hash_table_init(prte_plm_globals.jobids, 128);
 
     /* default to assigning daemons to nodes at launch */
     prte_plm_globals.daemon_nodes_assigned_at_launch = true;
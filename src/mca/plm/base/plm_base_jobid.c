@@ -24,6 +24,8 @@
 #include "constants.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "src/include/hash_string.h"
 
@@ -33,6 +35,7 @@
 #include "src/util/name_fns.h"
 #include "src/runtime/prte_globals.h"
 #include "src/pmix/pmix-internal.h"
+#include "src/mca/plm/base/base.h"
 #include "src/mca/plm/base/plm_private.h"
 
 /*
@@ -80,11 +83,8 @@ static bool reuse = false;
 
 int prte_plm_base_create_jobid(prte_job_t *jdata)
 {
-    uint32_t i;
-    pmix_nspace_t pjid;
-    prte_job_t *ptr;
-    bool found;
-    char *tmp;
+    uint32_t i, jobid;
+    void *ptr;
     int rc;
 
     if (PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_RESTART)) {
@@ -94,20 +94,25 @@ int prte_plm_base_create_jobid(prte_job_t *jdata)
         return PRTE_SUCCESS;
     }
 
+    if (NULL == prte_plm_globals.nspace_prefix) {
+        prte_asprintf(&prte_plm_globals.nspace_prefix, "%s@", prte_plm_globals.base_nspace);
+        prte_plm_globals.nspace_prefix_len = strlen(prte_plm_globals.nspace_prefix);
+    }
+
     if (reuse) {
-        /* find the first unused jobid */
-        found = false;
+        /* find the next unused jobid - we only have to step
+         * over the jobs that are still alive */
         for (i=1; i < UINT32_MAX; i++) {
-            ptr = NULL;
-            (void)snprintf(pjid, PMIX_MAX_NSLEN-1, "%s@%u", prte_plm_globals.base_nspace, i);
-            ptr = prte_get_job_data_object(pjid);
-            if (NULL == ptr) {
-                found = true;
-                prte_plm_globals.next_jobid = i;
+            if (PRTE_SUCCESS != prte_hash_table_get_value_uint32(prte_plm_globals.jobids,
+                                                                 prte_plm_globals.next_jobid, &ptr)) {
                 break;
             }
+            prte_plm_globals.next_jobid++;
+            if (UINT32_MAX == prte_plm_globals.next_jobid) {
+                prte_plm_globals.next_jobid = 1;
+            }
         }
-        if (!found) {
+        if (UINT32_MAX == i) {
             /* we have run out of jobids! */
             prte_output(0, "Whoa! What are you doing starting that many jobs concurrently? We are out of jobids!");
             return PRTE_ERR_OUT_OF_RESOURCE;
@@ -115,10 +120,8 @@ int prte_plm_base_create_jobid(prte_job_t *jdata)
     }
 
     /* the new nspace is our base nspace with an "@N" extension */
-    prte_asprintf(&tmp, "%s@%u", prte_plm_globals.base_nspace,
-                  prte_plm_globals.next_jobid);
-    PMIX_LOAD_NSPACE(jdata->nspace, tmp);
-    free(tmp);
+    jobid = prte_plm_globals.next_jobid;
+    (void)snprintf(jdata->nspace, PMIX_MAX_NSLEN, "%s%u", prte_plm_globals.nspace_prefix, jobid);
 
     /* store the job object */
     rc = prte_set_job_data_object(jdata);
@@ -126,6 +129,9 @@ int prte_plm_base_create_jobid(prte_job_t *jdata)
         PRTE_ERROR_LOG(rc);
         return rc;
     }
+    if (NULL != prte_plm_globals.jobids) {
+        prte_hash_table_set_value_uint32(prte_plm_globals.jobids, jobid, jdata);
+    }
 
     prte_plm_globals.next_jobid++;
     if (UINT32_MAX == prte_plm_globals.next_jobid) {
@@ -135,3 +141,31 @@ int prte_plm_base_create_jobid(prte_job_t *jdata)
 
     return PRTE_SUCCESS;
 }
+
+/*
+ * Return a jobid to the pool when its job object is released
+ */
+void prte_plm_base_release_jobid(prte_job_t *jdata)
+{
+    char *end;
+    unsigned long jobid;
+    void *ptr;
+
+    /* only the HNP assigns jobids */
+    if (NULL == prte_plm_globals.jobids || NULL == prte_plm_globals.nspace_prefix ||
+        0 != strncmp(jdata->nspace, prte_plm_globals.nspace_prefix,
+                     prte_plm_globals.nspace_prefix_len)) {
+        return;
+    }
+    jobid = strtoul(jdata->nspace + prte_plm_globals.nspace_prefix_len, &end, 10);
+    if ('\0' != *end || 0 == jobid || UINT32_MAX <= jobid) {
+        return;
+    }
+    /* make sure this is the object that holds the jobid and
+     * not just a copy of it */
+    if (PRTE_SUCCESS == prte_hash_table_get_value_uint32(prte_plm_globals.jobids,
+                                                         (uint32_t)jobid, &ptr) &&
+        ptr == (void*)jdata) {
+        prte_hash_table_remove_value_uint32(prte_plm_globals.jobids, (uint32_t)jobid);
+    }
+}
@@ -69,6 +69,7 @@
 #include "src/runtime/runtime.h"
 #include "src/runtime/prte_locks.h"
 #include "src/runtime/prte_quit.h"
+#include "src/util/compress.h"
 #include "src/util/name_fns.h"
 #include "src/util/proc_info.h"
 #include "src/threads/threads.h"
@@ -458,6 +459,7 @@ void prte_plm_base_launch_apps(int fd, short args, void *cbdata)
     prte_job_t *jdata;
     prte_daemon_cmd_flag_t command;
     int rc;
+    double start;
 
     PRTE_ACQUIRE_OBJECT(caddy);
 
@@ -492,15 +494,155 @@ void prte_plm_base_launch_apps(int fd, short args, void *cbdata)
     }
 
     /* get the local launcher's required data */
+    start = prte_state_base_trace_time();
     if (PRTE_SUCCESS != (rc = prte_odls.get_add_procs_data(&jdata->launch_msg, jdata->nspace))) {
         PRTE_ERROR_LOG(rc);
         PRTE_ACTIVATE_JOB_STATE(caddy->jdata, PRTE_JOB_STATE_NEVER_LAUNCHED);
     }
+    prte_state_base_trace_stage(jdata->nspace, PMIX_RANK_WILDCARD,
+                                PRTE_STATE_TRACE_GET_ADD_PROCS, start);
 
     PRTE_RELEASE(caddy);
     return;
 }
 
+/* jobs that arrived at the HNP in the same spawn batch share a
+ * single launch xcast. The batch is sent once no other batched job
+ * is still working its way towards launch, or after a short wait
+ * in case one of them stalls or fails */
+#define PRTE_PLM_LAUNCH_BATCH_WAIT  100000
+
+static pmix_data_buffer_t *launch_batch = NULL;
+static prte_pointer_array_t *launch_batch_jobs = NULL;
+static int32_t launch_batch_njobs = 0;
+static prte_event_t launch_batch_ev;
+static bool launch_batch_timer_active = false;
+
+static bool launch_batch_pending(void)
+{
+    prte_job_t *jptr;
+    int n;
+
+    for (n=0; n < prte_job_data->size; n++) {
+        if (NULL == (jptr = (prte_job_t*)prte_pointer_array_get_item(prte_job_data, n))) {
+            continue;
+        }
+        if (jptr->state <= PRTE_JOB_STATE_SEND_LAUNCH_MSG &&
+            prte_get_attribute(&jptr->attributes, PRTE_JOB_SPAWN_BATCH, NULL, PMIX_BOOL)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void launch_batch_send(int fd, short args, void *cbdata)
+{
+    prte_grpcomm_signature_t *sig;
+    prte_daemon_cmd_flag_t command;
+    pmix_data_buffer_t buf;
+    prte_job_t *jdata;
+    pmix_status_t prc;
+    int rc, n;
+    double start;
+
+    if (launch_batch_timer_active) {
+        prte_event_evtimer_del(&launch_batch_ev);
+        launch_batch_timer_active = false;
+    }
+    if (0 == launch_batch_njobs) {
+        return;
+    }
+
+    PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:send launch msg for batch of %d jobs",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int)launch_batch_njobs));
+
+    start = prte_state_base_trace_time();
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    command = PRTE_DAEMON_ADD_PROCS_BATCH_CMD;
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &buf, &command, 1, PMIX_UINT8)) ||
+        PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &buf, &launch_batch_njobs, 1, PMIX_INT32)) ||
+        PMIX_SUCCESS != (prc = PMIx_Data_copy_payload(&buf, launch_batch))) {
+        PMIX_ERROR_LOG(prc);
+        rc = prte_pmix_convert_status(prc);
+    } else {
+        /* goes to all daemons */
+        sig = PRTE_NEW(prte_grpcomm_signature_t);
+        sig->signature = (pmix_proc_t*)malloc(sizeof(pmix_proc_t));
+        PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+        sig->sz = 1;
+        if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_DAEMON, &buf))) {
+            PRTE_ERROR_LOG(rc);
+        }
+        PRTE_RELEASE(sig);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    PMIX_DATA_BUFFER_RELEASE(launch_batch);
+    launch_batch_njobs = 0;
+
+    for (n=0; n < launch_batch_jobs->size; n++) {
+        if (NULL == (jdata = (prte_job_t*)prte_pointer_array_get_item(launch_batch_jobs, n))) {
+            continue;
+        }
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_NEVER_LAUNCHED);
+        } else {
+            prte_state_base_trace_stage(jdata->nspace, PMIX_RANK_WILDCARD,
+                                        PRTE_STATE_TRACE_XCAST, start);
+        }
+        prte_pointer_array_set_item(launch_batch_jobs, n, NULL);
+        PRTE_RELEASE(jdata);
+    }
+}
+
+static int launch_batch_add(prte_job_t *jdata)
+{
+    pmix_byte_object_t bo;
+    struct timeval tv;
+    pmix_status_t prc;
+
+    /* no longer waiting to launch */
+    prte_remove_attribute(&jdata->attributes, PRTE_JOB_SPAWN_BATCH);
+
+    if (NULL == launch_batch_jobs) {
+        launch_batch_jobs = PRTE_NEW(prte_pointer_array_t);
+        prte_pointer_array_init(launch_batch_jobs, 8, INT_MAX, 8);
+    }
+    if (NULL == launch_batch) {
+        PMIX_DATA_BUFFER_CREATE(launch_batch);
+    }
+
+    /* each job's launch msg travels intact as a blob */
+    prc = PMIx_Data_unload(&jdata->launch_msg, &bo);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        return prte_pmix_convert_status(prc);
+    }
+    prc = PMIx_Data_pack(NULL, launch_batch, &bo, 1, PMIX_BYTE_OBJECT);
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    PMIX_DATA_BUFFER_DESTRUCT(&jdata->launch_msg);
+    PMIX_DATA_BUFFER_CONSTRUCT(&jdata->launch_msg);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        return prte_pmix_convert_status(prc);
+    }
+    PRTE_RETAIN(jdata);
+    prte_pointer_array_add(launch_batch_jobs, jdata);
+    ++launch_batch_njobs;
+
+    if (!launch_batch_pending()) {
+        /* the rest of the batch is already here */
+        launch_batch_send(0, 0, NULL);
+    } else if (!launch_batch_timer_active) {
+        tv.tv_sec = 0;
+        tv.tv_usec = PRTE_PLM_LAUNCH_BATCH_WAIT;
+        prte_event_evtimer_set(prte_event_base, &launch_batch_ev, launch_batch_send, NULL);
+        prte_event_evtimer_add(&launch_batch_ev, &tv);
+        launch_batch_timer_active = true;
+    }
+    return PRTE_SUCCESS;
+}
+
 void prte_plm_base_send_launch_msg(int fd, short args, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t*)cbdata;
@@ -508,6 +650,7 @@ void prte_plm_base_send_launch_msg(int fd, short args, void *cbdata)
     prte_grpcomm_signature_t *sig;
     prte_job_t *jdata;
     int rc;
+    double start;
 
     /* convenience */
     jdata = caddy->jdata;
@@ -523,9 +666,9 @@ void prte_plm_base_send_launch_msg(int fd, short args, void *cbdata)
         uint8_t *cmpdata = NULL;
         size_t cmplen;
         /* report the size of the launch message */
-        compressed = PMIx_Data_compress((uint8_t*)jdata->launch_msg.base_ptr,
-                                        jdata->launch_msg.bytes_used,
-                                        &cmpdata, &cmplen);
+        compressed = prte_compress((uint8_t*)jdata->launch_msg.base_ptr,
+                                   jdata->launch_msg.bytes_used,
+                                   &cmpdata, &cmplen);
         if (compressed) {
             prte_output(0, "LAUNCH MSG RAW SIZE: %d COMPRESSED SIZE: %d",
                         (int)jdata->launch_msg.bytes_used, (int)cmplen);
@@ -542,22 +685,35 @@ void prte_plm_base_send_launch_msg(int fd, short args, void *cbdata)
         return;
     }
 
-    /* goes to all daemons */
-    sig = PRTE_NEW(prte_grpcomm_signature_t);
-    sig->signature = (pmix_proc_t*)malloc(sizeof(pmix_proc_t));
-    PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
-    sig->sz = 1;
-    if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_DAEMON, &jdata->launch_msg))) {
-        PRTE_ERROR_LOG(rc);
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_SPAWN_BATCH, NULL, PMIX_BOOL)) {
+        /* combine it with the other jobs in its spawn batch */
+        if (PRTE_SUCCESS != (rc = launch_batch_add(jdata))) {
+            PRTE_ERROR_LOG(rc);
+            PRTE_ACTIVATE_JOB_STATE(caddy->jdata, PRTE_JOB_STATE_NEVER_LAUNCHED);
+            PRTE_RELEASE(caddy);
+            return;
+        }
+    } else {
+        /* goes to all daemons */
+        sig = PRTE_NEW(prte_grpcomm_signature_t);
+        sig->signature = (pmix_proc_t*)malloc(sizeof(pmix_proc_t));
+        PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+        sig->sz = 1;
+        start = prte_state_base_trace_time();
+        if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_DAEMON, &jdata->launch_msg))) {
+            PRTE_ERROR_LOG(rc);
+            PRTE_RELEASE(sig);
+            PRTE_ACTIVATE_JOB_STATE(caddy->jdata, PRTE_JOB_STATE_NEVER_LAUNCHED);
+            PRTE_RELEASE(caddy);
+            return;
+        }
+        prte_state_base_trace_stage(jdata->nspace, PMIX_RANK_WILDCARD,
+                                    PRTE_STATE_TRACE_XCAST, start);
+        PMIX_DATA_BUFFER_DESTRUCT(&jdata->launch_msg);
+        PMIX_DATA_BUFFER_CONSTRUCT(&jdata->launch_msg);
+        /* maintain accounting */
         PRTE_RELEASE(sig);
-        PRTE_ACTIVATE_JOB_STATE(caddy->jdata, PRTE_JOB_STATE_NEVER_LAUNCHED);
-        PRTE_RELEASE(caddy);
-        return;
     }
-    PMIX_DATA_BUFFER_DESTRUCT(&jdata->launch_msg);
-    PMIX_DATA_BUFFER_CONSTRUCT(&jdata->launch_msg);
-    /* maintain accounting */
-    PRTE_RELEASE(sig);
 
     /* track that we automatically are considered to have reported - used
      * only to report launch progress
@@ -1073,8 +1229,8 @@ void prte_plm_base_daemon_topology(int status, pmix_proc_t* sender,
     /* if compressed, decompress it */
     if (flag) {
         /* decompress the data */
-        if (PMIx_Data_decompress((uint8_t**)&bo.bytes, &bo.size,
-                                 (uint8_t*)pbo.bytes, pbo.size)) {
+        if (prte_decompress((uint8_t**)&bo.bytes, &bo.size,
+                            (uint8_t*)pbo.bytes, pbo.size)) {
             /* the data has been uncompressed */
             rc = PMIx_Data_load(&datbuf, &bo);
             PMIX_BYTE_OBJECT_DESTRUCT(&bo);
@@ -1238,37 +1394,114 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PRTE_PMIX_WAKEUP_THREAD(lock);
 }
 
+static int unpack_info(pmix_byte_object_t *bo, pmix_info_t **info, size_t *ninfo)
+{
+    pmix_data_buffer_t pbuf;
+    pmix_status_t ret;
+    int idx;
+
+    *info = NULL;
+    *ninfo = 0;
+    /* the rollup retains the bytes, so embed a copy for unpacking */
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
+    ret = PMIx_Data_embed(&pbuf, bo);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
+        return prte_pmix_convert_status(ret);
+    }
+    idx = 1;
+    ret = PMIx_Data_unpack(NULL, &pbuf, ninfo, &idx, PMIX_SIZE);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
+        return prte_pmix_convert_status(ret);
+    }
+    PMIX_INFO_CREATE(*info, *ninfo);
+    idx = *ninfo;
+    ret = PMIx_Data_unpack(NULL, &pbuf, *info, &idx, PMIX_INFO);
+    PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_INFO_FREE(*info, *ninfo);
+        *info = NULL;
+        return prte_pmix_convert_status(ret);
+    }
+    return PRTE_SUCCESS;
+}
+
+static int unpack_rollup_topo(prte_plm_rollup_t *rollup, hwloc_topology_t *topo)
+{
+    pmix_data_buffer_t datbuf;
+    pmix_byte_object_t bo;
+    pmix_topology_t ptopo;
+    pmix_status_t ret;
+    hwloc_obj_t root;
+    prte_hwloc_topo_data_t *sum;
+    int idx;
+
+    *topo = NULL;
+    PMIX_DATA_BUFFER_CONSTRUCT(&datbuf);
+    if (rollup->topo_compressed) {
+        /* decompress the data */
+        if (!prte_decompress((uint8_t**)&bo.bytes, &bo.size,
+                             (uint8_t*)rollup->topo.bytes, rollup->topo.size)) {
+            PMIX_ERROR_LOG(PMIX_ERROR);
+            return PRTE_ERROR;
+        }
+        ret = PMIx_Data_load(&datbuf, &bo);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    } else {
+        ret = PMIx_Data_load(&datbuf, &rollup->topo);
+    }
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
+        return prte_pmix_convert_status(ret);
+    }
+    /* unpack the available topology information */
+    idx=1;
+    ret = PMIx_Data_unpack(NULL, &datbuf, &ptopo, &idx, PMIX_TOPO);
+    PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        return prte_pmix_convert_status(ret);
+    }
+    *topo = ptopo.topology;
+    ptopo.topology = NULL;
+    PMIX_TOPOLOGY_DESTRUCT(&ptopo);
+    /* setup the summary data for this topology as we will need
+     * it when we go to map/bind procs to it */
+    root = hwloc_get_root_obj(*topo);
+    root->userdata = (void*)PRTE_NEW(prte_hwloc_topo_data_t);
+    sum = (prte_hwloc_topo_data_t*)root->userdata;
+    sum->available = prte_hwloc_base_setup_summary(*topo);
+    return PRTE_SUCCESS;
+}
+
 void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
                                    pmix_data_buffer_t *buffer,
                                    prte_rml_tag_t tag, void *cbdata)
 {
     char *ptr;
-    int idx;
+    int idx, rc;
     pmix_status_t ret;
     prte_proc_t *daemon=NULL;
     prte_job_t *jdata;
     pmix_proc_t dname;
     pmix_data_buffer_t *relay;
-    char *sig;
-    prte_topology_t *t, *mytopo;
+    prte_topology_t *t, *mytopo, **topos = NULL;
     hwloc_topology_t topo;
-    int i;
-    bool found;
+    int i, nsigs;
+    int32_t n, nreported = 0;
     prte_daemon_cmd_flag_t cmd;
-    char *myendian;
-    char *alias, **atmp;
-    uint8_t naliases, ni;
-    hwloc_obj_t root;
-    prte_hwloc_topo_data_t *sum;
+    char *alias;
     char *nodename = NULL;
     pmix_info_t *info;
-    size_t n, ninfo;
-    pmix_byte_object_t pbo, bo;
-    pmix_data_buffer_t pbuf;
-    int32_t flag;
-    bool compressed;
-    pmix_data_buffer_t datbuf, *data;
-    pmix_topology_t ptopo;
+    size_t m, ninfo;
+    prte_plm_rollup_t *rollup;
+    prte_plm_rollup_entry_t *e;
+    struct timeval start, now, *tvptr;
 
     /* get the daemon job, if necessary */
     if (NULL == jdatorted) {
@@ -1277,24 +1510,74 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
 
     /* get my endianness */
     mytopo = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, 0);
-    if (NULL == mytopo) {
-        /* should never happen */
-        myendian = "unknown";
-    } else {
-        myendian = strrchr(mytopo->sig, ':');
-        ++myendian;
+
+    /* the buffer contains a rollup of any number of daemons */
+    rollup = PRTE_NEW(prte_plm_rollup_t);
+    if (PRTE_SUCCESS != (rc = prte_plm_base_rollup_unpack(buffer, rollup))) {
+        PRTE_ERROR_LOG(rc);
+        prted_failed_launch = true;
+        goto CLEANUP;
     }
 
-    /* multiple daemons could be in this buffer, so unpack until we exhaust the data */
-    idx = 1;
-    while (PMIX_SUCCESS == (ret = PMIx_Data_unpack(NULL, buffer, &dname, &idx, PMIX_PROC))) {
+    PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:orted_report_launch from %s reporting %d daemons",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         PRTE_NAME_PRINT(sender), (int)rollup->num_entries));
+
+    /* resolve each topology signature just once rather than
+     * once for every daemon that reported it */
+    nsigs = prte_argv_count(rollup->sigs);
+    if (0 < nsigs) {
+        topos = (prte_topology_t**)calloc(nsigs, sizeof(prte_topology_t*));
+        if (NULL == topos) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            prted_failed_launch = true;
+            goto CLEANUP;
+        }
+    }
+    for (idx=0; idx < nsigs; idx++) {
+        PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                             "%s RECEIVED TOPOLOGY SIG %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), rollup->sigs[idx]));
+
+        if (NULL == prte_base_compute_node_sig) {
+            prte_base_compute_node_sig = strdup(rollup->sigs[idx]);
+            if (prte_hnp_is_allocated && 0 != strcmp(rollup->sigs[idx], mytopo->sig)) {
+                prte_hetero_nodes = true;
+            }
+        } else if (!prte_hetero_nodes) {
+            if (0 != strcmp(rollup->sigs[idx], prte_base_compute_node_sig) ||
+                (prte_hnp_is_allocated && 0 != strcmp(rollup->sigs[idx], mytopo->sig))) {
+                prte_hetero_nodes = true;
+            }
+        }
+
+        /* do we already have this topology from some other node? */
+        for (i=0; i < prte_node_topologies->size; i++) {
+            if (NULL == (t = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, i))) {
+                continue;
+            }
+            /* just check the signature */
+            if (0 == strcmp(rollup->sigs[idx], t->sig)) {
+                PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                                     "%s TOPOLOGY ALREADY RECORDED",
+                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+                topos[idx] = t;
+                break;
+            }
+        }
+    }
+
+    PMIX_LOAD_NSPACE(dname.nspace, jdatorted->nspace);
+    for (n=0; n < rollup->num_entries; n++) {
+        e = &rollup->entries[n];
+        dname.rank = e->vpid;
 
         PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
                              "%s plm:base:orted_report_launch from daemon %s",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                              PRTE_NAME_PRINT(&dname)));
 
-        atmp = NULL;
         /* update state and record for this daemon contact info */
         if (NULL == (daemon = (prte_proc_t*)prte_pointer_array_get_item(jdatorted->procs, dname.rank))) {
             PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
@@ -1305,57 +1588,14 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
         /* record that this daemon is alive */
         PRTE_FLAG_SET(daemon, PRTE_PROC_FLAG_ALIVE);
 
-        /* unpack the flag indicating if we have info objects */
-        idx = 1;
-        ret = PMIx_Data_unpack(NULL, buffer, &flag, &idx, PMIX_INT32);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            prted_failed_launch = true;
-            goto CLEANUP;
-        }
-
-        if (0 < flag) {
-            /* unpack the byte object containing the info array */
-            idx = 1;
-            ret = PMIx_Data_unpack(NULL, buffer, &pbo, &idx, PMIX_BYTE_OBJECT);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
+        if (0 < e->uri.size) {
+            if (PRTE_SUCCESS != (rc = unpack_info(&e->uri, &info, &ninfo))) {
                 prted_failed_launch = true;
                 goto CLEANUP;
             }
-            /* load the bytes into a PMIx data buffer for unpacking */
-            PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
-            ret = PMIx_Data_load(&pbuf, &pbo);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
-                prted_failed_launch = true;
-                goto CLEANUP;
-            }
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            /* unpack the number of info structs */
-            idx = 1;
-            ret = PMIx_Data_unpack(NULL, &pbuf, &ninfo, &idx, PMIX_SIZE);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
-                PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-                prted_failed_launch = true;
-                goto CLEANUP;
-            }
-            PMIX_INFO_CREATE(info, ninfo);
-            idx = ninfo;
-            ret = PMIx_Data_unpack(NULL, &pbuf, info, &idx, PMIX_INFO);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
-                PMIX_INFO_FREE(info, ninfo);
-                PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-                prted_failed_launch = true;
-                goto CLEANUP;
-            }
-            PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-
-            for (n=0; n < ninfo; n++) {
+            for (m=0; m < ninfo; m++) {
                 /* store this in a daemon wireup buffer for later distribution */
-                if (PMIX_SUCCESS != (ret = PMIx_Store_internal(&dname, info[n].key, &info[n].value))) {
+                if (PMIX_SUCCESS != (ret = PMIx_Store_internal(&dname, info[m].key, &info[m].value))) {
                     PMIX_ERROR_LOG(ret);
                     PMIX_INFO_FREE(info, ninfo);
                     prted_failed_launch = true;
@@ -1365,21 +1605,11 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
             PMIX_INFO_FREE(info, ninfo);
         }
 
-        /* unpack the node name */
-        idx = 1;
-        ret = PMIx_Data_unpack(NULL, buffer, &nodename, &idx, PMIX_STRING);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            prted_failed_launch = true;
-            goto CLEANUP;
-        }
+        nodename = e->nodename;
         if (!prte_have_fqdn_allocation) {
             /* remove any domain info */
             if (NULL != (ptr = strchr(nodename, '.'))) {
                 *ptr = '\0';
-                ptr = strdup(nodename);
-                free(nodename);
-                nodename = ptr;
             }
         }
 
@@ -1388,321 +1618,158 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                              PRTE_NAME_PRINT(&daemon->name), nodename));
 
+        /* if the launcher recorded when it started this daemon,
+         * report how long it took to call back */
+        tvptr = &start;
+        if (prte_get_attribute(&daemon->attributes, PRTE_PROC_LAUNCH_START, (void**)&tvptr, PMIX_TIMEVAL)) {
+            gettimeofday(&now, NULL);
+            prte_output_verbose(1, prte_plm_base_framework.framework_output,
+                                "%s plm:base: daemon %s on node %s called back %.3f sec after launch",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                PRTE_NAME_PRINT(&daemon->name), nodename,
+                                (double)(now.tv_sec - start.tv_sec) +
+                                (double)(now.tv_usec - start.tv_usec) / 1000000.0);
+            prte_remove_attribute(&daemon->attributes, PRTE_PROC_LAUNCH_START);
+        }
+
         /* mark the daemon as launched */
         PRTE_FLAG_SET(daemon->node, PRTE_NODE_FLAG_DAEMON_LAUNCHED);
         daemon->node->state = PRTE_NODE_STATE_UP;
 
-        /* first, store the nodename itself as an alias. We do
-         * this in case the nodename isn't the same as what we
+        /* store the nodename itself as an alias along with the provided
+         * ones. We do this in case the nodename isn't the same as what we
          * were given by the allocation. For example, a hostfile
          * might contain an IP address instead of the value returned
          * by gethostname, yet the daemon will have returned the latter
          * and apps may refer to the host by that name
          */
-        prte_argv_append_nosize(&atmp, nodename);
-        /* unpack and store the provided aliases */
-        idx = 1;
-        ret = PMIx_Data_unpack(NULL, buffer, &naliases, &idx, PMIX_UINT8);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            prted_failed_launch = true;
-            goto CLEANUP;
-        }
-        for (ni=0; ni < naliases; ni++) {
-            idx = 1;
-            ret = PMIx_Data_unpack(NULL, buffer, &alias, &idx, PMIX_STRING);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
+        if (NULL != e->aliases) {
+            if (0 > prte_asprintf(&alias, "%s,%s", nodename, e->aliases)) {
+                PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
                 prted_failed_launch = true;
                 goto CLEANUP;
             }
-            prte_argv_append_nosize(&atmp, alias);
-            free(alias);
-        }
-        if (0 < naliases) {
-            alias = prte_argv_join(atmp, ',');
             prte_set_attribute(&daemon->node->attributes, PRTE_NODE_ALIAS, PRTE_ATTR_LOCAL, alias, PMIX_STRING);
             free(alias);
+            prte_node_index_names(daemon->node);
         }
-        prte_argv_free(atmp);
-
-        /* unpack the topology signature for that node */
-        idx=1;
-        ret = PMIx_Data_unpack(NULL, buffer, &sig, &idx, PMIX_STRING);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            prted_failed_launch = true;
-            goto CLEANUP;
-        }
-        PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                             "%s RECEIVED TOPOLOGY SIG %s FROM NODE %s",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sig, nodename));
 
-        if (NULL == prte_base_compute_node_sig) {
-            prte_base_compute_node_sig = strdup(sig);
-            if (prte_hnp_is_allocated && 0 != strcmp(sig, mytopo->sig)) {
-                prte_hetero_nodes = true;
-            }
-        } else if (!prte_hetero_nodes) {
-            if (0 != strcmp(sig, prte_base_compute_node_sig) ||
-                (prte_hnp_is_allocated && 0 != strcmp(sig, mytopo->sig))) {
-                prte_hetero_nodes = true;
-            }
-        }
-
-        /* rank=1 always sends its topology back */
-        topo = NULL;
-        if (1 == dname.rank) {
-            PMIX_DATA_BUFFER_CONSTRUCT(&datbuf);
-            /* unpack the flag to see if this payload is compressed */
-            idx=1;
-            ret = PMIx_Data_unpack(NULL, buffer, &compressed, &idx, PMIX_BOOL);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
+        /* see if they provided their inventory */
+        if (0 < e->inventory.size) {
+            prte_pmix_lock_t lock;
+            if (PRTE_SUCCESS != (rc = unpack_info(&e->inventory, &info, &ninfo))) {
                 prted_failed_launch = true;
                 goto CLEANUP;
             }
-            /* unpack the data */
-            idx=1;
-            ret = PMIx_Data_unpack(NULL, buffer, &pbo, &idx, PMIX_BYTE_OBJECT);
+            PRTE_PMIX_CONSTRUCT_LOCK(&lock);
+            ret = PMIx_server_deliver_inventory(info, ninfo, NULL, 0, opcbfunc, &lock);
             if (PMIX_SUCCESS != ret) {
                 PMIX_ERROR_LOG(ret);
+                PMIX_INFO_FREE(info, ninfo);
                 prted_failed_launch = true;
                 goto CLEANUP;
             }
-            /* only need to process it if our signatures differ */
-            if (0 == strcmp(sig, mytopo->sig)) {
-                PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            } else {
-                if (compressed) {
-                    /* decompress the data */
-                    if (PMIx_Data_decompress((uint8_t**)&bo.bytes, &bo.size,
-                                             (uint8_t*)pbo.bytes, pbo.size)) {
-                        /* the data has been uncompressed */
-                        ret = PMIx_Data_load(&datbuf, &bo);
-                        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
-                        if (PMIX_SUCCESS != ret) {
-                            PMIX_ERROR_LOG(ret);
-                            prted_failed_launch = true;
-                            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                            goto CLEANUP;
-                        }
-                    } else {
-                        PMIX_ERROR_LOG(PMIX_ERROR);
-                        prted_failed_launch = true;
-                        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
-                        goto CLEANUP;
-                    }
-                } else {
-                    ret = PMIx_Data_load(&datbuf, &pbo);
-                    if (PMIX_SUCCESS != ret) {
-                        PMIX_ERROR_LOG(ret);
-                        prted_failed_launch = true;
-                        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                        goto CLEANUP;
-                    }
-                }
-                PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                data = &datbuf;
+            PRTE_PMIX_WAIT_THREAD(&lock);
+            PRTE_PMIX_DESTRUCT_LOCK(&lock);
+            PMIX_INFO_FREE(info, ninfo);
+        }
 
-                 /* unpack the available topology information */
-                idx=1;
-                ret = PMIx_Data_unpack(NULL, data, &ptopo, &idx, PMIX_TOPO);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    prted_failed_launch = true;
-                    goto CLEANUP;
-                }
-                topo = ptopo.topology;
-                ptopo.topology = NULL;
-                PMIX_TOPOLOGY_DESTRUCT(&ptopo);
-                /* setup the summary data for this topology as we will need
-                 * it when we go to map/bind procs to it */
-                root = hwloc_get_root_obj(topo);
-                root->userdata = (void*)PRTE_NEW(prte_hwloc_topo_data_t);
-                sum = (prte_hwloc_topo_data_t*)root->userdata;
-                sum->available = prte_hwloc_base_setup_summary(topo);
-                /* cleanup */
-                PMIX_DATA_BUFFER_DESTRUCT(data);
-            }
+        if (NULL != (t = topos[e->sig])) {
+            daemon->node->topology = t;
+            nreported++;
+            continue;
         }
 
-        /* see if they provided their inventory */
-        idx = 1;
-        ret = PMIx_Data_unpack(NULL, buffer, &flag, &idx, PMIX_INT8);
+        /* nope - save the signature and request the complete topology from that node */
+        PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                             "%s NEW TOPOLOGY - ADDING",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+        t = PRTE_NEW(prte_topology_t);
+        t->sig = strdup(rollup->sigs[e->sig]);
+        t->index = prte_pointer_array_add(prte_node_topologies, t);
+        topos[e->sig] = t;
+        daemon->node->topology = t;
+        /* rank=1 always sends its topology back */
+        if (1 == dname.rank && rollup->topo_included) {
+            if (PRTE_SUCCESS != (rc = unpack_rollup_topo(rollup, &topo))) {
+                prted_failed_launch = true;
+                goto CLEANUP;
+            }
+            /* Apply any CPU filters (not preserved by the XML) */
+            prte_hwloc_base_filter_cpus(topo);
+            t->topo = topo;
+            nreported++;
+            continue;
+        }
+        PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                             "%s REQUESTING TOPOLOGY FROM %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_NAME_PRINT(&dname)));
+        /* construct the request */
+        PMIX_DATA_BUFFER_CREATE(relay);
+        cmd = PRTE_DAEMON_REPORT_TOPOLOGY_CMD;
+        ret = PMIx_Data_pack(NULL, relay, &cmd, 1, PMIX_UINT8);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_RELEASE(relay);
             prted_failed_launch = true;
             goto CLEANUP;
         }
-        if (1 == flag) {
-            ret = PMIx_Data_unpack(NULL, buffer, &pbo, &idx, PMIX_BYTE_OBJECT);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
-                prted_failed_launch = true;
-                goto CLEANUP;
-            }
-            /* if nothing is present, then ignore it */
-            if (0 < pbo.size) {
-                prte_pmix_lock_t lock;
-                /* load the bytes into a PMIx data buffer for unpacking */
-                PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
-                ret = PMIx_Data_load(&pbuf, &pbo);
-                PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    prted_failed_launch = true;
-                    goto CLEANUP;
-                }
-                idx = 1;
-                ret = PMIx_Data_unpack(NULL, &pbuf, &ninfo, &idx, PMIX_SIZE);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-                    prted_failed_launch = true;
-                    goto CLEANUP;
-                }
-                PMIX_INFO_CREATE(info, ninfo);
-                idx = ninfo;
-                ret = PMIx_Data_unpack(NULL, &pbuf, info, &idx, PMIX_INFO);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_INFO_FREE(info, ninfo);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-                    prted_failed_launch = true;
-                    goto CLEANUP;
-                }
-                PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-                PRTE_PMIX_CONSTRUCT_LOCK(&lock);
-                ret = PMIx_server_deliver_inventory(info, ninfo, NULL, 0, opcbfunc, &lock);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_INFO_FREE(info, ninfo);
-                    prted_failed_launch = true;
-                    goto CLEANUP;
-                }
-                PRTE_PMIX_WAIT_THREAD(&lock);
-                PRTE_PMIX_DESTRUCT_LOCK(&lock);
-            }
-        }
+        /* send it */
+        prte_rml.send_buffer_nb(&dname, relay,
+                                PRTE_RML_TAG_DAEMON,
+                                prte_rml_send_callback, NULL);
+        /* we will count this node as completed
+         * when we get the full topology back */
+    }
 
-        /* do we already have this topology from some other node? */
-        found = false;
-        for (i=0; i < prte_node_topologies->size; i++) {
-            if (NULL == (t = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, i))) {
-                continue;
-            }
-            /* just check the signature */
-            if (0 == strcmp(sig, t->sig)) {
-                PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                                     "%s TOPOLOGY ALREADY RECORDED",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-                found = true;
-                daemon->node->topology = t;
-                if (NULL != topo) {
-                    hwloc_topology_destroy(topo);
-                }
-                free(sig);
-                break;
-            }
-        }
+  CLEANUP:
+    PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:orted_report_launch %s for rollup from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         prted_failed_launch ? "failed" : "completed",
+                         PRTE_NAME_PRINT(sender)));
 
-        if (!found) {
-            /* nope - save the signature and request the complete topology from that node */
-            PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                                 "%s NEW TOPOLOGY - ADDING",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-            t = PRTE_NEW(prte_topology_t);
-            t->sig = sig;
-            t->index = prte_pointer_array_add(prte_node_topologies, t);
-            daemon->node->topology = t;
-            if (NULL != topo) {
-                /* Apply any CPU filters (not preserved by the XML) */
-                prte_hwloc_base_filter_cpus(topo);
-                t->topo = topo;
-            } else {
-                PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                                     "%s REQUESTING TOPOLOGY FROM %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     PRTE_NAME_PRINT(&dname)));
-                /* construct the request */
-                PMIX_DATA_BUFFER_CREATE(relay);
-                cmd = PRTE_DAEMON_REPORT_TOPOLOGY_CMD;
-                ret = PMIx_Data_pack(NULL, relay, &cmd, 1, PMIX_UINT8);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_RELEASE(relay);
-                    prted_failed_launch = true;
-                    goto CLEANUP;
-                }
-                /* send it */
-                prte_rml.send_buffer_nb(&dname, relay,
-                                        PRTE_RML_TAG_DAEMON,
-                                        prte_rml_send_callback, NULL);
-                /* we will count this node as completed
-                 * when we get the full topology back */
-                if (NULL != nodename) {
-                    free(nodename);
-                    nodename = NULL;
-                }
-                idx = 1;
+    if (NULL != topos) {
+        free(topos);
+    }
+    PRTE_RELEASE(rollup);
+
+    if (prted_failed_launch) {
+        PRTE_ACTIVATE_JOB_STATE(jdatorted, PRTE_JOB_STATE_FAILED_TO_START);
+        return;
+    }
+    if (0 == nreported) {
+        return;
+    }
+    jdatorted->num_reported += nreported;
+    PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:orted_report_launch job %s recvd %d of %d reported daemons",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         PRTE_JOBID_PRINT(jdatorted->nspace),
+                         jdatorted->num_reported, jdatorted->num_procs));
+    if (jdatorted->num_procs == jdatorted->num_reported) {
+        bool dvm = true;
+        jdatorted->state = PRTE_JOB_STATE_DAEMONS_REPORTED;
+        /* activate the daemons_reported state for all jobs
+         * whose daemons were launched
+         */
+        for (i=1; i < prte_job_data->size; i++) {
+            jdata = (prte_job_t*)prte_pointer_array_get_item(prte_job_data, i);
+            if (NULL == jdata) {
                 continue;
             }
-        }
-
-      CLEANUP:
-        PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                             "%s plm:base:orted_report_launch %s for daemon %s at contact %s",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                             prted_failed_launch ? "failed" : "completed",
-                             PRTE_NAME_PRINT(&dname),
-                             (NULL == daemon) ? "UNKNOWN" : daemon->rml_uri));
-
-        if (NULL != nodename) {
-            free(nodename);
-            nodename = NULL;
-        }
-
-        if (prted_failed_launch) {
-            PRTE_ACTIVATE_JOB_STATE(jdatorted, PRTE_JOB_STATE_FAILED_TO_START);
-            return;
-        } else {
-            jdatorted->num_reported++;
-            PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                                 "%s plm:base:orted_report_launch job %s recvd %d of %d reported daemons",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_JOBID_PRINT(jdatorted->nspace),
-                                 jdatorted->num_reported, jdatorted->num_procs));
-            if (jdatorted->num_procs == jdatorted->num_reported) {
-                bool dvm = true;
-                jdatorted->state = PRTE_JOB_STATE_DAEMONS_REPORTED;
-                /* activate the daemons_reported state for all jobs
-                 * whose daemons were launched
-                 */
-                for (i=1; i < prte_job_data->size; i++) {
-                    jdata = (prte_job_t*)prte_pointer_array_get_item(prte_job_data, i);
-                    if (NULL == jdata) {
-                        continue;
-                    }
-                    if (!PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_TOOL)) {
-                        dvm = false;
-                        if (PRTE_JOB_STATE_DAEMONS_LAUNCHED == jdata->state) {
-                            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_DAEMONS_REPORTED);
-                        }
-                    }
-                }
-                if (dvm) {
-                    /* must be launching a DVM - activate the state */
-                    PRTE_ACTIVATE_JOB_STATE(jdatorted, PRTE_JOB_STATE_DAEMONS_REPORTED);
+            if (!PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_TOOL)) {
+                dvm = false;
+                if (PRTE_JOB_STATE_DAEMONS_LAUNCHED == jdata->state) {
+                    PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_DAEMONS_REPORTED);
                 }
             }
         }
-        idx = 1;
-    }
-    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != ret) {
-        PMIX_ERROR_LOG(ret);
-        PRTE_ACTIVATE_JOB_STATE(jdatorted, PRTE_JOB_STATE_FAILED_TO_START);
+        if (dvm) {
+            /* must be launching a DVM - activate the state */
+            PRTE_ACTIVATE_JOB_STATE(jdatorted, PRTE_JOB_STATE_DAEMONS_REPORTED);
+        }
     }
 }
 
@@ -1914,6 +1981,27 @@ int prte_plm_base_prted_append_basic_args(int *argc, char ***argv,
     return PRTE_SUCCESS;
 }
 
+/* check if we should pre-launch a daemon on this node - we
+ * only want nodes that are usable and don't already have one */
+static bool prelaunch_node(prte_node_t *node, int *nprelaunch)
+{
+    if (0 == prte_plm_globals.prelaunch_daemons ||
+        (0 < prte_plm_globals.prelaunch_daemons && prte_plm_globals.prelaunch_daemons <= *nprelaunch)) {
+        return false;
+    }
+    if (0 == node->index || NULL != node->daemon ||
+        PRTE_NODE_STATE_DOWN == node->state ||
+        PRTE_NODE_STATE_NOT_INCLUDED == node->state ||
+        PRTE_NODE_STATE_DO_NOT_USE == node->state) {
+        return false;
+    }
+    ++(*nprelaunch);
+    PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:setup_vm pre-launching daemon on node %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name));
+    return true;
+}
+
 int prte_plm_base_setup_virtual_machine(prte_job_t *jdata)
 {
     prte_node_t *node, *nptr;
@@ -1930,6 +2018,7 @@ int prte_plm_base_setup_virtual_machine(prte_job_t *jdata)
     char *hosts = NULL;
     bool singleton=false;
     bool multi_sim = false;
+    int nprelaunch = 0;
 
     PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
                          "%s plm:base:setup_vm",
@@ -2239,6 +2328,22 @@ int prte_plm_base_setup_virtual_machine(prte_job_t *jdata)
             PRTE_RELEASE(nptr);
         }
         PRTE_LIST_DESTRUCT(&tnodes);
+        /* pre-launch daemons on any of the rest of the known nodes */
+        for (i=1; 0 != prte_plm_globals.prelaunch_daemons && i < prte_node_pool->size; i++) {
+            if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, i))) {
+                continue;
+            }
+            PRTE_LIST_FOREACH(nptr, &nodes, prte_node_t) {
+                if (nptr == node) {
+                    break;
+                }
+            }
+            if (nptr == (prte_node_t*)prte_list_get_end(&nodes) &&
+                prelaunch_node(node, &nprelaunch)) {
+                PRTE_RETAIN(node);
+                prte_list_append(&nodes, &node->super);
+            }
+        }
         /* if we didn't get anything, then we are the only node in the
          * allocation - so there is nothing else to do as no other
          * daemons are to be launched
@@ -2346,8 +2451,10 @@ int prte_plm_base_setup_virtual_machine(prte_job_t *jdata)
             next = prte_list_get_next(item);
             node = (prte_node_t*)item;
             if (!PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_MAPPED)) {
-                prte_list_remove_item(&nodes, item);
-                PRTE_RELEASE(item);
+                if (!prelaunch_node(node, &nprelaunch)) {
+                    prte_list_remove_item(&nodes, item);
+                    PRTE_RELEASE(item);
+                }
             } else {
                 /* The filtering logic sets this flag only for nodes which
                  * are kept after filtering. This flag will be subsequently
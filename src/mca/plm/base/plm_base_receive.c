@@ -123,6 +123,184 @@ int prte_plm_base_comm_stop(void)
 }
 
 
+static int launch_job(pmix_proc_t *sender, prte_job_t *jdata)
+{
+    prte_job_t *parent;
+    prte_app_context_t *app, *child_app;
+    prte_proc_t *proc;
+    pmix_proc_t name, *nptr;
+    char **env;
+    char *prefix_dir;
+    int i, rc;
+
+    /* record the sender so we know who to respond to */
+    PMIX_LOAD_PROCID(&jdata->originator, sender->nspace, sender->rank);
+
+    /* get the name of the actual spawn parent - i.e., the proc that actually
+     * requested the spawn */
+    nptr = &name;
+    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_LAUNCH_PROXY, (void**)&nptr, PMIX_PROC)) {
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    /* get the parent's job object */
+    if (NULL != (parent = prte_get_job_data_object(name.nspace))) {
+        /* link the spawned job to the spawner */
+        PRTE_RETAIN(jdata);
+        prte_list_append(&parent->children, &jdata->super);
+        /* connect the launcher as well */
+        if (PMIX_NSPACE_INVALID(parent->launcher)) {
+            /* we are an original spawn */
+            PMIX_LOAD_NSPACE(jdata->launcher, name.nspace);
+        } else {
+            PMIX_LOAD_NSPACE(jdata->launcher, parent->launcher);
+        }
+        if (PRTE_FLAG_TEST(parent, PRTE_JOB_FLAG_TOOL)) {
+            /* don't use the parent for anything more */
+            parent = NULL;
+        } else {
+            /* if the prefix was set in the parent's job, we need to transfer
+             * that prefix to the child's app_context so any further launch of
+             * orteds can find the correct binary. There always has to be at
+             * least one app_context in both parent and child, so we don't
+             * need to check that here. However, be sure not to overwrite
+             * the prefix if the user already provided it!
+             */
+            app = (prte_app_context_t*)prte_pointer_array_get_item(parent->apps, 0);
+            child_app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, 0);
+            if (NULL != app && NULL != child_app) {
+                prefix_dir = NULL;
+                if (prte_get_attribute(&app->attributes, PRTE_APP_PREFIX_DIR, (void**)&prefix_dir, PMIX_STRING) &&
+                    !prte_get_attribute(&child_app->attributes, PRTE_APP_PREFIX_DIR, NULL, PMIX_STRING)) {
+                    prte_set_attribute(&child_app->attributes, PRTE_APP_PREFIX_DIR, PRTE_ATTR_GLOBAL, prefix_dir, PMIX_STRING);
+                }
+                if (NULL != prefix_dir) {
+                    free(prefix_dir);
+                }
+            }
+        }
+    }
+
+    /* if the user asked to forward any envars, cycle through the app contexts
+     * in the comm_spawn request and add them
+     */
+    if (NULL != prte_forwarded_envars) {
+        for (i=0; i < jdata->apps->size; i++) {
+            if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+                continue;
+            }
+            env = prte_environ_merge(prte_forwarded_envars, app->env);
+            prte_argv_free(app->env);
+            app->env = env;
+        }
+    }
+
+    PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:receive adding hosts",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+
+    /* process any add-hostfile and add-host options that were provided */
+    if (PRTE_SUCCESS != (rc = prte_ras_base_add_hosts(jdata))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (NULL != parent && !PRTE_FLAG_TEST(parent, PRTE_JOB_FLAG_TOOL)) {
+        if (NULL == parent->bookmark) {
+            /* find the sender's node in the job map */
+            if (NULL != (proc = (prte_proc_t*)prte_pointer_array_get_item(parent->procs, sender->rank))) {
+                /* set the bookmark so the child starts from that place - this means
+                 * that the first child process could be co-located with the proc
+                 * that called comm_spawn, assuming slots remain on that node. Otherwise,
+                 * the procs will start on the next available node
+                 */
+                jdata->bookmark = proc->node;
+            }
+        } else {
+            jdata->bookmark = parent->bookmark;
+        }
+        /* provide the parent's last object */
+        jdata->bkmark_obj = parent->bkmark_obj;
+    }
+
+    if (!prte_dvm_ready) {
+        prte_pointer_array_add(prte_cache, jdata);
+        return PRTE_SUCCESS;
+    }
+
+    /* launch it */
+    PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:receive calling spawn",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+    if (PRTE_SUCCESS != (rc = prte_plm.spawn(jdata))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    return PRTE_SUCCESS;
+}
+
+static void answer_launch_room(pmix_proc_t *sender, int room, int rc)
+{
+    pmix_data_buffer_t *answer;
+    int ret;
+#if PMIX_NUMERIC_VERSION < 0x00040100
+    char *tmp;
+#else
+    pmix_nspace_t job;
+#endif
+
+    PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:receive - error on launch: %d",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), rc));
+
+    /* setup the response */
+    PMIX_DATA_BUFFER_CREATE(answer);
+
+    /* pack the error code to be returned */
+    rc = PMIx_Data_pack(NULL, answer, &rc, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+
+    /* pack an invalid jobid */
+#if PMIX_NUMERIC_VERSION < 0x00040100
+    tmp = NULL;
+    rc = PMIx_Data_pack(NULL, answer, &tmp, 1, PMIX_STRING);
+#else
+    PMIX_LOAD_NSPACE(job, NULL);
+    rc = PMIx_Data_pack(NULL, answer, &job, 1, PMIX_PROC_NSPACE);
+#endif
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+
+    /* pack the room number of the request, if known */
+    if (0 <= room) {
+        rc = PMIx_Data_pack(NULL, answer, &room, 1, PMIX_INT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+    }
+
+    /* send the response back to the sender */
+    if (0 > (ret = prte_rml.send_buffer_nb(sender, answer, PRTE_RML_TAG_LAUNCH_RESP,
+                                           prte_rml_send_callback, NULL))) {
+        PRTE_ERROR_LOG(ret);
+        PRTE_RELEASE(answer);
+    }
+}
+
+static void answer_launch(pmix_proc_t *sender, prte_job_t *jdata, int rc)
+{
+    int room = -1, *rmptr = &room;
+
+    if (NULL != jdata) {
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_ROOM_NUM, (void**)&rmptr, PMIX_INT);
+    }
+    answer_launch_room(sender, room, rc);
+}
+
 /* process incoming messages in order of receipt */
 void prte_plm_base_recv(int status, pmix_proc_t* sender,
                         pmix_data_buffer_t* buffer, prte_rml_tag_t tag,
@@ -131,20 +309,18 @@ void prte_plm_base_recv(int status, pmix_proc_t* sender,
     prte_plm_cmd_flag_t command;
     int32_t count;
     pmix_nspace_t job;
-    prte_job_t *jdata, *parent, jb;
+    prte_job_t *jdata, jb;
     pmix_data_buffer_t *answer;
     pmix_rank_t vpid;
     prte_proc_t *proc;
     prte_proc_state_t state;
     prte_exit_code_t exit_code;
     int32_t rc=PRTE_SUCCESS, ret;
-    prte_app_context_t *app, *child_app;
-    pmix_proc_t name, *nptr;
+    pmix_proc_t name;
     pid_t pid;
     bool running;
-    int i, room;
-    char **env;
-    char *prefix_dir;
+    int i, room, *rooms = NULL;
+    int32_t njobs;
 
     PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
                          "%s plm:base:receive processing msg",
@@ -229,155 +405,69 @@ void prte_plm_base_recv(int status, pmix_proc_t* sender,
         rc = prte_job_unpack(buffer, &jdata);
         if (PRTE_SUCCESS != rc) {
             PRTE_ERROR_LOG(rc);
-            goto ANSWER_LAUNCH;
-        }
-
-        /* record the sender so we know who to respond to */
-        PMIX_LOAD_PROCID(&jdata->originator, sender->nspace, sender->rank);
-
-        /* get the name of the actual spawn parent - i.e., the proc that actually
-         * requested the spawn */
-        nptr = &name;
-        if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_LAUNCH_PROXY, (void**)&nptr, PMIX_PROC)) {
-            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-            rc = PRTE_ERR_NOT_FOUND;
-            goto ANSWER_LAUNCH;
+            answer_launch(sender, NULL, rc);
+            rc = PRTE_SUCCESS;
+            break;
         }
 
-        /* get the parent's job object */
-        if (NULL != (parent = prte_get_job_data_object(name.nspace))) {
-            /* link the spawned job to the spawner */
-            PRTE_RETAIN(jdata);
-            prte_list_append(&parent->children, &jdata->super);
-            /* connect the launcher as well */
-            if (PMIX_NSPACE_INVALID(parent->launcher)) {
-                /* we are an original spawn */
-                PMIX_LOAD_NSPACE(jdata->launcher, name.nspace);
-            } else {
-                PMIX_LOAD_NSPACE(jdata->launcher, parent->launcher);
-            }
-            if (PRTE_FLAG_TEST(parent, PRTE_JOB_FLAG_TOOL)) {
-                /* don't use the parent for anything more */
-                parent = NULL;
-            } else {
-                /* if the prefix was set in the parent's job, we need to transfer
-                 * that prefix to the child's app_context so any further launch of
-                 * orteds can find the correct binary. There always has to be at
-                 * least one app_context in both parent and child, so we don't
-                 * need to check that here. However, be sure not to overwrite
-                 * the prefix if the user already provided it!
-                 */
-                app = (prte_app_context_t*)prte_pointer_array_get_item(parent->apps, 0);
-                child_app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, 0);
-                if (NULL != app && NULL != child_app) {
-                    prefix_dir = NULL;
-                    if (prte_get_attribute(&app->attributes, PRTE_APP_PREFIX_DIR, (void**)&prefix_dir, PMIX_STRING) &&
-                        !prte_get_attribute(&child_app->attributes, PRTE_APP_PREFIX_DIR, NULL, PMIX_STRING)) {
-                        prte_set_attribute(&child_app->attributes, PRTE_APP_PREFIX_DIR, PRTE_ATTR_GLOBAL, prefix_dir, PMIX_STRING);
-                    }
-                    if (NULL != prefix_dir) {
-                        free(prefix_dir);
-                    }
-                }
-            }
+        if (PRTE_SUCCESS != (rc = launch_job(sender, jdata))) {
+            answer_launch(sender, jdata, rc);
         }
+        rc = PRTE_SUCCESS;
+        break;
 
-        /* if the user asked to forward any envars, cycle through the app contexts
-         * in the comm_spawn request and add them
-         */
-        if (NULL != prte_forwarded_envars) {
-            for (i=0; i < jdata->apps->size; i++) {
-                if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
-                    continue;
-                }
-                env = prte_environ_merge(prte_forwarded_envars, app->env);
-                prte_argv_free(app->env);
-                app->env = env;
-            }
+    case PRTE_PLM_LAUNCH_JOBS_CMD:
+        /* a batch of job launch requests */
+        count = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &njobs, &count, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            rc = prte_pmix_convert_status(rc);
+            goto CLEANUP;
         }
-
         PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                             "%s plm:base:receive adding hosts",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-
-        /* process any add-hostfile and add-host options that were provided */
-        if (PRTE_SUCCESS != (rc = prte_ras_base_add_hosts(jdata))) {
-            PRTE_ERROR_LOG(rc);
-            goto ANSWER_LAUNCH;
-        }
-
-        if (NULL != parent && !PRTE_FLAG_TEST(parent, PRTE_JOB_FLAG_TOOL)) {
-            if (NULL == parent->bookmark) {
-                /* find the sender's node in the job map */
-                if (NULL != (proc = (prte_proc_t*)prte_pointer_array_get_item(parent->procs, sender->rank))) {
-                    /* set the bookmark so the child starts from that place - this means
-                     * that the first child process could be co-located with the proc
-                     * that called comm_spawn, assuming slots remain on that node. Otherwise,
-                     * the procs will start on the next available node
-                     */
-                    jdata->bookmark = proc->node;
-                }
-            } else {
-                jdata->bookmark = parent->bookmark;
-            }
-            /* provide the parent's last object */
-            jdata->bkmark_obj = parent->bkmark_obj;
-        }
-
-        if (!prte_dvm_ready) {
-            prte_pointer_array_add(prte_cache, jdata);
-            return;
+                             "%s plm:base:receive launch command for %d jobs from %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), njobs,
+                             PRTE_NAME_PRINT(sender)));
+        if (0 >= njobs) {
+            rc = PRTE_SUCCESS;
+            break;
         }
-
-        /* launch it */
-        PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                             "%s plm:base:receive calling spawn",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-        if (PRTE_SUCCESS != (rc = prte_plm.spawn(jdata))) {
+        /* the room numbers travel ahead of the jobs so that every
+         * request can be answered even if a job fails to unpack */
+        rooms = (int*)malloc(njobs * sizeof(int));
+        if (NULL == rooms) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
             PRTE_ERROR_LOG(rc);
-            goto ANSWER_LAUNCH;
-        }
-        break;
-    ANSWER_LAUNCH:
-        PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                             "%s plm:base:receive - error on launch: %d",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), rc));
-
-        /* setup the response */
-        PMIX_DATA_BUFFER_CREATE(answer);
-
-        /* pack the error code to be returned */
-        rc = PMIx_Data_pack(NULL, answer, &rc, 1, PMIX_INT32);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
+            goto CLEANUP;
         }
-
-        /* pack an invalid jobid */
-#if PMIX_NUMERIC_VERSION < 0x00040100
-        tmp = NULL;
-        rc = PMIx_Data_pack(NULL, answer, &tmp, 1, PMIX_STRING);
-#else
-        PMIX_LOAD_NSPACE(job, NULL);
-        rc = PMIx_Data_pack(NULL, answer, &job, 1, PMIX_PROC_NSPACE);
-#endif
+        count = njobs;
+        rc = PMIx_Data_unpack(NULL, buffer, rooms, &count, PMIX_INT);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
+            free(rooms);
+            rc = prte_pmix_convert_status(rc);
+            goto CLEANUP;
         }
-
-            /* pack the room number of the request */
-        if (prte_get_attribute(&jdata->attributes, PRTE_JOB_ROOM_NUM, (void**)&room, PMIX_INT)) {
-            rc = PMIx_Data_pack(NULL, answer, &room, 1, PMIX_INT);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
+        for (i=0; i < njobs; i++) {
+            rc = prte_job_unpack(buffer, &jdata);
+            if (PRTE_SUCCESS != rc) {
+                /* we cannot locate the remaining jobs */
+                PRTE_ERROR_LOG(rc);
+                for (; i < njobs; i++) {
+                    answer_launch_room(sender, rooms[i], rc);
+                }
+                break;
+            }
+            /* share the launch xcast with the rest of the batch */
+            prte_set_attribute(&jdata->attributes, PRTE_JOB_SPAWN_BATCH,
+                               PRTE_ATTR_LOCAL, NULL, PMIX_BOOL);
+            if (PRTE_SUCCESS != (rc = launch_job(sender, jdata))) {
+                answer_launch_room(sender, rooms[i], rc);
             }
         }
-
-        /* send the response back to the sender */
-        if (0 > (ret = prte_rml.send_buffer_nb(sender, answer, PRTE_RML_TAG_LAUNCH_RESP,
-                                               prte_rml_send_callback, NULL))) {
-            PRTE_ERROR_LOG(ret);
-            PRTE_RELEASE(answer);
-        }
+        free(rooms);
+        rc = PRTE_SUCCESS;
         break;
 
     case PRTE_PLM_UPDATE_PROC_STATE:
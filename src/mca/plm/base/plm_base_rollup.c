@@ -0,0 +1,654 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/util/argv.h"
+#include "src/util/printf.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/mca/plm/base/plm_private.h"
+
+/*
+ * Wire format of a rollup, with the entries sorted by vpid:
+ *
+ *  int32         number of entries - nothing else follows if zero
+ *  int32         number of vpid ranges
+ *  rank[2*n]     (first vpid, count) pairs
+ *  string        common hostname prefix
+ *  string        common hostname suffix
+ *  string[n]     remainder of each hostname
+ *  int32         number of signatures
+ *    string      signature
+ *    int32       number of vpid ranges using it
+ *    rank[2*n]   (first vpid, count) pairs
+ *  int32         number of entries with aliases
+ *    int32       entry index
+ *    string      aliases
+ *  bo[n]         connection info
+ *  bo[n]         inventory
+ *  bool          topology included
+ *    bool        compressed
+ *    bo          topology
+ */
+
+static void rcon(prte_plm_rollup_t *p)
+{
+    p->entries = NULL;
+    p->num_entries = 0;
+    p->size = 0;
+    p->sigs = NULL;
+    p->topo_included = false;
+    p->topo_compressed = false;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->topo);
+}
+static void rdes(prte_plm_rollup_t *p)
+{
+    int32_t n;
+
+    for (n=0; n < p->num_entries; n++) {
+        if (NULL != p->entries[n].nodename) {
+            free(p->entries[n].nodename);
+        }
+        if (NULL != p->entries[n].aliases) {
+            free(p->entries[n].aliases);
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&p->entries[n].uri);
+        PMIX_BYTE_OBJECT_DESTRUCT(&p->entries[n].inventory);
+    }
+    if (NULL != p->entries) {
+        free(p->entries);
+    }
+    prte_argv_free(p->sigs);
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->topo);
+}
+PRTE_CLASS_INSTANCE(prte_plm_rollup_t,
+                    prte_object_t,
+                    rcon, rdes);
+
+static int sig_index(prte_plm_rollup_t *rollup, const char *sig)
+{
+    int n;
+
+    for (n=0; NULL != rollup->sigs && NULL != rollup->sigs[n]; n++) {
+        if (0 == strcmp(rollup->sigs[n], sig)) {
+            return n;
+        }
+    }
+    prte_argv_append_nosize(&rollup->sigs, sig);
+    return n;
+}
+
+static prte_plm_rollup_entry_t* new_entries(prte_plm_rollup_t *rollup, int32_t num)
+{
+    prte_plm_rollup_entry_t *ptr;
+    int32_t size;
+
+    if (rollup->size < rollup->num_entries + num) {
+        size = (0 == rollup->size) ? 8 : rollup->size;
+        while (size < rollup->num_entries + num) {
+            size *= 2;
+        }
+        ptr = (prte_plm_rollup_entry_t*)realloc(rollup->entries,
+                                                 size * sizeof(prte_plm_rollup_entry_t));
+        if (NULL == ptr) {
+            return NULL;
+        }
+        rollup->entries = ptr;
+        rollup->size = size;
+    }
+    ptr = &rollup->entries[rollup->num_entries];
+    memset(ptr, 0, num * sizeof(prte_plm_rollup_entry_t));
+    rollup->num_entries += num;
+    return ptr;
+}
+
+static int entry_cmp(const void *a, const void *b)
+{
+    const prte_plm_rollup_entry_t *e1 = (const prte_plm_rollup_entry_t*)a;
+    const prte_plm_rollup_entry_t *e2 = (const prte_plm_rollup_entry_t*)b;
+
+    if (e1->vpid < e2->vpid) {
+        return -1;
+    }
+    return (e1->vpid > e2->vpid) ? 1 : 0;
+}
+
+int prte_plm_base_rollup_add(prte_plm_rollup_t *rollup,
+                             pmix_rank_t vpid,
+                             const char *nodename,
+                             const char *aliases,
+                             const char *sig,
+                             pmix_byte_object_t *uri,
+                             pmix_byte_object_t *inventory)
+{
+    prte_plm_rollup_entry_t *e;
+
+    if (NULL == (e = new_entries(rollup, 1))) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    e->vpid = vpid;
+    e->nodename = strdup(nodename);
+    if (NULL != aliases && '\0' != aliases[0]) {
+        e->aliases = strdup(aliases);
+    }
+    e->sig = sig_index(rollup, sig);
+    if (NULL != uri) {
+        e->uri = *uri;
+        PMIX_BYTE_OBJECT_CONSTRUCT(uri);
+    }
+    if (NULL != inventory) {
+        e->inventory = *inventory;
+        PMIX_BYTE_OBJECT_CONSTRUCT(inventory);
+    }
+    return PRTE_SUCCESS;
+}
+
+prte_plm_rollup_entry_t* prte_plm_base_rollup_lookup(prte_plm_rollup_t *rollup,
+                                                     pmix_rank_t vpid)
+{
+    int32_t n;
+
+    for (n=0; n < rollup->num_entries; n++) {
+        if (vpid == rollup->entries[n].vpid) {
+            return &rollup->entries[n];
+        }
+    }
+    return NULL;
+}
+
+/* compute the ranges of consecutive vpids among the entries
+ * selected by sig (or all entries if sig < 0) */
+static int32_t get_ranges(prte_plm_rollup_t *rollup, int32_t sig,
+                          pmix_rank_t *ranges)
+{
+    int32_t n, nranges = 0;
+    prte_plm_rollup_entry_t *e;
+
+    for (n=0; n < rollup->num_entries; n++) {
+        e = &rollup->entries[n];
+        if (0 <= sig && sig != e->sig) {
+            continue;
+        }
+        if (0 < nranges &&
+            e->vpid == ranges[2*(nranges-1)] + ranges[2*(nranges-1)+1]) {
+            ranges[2*(nranges-1)+1]++;
+        } else {
+            ranges[2*nranges] = e->vpid;
+            ranges[2*nranges+1] = 1;
+            nranges++;
+        }
+    }
+    return nranges;
+}
+
+static int pack_ranges(pmix_data_buffer_t *buffer, pmix_rank_t *ranges, int32_t nranges)
+{
+    pmix_status_t rc;
+
+    rc = PMIx_Data_pack(NULL, buffer, &nranges, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    rc = PMIx_Data_pack(NULL, buffer, ranges, 2*nranges, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+static int unpack_ranges(pmix_data_buffer_t *buffer, pmix_rank_t **ranges, int32_t *nranges)
+{
+    pmix_status_t rc;
+    int32_t cnt;
+
+    *ranges = NULL;
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, nranges, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (*nranges <= 0) {
+        return PRTE_SUCCESS;
+    }
+    *ranges = (pmix_rank_t*)malloc(2 * (*nranges) * sizeof(pmix_rank_t));
+    if (NULL == *ranges) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    cnt = 2 * (*nranges);
+    rc = PMIx_Data_unpack(NULL, buffer, *ranges, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        free(*ranges);
+        *ranges = NULL;
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_plm_base_rollup_pack(pmix_data_buffer_t *buffer,
+                              prte_plm_rollup_t *rollup)
+{
+    pmix_status_t rc;
+    int32_t n, nsigs, nranges, nalias;
+    pmix_rank_t *ranges = NULL;
+    char **names = NULL, *prefix = NULL, *suffix = NULL;
+    pmix_byte_object_t *bos = NULL;
+    size_t plen, slen, len, minlen;
+    prte_plm_rollup_entry_t *e;
+    int ret = PRTE_SUCCESS;
+
+    rc = PMIx_Data_pack(NULL, buffer, &rollup->num_entries, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 == rollup->num_entries) {
+        return PRTE_SUCCESS;
+    }
+    qsort(rollup->entries, rollup->num_entries,
+          sizeof(prte_plm_rollup_entry_t), entry_cmp);
+
+    /* the vpid column */
+    ranges = (pmix_rank_t*)malloc(2 * rollup->num_entries * sizeof(pmix_rank_t));
+    names = (char**)calloc(rollup->num_entries, sizeof(char*));
+    bos = (pmix_byte_object_t*)malloc(rollup->num_entries * sizeof(pmix_byte_object_t));
+    if (NULL == ranges || NULL == names || NULL == bos) {
+        ret = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    nranges = get_ranges(rollup, -1, ranges);
+    if (PRTE_SUCCESS != (ret = pack_ranges(buffer, ranges, nranges))) {
+        goto cleanup;
+    }
+
+    /* the hostname column - node names generally differ only
+     * in their index, so strip the common prefix and suffix */
+    plen = strlen(rollup->entries[0].nodename);
+    slen = plen;
+    minlen = plen;
+    for (n=1; n < rollup->num_entries; n++) {
+        e = &rollup->entries[n];
+        len = strlen(e->nodename);
+        if (len < minlen) {
+            minlen = len;
+        }
+        for (len=0; len < plen && e->nodename[len] == rollup->entries[0].nodename[len]; len++);
+        plen = len;
+    }
+    if (plen > minlen) {
+        plen = minlen;
+    }
+    slen = minlen - plen;
+    for (n=0; n < rollup->num_entries && 0 < slen; n++) {
+        e = &rollup->entries[n];
+        len = strlen(e->nodename);
+        while (0 < slen &&
+               0 != strcmp(&e->nodename[len - slen],
+                           &rollup->entries[0].nodename[strlen(rollup->entries[0].nodename) - slen])) {
+            --slen;
+        }
+    }
+    prefix = strndup(rollup->entries[0].nodename, plen);
+    suffix = strdup(&rollup->entries[0].nodename[strlen(rollup->entries[0].nodename) - slen]);
+    for (n=0; n < rollup->num_entries; n++) {
+        e = &rollup->entries[n];
+        len = strlen(e->nodename);
+        names[n] = strndup(&e->nodename[plen], len - plen - slen);
+    }
+    rc = PMIx_Data_pack(NULL, buffer, &prefix, 1, PMIX_STRING);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buffer, &suffix, 1, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buffer, names, rollup->num_entries, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+
+    /* the signature dictionary */
+    nsigs = prte_argv_count(rollup->sigs);
+    rc = PMIx_Data_pack(NULL, buffer, &nsigs, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    for (n=0; n < nsigs; n++) {
+        rc = PMIx_Data_pack(NULL, buffer, &rollup->sigs[n], 1, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+        nranges = get_ranges(rollup, n, ranges);
+        if (PRTE_SUCCESS != (ret = pack_ranges(buffer, ranges, nranges))) {
+            goto cleanup;
+        }
+    }
+
+    /* aliases are rare, so only include those that have them */
+    nalias = 0;
+    for (n=0; n < rollup->num_entries; n++) {
+        if (NULL != rollup->entries[n].aliases) {
+            ++nalias;
+        }
+    }
+    rc = PMIx_Data_pack(NULL, buffer, &nalias, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    for (n=0; n < rollup->num_entries && 0 < nalias; n++) {
+        e = &rollup->entries[n];
+        if (NULL == e->aliases) {
+            continue;
+        }
+        rc = PMIx_Data_pack(NULL, buffer, &n, 1, PMIX_INT32);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buffer, &e->aliases, 1, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+    }
+
+    /* the connection info and inventory columns - the byte
+     * objects are shallow copies, so don't release them */
+    for (n=0; n < rollup->num_entries; n++) {
+        bos[n] = rollup->entries[n].uri;
+    }
+    rc = PMIx_Data_pack(NULL, buffer, bos, rollup->num_entries, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS == rc) {
+        for (n=0; n < rollup->num_entries; n++) {
+            bos[n] = rollup->entries[n].inventory;
+        }
+        rc = PMIx_Data_pack(NULL, buffer, bos, rollup->num_entries, PMIX_BYTE_OBJECT);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+
+    /* the topology, if we have it */
+    rc = PMIx_Data_pack(NULL, buffer, &rollup->topo_included, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS == rc && rollup->topo_included) {
+        rc = PMIx_Data_pack(NULL, buffer, &rollup->topo_compressed, 1, PMIX_BOOL);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buffer, &rollup->topo, 1, PMIX_BYTE_OBJECT);
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+    }
+
+  cleanup:
+    if (NULL != names) {
+        for (n=0; n < rollup->num_entries; n++) {
+            if (NULL != names[n]) {
+                free(names[n]);
+            }
+        }
+        free(names);
+    }
+    if (NULL != prefix) {
+        free(prefix);
+    }
+    if (NULL != suffix) {
+        free(suffix);
+    }
+    if (NULL != ranges) {
+        free(ranges);
+    }
+    if (NULL != bos) {
+        free(bos);
+    }
+    return ret;
+}
+
+int prte_plm_base_rollup_unpack(pmix_data_buffer_t *buffer,
+                                prte_plm_rollup_t *rollup)
+{
+    pmix_status_t rc;
+    int32_t n, m, k, cnt, num, nsigs, nranges, nalias, sig;
+    pmix_rank_t *ranges = NULL, vpid;
+    char **names = NULL, *prefix = NULL, *suffix = NULL, *str;
+    pmix_byte_object_t *bos = NULL;
+    prte_plm_rollup_entry_t *entries;
+    int ret = PRTE_SUCCESS;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &num, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 >= num) {
+        return PRTE_SUCCESS;
+    }
+    if (NULL == (entries = new_entries(rollup, num))) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    /* the entries are zero'd, so a partially-filled
+     * set is safe to release on error */
+
+    /* the vpid column */
+    if (PRTE_SUCCESS != (ret = unpack_ranges(buffer, &ranges, &nranges))) {
+        return ret;
+    }
+    k = 0;
+    for (n=0; n < nranges; n++) {
+        for (vpid=0; vpid < ranges[2*n+1]; vpid++) {
+            if (k == num) {
+                ret = PRTE_ERR_UNPACK_FAILURE;
+                PRTE_ERROR_LOG(ret);
+                goto cleanup;
+            }
+            entries[k++].vpid = ranges[2*n] + vpid;
+        }
+    }
+    free(ranges);
+    ranges = NULL;
+    if (k != num) {
+        ret = PRTE_ERR_UNPACK_FAILURE;
+        PRTE_ERROR_LOG(ret);
+        goto cleanup;
+    }
+
+    /* the hostname column */
+    names = (char**)calloc(num, sizeof(char*));
+    bos = (pmix_byte_object_t*)calloc(num, sizeof(pmix_byte_object_t));
+    if (NULL == names || NULL == bos) {
+        ret = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &prefix, &cnt, PMIX_STRING);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &suffix, &cnt, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = num;
+        rc = PMIx_Data_unpack(NULL, buffer, names, &cnt, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    for (n=0; n < num; n++) {
+        if (0 > prte_asprintf(&entries[n].nodename, "%s%s%s",
+                         (NULL == prefix) ? "" : prefix,
+                         (NULL == names[n]) ? "" : names[n],
+                         (NULL == suffix) ? "" : suffix)) {
+            entries[n].nodename = NULL;
+            ret = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+    }
+
+    /* the signature dictionary - translate the sender's
+     * indices into our own as we go */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nsigs, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    for (n=0; n < nsigs; n++) {
+        cnt = 1;
+        str = NULL;
+        rc = PMIx_Data_unpack(NULL, buffer, &str, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+        sig = sig_index(rollup, str);
+        free(str);
+        if (PRTE_SUCCESS != (ret = unpack_ranges(buffer, &ranges, &nranges))) {
+            goto cleanup;
+        }
+        /* the entries are sorted, so each range maps to
+         * a contiguous block of them */
+        for (m=0; m < nranges; m++) {
+            prte_plm_rollup_entry_t key, *e;
+            key.vpid = ranges[2*m];
+            e = (prte_plm_rollup_entry_t*)bsearch(&key, entries, num,
+                                                   sizeof(prte_plm_rollup_entry_t),
+                                                   entry_cmp);
+            if (NULL == e || (e - entries) + (int32_t)ranges[2*m+1] > num) {
+                ret = PRTE_ERR_UNPACK_FAILURE;
+                PRTE_ERROR_LOG(ret);
+                goto cleanup;
+            }
+            for (vpid=0; vpid < ranges[2*m+1]; vpid++) {
+                e[vpid].sig = sig;
+            }
+        }
+        free(ranges);
+        ranges = NULL;
+    }
+
+    /* the aliases */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nalias, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    for (n=0; n < nalias; n++) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &k, &cnt, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+        if (k < 0 || num <= k) {
+            ret = PRTE_ERR_UNPACK_FAILURE;
+            PRTE_ERROR_LOG(ret);
+            goto cleanup;
+        }
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &entries[k].aliases, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+    }
+
+    /* the connection info and inventory - ownership of
+     * the unpacked bytes passes to the entries */
+    cnt = num;
+    rc = PMIx_Data_unpack(NULL, buffer, bos, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    for (n=0; n < num; n++) {
+        entries[n].uri = bos[n];
+    }
+    memset(bos, 0, num * sizeof(pmix_byte_object_t));
+    cnt = num;
+    rc = PMIx_Data_unpack(NULL, buffer, bos, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    for (n=0; n < num; n++) {
+        entries[n].inventory = bos[n];
+    }
+
+    /* the topology */
+    {
+        bool included;
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &included, &cnt, PMIX_BOOL);
+        if (PMIX_SUCCESS == rc && included) {
+            if (rollup->topo_included) {
+                PMIX_BYTE_OBJECT_DESTRUCT(&rollup->topo);
+            }
+            rollup->topo_included = true;
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &rollup->topo_compressed, &cnt, PMIX_BOOL);
+            if (PMIX_SUCCESS == rc) {
+                cnt = 1;
+                rc = PMIx_Data_unpack(NULL, buffer, &rollup->topo, &cnt, PMIX_BYTE_OBJECT);
+            }
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = prte_pmix_convert_status(rc);
+        }
+    }
+
+  cleanup:
+    if (NULL != names) {
+        for (n=0; n < num; n++) {
+            if (NULL != names[n]) {
+                free(names[n]);
+            }
+        }
+        free(names);
+    }
+    if (NULL != prefix) {
+        free(prefix);
+    }
+    if (NULL != suffix) {
+        free(suffix);
+    }
+    if (NULL != ranges) {
+        free(ranges);
+    }
+    if (NULL != bos) {
+        free(bos);
+    }
+    return ret;
+}
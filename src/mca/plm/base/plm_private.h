@@ -38,6 +38,7 @@
 #include <sys/time.h>
 #endif  /* HAVE_SYS_TIME_H */
 
+#include "src/class/prte_hash_table.h"
 #include "src/class/prte_list.h"
 #include "src/class/prte_pointer_array.h"
 #include "src/mca/base/prte_mca_base_framework.h"
@@ -58,6 +59,11 @@ typedef struct {
     char *base_nspace;
     /* next jobid */
     uint32_t next_jobid;
+    /* cached "<base_nspace>@" prefix of our job nspaces */
+    char *nspace_prefix;
+    size_t nspace_prefix_len;
+    /* local jobids currently in use, keyed by jobid */
+    prte_hash_table_t *jobids;
     /* time when daemons started launch */
     struct timeval daemonlaunchstart;
     /* tree spawn cmd */
@@ -65,6 +71,8 @@ typedef struct {
     /* daemon nodes assigned at launch */
     bool daemon_nodes_assigned_at_launch;
     size_t node_regex_threshold;
+    /* number of idle nodes to pre-launch daemons on */
+    int prelaunch_daemons;
 } prte_plm_globals_t;
 /**
  * Global instance of PLM framework data
@@ -90,6 +98,57 @@ PRTE_EXPORT void prte_plm_base_daemon_topology(int status, pmix_proc_t* sender,
                                                  pmix_data_buffer_t *buffer,
                                                  prte_rml_tag_t tag, void *cbdata);
 
+/*
+ * Daemon callback rollups. Each daemon reports its contact info,
+ * nodename, aliases and topology signature on startup. Intermediate
+ * daemons merge the reports of their children into a single rollup
+ * that is sent up the tree in columnar form: vpids and signatures
+ * as ranges, hostnames relative to a common prefix/suffix, and the
+ * contact info and inventory blobs as one array each.
+ */
+typedef struct {
+    pmix_rank_t vpid;
+    char *nodename;
+    /* comma-delimited list of non-local aliases, NULL if none */
+    char *aliases;
+    /* index into the rollup's signature dictionary */
+    int32_t sig;
+    /* packed connection info and inventory - empty if not provided */
+    pmix_byte_object_t uri;
+    pmix_byte_object_t inventory;
+} prte_plm_rollup_entry_t;
+
+typedef struct {
+    prte_object_t super;
+    prte_plm_rollup_entry_t *entries;
+    int32_t num_entries;
+    int32_t size;
+    /* signature dictionary */
+    char **sigs;
+    /* topology reported by vpid=1, if included in this rollup */
+    bool topo_included;
+    bool topo_compressed;
+    pmix_byte_object_t topo;
+} prte_plm_rollup_t;
+PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_plm_rollup_t);
+
+/* add a daemon's report to the rollup - the contents of the
+ * provided byte objects are transferred to the rollup */
+PRTE_EXPORT int prte_plm_base_rollup_add(prte_plm_rollup_t *rollup,
+                                         pmix_rank_t vpid,
+                                         const char *nodename,
+                                         const char *aliases,
+                                         const char *sig,
+                                         pmix_byte_object_t *uri,
+                                         pmix_byte_object_t *inventory);
+PRTE_EXPORT int prte_plm_base_rollup_pack(pmix_data_buffer_t *buffer,
+                                          prte_plm_rollup_t *rollup);
+/* unpack a rollup from the buffer and merge it into the given one */
+PRTE_EXPORT int prte_plm_base_rollup_unpack(pmix_data_buffer_t *buffer,
+                                            prte_plm_rollup_t *rollup);
+PRTE_EXPORT prte_plm_rollup_entry_t* prte_plm_base_rollup_lookup(prte_plm_rollup_t *rollup,
+                                                                 pmix_rank_t vpid);
+
 PRTE_EXPORT int prte_plm_base_create_jobid(prte_job_t *jdata);
 PRTE_EXPORT int prte_plm_base_set_hnp_name(void);
 PRTE_EXPORT void prte_plm_base_reset_job(prte_job_t *jdata);
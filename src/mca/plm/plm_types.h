@@ -225,6 +225,7 @@ typedef uint8_t prte_plm_cmd_flag_t;
 #define PRTE_PLM_UPDATE_PROC_STATE      2
 #define PRTE_PLM_REGISTERED_CMD         3
 #define PRTE_PLM_ALLOC_JOBID_CMD        4
+#define PRTE_PLM_LAUNCH_JOBS_CMD        5
 
 END_C_DECLS
 
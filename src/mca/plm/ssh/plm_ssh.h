@@ -69,6 +69,9 @@ struct prte_plm_ssh_component_t {
     char *ssh_args;
     char *pass_libpath;
     char *chdir;
+    bool multiplex;
+    char *control_dir;
+    int control_persist;
 };
 typedef struct prte_plm_ssh_component_t prte_plm_ssh_component_t;
 
@@ -249,6 +249,36 @@ static int ssh_component_register(void)
                                                   PRTE_INFO_LVL_2,
                                                   PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                                   &prte_plm_ssh_component.chdir);
+
+    prte_plm_ssh_component.multiplex = false;
+    (void) prte_mca_base_component_var_register (c, "multiplex",
+                                                  "Reuse a persistent ssh master connection to each host (ControlMaster) "
+                                                  "across launches instead of performing a new handshake for every daemon",
+                                                  PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                                  PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                                  PRTE_INFO_LVL_4,
+                                                  PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                                  &prte_plm_ssh_component.multiplex);
+
+    prte_plm_ssh_component.control_dir = NULL;
+    (void) prte_mca_base_component_var_register (c, "control_dir",
+                                                  "Directory in which to place the ssh master connection sockets "
+                                                  "(default: the system temporary directory)",
+                                                  PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0,
+                                                  PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                                  PRTE_INFO_LVL_4,
+                                                  PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                                  &prte_plm_ssh_component.control_dir);
+
+    prte_plm_ssh_component.control_persist = 600;
+    (void) prte_mca_base_component_var_register (c, "control_persist",
+                                                  "Number of seconds an idle ssh master connection is kept open "
+                                                  "for reuse by later launches (0: until explicitly closed)",
+                                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                                  PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                                  PRTE_INFO_LVL_4,
+                                                  PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                                  &prte_plm_ssh_component.control_persist);
     return PRTE_SUCCESS;
 }
 
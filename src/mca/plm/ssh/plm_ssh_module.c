@@ -178,6 +178,7 @@ static int setup_shell(prte_plm_ssh_shell_t *sshell,
                        char *nodename, int *argc, char ***argv);
 static void launch_daemons(int fd, short args, void *cbdata);
 static void process_launch_list(int fd, short args, void *cbdata);
+static void add_multiplex_args(char ***argv);
 
 /* local global storage */
 static int num_in_progress=0;
@@ -234,6 +235,14 @@ static int ssh_init(void)
             PRTE_ERROR_LOG(rc);
             return rc;
         }
+        /* the shell probe uses the component's copy of the agent */
+        if (NULL != prte_plm_ssh_component.agent_argv &&
+            NULL != (tmp = prte_basename(prte_plm_ssh_component.agent_argv[0]))) {
+            if (0 == strcmp(tmp, "ssh")) {
+                add_multiplex_args(&prte_plm_ssh_component.agent_argv);
+            }
+            free(tmp);
+        }
     }
 
     /* point to our launch command */
@@ -934,6 +943,7 @@ static void process_launch_list(int fd, short args, void *cbdata)
     prte_list_item_t *item;
     pid_t pid;
     prte_plm_ssh_caddy_t *caddy;
+    struct timeval start;
 
     PRTE_ACQUIRE_OBJECT(caddy);
 
@@ -948,6 +958,14 @@ static void process_launch_list(int fd, short args, void *cbdata)
         PRTE_FLAG_SET(caddy->daemon, PRTE_PROC_FLAG_ALIVE);
         prte_wait_cb(caddy->daemon, ssh_wait_daemon, prte_event_base, (void*)caddy);
 
+        /* record the start so the time until the daemon
+         * calls back can be reported */
+        if (0 < prte_output_get_verbosity(prte_plm_base_framework.framework_output)) {
+            gettimeofday(&start, NULL);
+            prte_set_attribute(&caddy->daemon->attributes, PRTE_PROC_LAUNCH_START,
+                               PRTE_ATTR_LOCAL, &start, PMIX_TIMEVAL);
+        }
+
         /* fork a child to exec the ssh/ssh session */
         pid = fork();
         if (pid < 0) {
@@ -1451,6 +1469,7 @@ static int launch_agent_setup(const char *agent, char *path)
                 prte_argv_append_nosize(&ssh_agent_argv, "-x");
             }
         }
+        add_multiplex_args(&ssh_agent_argv);
     }
     if (NULL != bname) {
         free(bname);
@@ -1460,6 +1479,42 @@ static int launch_agent_setup(const char *agent, char *path)
     return PRTE_SUCCESS;
 }
 
+/*
+ * Have ssh share a persistent master connection to each host so
+ * that only the first session to a host pays for the handshake and
+ * authentication. The master stays up for control_persist seconds
+ * after its last session, so it is reused by later launches such as
+ * DVM expansions and restarts - and concurrent sessions to the same
+ * host are multiplexed over it.
+ */
+static void add_multiplex_args(char ***argv)
+{
+    char *param;
+    const char *dir;
+
+    if (!prte_plm_ssh_component.multiplex) {
+        return;
+    }
+    dir = prte_plm_ssh_component.control_dir;
+    if (NULL == dir) {
+        dir = prte_tmp_directory();
+    }
+    prte_argv_append_nosize(argv, "-o");
+    prte_argv_append_nosize(argv, "ControlMaster=auto");
+    prte_asprintf(&param, "ControlPath=%s/prte-ssh-%%C", dir);
+    prte_argv_append_nosize(argv, "-o");
+    prte_argv_append_nosize(argv, param);
+    free(param);
+    if (0 < prte_plm_ssh_component.control_persist) {
+        prte_asprintf(&param, "ControlPersist=%d", prte_plm_ssh_component.control_persist);
+    } else {
+        param = strdup("ControlPersist=yes");
+    }
+    prte_argv_append_nosize(argv, "-o");
+    prte_argv_append_nosize(argv, param);
+    free(param);
+}
+
 /**
  * Check the Shell variable and system type on the specified node
  */
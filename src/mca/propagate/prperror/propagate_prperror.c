@@ -392,22 +392,24 @@ static int prte_propagate_prperror(const pmix_nspace_t job,
     return PRTE_SUCCESS;
 }
 
+/* deliver an error received over the reliable broadcast. Returns
+ * PRTE_EXISTS if this error proc was already handled, in which case
+ * the message must not be forwarded any further */
 static int _prte_propagate_prperror(pmix_nspace_t job, pmix_proc_t *source,
-                pmix_proc_t *errorproc, prte_proc_state_t state, pmix_data_buffer_t* buffer,pmix_data_buffer_t* rly) {
+                pmix_proc_t *errorproc, prte_proc_state_t state, pmix_data_buffer_t* buffer) {
 
     int rc = PRTE_SUCCESS;
     /* don't need to check jobid because this can be different: daemon and process has different jobids */
 
     /* namelist for tracking error procs */
     prte_namelist_t *nmcheck, *nm;
-    nmcheck = PRTE_NEW(prte_namelist_t);
 
     PRTE_LIST_FOREACH(nmcheck, &prte_error_procs, prte_namelist_t){
         if (PMIX_CHECK_PROCID(&nmcheck->name, errorproc)) {
             PRTE_OUTPUT_VERBOSE((10, prte_propagate_base_framework.framework_output,
                                  "propagate: prperror: already propagated this msg: error proc is %s",
                                  PRTE_NAME_PRINT(errorproc)));
-            return rc;
+            return PRTE_EXISTS;
         }
     }
     PRTE_OUTPUT_VERBOSE((10, prte_propagate_base_framework.framework_output,
@@ -417,14 +419,8 @@ static int _prte_propagate_prperror(pmix_nspace_t job, pmix_proc_t *source,
     nm = PRTE_NEW(prte_namelist_t);
     PMIX_XFER_PROCID(&nm->name, errorproc);
     prte_list_append(&prte_error_procs, &(nm->super));
-    /* goes to all daemons */
-    prte_grpcomm_signature_t *sig;
-    sig = PRTE_NEW(prte_grpcomm_signature_t);
-    sig->signature = (pmix_proc_t*)malloc(sizeof(pmix_proc_t));
-    PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
-    if (PRTE_SUCCESS != (rc = prte_grpcomm.rbcast(sig, PRTE_RML_TAG_PROPAGATE, rly))) {
-        PRTE_ERROR_LOG(rc);
-    }
+    /* the grpcomm forwards the original message to the rest of the
+     * daemons when we return - no need to start a new broadcast */
 
     pmix_info_t *pinfo;
     int ret;
@@ -470,14 +466,6 @@ static int prte_propagate_prperror_recv(pmix_data_buffer_t* buffer)
     pmix_proc_t errorproc;
     int cbtype;
 
-    pmix_data_buffer_t rly;
-    PMIX_DATA_BUFFER_CONSTRUCT(&rly);
-
-    rc = PMIx_Data_copy_payload(&rly, buffer);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return false;
-    }
     /* get the cbtype */
     cnt=1;
     rc = PMIx_Data_unpack(NULL, buffer, &cbtype, &cnt, PMIX_INT);
@@ -503,6 +491,7 @@ static int prte_propagate_prperror_recv(pmix_data_buffer_t* buffer)
                 "%s propagete: prperror: daemon received %s gone forwarding with status %d",
                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&errorproc), state));
 
-    _prte_propagate_prperror(prte_process_info.myproc.nspace, NULL, &errorproc, state, buffer , &rly);
-    return false;
+    /* only forward errors we had not heard of yet */
+    rc = _prte_propagate_prperror(prte_process_info.myproc.nspace, NULL, &errorproc, state, buffer);
+    return (PRTE_EXISTS != rc);
 }
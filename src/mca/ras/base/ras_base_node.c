@@ -101,6 +101,7 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
                     free(hnp_node->name);
                 }
                 hnp_node->name = strdup("prte");
+                prte_node_index_names(hnp_node);
                 skiphnp = true;
                 PRTE_SET_MAPPING_DIRECTIVE(prte_rmaps_base.mapping, PRTE_MAPPING_NO_USE_LOCAL);
                 PRTE_FLAG_SET(hnp_node, PRTE_NODE_NON_USABLE);  // leave this node out of mapping operations
@@ -172,6 +173,7 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
                     ptr = prte_argv_join(alias, ',');
                     prte_set_attribute(&hnp_node->attributes, PRTE_NODE_ALIAS, PRTE_ATTR_LOCAL, ptr, PMIX_STRING);
                     free(ptr);
+                    prte_node_index_names(hnp_node);
                 }
                 prte_argv_free(alias);
             }
@@ -185,6 +187,7 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
                 }
                 PRTE_FLAG_UNSET(node, PRTE_NODE_FLAG_DAEMON_LAUNCHED);
                 node->index = prte_pointer_array_add(prte_node_pool, node);
+                prte_node_index_names(node);
             }
         } else {
             /* insert the object onto the prte_nodes global array */
@@ -205,6 +208,7 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
                 PRTE_ERROR_LOG(rc);
                 return rc;
             }
+            prte_node_index_names(node);
             if (prte_get_attribute(&djob->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
                 /* create a daemon for this node since we won't be launching
                  * and the mapper needs to see a daemon - this is used solely
@@ -233,6 +237,7 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
                     return rc;
                 }
                 nptr->index = prte_pointer_array_add(prte_node_pool, nptr);
+                prte_node_index_names(nptr);
             }
        }
     }
@@ -244,6 +249,7 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
     if (NULL != hnp_node && !prte_have_fqdn_allocation && !hnp_alone) {
         if (NULL != (ptr = strchr(hnp_node->name, '.'))) {
             *ptr = '\0';
+            prte_node_index_names(hnp_node);
         }
     }
 
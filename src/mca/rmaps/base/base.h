@@ -73,6 +73,10 @@ typedef struct {
     /* default file for use in sequential and rankfile mapping
      * when the directive comes thru MCA param */
     char *file;
+    /* number of threads to use when computing bindings */
+    int bind_threads;
+    /* max number of job maps to keep for reuse (0 => disabled) */
+    int map_cache_size;
 } prte_rmaps_base_t;
 
 /**
@@ -91,6 +95,46 @@ typedef struct {
 } prte_rmaps_base_selected_module_t;
 PRTE_CLASS_DECLARATION(prte_rmaps_base_selected_module_t);
 
+/**
+ * Cached map of a prior job, replayed when a new job presents the
+ * same fingerprint. The launch-message pieces that do not depend on
+ * the job's nspace are also kept here so they need not be regenerated.
+ */
+typedef struct {
+    prte_list_item_t super;
+    uint64_t hash;
+    pmix_byte_object_t fingerprint;
+    /* the most recent job to use this entry */
+    pmix_nspace_t nspace;
+    /* final policies */
+    prte_mapping_policy_t mapping;
+    prte_ranking_policy_t ranking;
+    prte_binding_policy_t binding;
+    bool oversubscribed;
+    /* pool index of the bookmark node, -1 if none */
+    int32_t bookmark;
+    pmix_rank_t num_procs;
+    int32_t num_apps;
+    pmix_rank_t *app_nprocs;
+    pmix_rank_t *app_first_rank;
+    /* pool index of each node in map order, the number of procs
+     * placed on it, and the ranks in the order they were placed */
+    int32_t num_nodes;
+    int32_t *nodes;
+    int32_t *node_nprocs;
+    pmix_rank_t *ranks;
+    /* app index and rank within its app of each rank */
+    prte_app_idx_t *apps;
+    pmix_rank_t *app_ranks;
+    /* launch-message pieces */
+    char *nodemap;
+    char *procmap;
+    pmix_data_buffer_t ppn;
+    bool ppn_valid;
+    size_t hits;
+} prte_rmaps_base_map_cache_t;
+PRTE_CLASS_DECLARATION(prte_rmaps_base_map_cache_t);
+
 /*
  * Map a job
  */
@@ -123,6 +167,14 @@ PRTE_EXPORT int prte_rmaps_base_set_ranking_policy(prte_job_t *jdata, char *spec
 
 PRTE_EXPORT void prte_rmaps_base_display_map(prte_job_t *jdata);
 
+/* map cache */
+PRTE_EXPORT void prte_rmaps_base_map_cache_init(void);
+PRTE_EXPORT void prte_rmaps_base_map_cache_finalize(void);
+PRTE_EXPORT bool prte_rmaps_base_map_cache_fingerprint(prte_job_t *jdata, pmix_byte_object_t *fp);
+PRTE_EXPORT bool prte_rmaps_base_map_cache_replay(prte_job_t *jdata, pmix_byte_object_t *fp);
+PRTE_EXPORT void prte_rmaps_base_map_cache_store(prte_job_t *jdata, pmix_byte_object_t *fp);
+PRTE_EXPORT prte_rmaps_base_map_cache_t* prte_rmaps_base_map_cache_get(const pmix_nspace_t nspace);
+
 END_C_DECLS
 
 #endif
@@ -32,6 +32,7 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#include <limits.h>
 
 #include "src/util/if.h"
 #include "src/util/output.h"
@@ -39,6 +40,8 @@
 #include "src/mca/base/base.h"
 #include "src/hwloc/hwloc-internal.h"
 #include "src/threads/tsd.h"
+#include "src/threads/threads.h"
+#include "src/sys/atomic.h"
 
 #include "types.h"
 #include "src/util/show_help.h"
@@ -68,6 +71,122 @@ static bool membind_warned=false;
  * topology itself untouched (critical!) and confine ourselves
  * to recording usage etc in the userdata object */
 
+/* Topologies are shared across all nodes that report the same
+ * signature, and so the userdata cannot be used to track usage
+ * when several nodes are being bound at the same time. The
+ * per-node binders therefore track usage in a private scratch
+ * object that is owned by the thread doing the work. Objects are
+ * indexed by their logical index at the depth being bound, which
+ * is all the binders ever need to count */
+typedef struct {
+    hwloc_cpuset_t available;
+    hwloc_cpuset_t totalcpuset;
+    prte_node_t *node;
+    int depth;
+    unsigned *usage;
+    unsigned nusage;
+    unsigned size;
+} bind_scratch_t;
+
+static void bind_scratch_init(bind_scratch_t *s)
+{
+    s->available = hwloc_bitmap_alloc();
+    s->totalcpuset = hwloc_bitmap_alloc();
+    s->node = NULL;
+    s->depth = INT_MIN;
+    s->usage = NULL;
+    s->nusage = 0;
+    s->size = 0;
+}
+
+static void bind_scratch_fini(bind_scratch_t *s)
+{
+    hwloc_bitmap_free(s->available);
+    hwloc_bitmap_free(s->totalcpuset);
+    if (NULL != s->usage) {
+        free(s->usage);
+    }
+}
+
+/* show_help is not thread safe, and only the first failure in
+ * map order may be reported, so the binders record the message
+ * here and the caller emits it once all the nodes are done */
+typedef struct {
+    const char *topic;
+    char *str[3];
+    int num[2];
+} bind_help_t;
+
+/* each node to be bound is tracked by one of these. The cpus
+ * available on the node are computed before the binders start
+ * as doing so writes to the userdata of the shared topology */
+typedef struct {
+    prte_node_t *node;
+    int depth;
+    hwloc_cpuset_t available;
+    bind_help_t help;
+    int rc;
+} bind_item_t;
+
+/* shared state for the binder threads */
+typedef struct {
+    prte_job_t *jdata;
+    bind_item_t *items;
+    int32_t nitems;
+    /* number of items to be bound - if a node failed its
+     * checks, it is recorded as the last item but not bound */
+    int32_t nbind;
+    bool in_place;
+    prte_atomic_int32_t next;
+    volatile bool abort;
+} bind_tracker_t;
+
+static void bind_help(bind_item_t *item, const char *topic,
+                      const char *s0, const char *s1, const char *s2,
+                      int n0, int n1)
+{
+    item->help.topic = topic;
+    item->help.str[0] = (NULL == s0) ? NULL : strdup(s0);
+    item->help.str[1] = (NULL == s1) ? NULL : strdup(s1);
+    item->help.str[2] = (NULL == s2) ? NULL : strdup(s2);
+    item->help.num[0] = n0;
+    item->help.num[1] = n1;
+}
+
+static void bind_help_show(bind_item_t *item)
+{
+    bind_help_t *h = &item->help;
+
+    if (NULL == h->topic) {
+        return;
+    }
+    if (0 == strcmp(h->topic, "rmaps:binding-overload")) {
+        prte_show_help("help-prte-rmaps-base.txt", h->topic, true,
+                       h->str[0], h->str[1], h->num[0], h->num[1]);
+    } else if (0 == strcmp(h->topic, "insufficient-cpus-per-proc")) {
+        prte_show_help("help-prte-rmaps-base.txt", h->topic, true,
+                       h->str[0], h->str[1], h->str[2], h->num[0]);
+    } else if (0 == strcmp(h->topic, "prte-rmaps-base:no-objects")) {
+        prte_show_help("help-prte-rmaps-base.txt", h->topic, true,
+                       h->str[0], h->str[1]);
+    } else {
+        prte_show_help("help-prte-rmaps-base.txt", h->topic, true, h->str[0]);
+    }
+}
+
+static void bind_item_fini(bind_item_t *item)
+{
+    int n;
+
+    if (NULL != item->available) {
+        hwloc_bitmap_free(item->available);
+    }
+    for (n=0; n < 3; n++) {
+        if (NULL != item->help.str[n]) {
+            free(item->help.str[n]);
+        }
+    }
+}
 
 static void reset_usage(prte_node_t *node, pmix_nspace_t jobid)
 {
@@ -126,6 +245,49 @@ static void reset_usage(prte_node_t *node, pmix_nspace_t jobid)
     }
 }
 
+/* equivalent of reset_usage, but counting into the scratch
+ * usage table for the objects at the given depth */
+static void reset_scratch_usage(bind_scratch_t *s, prte_node_t *node,
+                                pmix_nspace_t jobid, int depth)
+{
+    int j;
+    unsigned n;
+    prte_proc_t *proc;
+    hwloc_obj_t bound;
+
+    n = hwloc_get_nbobjs_by_depth(node->topology->topo, depth);
+    if (s->size < n) {
+        s->usage = (unsigned*)realloc(s->usage, n * sizeof(unsigned));
+        s->size = n;
+    }
+    memset(s->usage, 0, n * sizeof(unsigned));
+    s->nusage = n;
+    s->node = node;
+    s->depth = depth;
+
+    for (j=0; j < node->procs->size; j++) {
+        if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
+            continue;
+        }
+        /* ignore procs from this job */
+        if (PMIX_CHECK_NSPACE(proc->name.nspace, jobid)) {
+            continue;
+        }
+        bound = NULL;
+        if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND, (void**)&bound, PMIX_POINTER) ||
+            NULL == bound) {
+            continue;
+        }
+        /* only objects at the target depth can ever be compared */
+        if ((int)bound->depth != depth || n <= bound->logical_index) {
+            continue;
+        }
+        s->usage[bound->logical_index]++;
+    }
+}
+
+#define BIND_USAGE(s, obj)  ((s)->usage[(obj)->logical_index])
+
 static void unbind_procs(prte_job_t *jdata)
 {
     int j;
@@ -140,54 +302,46 @@ static void unbind_procs(prte_job_t *jdata)
     }
 }
 
+/* Bind the procs of this job on the item's node downwards to objects
+ * at the item's depth. This may be executed concurrently for different
+ * nodes, and so it must not touch anything other than the item, its
+ * node and procs, and the provided scratch space - the topology is
+ * only read. A return of PRTE_ERR_NOT_BOUND
+ * indicates that we couldn't meet the default binding policy and
+ * the caller should revert the job to not being bound */
 static int bind_generic(prte_job_t *jdata,
-                        prte_node_t *node,
-                        int target_depth)
+                        bind_item_t *item,
+                        bind_scratch_t *scratch)
 {
     int j;
     prte_job_map_t *map;
     prte_proc_t *proc;
     hwloc_obj_t trg_obj, tmp_obj, nxt_obj;
     unsigned int ncpus;
-    prte_hwloc_obj_data_t *data;
     int total_cpus, cpus_per_rank;
-    hwloc_cpuset_t totalcpuset, available, mycpus;
+    hwloc_cpuset_t totalcpuset, available;
     hwloc_obj_t locale;
     char *cpu_bitmap, *job_cpuset;
     unsigned min_bound;
-    bool dobind, use_hwthread_cpus;
-    struct hwloc_topology_support *support;
-    hwloc_obj_t root;
-    prte_hwloc_topo_data_t *rdata;
+    bool use_hwthread_cpus;
+    prte_node_t *node = item->node;
+    int target_depth = item->depth;
     uint16_t u16, *u16ptr = &u16;
 
     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                        "mca:rmaps: bind downward for job %s with bindings %s",
-                        PRTE_JOBID_PRINT(jdata->nspace),
+                        "mca:rmaps: bind downward for job %s on node %s with bindings %s",
+                        PRTE_JOBID_PRINT(jdata->nspace), node->name,
                         prte_hwloc_base_print_binding(jdata->map->binding));
     /* initialize */
     map = jdata->map;
-    totalcpuset = hwloc_bitmap_alloc();
+    totalcpuset = scratch->totalcpuset;
+    available = scratch->available;
 
-    dobind = false;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PMIX_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PMIX_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PMIX_BOOL)) {
-        dobind = true;
-    }
     /* reset usage */
-    reset_usage(node, jdata->nspace);
+    reset_scratch_usage(scratch, node, jdata->nspace, target_depth);
 
     /* get the available processors on this node */
-    root = hwloc_get_root_obj(node->topology->topo);
-    if (NULL == root->userdata) {
-        /* incorrect */
-        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-        return PRTE_ERR_BAD_PARAM;
-    }
-    rdata = (prte_hwloc_topo_data_t*)root->userdata;
-    available = hwloc_bitmap_dup(rdata->available);
+    hwloc_bitmap_copy(available, item->available);
 
     /* see if they want multiple cpus/rank */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PMIX_UINT16)) {
@@ -203,16 +357,13 @@ static int bind_generic(prte_job_t *jdata,
         use_hwthread_cpus = false;
     }
 
-    /* see if this job has a "soft" cgroup assignment */
+    /* see if this job has a "soft" cgroup assignment - the
+     * available cpus have already been filtered against it */
     job_cpuset = NULL;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PMIX_STRING) &&
-        NULL != job_cpuset) {
-        mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
-        hwloc_bitmap_and(available, mycpus, available);
-        hwloc_bitmap_free(mycpus);
-    }
+    prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PMIX_STRING);
 
-    /* cycle thru the procs */
+    /* cycle thru the procs - the caller has already checked
+     * that this node supports the requested binding */
     for (j=0; j < node->procs->size; j++) {
         if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
             continue;
@@ -221,68 +372,12 @@ static int bind_generic(prte_job_t *jdata,
         if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
             continue;
         }
-        if ((int)PRTE_PROC_MY_NAME->rank != node->index && !dobind) {
-            continue;
-        }
-
-        if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
-            /* if we don't want to launch, then we are just testing the system,
-             * so ignore questions about support capabilities
-             */
-            support = (struct hwloc_topology_support*)hwloc_topology_get_support(node->topology->topo);
-            /* check if topology supports cpubind - have to be careful here
-             * as Linux doesn't currently support thread-level binding. This
-             * may change in the future, though, and it isn't clear how hwloc
-             * interprets the current behavior. So check both flags to be sure.
-             */
-            if (!support->cpubind->set_thisproc_cpubind &&
-                !support->cpubind->set_thisthread_cpubind) {
-                if (!PRTE_BINDING_REQUIRED(map->binding) ||
-                    !PRTE_BINDING_POLICY_IS_SET(map->binding)) {
-                    /* we are not required to bind, so ignore this */
-                    continue;
-                }
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
-                hwloc_bitmap_free(totalcpuset);
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
-            }
-            /* check if topology supports membind - have to be careful here
-             * as hwloc treats this differently than I (at least) would have
-             * expected. Per hwloc, Linux memory binding is at the thread,
-             * and not process, level. Thus, hwloc sets the "thisproc" flag
-             * to "false" on all Linux systems, and uses the "thisthread" flag
-             * to indicate binding capability - don't warn if the user didn't
-             * specifically request binding
-             */
-            if (!support->membind->set_thisproc_membind &&
-                !support->membind->set_thisthread_membind &&
-                PRTE_BINDING_POLICY_IS_SET(map->binding)) {
-                if (PRTE_HWLOC_BASE_MBFA_WARN == prte_hwloc_base_mbfa && !membind_warned) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported", true, node->name);
-                    membind_warned = true;
-                } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
-                    return PRTE_ERR_SILENT;
-                }
-            }
-        }
 
         /* bozo check */
         locale = NULL;
         if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&locale, PMIX_POINTER) ||
             NULL == locale) {
-            prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-locale", true, PRTE_NAME_PRINT(&proc->name));
-            hwloc_bitmap_free(totalcpuset);
-            hwloc_bitmap_free(available);
+            bind_help(item, "rmaps:no-locale", PRTE_NAME_PRINT(&proc->name), NULL, NULL, 0, 0);
             if (NULL != job_cpuset) {
                 free(job_cpuset);
             }
@@ -301,21 +396,14 @@ static int bind_generic(prte_job_t *jdata,
             if (!hwloc_bitmap_intersects(available, tmp_obj->cpuset))
                 continue;
 
-            data = (prte_hwloc_obj_data_t*)tmp_obj->userdata;
-            if (NULL == data) {
-                data = PRTE_NEW(prte_hwloc_obj_data_t);
-                tmp_obj->userdata = data;
-            }
-            if (data->num_bound < min_bound) {
-                min_bound = data->num_bound;
+            if (BIND_USAGE(scratch, tmp_obj) < min_bound) {
+                min_bound = BIND_USAGE(scratch, tmp_obj);
                 trg_obj = tmp_obj;
             }
         }
         if (NULL == trg_obj) {
             /* there aren't any such targets under this object */
-            prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
-            hwloc_bitmap_free(totalcpuset);
-            hwloc_bitmap_free(available);
+            bind_help(item, "rmaps:no-available-cpus", node->name, NULL, NULL, 0, 0);
             if (NULL != job_cpuset) {
                 free(job_cpuset);
             }
@@ -331,9 +419,7 @@ static int bind_generic(prte_job_t *jdata,
         do {
             if (NULL == nxt_obj) {
                 /* could not find enough cpus to meet request */
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
-                hwloc_bitmap_free(totalcpuset);
-                hwloc_bitmap_free(available);
+                bind_help(item, "rmaps:no-available-cpus", node->name, NULL, NULL, 0, 0);
                 if (NULL != job_cpuset) {
                     free(job_cpuset);
                 }
@@ -344,26 +430,20 @@ static int bind_generic(prte_job_t *jdata,
             ncpus = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
                                               available, trg_obj);
             /* track the number bound */
-            if (NULL == (data = (prte_hwloc_obj_data_t*)trg_obj->userdata)) {
-                data = PRTE_NEW(prte_hwloc_obj_data_t);
-                trg_obj->userdata = data;
-            }
-            data->num_bound++;
+            BIND_USAGE(scratch, trg_obj)++;
             /* error out if adding a proc would cause overload and that wasn't allowed,
              * and it wasn't a default binding policy (i.e., the user requested it)
              */
-            if (ncpus < data->num_bound &&
+            if (ncpus < BIND_USAGE(scratch, trg_obj) &&
                 !PRTE_BIND_OVERLOAD_ALLOWED(jdata->map->binding)) {
                 if (PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
                     /* if the user specified a binding policy, then we cannot meet
                      * it since overload isn't allowed, so error out - have the
                      * message indicate that setting overload allowed will remove
                      * this restriction */
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:binding-overload", true,
-                                   prte_hwloc_base_print_binding(map->binding), node->name,
-                                   data->num_bound, ncpus);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
+                    bind_help(item, "rmaps:binding-overload",
+                              prte_hwloc_base_print_binding(map->binding), node->name, NULL,
+                              BIND_USAGE(scratch, trg_obj), ncpus);
                     if (NULL != job_cpuset) {
                         free(job_cpuset);
                     }
@@ -372,11 +452,10 @@ static int bind_generic(prte_job_t *jdata,
                     /* if the user specified cpus/proc, then we weren't able
                      * to meet that request - this constitutes an error that
                      * must be reported */
-                    prte_show_help("help-prte-rmaps-base.txt", "insufficient-cpus-per-proc", true,
-                                   prte_hwloc_base_print_binding(map->binding), node->name,
-                                   (NULL != job_cpuset) ? job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
-                                   cpus_per_rank);
-                    hwloc_bitmap_free(available);
+                    bind_help(item, "insufficient-cpus-per-proc",
+                              prte_hwloc_base_print_binding(map->binding), node->name,
+                              (NULL != job_cpuset) ? job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
+                              cpus_per_rank, 0);
                     if (NULL != job_cpuset) {
                         free(job_cpuset);
                     }
@@ -386,14 +465,10 @@ static int bind_generic(prte_job_t *jdata,
                     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                                         "%s NOT ENOUGH CPUS TO COMPLETE BINDING - BINDING NOT REQUIRED, REVERTING TO NOT BINDING",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                    PRTE_SET_BINDING_POLICY(map->binding, PRTE_BIND_TO_NONE);
-                    unbind_procs(jdata);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
                     if (NULL != job_cpuset) {
                         free(job_cpuset);
                     }
-                    return PRTE_SUCCESS;
+                    return PRTE_ERR_NOT_BOUND;
                 }
             }
             /* bind the proc here */
@@ -422,8 +497,6 @@ static int bind_generic(prte_job_t *jdata,
             free(tmp1);
         }
     }
-    hwloc_bitmap_free(totalcpuset);
-    hwloc_bitmap_free(available);
     if (NULL != job_cpuset) {
         free(job_cpuset);
     }
@@ -431,45 +504,37 @@ static int bind_generic(prte_job_t *jdata,
     return PRTE_SUCCESS;
 }
 
+/* Traverse the hwloc topology tree on the given node downwards
+ * until we find an unused object at the depth where the procs
+ * were mapped - and then bind the process to that object. As with
+ * bind_generic, this may be executed concurrently for different
+ * nodes and returns PRTE_ERR_NOT_BOUND if the default binding
+ * policy cannot be met */
 static int bind_in_place(prte_job_t *jdata,
-                         hwloc_obj_type_t target,
-                         unsigned cache_level)
+                         bind_item_t *item,
+                         bind_scratch_t *scratch)
 {
-    /* traverse the hwloc topology tree on each node downwards
-     * until we find an unused object of type target - and then bind
-     * the process to that target
-     */
-    int i, j;
+    int j;
     prte_job_map_t *map;
-    prte_node_t *node;
     prte_proc_t *proc;
-    unsigned int idx, ncpus;
-    struct hwloc_topology_support *support;
-    prte_hwloc_obj_data_t *data;
+    unsigned int ncpus;
     hwloc_obj_t locale, sib;
     char *cpu_bitmap, *job_cpuset;
     bool found, use_hwthread_cpus;
-    bool dobind;
     int cpus_per_rank;
-    hwloc_cpuset_t available, mycpus;
-    hwloc_obj_t root;
-    prte_hwloc_topo_data_t *rdata;
+    hwloc_cpuset_t available;
+    prte_node_t *node = item->node;
     uint16_t u16, *u16ptr = &u16;
 
     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                        "mca:rmaps: bind in place for job %s with bindings %s",
-                        PRTE_JOBID_PRINT(jdata->nspace),
+                        "mca:rmaps: bind in place for job %s on node %s with bindings %s",
+                        PRTE_JOBID_PRINT(jdata->nspace), node->name,
                         prte_hwloc_base_print_binding(jdata->map->binding));
     /* initialize */
     map = jdata->map;
-
-    dobind = false;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PMIX_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PMIX_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PMIX_BOOL)) {
-        dobind = true;
-    }
+    available = scratch->available;
+    /* force the usage to be reset for this node */
+    scratch->node = NULL;
 
     /* see if this job has a "soft" cgroup assignment */
     job_cpuset = NULL;
@@ -489,258 +554,138 @@ static int bind_in_place(prte_job_t *jdata,
         use_hwthread_cpus = false;
     }
 
-    for (i=0; i < map->nodes->size; i++) {
-        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(map->nodes, i))) {
+    /* get the available processors on this node */
+    hwloc_bitmap_copy(available, item->available);
+    /* cycle thru the procs */
+    for (j=0; j < node->procs->size; j++) {
+        if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
             continue;
         }
-        if ((int)PRTE_PROC_MY_NAME->rank != node->index && !dobind) {
+        /* ignore procs from other jobs */
+        if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
             continue;
         }
-        if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
-            /* if we don't want to launch, then we are just testing the system,
-             * so ignore questions about support capabilities
-             */
-            support = (struct hwloc_topology_support*)hwloc_topology_get_support(node->topology->topo);
-            /* check if topology supports cpubind - have to be careful here
-             * as Linux doesn't currently support thread-level binding. This
-             * may change in the future, though, and it isn't clear how hwloc
-             * interprets the current behavior. So check both flags to be sure.
-             */
-            if (!support->cpubind->set_thisproc_cpubind &&
-                !support->cpubind->set_thisthread_cpubind) {
-                if (!PRTE_BINDING_REQUIRED(map->binding) ||
-                    !PRTE_BINDING_POLICY_IS_SET(map->binding)) {
-                    /* we are not required to bind, so ignore this */
-                    continue;
-                }
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
-            }
-            /* check if topology supports membind - have to be careful here
-             * as hwloc treats this differently than I (at least) would have
-             * expected. Per hwloc, Linux memory binding is at the thread,
-             * and not process, level. Thus, hwloc sets the "thisproc" flag
-             * to "false" on all Linux systems, and uses the "thisthread" flag
-             * to indicate binding capability - don't warn if the user didn't
-             * specifically request binding
-             */
-            if (!support->membind->set_thisproc_membind &&
-                !support->membind->set_thisthread_membind &&
-                PRTE_BINDING_POLICY_IS_SET(map->binding)) {
-                if (PRTE_HWLOC_BASE_MBFA_WARN == prte_hwloc_base_mbfa && !membind_warned) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported", true, node->name);
-                    membind_warned = true;
-                } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
-                    return PRTE_ERR_SILENT;
-                }
+        /* bozo check */
+        locale = NULL;
+        if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&locale, PMIX_POINTER) ||
+            NULL == locale) {
+            bind_help(item, "rmaps:no-locale", PRTE_NAME_PRINT(&proc->name), NULL, NULL, 0, 0);
+            if (NULL != job_cpuset) {
+                free(job_cpuset);
             }
+            return PRTE_ERR_SILENT;
         }
-
-        /* some systems do not report cores, and so we can get a situation where our
-         * default binding policy will fail for no necessary reason. So if we are
-         * computing a binding due to our default policy, and no cores are found
-         * on this node, just silently skip it - we will not bind
-         */
-        if (!PRTE_BINDING_POLICY_IS_SET(map->binding) &&
-            HWLOC_TYPE_DEPTH_UNKNOWN == hwloc_get_type_depth(node->topology->topo, HWLOC_OBJ_CORE)) {
-            prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                "Unable to bind-to core by default on node %s as no cores detected",
-                                node->name);
-            continue;
+        /* all procs on a node were mapped to the same type of
+         * object, so we only need to reset the usage once */
+        if (scratch->node != node || scratch->depth != (int)locale->depth) {
+            reset_scratch_usage(scratch, node, jdata->nspace, locale->depth);
         }
-
-        /* we share topologies in order
-         * to save space, so we need to reset the usage info to reflect
-         * our own current state
-         */
-        reset_usage(node, jdata->nspace);
-        /* get the available processors on this node */
-        root = hwloc_get_root_obj(node->topology->topo);
-        if (NULL == root->userdata) {
-            /* incorrect */
-            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        /* get the number of cpus under this location */
+        if (0 == (ncpus = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
+                                                    available, locale))) {
+            bind_help(item, "rmaps:no-available-cpus", node->name, NULL, NULL, 0, 0);
             if (NULL != job_cpuset) {
                 free(job_cpuset);
             }
-            return PRTE_ERR_BAD_PARAM;
-        }
-        rdata = (prte_hwloc_topo_data_t*)root->userdata;
-        available = hwloc_bitmap_dup(rdata->available);
-        if (NULL != job_cpuset) {
-            mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
-            hwloc_bitmap_and(available, mycpus, available);
-            hwloc_bitmap_free(mycpus);
+            return PRTE_ERR_SILENT;
         }
-        /* cycle thru the procs */
-        for (j=0; j < node->procs->size; j++) {
-            if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
-                continue;
-            }
-            /* ignore procs from other jobs */
-            if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
-                continue;
-            }
-            /* bozo check */
-            locale = NULL;
-            if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&locale, PMIX_POINTER)) {
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-locale", true, PRTE_NAME_PRINT(&proc->name));
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
-            }
-            /* get the index of this location */
-            if (UINT_MAX == (idx = prte_hwloc_base_get_obj_idx(node->topology->topo, locale))) {
-                PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
-            }
-            /* get the number of cpus under this location */
-            if (0 == (ncpus = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
-                                                        available, locale))) {
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
+        /* if we don't have enough cpus to support this additional proc, try
+         * shifting the location to a cousin that can support it - the important
+         * thing is that we maintain the same level in the topology */
+        if (ncpus < (BIND_USAGE(scratch, locale)+cpus_per_rank)) {
+            prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                                "%s bind_in_place: searching right",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+            sib = locale;
+            found = false;
+            while (NULL != (sib = sib->next_cousin)) {
+                ncpus = prte_hwloc_base_get_npus(node->topology->topo,
+                                                  use_hwthread_cpus,
+                                                  available, sib);
+                if ((BIND_USAGE(scratch, sib)+cpus_per_rank) <= ncpus) {
+                    found = true;
+                    locale = sib;
+                    break;
                 }
-                return PRTE_ERR_SILENT;
-            }
-            data = (prte_hwloc_obj_data_t*)locale->userdata;
-            if (NULL == data) {
-                data = PRTE_NEW(prte_hwloc_obj_data_t);
-                locale->userdata = data;
             }
-            /* if we don't have enough cpus to support this additional proc, try
-             * shifting the location to a cousin that can support it - the important
-             * thing is that we maintain the same level in the topology */
-            if (ncpus < (data->num_bound+cpus_per_rank)) {
+            if (!found) {
+                /* try the other direction */
                 prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                    "%s bind_in_place: searching right",
+                                    "%s bind_in_place: searching left",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
                 sib = locale;
-                found = false;
-                while (NULL != (sib = sib->next_cousin)) {
+                while (NULL != (sib = sib->prev_cousin)) {
                     ncpus = prte_hwloc_base_get_npus(node->topology->topo,
                                                       use_hwthread_cpus,
                                                       available, sib);
-                    data = (prte_hwloc_obj_data_t*)sib->userdata;
-                    if (NULL == data) {
-                        data = PRTE_NEW(prte_hwloc_obj_data_t);
-                        sib->userdata = data;
-                    }
-                    if ((data->num_bound+cpus_per_rank) <= ncpus) {
+                    if ((BIND_USAGE(scratch, sib)+cpus_per_rank) <= ncpus) {
                         found = true;
                         locale = sib;
                         break;
                     }
                 }
-                if (!found) {
-                    /* try the other direction */
-                    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                        "%s bind_in_place: searching left",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                    sib = locale;
-                    while (NULL != (sib = sib->prev_cousin)) {
-                        ncpus = prte_hwloc_base_get_npus(node->topology->topo,
-                                                          use_hwthread_cpus,
-                                                          available, sib);
-                        data = (prte_hwloc_obj_data_t*)sib->userdata;
-                        if (NULL == data) {
-                            data = PRTE_NEW(prte_hwloc_obj_data_t);
-                            sib->userdata = data;
+            }
+            if (!found) {
+                /* no place to put this - see if overload is allowed */
+                if (!PRTE_BIND_OVERLOAD_ALLOWED(jdata->map->binding)) {
+                    if (PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
+                        /* if the user specified a binding policy, then we cannot meet
+                         * it since overload isn't allowed, so error out - have the
+                         * message indicate that setting overload allowed will remove
+                         * this restriction */
+                        bind_help(item, "rmaps:binding-overload",
+                                  prte_hwloc_base_print_binding(map->binding), node->name, NULL,
+                                  BIND_USAGE(scratch, locale), ncpus);
+                        if (NULL != job_cpuset) {
+                            free(job_cpuset);
                         }
-                        if ((data->num_bound+cpus_per_rank) <= ncpus) {
-                            found = true;
-                            locale = sib;
-                            break;
+                        return PRTE_ERR_SILENT;
+                    } else if (1 < cpus_per_rank) {
+                        /* if the user specified cpus/proc, then we weren't able
+                         * to meet that request - this constitutes an error that
+                         * must be reported */
+                        bind_help(item, "insufficient-cpus-per-proc",
+                                  prte_hwloc_base_print_binding(map->binding), node->name,
+                                  (NULL != job_cpuset) ? job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
+                                  cpus_per_rank, 0);
+                        if (NULL != job_cpuset) {
+                            free(job_cpuset);
                         }
-                    }
-                }
-                if (!found) {
-                    /* no place to put this - see if overload is allowed */
-                    if (!PRTE_BIND_OVERLOAD_ALLOWED(jdata->map->binding)) {
-                        if (PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
-                            /* if the user specified a binding policy, then we cannot meet
-                             * it since overload isn't allowed, so error out - have the
-                             * message indicate that setting overload allowed will remove
-                             * this restriction */
-                            prte_show_help("help-prte-rmaps-base.txt", "rmaps:binding-overload", true,
-                                           prte_hwloc_base_print_binding(map->binding), node->name,
-                                           data->num_bound, ncpus);
-                            hwloc_bitmap_free(available);
-                            if (NULL != job_cpuset) {
-                                free(job_cpuset);
-                            }
-                            return PRTE_ERR_SILENT;
-                        } else if (1 < cpus_per_rank) {
-                            /* if the user specified cpus/proc, then we weren't able
-                             * to meet that request - this constitutes an error that
-                             * must be reported */
-                            prte_show_help("help-prte-rmaps-base.txt", "insufficient-cpus-per-proc", true,
-                                           prte_hwloc_base_print_binding(map->binding), node->name,
-                                           (NULL != job_cpuset) ? job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
-                                           cpus_per_rank);
-                            hwloc_bitmap_free(available);
-                            if (NULL != job_cpuset) {
-                                free(job_cpuset);
-                            }
-                            return PRTE_ERR_SILENT;
-                        } else {
-                            /* if we have the default binding policy, then just don't bind */
-                            prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                                "%s NOT ENOUGH CPUS TO COMPLETE BINDING - BINDING NOT REQUIRED, REVERTING TO NOT BINDING",
-                                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                            unbind_procs(jdata);
-                            hwloc_bitmap_free(available);
-                            if (NULL != job_cpuset) {
-                                free(job_cpuset);
-                            }
-                           return PRTE_SUCCESS;
+                        return PRTE_ERR_SILENT;
+                    } else {
+                        /* if we have the default binding policy, then just don't bind */
+                        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                                            "%s NOT ENOUGH CPUS TO COMPLETE BINDING - BINDING NOT REQUIRED, REVERTING TO NOT BINDING",
+                                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+                        if (NULL != job_cpuset) {
+                            free(job_cpuset);
                         }
+                        return PRTE_ERR_NOT_BOUND;
                     }
                 }
             }
-            /* track the number bound */
-            data = (prte_hwloc_obj_data_t*)locale->userdata;  // just in case it changed
-            if (NULL == data) {
-                data = PRTE_NEW(prte_hwloc_obj_data_t);
-                locale->userdata = data;
-            }
-            data->num_bound++;
-            prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                "BINDING PROC %s TO %s NUMBER %u",
-                                PRTE_NAME_PRINT(&proc->name),
-                                hwloc_obj_type_string(locale->type), idx);
-            /* bind the proc here, masking it to any "soft" cgroup the user provided */
-            mycpus = hwloc_bitmap_alloc();
-            hwloc_bitmap_and(mycpus, available, locale->cpuset);
-            hwloc_bitmap_list_asprintf(&cpu_bitmap, mycpus);
-            hwloc_bitmap_free(mycpus);
-            prte_set_attribute(&proc->attributes, PRTE_PROC_CPU_BITMAP, PRTE_ATTR_GLOBAL, cpu_bitmap, PMIX_STRING);
-            /* update the location, in case it changed */
-            prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND, PRTE_ATTR_LOCAL, locale, PMIX_POINTER);
-            prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                "%s BOUND PROC %s TO %s[%s:%u] on node %s",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                PRTE_NAME_PRINT(&proc->name),
-                                cpu_bitmap, hwloc_obj_type_string(locale->type),
-                                idx, node->name);
-            if (NULL != cpu_bitmap) {
-                free(cpu_bitmap);
-            }
         }
-        hwloc_bitmap_free(available);
+        /* track the number bound */
+        BIND_USAGE(scratch, locale)++;
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "BINDING PROC %s TO %s NUMBER %u",
+                            PRTE_NAME_PRINT(&proc->name),
+                            hwloc_obj_type_string(locale->type), locale->logical_index);
+        /* bind the proc here, masking it to any "soft" cgroup the user provided */
+        hwloc_bitmap_and(scratch->totalcpuset, available, locale->cpuset);
+        hwloc_bitmap_list_asprintf(&cpu_bitmap, scratch->totalcpuset);
+        prte_set_attribute(&proc->attributes, PRTE_PROC_CPU_BITMAP, PRTE_ATTR_GLOBAL, cpu_bitmap, PMIX_STRING);
+        /* update the location, in case it changed */
+        prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND, PRTE_ATTR_LOCAL, locale, PMIX_POINTER);
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "%s BOUND PROC %s TO %s[%s:%u] on node %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&proc->name),
+                            cpu_bitmap, hwloc_obj_type_string(locale->type),
+                            locale->logical_index, node->name);
+        if (NULL != cpu_bitmap) {
+            free(cpu_bitmap);
+        }
     }
     if (NULL != job_cpuset) {
         free(job_cpuset);
@@ -749,6 +694,7 @@ static int bind_in_place(prte_job_t *jdata,
     return PRTE_SUCCESS;
 }
 
+
 static int bind_to_cpuset(prte_job_t *jdata)
 {
     /* bind each process to prte_hwloc_base_cpu_list */
@@ -928,6 +874,179 @@ static int bind_to_cpuset(prte_job_t *jdata)
     return PRTE_SUCCESS;
 }
 
+/* check that the given node supports the binding we need to
+ * compute. Returns PRTE_SUCCESS if the node is to be bound,
+ * PRTE_ERR_TAKE_NEXT_OPTION if the node is to be skipped,
+ * or an error - in which case the message to report is
+ * recorded in the item */
+static int check_node(prte_job_t *jdata, bind_item_t *item)
+{
+    prte_node_t *node = item->node;
+    struct hwloc_topology_support *support;
+
+    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
+        /* if we don't want to launch, then we are just testing the system,
+         * so ignore questions about support capabilities
+         */
+        support = (struct hwloc_topology_support*)hwloc_topology_get_support(node->topology->topo);
+        /* check if topology supports cpubind - have to be careful here
+         * as Linux doesn't currently support thread-level binding. This
+         * may change in the future, though, and it isn't clear how hwloc
+         * interprets the current behavior. So check both flags to be sure.
+         */
+        if (!support->cpubind->set_thisproc_cpubind &&
+            !support->cpubind->set_thisthread_cpubind) {
+            if (!PRTE_BINDING_REQUIRED(jdata->map->binding) ||
+                !PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
+                /* we are not required to bind, so ignore this */
+                return PRTE_ERR_TAKE_NEXT_OPTION;
+            }
+            bind_help(item, "rmaps:cpubind-not-supported", node->name, NULL, NULL, 0, 0);
+            return PRTE_ERR_SILENT;
+        }
+        /* check if topology supports membind - have to be careful here
+         * as hwloc treats this differently than I (at least) would have
+         * expected. Per hwloc, Linux memory binding is at the thread,
+         * and not process, level. Thus, hwloc sets the "thisproc" flag
+         * to "false" on all Linux systems, and uses the "thisthread" flag
+         * to indicate binding capability - don't warn if the user didn't
+         * specifically request binding
+         */
+        if (!support->membind->set_thisproc_membind &&
+            !support->membind->set_thisthread_membind &&
+            PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
+            if (PRTE_HWLOC_BASE_MBFA_WARN == prte_hwloc_base_mbfa && !membind_warned) {
+                prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported", true, node->name);
+                membind_warned = true;
+            } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
+                bind_help(item, "rmaps:membind-not-supported-fatal", node->name, NULL, NULL, 0, 0);
+                return PRTE_ERR_SILENT;
+            }
+        }
+    }
+
+    /* some systems do not report cores, and so we can get a situation where our
+     * default binding policy will fail for no necessary reason. So if we are
+     * computing a binding due to our default policy, and no cores are found
+     * on this node, just silently skip it - we will not bind
+     */
+    if (!PRTE_BINDING_POLICY_IS_SET(jdata->map->binding) &&
+        HWLOC_TYPE_DEPTH_UNKNOWN == hwloc_get_type_depth(node->topology->topo, HWLOC_OBJ_CORE)) {
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "Unable to bind-to core by default on node %s as no cores detected",
+                            node->name);
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    return PRTE_SUCCESS;
+}
+
+static void bind_node(bind_tracker_t *trk, bind_item_t *item,
+                      bind_scratch_t *scratch)
+{
+    if (trk->in_place) {
+        item->rc = bind_in_place(trk->jdata, item, scratch);
+    } else {
+        item->rc = bind_generic(trk->jdata, item, scratch);
+    }
+    if (PRTE_SUCCESS != item->rc) {
+        /* no point in continuing to bind the remaining nodes */
+        trk->abort = true;
+    }
+}
+
+static void bind_loop(bind_tracker_t *trk)
+{
+    bind_scratch_t scratch;
+    int32_t n;
+
+    bind_scratch_init(&scratch);
+    /* nodes are handed out in map order, so any node we skip
+     * due to an abort comes after the one that failed */
+    while (!trk->abort) {
+        n = prte_atomic_fetch_add_32(&trk->next, 1);
+        if (trk->nbind <= n) {
+            break;
+        }
+        bind_node(trk, &trk->items[n], &scratch);
+    }
+    bind_scratch_fini(&scratch);
+}
+
+static void* bind_thread(prte_object_t *obj)
+{
+    prte_thread_t *t = (prte_thread_t*)obj;
+
+    bind_loop((bind_tracker_t*)t->t_arg);
+    return NULL;
+}
+
+/* compute the bindings on all the nodes in the tracker, fanning
+ * them out across the binder threads if we were given any, and
+ * then merge the results back in map order so the outcome is the
+ * same as if we had done them one at a time */
+static int bind_nodes(bind_tracker_t *trk)
+{
+    int i, nthreads, rc;
+    prte_thread_t *threads;
+
+    nthreads = prte_rmaps_base.bind_threads;
+    if (trk->nbind < nthreads) {
+        nthreads = trk->nbind;
+    }
+
+    if (nthreads <= 1) {
+        bind_loop(trk);
+    } else {
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps: binding %d nodes for job %s using %d threads",
+                            (int)trk->nbind, PRTE_JOBID_PRINT(trk->jdata->nspace), nthreads);
+        threads = (prte_thread_t*)malloc(nthreads * sizeof(prte_thread_t));
+        for (i=0; i < nthreads; i++) {
+            PRTE_CONSTRUCT(&threads[i], prte_thread_t);
+            threads[i].t_run = bind_thread;
+            threads[i].t_arg = trk;
+            if (PRTE_SUCCESS != prte_thread_start(&threads[i])) {
+                /* just do the work with the threads we have */
+                PRTE_DESTRUCT(&threads[i]);
+                break;
+            }
+        }
+        nthreads = i;
+        if (0 == nthreads) {
+            /* couldn't start any threads, so do it ourselves */
+            bind_loop(trk);
+        }
+        for (i=0; i < nthreads; i++) {
+            prte_thread_join(&threads[i], NULL);
+            PRTE_DESTRUCT(&threads[i]);
+        }
+        free(threads);
+    }
+
+    /* report the first failure in map order - the binders
+     * stop once one fails, so nothing beyond it was reported
+     * by the serial path either */
+    rc = PRTE_SUCCESS;
+    for (i=0; i < trk->nitems; i++) {
+        if (PRTE_SUCCESS != trk->items[i].rc) {
+            rc = trk->items[i].rc;
+            bind_help_show(&trk->items[i]);
+            break;
+        }
+    }
+    if (PRTE_ERR_NOT_BOUND == rc) {
+        /* we couldn't meet the default binding policy, so
+         * the job will not be bound */
+        if (!trk->in_place) {
+            PRTE_SET_BINDING_POLICY(trk->jdata->map->binding, PRTE_BIND_TO_NONE);
+        }
+        unbind_procs(trk->jdata);
+        rc = PRTE_SUCCESS;
+    }
+    return rc;
+}
+
 int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
 {
     hwloc_obj_type_t hwb;
@@ -936,9 +1055,13 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
     prte_mapping_policy_t map;
     prte_node_t *node;
     int i, rc;
-    struct hwloc_topology_support *support;
-    int bind_depth;
-    bool dobind;
+    bool dobind, use_hwthread_cpus;
+    bind_tracker_t trk;
+    bind_item_t *item;
+    char *job_cpuset;
+    hwloc_obj_t root;
+    hwloc_cpuset_t mycpus;
+    prte_hwloc_topo_data_t *rdata;
 
     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                         "mca:rmaps: compute bindings for job %s with policy %s[%x]",
@@ -1004,32 +1127,24 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
      * procs to the resources below.
      */
 
-    if (PRTE_MAPPING_BYDIST == map) {
-        /* bind every proc downwards */
-        goto execute;
-    }
-
-    /* now deal with the remaining binding policies based on hardware */
-    if (bind == map) {
+    memset(&trk, 0, sizeof(trk));
+    trk.jdata = jdata;
+    trk.in_place = false;
+    if (PRTE_MAPPING_BYDIST != map && bind == map) {
         prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                             "mca:rmaps: bindings for job %s - bind in place",
                             PRTE_JOBID_PRINT(jdata->nspace));
-        if (PRTE_SUCCESS != (rc = bind_in_place(jdata, hwb, clvl))) {
-            PRTE_ERROR_LOG(rc);
-        }
-        return rc;
+        trk.in_place = true;
+    } else {
+        /* we need to handle the remaining binding options on a per-node
+         * basis because different nodes could potentially have different
+         * topologies, with different relative depths for the two levels
+         */
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps: computing bindings for job %s",
+                            PRTE_JOBID_PRINT(jdata->nspace));
     }
 
-    /* we need to handle the remaining binding options on a per-node
-     * basis because different nodes could potentially have different
-     * topologies, with different relative depths for the two levels
-     */
-  execute:
-    /* initialize */
-    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                        "mca:rmaps: computing bindings for job %s",
-                        PRTE_JOBID_PRINT(jdata->nspace));
-
     dobind = false;
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL) ||
         prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PMIX_BOOL) ||
@@ -1038,6 +1153,17 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
         dobind = true;
     }
 
+    /* collect the nodes we need to bind - the checks are cheap, so
+     * do them here. Anything that writes to the shared topologies is
+     * also done here so the binders only ever read them */
+    trk.items = (bind_item_t*)calloc(jdata->map->nodes->size, sizeof(bind_item_t));
+    if (NULL == trk.items) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    job_cpuset = NULL;
+    prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PMIX_STRING);
+    use_hwthread_cpus = prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PMIX_BOOL);
     for (i=0; i < jdata->map->nodes->size; i++) {
         if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, i))) {
             continue;
@@ -1045,90 +1171,84 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
         if ((int)PRTE_PROC_MY_NAME->rank != node->index && !dobind) {
             continue;
         }
-        if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
-            /* if we don't want to launch, then we are just testing the system,
-             * so ignore questions about support capabilities
-             */
-            support = (struct hwloc_topology_support*)hwloc_topology_get_support(node->topology->topo);
-            /* check if topology supports cpubind - have to be careful here
-             * as Linux doesn't currently support thread-level binding. This
-             * may change in the future, though, and it isn't clear how hwloc
-             * interprets the current behavior. So check both flags to be sure.
-             */
-            if (!support->cpubind->set_thisproc_cpubind &&
-                !support->cpubind->set_thisthread_cpubind) {
-                if (!PRTE_BINDING_REQUIRED(jdata->map->binding) ||
-                    !PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
-                    /* we are not required to bind, so ignore this */
-                    continue;
-                }
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
-                return PRTE_ERR_SILENT;
-            }
-            /* check if topology supports membind - have to be careful here
-             * as hwloc treats this differently than I (at least) would have
-             * expected. Per hwloc, Linux memory binding is at the thread,
-             * and not process, level. Thus, hwloc sets the "thisproc" flag
-             * to "false" on all Linux systems, and uses the "thisthread" flag
-             * to indicate binding capability - don't warn if the user didn't
-             * specifically request binding
-             */
-            if (!support->membind->set_thisproc_membind &&
-                !support->membind->set_thisthread_membind &&
-                PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
-                if (PRTE_HWLOC_BASE_MBFA_WARN == prte_hwloc_base_mbfa && !membind_warned) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported", true, node->name);
-                    membind_warned = true;
-                } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
-                    return PRTE_ERR_SILENT;
-                }
-            }
-        }
-
-        /* some systems do not report cores, and so we can get a situation where our
-         * default binding policy will fail for no necessary reason. So if we are
-         * computing a binding due to our default policy, and no cores are found
-         * on this node, just silently skip it - we will not bind
-         */
-        if (!PRTE_BINDING_POLICY_IS_SET(jdata->map->binding) &&
-            HWLOC_TYPE_DEPTH_UNKNOWN == hwloc_get_type_depth(node->topology->topo, HWLOC_OBJ_CORE)) {
-            prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                "Unable to bind-to core by default on node %s as no cores detected",
-                                node->name);
+        item = &trk.items[trk.nitems];
+        item->node = node;
+        item->rc = check_node(jdata, item);
+        if (PRTE_ERR_TAKE_NEXT_OPTION == item->rc) {
+            memset(item, 0, sizeof(bind_item_t));
             continue;
         }
+        ++trk.nitems;
+        if (PRTE_SUCCESS != item->rc) {
+            /* nothing beyond this node would have been bound */
+            break;
+        }
 
-        /* determine the relative depth on this node */
+        if (!trk.in_place) {
+            /* determine the relative depth on this node */
 #if HWLOC_API_VERSION < 0x20000
-        if (HWLOC_OBJ_CACHE == hwb) {
-            /* must use a unique function because blasted hwloc
-             * just doesn't deal with caches very well...sigh
-             */
-            bind_depth = hwloc_get_cache_type_depth(node->topology->topo, clvl, (hwloc_obj_cache_type_t)-1);
-        } else
+            if (HWLOC_OBJ_CACHE == hwb) {
+                /* must use a unique function because blasted hwloc
+                 * just doesn't deal with caches very well...sigh
+                 */
+                item->depth = hwloc_get_cache_type_depth(node->topology->topo, clvl, (hwloc_obj_cache_type_t)-1);
+            } else
 #endif
-            bind_depth = hwloc_get_type_depth(node->topology->topo, hwb);
+                item->depth = hwloc_get_type_depth(node->topology->topo, hwb);
 #if HWLOC_API_VERSION < 0x20000
-        if (0 > bind_depth)
+            if (0 > item->depth)
 #else
-        if (0 > bind_depth && HWLOC_TYPE_DEPTH_NUMANODE != bind_depth)
+            if (0 > item->depth && HWLOC_TYPE_DEPTH_NUMANODE != item->depth)
 #endif
-        {
-            /* didn't find such an object */
-            prte_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:no-objects",
-                           true, hwloc_obj_type_string(hwb), node->name);
-            return PRTE_ERR_SILENT;
+            {
+                /* didn't find such an object */
+                bind_help(item, "prte-rmaps-base:no-objects",
+                          hwloc_obj_type_string(hwb), node->name, NULL, 0, 0);
+                item->rc = PRTE_ERR_SILENT;
+                break;
+            }
+            prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                                "%s bind_depth: %d",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                item->depth);
         }
-        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                            "%s bind_depth: %d",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                            bind_depth);
-        if (PRTE_SUCCESS != (rc = bind_generic(jdata, node, bind_depth))) {
-            PRTE_ERROR_LOG(rc);
-            return rc;
+
+        /* get the available processors on this node, filtered
+         * against any "soft" cgroup - nodes of the same type share
+         * a topology, so reuse the result from the previous node */
+        if (1 < trk.nitems && node->topology == trk.items[trk.nitems-2].node->topology) {
+            item->available = hwloc_bitmap_dup(trk.items[trk.nitems-2].available);
+        } else {
+            root = hwloc_get_root_obj(node->topology->topo);
+            if (NULL == root->userdata) {
+                /* incorrect */
+                PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+                item->rc = PRTE_ERR_BAD_PARAM;
+                break;
+            }
+            /* make sure the topology index has been built */
+            (void)prte_hwloc_base_get_nbobjs_by_type(node->topology->topo, HWLOC_OBJ_PU, 0);
+            rdata = (prte_hwloc_topo_data_t*)root->userdata;
+            item->available = hwloc_bitmap_dup(rdata->available);
+            if (NULL != job_cpuset) {
+                mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
+                hwloc_bitmap_and(item->available, mycpus, item->available);
+                hwloc_bitmap_free(mycpus);
+            }
         }
+        ++trk.nbind;
+    }
+    if (NULL != job_cpuset) {
+        free(job_cpuset);
     }
 
-    return PRTE_SUCCESS;
+    rc = bind_nodes(&trk);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+    }
+    for (i=0; i < trk.nitems; i++) {
+        bind_item_fini(&trk.items[i]);
+    }
+    free(trk.items);
+    return rc;
 }
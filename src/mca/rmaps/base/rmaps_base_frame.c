@@ -94,6 +94,22 @@ static int prte_rmaps_base_register(prte_mca_base_register_flag_t flags)
                                        PRTE_INFO_LVL_9,
                                        PRTE_MCA_BASE_VAR_SCOPE_READONLY, &rmaps_base_inherit);
 
+    prte_rmaps_base.bind_threads = 0;
+    (void) prte_mca_base_var_register("prte", "rmaps", "base", "bind_threads",
+                                       "Number of threads to use when computing bindings for a job that spans "
+                                       "multiple nodes (0 or 1 => compute them on the calling thread)",
+                                       PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_rmaps_base.bind_threads);
+
+    prte_rmaps_base.map_cache_size = 0;
+    (void) prte_mca_base_var_register("prte", "rmaps", "base", "map_cache_size",
+                                       "Number of job maps to retain so that a later job with identical apps, "
+                                       "directives, and node state can reuse its map (0 => disabled)",
+                                       PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_rmaps_base.map_cache_size);
+
     return PRTE_SUCCESS;
 }
 
@@ -106,6 +122,7 @@ static int prte_rmaps_base_close(void)
         PRTE_RELEASE(item);
     }
     PRTE_DESTRUCT(&prte_rmaps_base.selected_modules);
+    prte_rmaps_base_map_cache_finalize();
 
     return prte_mca_base_framework_components_close(&prte_rmaps_base_framework, NULL);
 }
@@ -120,6 +137,7 @@ static int prte_rmaps_base_open(prte_mca_base_open_flag_t flags)
 
     /* init the globals */
     PRTE_CONSTRUCT(&prte_rmaps_base.selected_modules, prte_list_t);
+    prte_rmaps_base_map_cache_init();
     prte_rmaps_base.mapping = 0;
     prte_rmaps_base.ranking = 0;
     prte_rmaps_base.inherit = rmaps_base_inherit;
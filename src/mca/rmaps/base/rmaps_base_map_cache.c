@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+#include <sys/stat.h>
+
+#include "src/class/prte_list.h"
+#include "src/hwloc/hwloc-internal.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/util/output.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/runtime/prte_globals.h"
+
+#include "src/mca/rmaps/base/base.h"
+#include "src/mca/rmaps/base/rmaps_private.h"
+
+/*
+ * A persistent DVM often runs the same job over and over. The
+ * fingerprint captures everything the mappers look at - the apps and
+ * their node directives, the mapping-related job attributes and
+ * policies, and the state of every node in the pool - so a job whose
+ * fingerprint matches a prior one will get exactly the same map. In
+ * that case we replay the recorded placement instead of running the
+ * mappers and computing the vpids again.
+ */
+
+static prte_list_t map_cache;
+
+static void mccon(prte_rmaps_base_map_cache_t *p)
+{
+    p->hash = 0;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->fingerprint);
+    PMIX_LOAD_NSPACE(p->nspace, NULL);
+    p->mapping = 0;
+    p->ranking = 0;
+    p->binding = 0;
+    p->oversubscribed = false;
+    p->bookmark = -1;
+    p->num_procs = 0;
+    p->num_apps = 0;
+    p->app_nprocs = NULL;
+    p->app_first_rank = NULL;
+    p->num_nodes = 0;
+    p->nodes = NULL;
+    p->node_nprocs = NULL;
+    p->ranks = NULL;
+    p->apps = NULL;
+    p->app_ranks = NULL;
+    p->nodemap = NULL;
+    p->procmap = NULL;
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->ppn);
+    p->ppn_valid = false;
+    p->hits = 0;
+}
+static void mcdes(prte_rmaps_base_map_cache_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->fingerprint);
+    if (NULL != p->app_nprocs) {
+        free(p->app_nprocs);
+    }
+    if (NULL != p->app_first_rank) {
+        free(p->app_first_rank);
+    }
+    if (NULL != p->nodes) {
+        free(p->nodes);
+    }
+    if (NULL != p->node_nprocs) {
+        free(p->node_nprocs);
+    }
+    if (NULL != p->ranks) {
+        free(p->ranks);
+    }
+    if (NULL != p->apps) {
+        free(p->apps);
+    }
+    if (NULL != p->app_ranks) {
+        free(p->app_ranks);
+    }
+    if (NULL != p->nodemap) {
+        free(p->nodemap);
+    }
+    if (NULL != p->procmap) {
+        free(p->procmap);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&p->ppn);
+}
+PRTE_CLASS_INSTANCE(prte_rmaps_base_map_cache_t,
+                    prte_list_item_t,
+                    mccon, mcdes);
+
+/* attributes that influence the mapping */
+static prte_attribute_key_t job_keys[] = {
+    PRTE_JOB_PPR,
+    PRTE_JOB_PES_PER_PROC,
+    PRTE_JOB_HWT_CPUS,
+    PRTE_JOB_CORE_CPUS,
+    PRTE_JOB_DIST_DEVICE,
+    PRTE_JOB_CPUSET,
+    PRTE_JOB_MULTI_DAEMON_SIM
+};
+static prte_attribute_key_t app_keys[] = {
+    PRTE_APP_HOSTFILE,
+    PRTE_APP_ADD_HOSTFILE,
+    PRTE_APP_DASH_HOST,
+    PRTE_APP_ADD_HOST,
+    PRTE_APP_MIN_NODES,
+    PRTE_APP_MANDATORY,
+    PRTE_APP_MAX_PPN,
+    PRTE_APP_DEBUGGER_DAEMON
+};
+
+void prte_rmaps_base_map_cache_init(void)
+{
+    PRTE_CONSTRUCT(&map_cache, prte_list_t);
+}
+
+void prte_rmaps_base_map_cache_finalize(void)
+{
+    PRTE_LIST_DESTRUCT(&map_cache);
+}
+
+static uint64_t fp_hash(pmix_byte_object_t *fp)
+{
+    uint64_t h = 14695981039346656037ULL;
+    size_t n;
+
+    for (n=0; n < fp->size; n++) {
+        h ^= (uint8_t)fp->bytes[n];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static pmix_status_t pack_keys(pmix_data_buffer_t *buf, prte_list_t *attrs,
+                               prte_attribute_key_t *keys, size_t nkeys)
+{
+    prte_attribute_t *kv;
+    struct stat st;
+    int64_t stamp[2];
+    bool present;
+    size_t n;
+    pmix_status_t rc;
+
+    for (n=0; n < nkeys; n++) {
+        kv = prte_fetch_attribute(attrs, NULL, keys[n]);
+        present = (NULL != kv);
+        if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &keys[n], 1, PMIX_UINT16)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &present, 1, PMIX_BOOL))) {
+            return rc;
+        }
+        if (!present) {
+            continue;
+        }
+        if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &kv->data, 1, PMIX_VALUE))) {
+            return rc;
+        }
+        /* the mapping depends on the contents of a hostfile, not just its name */
+        if ((PRTE_APP_HOSTFILE == keys[n] || PRTE_APP_ADD_HOSTFILE == keys[n]) &&
+            PMIX_STRING == kv->data.type && NULL != kv->data.data.string) {
+            stamp[0] = stamp[1] = -1;
+            if (0 == stat(kv->data.data.string, &st)) {
+                stamp[0] = (int64_t)st.st_mtime;
+                stamp[1] = (int64_t)st.st_size;
+            }
+            if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, stamp, 2, PMIX_INT64))) {
+                return rc;
+            }
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+bool prte_rmaps_base_map_cache_fingerprint(prte_job_t *jdata, pmix_byte_object_t *fp)
+{
+    pmix_data_buffer_t buf;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    int32_t i, i32[7];
+    uint16_t u16[5];
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (0 >= prte_rmaps_base.map_cache_size) {
+        return false;
+    }
+    /* the mappers that read their instructions from a file, jobs
+     * whose map must be fully computed here, and dynamic spawns that
+     * depend on their parent are not cached */
+    if (PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_DEBUGGER_DAEMON) ||
+        PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_TOOL) ||
+        !PMIX_NSPACE_INVALID(jdata->originator.nspace) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_FILE, NULL, PMIX_STRING) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PMIX_BOOL) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PMIX_BOOL) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PMIX_BOOL) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PMIX_BOOL)) {
+        return false;
+    }
+    if (PRTE_MAPPING_SEQ == PRTE_GET_MAPPING_POLICY(jdata->map->mapping) ||
+        PRTE_MAPPING_BYUSER == PRTE_GET_MAPPING_POLICY(jdata->map->mapping)) {
+        return false;
+    }
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+
+    /* the policies as given and the defaults they fall back to */
+    u16[0] = jdata->map->mapping;
+    u16[1] = jdata->map->ranking;
+    u16[2] = jdata->map->binding;
+    u16[3] = prte_rmaps_base.mapping;
+    u16[4] = prte_rmaps_base.ranking;
+    if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, u16, 5, PMIX_UINT16)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &prte_hwloc_default_binding_policy, 1, PMIX_UINT16)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &jdata->map->req_mapper, 1, PMIX_STRING)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &jdata->flags, 1, PMIX_UINT16))) {
+        goto done;
+    }
+    i32[0] = (NULL == jdata->bookmark) ? -1 : jdata->bookmark->index;
+    if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &i32[0], 1, PMIX_INT32)) ||
+        PMIX_SUCCESS != (rc = pack_keys(&buf, &jdata->attributes, job_keys,
+                                        sizeof(job_keys) / sizeof(prte_attribute_key_t)))) {
+        goto done;
+    }
+
+    /* the apps */
+    if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &jdata->num_apps, 1, PMIX_UINT32))) {
+        goto done;
+    }
+    for (i=0; i < jdata->apps->size; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            continue;
+        }
+        if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &app->idx, 1, PMIX_UINT32)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &app->num_procs, 1, PMIX_PROC_RANK)) ||
+            PMIX_SUCCESS != (rc = pack_keys(&buf, &app->attributes, app_keys,
+                                            sizeof(app_keys) / sizeof(prte_attribute_key_t)))) {
+            goto done;
+        }
+    }
+
+    /* the state of the node pool */
+    for (i=0; i < prte_node_pool->size; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, i))) {
+            continue;
+        }
+        i32[0] = node->index;
+        i32[1] = node->state;
+        i32[2] = node->slots;
+        i32[3] = node->slots_max;
+        i32[4] = node->slots_inuse;
+        i32[5] = node->num_procs;
+        i32[6] = (NULL == node->daemon) ? -1 : (int32_t)node->daemon->name.rank;
+        u16[0] = node->flags & ~PRTE_NODE_FLAG_MAPPED;
+        if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, i32, 7, PMIX_INT32)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &u16[0], 1, PMIX_UINT16))) {
+            goto done;
+        }
+        if (NULL != node->topology &&
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &buf, &node->topology->sig, 1, PMIX_STRING))) {
+            goto done;
+        }
+    }
+
+    rc = PMIx_Data_unload(&buf, fp);
+
+  done:
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return false;
+    }
+    return true;
+}
+
+static prte_rmaps_base_map_cache_t* lookup(pmix_byte_object_t *fp, uint64_t hash)
+{
+    prte_rmaps_base_map_cache_t *mc;
+
+    PRTE_LIST_FOREACH(mc, &map_cache, prte_rmaps_base_map_cache_t) {
+        if (mc->hash == hash && mc->fingerprint.size == fp->size &&
+            0 == memcmp(mc->fingerprint.bytes, fp->bytes, fp->size)) {
+            return mc;
+        }
+    }
+    return NULL;
+}
+
+/* take back a partially replayed map so the mappers can start
+ * from the same state as if we had never tried */
+static void replay_undo(prte_job_t *jdata, int32_t nnodes, uint16_t *flags)
+{
+    prte_node_t *node;
+    prte_proc_t *proc;
+    int32_t i, j;
+
+    for (i=0; i < jdata->procs->size; i++) {
+        if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, i))) {
+            continue;
+        }
+        prte_pointer_array_set_item(jdata->procs, i, NULL);
+        /* we hold the reference from setup_proc and our own */
+        PRTE_RELEASE(proc);
+        PRTE_RELEASE(proc);
+    }
+    for (i=0; i < nnodes; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, i))) {
+            continue;
+        }
+        for (j=0; j < node->procs->size; j++) {
+            if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j)) ||
+                !PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
+                continue;
+            }
+            prte_pointer_array_set_item(node->procs, j, NULL);
+            node->num_procs--;
+            --node->slots_inuse;
+            PRTE_RELEASE(proc);
+        }
+        /* restore the flags we may have set */
+        node->flags = flags[i];
+        prte_pointer_array_set_item(jdata->map->nodes, i, NULL);
+        PRTE_RELEASE(node);
+    }
+    jdata->map->num_nodes = 0;
+    jdata->num_procs = 0;
+}
+
+bool prte_rmaps_base_map_cache_replay(prte_job_t *jdata, pmix_byte_object_t *fp)
+{
+    prte_rmaps_base_map_cache_t *mc;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    prte_proc_t *proc;
+    int32_t i, j, k;
+    uint16_t *flags;
+    int rc;
+
+    if (NULL == (mc = lookup(fp, fp_hash(fp)))) {
+        return false;
+    }
+
+    /* make sure everything the entry refers to is still there
+     * before we touch anything */
+    for (i=0; i < mc->num_nodes; i++) {
+        if (NULL == prte_pointer_array_get_item(prte_node_pool, mc->nodes[i])) {
+            goto invalid;
+        }
+    }
+    for (k=0; k < (int32_t)mc->num_procs; k++) {
+        if (mc->num_procs <= mc->ranks[k] ||
+            NULL == prte_pointer_array_get_item(jdata->apps, mc->apps[mc->ranks[k]]) ||
+            NULL != prte_pointer_array_get_item(jdata->procs, mc->ranks[k])) {
+            goto invalid;
+        }
+    }
+    if (0 < jdata->map->num_nodes) {
+        /* already partially mapped */
+        return false;
+    }
+    if (NULL == (flags = (uint16_t*)malloc(mc->num_nodes * sizeof(uint16_t)))) {
+        return false;
+    }
+
+    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps: job %s matches cached map of job %s - reusing it",
+                        PRTE_JOBID_PRINT(jdata->nspace), PRTE_JOBID_PRINT(mc->nspace));
+
+    k = 0;
+    for (i=0; i < mc->num_nodes; i++) {
+        node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, mc->nodes[i]);
+        flags[i] = node->flags;
+        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
+        PRTE_RETAIN(node);
+        if (0 > prte_pointer_array_add(jdata->map->nodes, node)) {
+            PRTE_RELEASE(node);
+            replay_undo(jdata, i, flags);
+            free(flags);
+            return false;
+        }
+        ++(jdata->map->num_nodes);
+        for (j=0; j < mc->node_nprocs[i]; j++, k++) {
+            if (NULL == (proc = prte_rmaps_base_setup_proc(jdata, node, mc->apps[mc->ranks[k]]))) {
+                replay_undo(jdata, i+1, flags);
+                free(flags);
+                return false;
+            }
+            proc->name.rank = mc->ranks[k];
+            proc->rank = mc->ranks[k];
+            proc->app_rank = mc->app_ranks[mc->ranks[k]];
+            PRTE_RETAIN(proc);
+            if (PRTE_SUCCESS != (rc = prte_pointer_array_set_item(jdata->procs, proc->name.rank, proc))) {
+                PRTE_ERROR_LOG(rc);
+                PRTE_RELEASE(proc);
+                PRTE_RELEASE(proc);
+                replay_undo(jdata, i+1, flags);
+                free(flags);
+                return false;
+            }
+        }
+        if (node->slots < (int)node->num_procs) {
+            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_OVERSUBSCRIBED);
+        }
+    }
+    free(flags);
+
+    /* the map is in place, so adopt the rest of the job's layout */
+    jdata->map->mapping = mc->mapping;
+    jdata->map->ranking = mc->ranking;
+    jdata->map->binding = mc->binding;
+    for (i=0; i < mc->num_apps; i++) {
+        if (NULL != (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            app->num_procs = mc->app_nprocs[i];
+            app->first_rank = mc->app_first_rank[i];
+        }
+    }
+    if (mc->oversubscribed) {
+        PRTE_FLAG_SET(jdata, PRTE_JOB_FLAG_OVERSUBSCRIBED);
+    }
+    jdata->num_procs = mc->num_procs;
+    jdata->bookmark = (0 > mc->bookmark) ? NULL :
+                      (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, mc->bookmark);
+
+    PMIX_LOAD_NSPACE(mc->nspace, jdata->nspace);
+    mc->hits++;
+    /* keep the most recently used entries at the front */
+    prte_list_remove_item(&map_cache, &mc->super);
+    prte_list_prepend(&map_cache, &mc->super);
+    return true;
+
+  invalid:
+    prte_list_remove_item(&map_cache, &mc->super);
+    PRTE_RELEASE(mc);
+    return false;
+}
+
+void prte_rmaps_base_map_cache_store(prte_job_t *jdata, pmix_byte_object_t *fp)
+{
+    prte_rmaps_base_map_cache_t *mc;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    prte_proc_t *proc;
+    int32_t i, k, n;
+
+    if (PRTE_MAPPING_SEQ == PRTE_GET_MAPPING_POLICY(jdata->map->mapping) ||
+        PRTE_MAPPING_BYUSER == PRTE_GET_MAPPING_POLICY(jdata->map->mapping)) {
+        return;
+    }
+
+    mc = PRTE_NEW(prte_rmaps_base_map_cache_t);
+    mc->mapping = jdata->map->mapping;
+    mc->ranking = jdata->map->ranking;
+    mc->binding = jdata->map->binding;
+    mc->oversubscribed = PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_OVERSUBSCRIBED);
+    mc->bookmark = (NULL == jdata->bookmark) ? -1 : jdata->bookmark->index;
+    mc->num_procs = jdata->num_procs;
+    mc->num_apps = jdata->apps->size;
+    mc->app_nprocs = (pmix_rank_t*)calloc(mc->num_apps, sizeof(pmix_rank_t));
+    mc->app_first_rank = (pmix_rank_t*)calloc(mc->num_apps, sizeof(pmix_rank_t));
+    mc->nodes = (int32_t*)malloc(jdata->map->nodes->size * sizeof(int32_t));
+    mc->node_nprocs = (int32_t*)malloc(jdata->map->nodes->size * sizeof(int32_t));
+    mc->ranks = (pmix_rank_t*)malloc(jdata->num_procs * sizeof(pmix_rank_t));
+    mc->apps = (prte_app_idx_t*)malloc(jdata->num_procs * sizeof(prte_app_idx_t));
+    mc->app_ranks = (pmix_rank_t*)malloc(jdata->num_procs * sizeof(pmix_rank_t));
+    if (NULL == mc->app_nprocs || NULL == mc->app_first_rank || NULL == mc->nodes ||
+        NULL == mc->node_nprocs || NULL == mc->ranks || NULL == mc->apps ||
+        NULL == mc->app_ranks) {
+        PRTE_RELEASE(mc);
+        return;
+    }
+    for (i=0; i < mc->num_apps; i++) {
+        if (NULL != (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            mc->app_nprocs[i] = app->num_procs;
+            mc->app_first_rank[i] = app->first_rank;
+        }
+    }
+    k = 0;
+    for (i=0; i < jdata->map->nodes->size; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, i))) {
+            continue;
+        }
+        n = 0;
+        for (int j=0; j < node->procs->size; j++) {
+            if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j)) ||
+                !PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
+                continue;
+            }
+            if (k == (int32_t)jdata->num_procs || proc->name.rank >= jdata->num_procs) {
+                /* not a map we can reproduce */
+                PRTE_RELEASE(mc);
+                return;
+            }
+            mc->ranks[k++] = proc->name.rank;
+            mc->apps[proc->name.rank] = proc->app_idx;
+            mc->app_ranks[proc->name.rank] = proc->app_rank;
+            n++;
+        }
+        mc->nodes[mc->num_nodes] = node->index;
+        mc->node_nprocs[mc->num_nodes] = n;
+        mc->num_nodes++;
+    }
+    if (k != (int32_t)jdata->num_procs) {
+        PRTE_RELEASE(mc);
+        return;
+    }
+
+    /* take the fingerprint */
+    mc->fingerprint = *fp;
+    PMIX_BYTE_OBJECT_CONSTRUCT(fp);
+    mc->hash = fp_hash(&mc->fingerprint);
+    PMIX_LOAD_NSPACE(mc->nspace, jdata->nspace);
+
+    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps: caching map of job %s (%u procs on %d nodes)",
+                        PRTE_JOBID_PRINT(jdata->nspace), (unsigned)mc->num_procs,
+                        (int)mc->num_nodes);
+
+    prte_list_prepend(&map_cache, &mc->super);
+    while ((int)prte_list_get_size(&map_cache) > prte_rmaps_base.map_cache_size) {
+        mc = (prte_rmaps_base_map_cache_t*)prte_list_remove_last(&map_cache);
+        PRTE_RELEASE(mc);
+    }
+}
+
+prte_rmaps_base_map_cache_t* prte_rmaps_base_map_cache_get(const pmix_nspace_t nspace)
+{
+    prte_rmaps_base_map_cache_t *mc;
+
+    if (0 >= prte_rmaps_base.map_cache_size) {
+        return NULL;
+    }
+    PRTE_LIST_FOREACH(mc, &map_cache, prte_rmaps_base_map_cache_t) {
+        if (PMIX_CHECK_NSPACE(mc->nspace, nspace)) {
+            return mc;
+        }
+    }
+    return NULL;
+}
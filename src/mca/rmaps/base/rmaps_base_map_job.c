@@ -43,6 +43,7 @@
 #include "src/util/show_help.h"
 #include "src/threads/threads.h"
 #include "src/mca/state/state.h"
+#include "src/mca/state/base/base.h"
 
 #include "src/mca/rmaps/base/base.h"
 #include "src/mca/rmaps/base/rmaps_private.h"
@@ -67,9 +68,14 @@ void prte_rmaps_base_map_job(int fd, short args, void *cbdata)
     bool use_hwthreads = false;
     bool sequential = false;
     int32_t slots;
+    pmix_byte_object_t fp;
+    bool cache_map = false;
+    double start;
 
     PRTE_ACQUIRE_OBJECT(caddy);
     jdata = caddy->jdata;
+    start = prte_state_base_trace_time();
+    PMIX_BYTE_OBJECT_CONSTRUCT(&fp);
 
     jdata->state = PRTE_JOB_STATE_MAP;
 
@@ -481,6 +487,14 @@ compute:
         }
     }
 
+    /* if an identical job was mapped before, then reuse its map */
+    if (prte_rmaps_base_map_cache_fingerprint(jdata, &fp)) {
+        if (prte_rmaps_base_map_cache_replay(jdata, &fp)) {
+            goto mapped;
+        }
+        cache_map = true;
+    }
+
     /* cycle thru the available mappers until one agrees to map
      * the job
      */
@@ -583,6 +597,11 @@ compute:
         }
     }
 
+    if (cache_map) {
+        prte_rmaps_base_map_cache_store(jdata, &fp);
+    }
+
+  mapped:
     /* set the offset so shared memory components can potentially
      * connect to any spawned jobs
      */
@@ -604,6 +623,9 @@ compute:
         prte_rmaps_base_display_map(jdata);
     }
 
+    prte_state_base_trace_stage(jdata->nspace, PMIX_RANK_WILDCARD,
+                                PRTE_STATE_TRACE_MAP, start);
+
     /* set the job state to the next position */
     PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_COMPLETE);
 
@@ -616,6 +638,7 @@ compute:
        }
 
     /* cleanup */
+    PMIX_BYTE_OBJECT_DESTRUCT(&fp);
     PRTE_RELEASE(caddy);
 }
 
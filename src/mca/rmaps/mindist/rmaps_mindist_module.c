@@ -368,9 +368,6 @@ static int mindist_map(prte_job_t *jdata)
                         }
                     }
                 }
-                /* first we need to fill summary object for root with information about nodes
-                 * so we call prte_hwloc_base_get_nbobjs_by_type */
-                prte_hwloc_base_get_nbobjs_by_type(node->topology->topo, HWLOC_OBJ_NODE, 0);
                 PRTE_CONSTRUCT(&numa_list, prte_list_t);
                 ret = prte_hwloc_get_sorted_numa_list(node->topology->topo, prte_rmaps_base.device, &numa_list);
                 if (ret > 1) {
@@ -542,9 +539,6 @@ static int assign_locations(prte_job_t *jdata)
                 hwloc_bitmap_free(mycpus);
             }
 
-            /* first we need to fill summary object for root with information about nodes
-             * so we call prte_hwloc_base_get_nbobjs_by_type */
-            prte_hwloc_base_get_nbobjs_by_type(node->topology->topo, HWLOC_OBJ_NODE, 0);
             PRTE_CONSTRUCT(&numa_list, prte_list_t);
             rc = prte_hwloc_get_sorted_numa_list(node->topology->topo, prte_rmaps_base.device, &numa_list);
             if (rc > 1) {
@@ -109,7 +109,7 @@ static int prte_rmaps_seq_map(prte_job_t *jdata)
     prte_proc_t *proc;
     prte_mca_base_component_t *c = &prte_rmaps_seq_component.base_version;
     char *hosts = NULL;
-    bool use_hwthread_cpus, match;
+    bool use_hwthread_cpus;
 
     PRTE_OUTPUT_VERBOSE((1, prte_rmaps_base_framework.framework_output,
                          "%s rmaps:seq called on job %s",
@@ -310,17 +310,7 @@ static int prte_rmaps_seq_map(prte_job_t *jdata)
              * that our mapping gets saved on that array as the objects
              * returned by the hostfile function are -not- on the array
              */
-            match = false;
-            for (j=0; j < prte_node_pool->size; j++) {
-                if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, j))) {
-                    continue;
-                }
-                if (prte_node_match(node, sq->hostname)) {
-                    match = true;
-                    break;
-                }
-            }
-            if (!match) {
+            if (NULL == (node = prte_node_lookup(sq->hostname))) {
                 /* wasn't found - that is an error */
                 prte_show_help("help-prte-rmaps-seq.txt",
                                "prte-rmaps-seq:resource-not-found",
@@ -45,6 +45,7 @@
 #include "prte_config.h"
 
 #include "src/mca/mca.h"
+#include "src/class/prte_lifo.h"
 #include "src/class/prte_pointer_array.h"
 
 #include "src/runtime/prte_globals.h"
@@ -68,12 +69,23 @@ PRTE_EXPORT int prte_rml_base_select(void);
 
 /* a global struct containing framework-level values */
 typedef struct {
+    /* posted recvs are indexed by tag - recvs on tags outside
+     * the reserved range are kept on the overflow list */
+    prte_list_t posted_by_tag[PRTE_RML_TAG_MAX];
     prte_list_t posted_recvs;
     prte_list_t unmatched_msgs;
     int max_retries;
+    /* cache of released recv descriptors */
+    prte_lifo_t recv_pool;
+    prte_atomic_int32_t recv_pool_size;
+    int recv_pool_max;
 } prte_rml_base_t;
 PRTE_EXPORT extern prte_rml_base_t prte_rml_base;
 
+#define PRTE_RML_POSTED_RECVS(t)                                        \
+    (((t) < PRTE_RML_TAG_MAX) ? &prte_rml_base.posted_by_tag[(t)] :     \
+                                &prte_rml_base.posted_recvs)
+
 
 /* structure to send RML messages - used internally */
 typedef struct {
@@ -154,7 +166,7 @@ PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_self_send_xfer_t);
                             "%s Message posted at %s:%d for tag %d",    \
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),         \
                             __FILE__, __LINE__, (t));                   \
-        msg = PRTE_NEW(prte_rml_recv_t);                                \
+        msg = prte_rml_base_recv_alloc();                               \
         PMIX_XFER_PROCID(&msg->sender, (p));                            \
         msg->tag = (t);                                                 \
         msg->seq_num = (s);                                             \
@@ -165,9 +177,8 @@ PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_self_send_xfer_t);
             PMIX_ERROR_LOG(_rc);                                        \
         }                                                               \
         /* setup the event */                                           \
-        prte_event_set(prte_event_base, &msg->ev, -1,                   \
-                       PRTE_EV_WRITE,                                   \
-                       prte_rml_base_process_msg, msg);                 \
+        prte_event_shift_set(prte_event_base, &msg->ev,                 \
+                             prte_rml_base_process_msg, msg);           \
         prte_event_set_priority(&msg->ev, PRTE_MSG_PRI);                \
         prte_event_active(&msg->ev, PRTE_EV_WRITE, 1);                  \
     } while(0);
@@ -175,9 +186,8 @@ PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_self_send_xfer_t);
 #define PRTE_RML_ACTIVATE_MESSAGE(m)                            \
     do {                                                        \
         /* setup the event */                                   \
-        prte_event_set(prte_event_base, &(m)->ev, -1,           \
-                       PRTE_EV_WRITE,                           \
-                       prte_rml_base_process_msg, (m));         \
+        prte_event_shift_set(prte_event_base, &(m)->ev,         \
+                             prte_rml_base_process_msg, (m));   \
         prte_event_set_priority(&(m)->ev, PRTE_MSG_PRI);        \
         prte_event_active(&(m)->ev, PRTE_EV_WRITE, 1);          \
     } while(0);
@@ -198,6 +208,12 @@ PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_self_send_xfer_t);
         PRTE_RELEASE(m);                                                \
     }while(0);
 
+/* recv descriptors are taken from and returned to a pool. The
+ * descriptor's buffer is emptied when it is returned, so any
+ * payload the user wants to keep must have been unloaded */
+PRTE_EXPORT prte_rml_recv_t* prte_rml_base_recv_alloc(void);
+PRTE_EXPORT void prte_rml_base_recv_free(prte_rml_recv_t *msg);
+
 /* common implementations */
 PRTE_EXPORT void prte_rml_base_post_recv(int sd, short args, void *cbdata);
 PRTE_EXPORT void prte_rml_base_process_msg(int fd, short flags, void *cbdata);
@@ -55,21 +55,47 @@ static int prte_rml_base_register(prte_mca_base_register_flag_t flags)
                                  PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                  &prte_rml_base.max_retries);
 
+    prte_rml_base.recv_pool_max = 256;
+    prte_mca_base_var_register("prte", "rml", "base", "recv_pool_max",
+                                 "Max number of released recv descriptors to cache for reuse",
+                                 PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                 PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                 PRTE_INFO_LVL_9,
+                                 PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                 &prte_rml_base.recv_pool_max);
+
     return PRTE_SUCCESS;
 }
 
 static int prte_rml_base_close(void)
 {
+    prte_list_item_t *item;
+    int n;
+
+    for (n=0; n < PRTE_RML_TAG_MAX; n++) {
+        PRTE_LIST_DESTRUCT(&prte_rml_base.posted_by_tag[n]);
+    }
     PRTE_LIST_DESTRUCT(&prte_rml_base.posted_recvs);
+    while (NULL != (item = prte_lifo_pop(&prte_rml_base.recv_pool))) {
+        PRTE_RELEASE(item);
+    }
+    PRTE_DESTRUCT(&prte_rml_base.recv_pool);
     return prte_mca_base_framework_components_close(&prte_rml_base_framework, NULL);
 }
 
 static int prte_rml_base_open(prte_mca_base_open_flag_t flags)
 {
+    int n;
+
     /* Initialize globals */
     /* construct object for holding the active plugin modules */
+    for (n=0; n < PRTE_RML_TAG_MAX; n++) {
+        PRTE_CONSTRUCT(&prte_rml_base.posted_by_tag[n], prte_list_t);
+    }
     PRTE_CONSTRUCT(&prte_rml_base.posted_recvs, prte_list_t);
     PRTE_CONSTRUCT(&prte_rml_base.unmatched_msgs, prte_list_t);
+    PRTE_CONSTRUCT(&prte_rml_base.recv_pool, prte_lifo_t);
+    prte_rml_base.recv_pool_size = 0;
 
     /* Open up all available components */
     return prte_mca_base_framework_components_open(&prte_rml_base_framework, flags);
@@ -202,6 +228,31 @@ PRTE_CLASS_INSTANCE(prte_rml_recv_t,
                    prte_list_item_t,
                    recv_cons, recv_des);
 
+prte_rml_recv_t* prte_rml_base_recv_alloc(void)
+{
+    prte_rml_recv_t *msg;
+
+    msg = (prte_rml_recv_t*)prte_lifo_pop(&prte_rml_base.recv_pool);
+    if (NULL == msg) {
+        return PRTE_NEW(prte_rml_recv_t);
+    }
+    prte_atomic_add_fetch_32(&prte_rml_base.recv_pool_size, -1);
+    return msg;
+}
+
+void prte_rml_base_recv_free(prte_rml_recv_t *msg)
+{
+    if (prte_rml_base.recv_pool_max <= prte_rml_base.recv_pool_size) {
+        PRTE_RELEASE(msg);
+        return;
+    }
+    /* release any payload the user left behind */
+    PMIX_DATA_BUFFER_DESTRUCT(&msg->dbuf);
+    PMIX_DATA_BUFFER_CONSTRUCT(&msg->dbuf);
+    prte_atomic_add_fetch_32(&prte_rml_base.recv_pool_size, 1);
+    prte_lifo_push(&prte_rml_base.recv_pool, &msg->super);
+}
+
 static void rcv_cons(prte_rml_recv_cb_t *ptr)
 {
     PMIX_DATA_BUFFER_CONSTRUCT(&ptr->data);
@@ -59,6 +59,7 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
 {
     prte_rml_recv_request_t *req = (prte_rml_recv_request_t*)cbdata;
     prte_rml_posted_recv_t *post, *recv;
+    prte_list_t *posted;
 
     PRTE_ACQUIRE_OBJECT(req);
 
@@ -74,12 +75,13 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
         return;
     }
     post = req->post;
+    posted = PRTE_RML_POSTED_RECVS(post->tag);
 
     /* if the request is to cancel a recv, then find the recv
      * and remove it from our list
      */
     if (req->cancel) {
-        PRTE_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t) {
+        PRTE_LIST_FOREACH(recv, posted, prte_rml_posted_recv_t) {
             if (PMIX_CHECK_PROCID(&post->peer, &recv->peer) &&
                 post->tag == recv->tag) {
                 prte_output_verbose(5, prte_rml_base_framework.framework_output,
@@ -87,7 +89,7 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                     post->tag, PRTE_NAME_PRINT(&recv->peer));
                 /* got a match - remove it */
-                prte_list_remove_item(&prte_rml_base.posted_recvs, &recv->super);
+                prte_list_remove_item(posted, &recv->super);
                 PRTE_RELEASE(recv);
                 break;
             }
@@ -97,7 +99,7 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
     }
 
     /* bozo check - cannot have two receives for the same peer/tag combination */
-    PRTE_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t) {
+    PRTE_LIST_FOREACH(recv, posted, prte_rml_posted_recv_t) {
         if (PMIX_CHECK_PROCID(&post->peer, &recv->peer) &&
             post->tag == recv->tag) {
             prte_output(0, "%s TWO RECEIVES WITH SAME PEER %s AND TAG %d - ABORTING",
@@ -112,8 +114,8 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         (post->persistent) ? "persistent" : "non-persistent",
                         post->tag, PRTE_NAME_PRINT(&post->peer));
-    /* add it to the list of recvs */
-    prte_list_append(&prte_rml_base.posted_recvs, &post->super);
+    /* add it to the list of recvs for this tag */
+    prte_list_append(posted, &post->super);
     req->post = NULL;
     /* handle any messages that may have already arrived for this recv */
     msg_match_recv(post, post->persistent);
@@ -160,6 +162,7 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
 {
     prte_rml_recv_t *msg = (prte_rml_recv_t*)cbdata;
     prte_rml_posted_recv_t *post;
+    prte_list_t *posted;
 
     PRTE_ACQUIRE_OBJECT(msg);
 
@@ -191,13 +194,15 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
                 return;
             }
             PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            PRTE_RELEASE(msg);
+            prte_rml_base_recv_free(msg);
             return;
         }
     }
 
-    /* see if we have a waiting recv for this message */
-    PRTE_LIST_FOREACH(post, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t) {
+    /* see if we have a waiting recv for this message - only the
+     * recvs posted on this tag need to be checked */
+    posted = PRTE_RML_POSTED_RECVS(msg->tag);
+    PRTE_LIST_FOREACH(post, posted, prte_rml_posted_recv_t) {
         /* since names could include wildcards, must use
          * the more generalized comparison function
          */
@@ -214,15 +219,15 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
                                  msg->dbuf.bytes_used,
                                  PRTE_NAME_PRINT(&msg->sender),
                                  msg->tag));
-            /* release the message */
-            PRTE_RELEASE(msg);
+            /* return the message to the pool */
+            prte_rml_base_recv_free(msg);
             PRTE_OUTPUT_VERBOSE((5, prte_rml_base_framework.framework_output,
                                  "%s message tag %d on released",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                  post->tag));
             /* if the recv is non-persistent, remove it */
             if (!post->persistent) {
-                prte_list_remove_item(&prte_rml_base.posted_recvs, &post->super);
+                prte_list_remove_item(posted, &post->super);
                 /*PRTE_OUTPUT_VERBOSE((5, prte_rml_base_framework.framework_output,
                                      "%s non persistent recv %p remove success releasing now",
                                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -126,13 +126,13 @@ int prte_rml_oob_send_buffer_nb(pmix_proc_t* peer,
         PRTE_THREADSHIFT(xfer, prte_event_base, send_self_exe, PRTE_MSG_PRI);
 
         /* copy the message for the recv */
-        rcv = PRTE_NEW(prte_rml_recv_t);
+        rcv = prte_rml_base_recv_alloc();
         rcv->sender = *peer;
         rcv->tag = tag;
         rc = PMIx_Data_copy_payload(&rcv->dbuf, buffer);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
-            PRTE_RELEASE(rcv);
+            prte_rml_base_recv_free(rcv);
             return prte_pmix_convert_status(rc);
         }
         /* post the message for receipt - since the send callback was posted
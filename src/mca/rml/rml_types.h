@@ -193,6 +193,12 @@ BEGIN_C_DECLS
 /* error propagate  */
 #define PRTE_RML_TAG_PROPAGATE              71
 
+/* launch trace report */
+#define PRTE_RML_TAG_LAUNCH_TRACE           72
+
+/* tree-reduced job state milestones */
+#define PRTE_RML_TAG_STATE_ROLLUP           73
+
 #define PRTE_RML_TAG_MAX                   100
 
 
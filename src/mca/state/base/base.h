@@ -43,6 +43,65 @@ PRTE_EXPORT void prte_state_base_print_proc_state_machine(void);
 PRTE_EXPORT extern int prte_state_base_parent_fd;
 PRTE_EXPORT extern bool prte_state_base_ready_msg;
 
+/*
+ * Launch trace - every daemon records the state transitions and the
+ * duration of the major launch stages into a fixed-size ring. On
+ * request, the HNP collects the entries for a job from all daemons
+ * and writes them out as a Chrome/Perfetto JSON trace.
+ */
+typedef enum {
+    PRTE_STATE_TRACE_MAP,
+    PRTE_STATE_TRACE_GET_ADD_PROCS,
+    PRTE_STATE_TRACE_XCAST,
+    PRTE_STATE_TRACE_CONSTRUCT_CHILDREN,
+    PRTE_STATE_TRACE_PMIX_REGISTER,
+    PRTE_STATE_TRACE_FORK,
+    PRTE_STATE_TRACE_NUM_STAGES
+} prte_state_trace_stage_t;
+
+PRTE_EXPORT extern int prte_state_base_trace_size;
+PRTE_EXPORT extern char *prte_state_base_trace_output;
+PRTE_EXPORT extern int prte_state_base_trace_timeout;
+
+PRTE_EXPORT int prte_state_base_trace_init(void);
+PRTE_EXPORT void prte_state_base_trace_finalize(void);
+/* post the persistent recv - must be called once the RML is available */
+PRTE_EXPORT void prte_state_base_trace_start(void);
+/* current time for use as the start of a stage */
+PRTE_EXPORT double prte_state_base_trace_time(void);
+PRTE_EXPORT void prte_state_base_trace_job_state(const pmix_nspace_t nspace,
+                                                 prte_job_state_t state);
+PRTE_EXPORT void prte_state_base_trace_proc_state(const pmix_proc_t *proc,
+                                                  prte_proc_state_t state);
+/* record a stage that began at the given time and ends now - use
+ * PMIX_RANK_WILDCARD for stages that are not specific to one proc */
+PRTE_EXPORT void prte_state_base_trace_stage(const pmix_nspace_t nspace,
+                                             pmix_rank_t rank,
+                                             prte_state_trace_stage_t stage,
+                                             double start);
+/* drop all entries of the given job */
+PRTE_EXPORT void prte_state_base_trace_purge(const pmix_nspace_t nspace);
+/* HNP: gather the trace of the given job from all daemons */
+PRTE_EXPORT void prte_state_base_trace_collect(const pmix_nspace_t nspace);
+/* daemon: send our trace entries for the given job, merged with
+ * those of our children, up the routing tree to the HNP */
+PRTE_EXPORT void prte_state_base_trace_report(const pmix_nspace_t nspace);
+
+/*
+ * Job state rollups - daemons report that all their local procs of a
+ * job registered or terminated by merging their report with those of
+ * their children in the routing tree, so the HNP receives a handful
+ * of aggregated reports and updates the job counters in bulk.
+ */
+PRTE_EXPORT void prte_state_base_rollup_init(void);
+PRTE_EXPORT void prte_state_base_rollup_finalize(void);
+/* post the persistent recv - must be called once the RML is available */
+PRTE_EXPORT void prte_state_base_rollup_start(void);
+/* daemon: contribute the local procs of the job that reached the
+ * given milestone (REGISTERED or TERMINATED) */
+PRTE_EXPORT int prte_state_base_rollup_contribute(prte_job_t *jdata,
+                                                  prte_proc_state_t state);
+
 END_C_DECLS
 
 #endif
@@ -57,6 +57,10 @@ void prte_state_base_activate_job_state(prte_job_t *jdata,
     prte_state_t *s;
     prte_state_caddy_t *caddy;
 
+    if (NULL != jdata) {
+        prte_state_base_trace_job_state(jdata->nspace, state);
+    }
+
     for (itm = prte_list_get_first(&prte_job_states);
          itm != prte_list_get_end(&prte_job_states);
          itm = prte_list_get_next(itm)) {
@@ -232,6 +236,8 @@ void prte_state_base_activate_proc_state(pmix_proc_t *proc,
     prte_state_t *s;
     prte_state_caddy_t *caddy;
 
+    prte_state_base_trace_proc_state(proc, state);
+
     for (itm = prte_list_get_first(&prte_proc_states);
          itm != prte_list_get_end(&prte_proc_states);
          itm = prte_list_get_next(itm)) {
@@ -46,6 +46,9 @@ prte_state_base_module_t prte_state = {0};
 bool prte_state_base_run_fdcheck = false;
 int prte_state_base_parent_fd = -1;
 bool prte_state_base_ready_msg = true;
+int prte_state_base_trace_size = 4096;
+char *prte_state_base_trace_output = NULL;
+int prte_state_base_trace_timeout = 10;
 
 static int prte_state_base_register(prte_mca_base_register_flag_t flags)
 {
@@ -58,6 +61,37 @@ static int prte_state_base_register(prte_mca_base_register_flag_t flags)
                                 PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                 &prte_state_base_run_fdcheck);
 
+    prte_state_base_trace_size = 4096;
+    prte_mca_base_var_register("prte", "state", "base", "trace_size",
+                                "Number of launch trace entries (state transitions and launch "
+                                "stages) retained by each daemon (0 to disable)",
+                                PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                PRTE_INFO_LVL_9,
+                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prte_state_base_trace_size);
+
+    prte_state_base_trace_output = NULL;
+    prte_mca_base_var_register("prte", "state", "base", "trace_output",
+                                "Collect the launch trace of each job from all daemons when the "
+                                "job completes and write it as Chrome/Perfetto JSON to "
+                                "<value>.<local jobid>.json",
+                                PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0,
+                                PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                PRTE_INFO_LVL_9,
+                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prte_state_base_trace_output);
+
+    prte_state_base_trace_timeout = 10;
+    prte_mca_base_var_register("prte", "state", "base", "trace_timeout",
+                                "Seconds to wait for all daemons to report a job's launch "
+                                "trace before writing out what was received (0 to wait forever)",
+                                PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                PRTE_INFO_LVL_9,
+                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prte_state_base_trace_timeout);
+
     return PRTE_SUCCESS;
 }
 
@@ -67,6 +101,8 @@ static int prte_state_base_close(void)
     if (NULL != prte_state.finalize) {
         prte_state.finalize();
     }
+    prte_state_base_trace_finalize();
+    prte_state_base_rollup_finalize();
 
     return prte_mca_base_framework_components_close(&prte_state_base_framework, NULL);
 }
@@ -77,6 +113,13 @@ static int prte_state_base_close(void)
  *    */
 static int prte_state_base_open(prte_mca_base_open_flag_t flags)
 {
+    int rc;
+
+    if (PRTE_SUCCESS != (rc = prte_state_base_trace_init())) {
+        return rc;
+    }
+    prte_state_base_rollup_init();
+
     /* Open up all available components */
     return prte_mca_base_framework_components_open(&prte_state_base_framework, flags);
 }
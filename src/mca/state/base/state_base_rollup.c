@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/class/prte_bitmap.h"
+#include "src/class/prte_list.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/util/name_fns.h"
+#include "src/util/output.h"
+#include "src/util/proc_info.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/rmaps/rmaps_types.h"
+#include "src/mca/rml/rml.h"
+#include "src/mca/routed/routed.h"
+#include "src/runtime/prte_data_server.h"
+#include "src/runtime/prte_globals.h"
+
+#include "src/mca/state/base/base.h"
+#include "src/mca/state/base/state_private.h"
+
+/*
+ * Job milestones (all local procs registered, all local procs
+ * terminated) are reduced up the routing tree instead of being sent
+ * by every daemon to the HNP. Each daemon waits for its own local
+ * report plus one report from each child whose subtree hosts procs
+ * of the job, merges them and forwards a single report to its parent.
+ * A report carries the number of procs that reached the milestone
+ * normally, the set of daemons whose procs are covered, and the
+ * individual procs that terminated abnormally.
+ *
+ * The HNP applies every report it receives, so correctness does
+ * not depend on the aggregation - a daemon that cannot tell what
+ * to expect simply forwards what it has. When fault tolerance is
+ * enabled a child daemon can be lost at any time, so nobody waits
+ * on the tree: every daemon sends its report straight to the HNP.
+ */
+typedef struct {
+    pmix_rank_t rank;
+    pid_t pid;
+    prte_proc_state_t state;
+    int32_t exit_code;
+} prte_state_rollup_proc_t;
+
+typedef struct {
+    prte_list_item_t super;
+    pmix_nspace_t nspace;
+    prte_proc_state_t state;
+    int32_t nexpected;
+    int32_t nrecvd;
+    /* procs that reached the milestone normally */
+    int32_t nprocs;
+    /* daemons whose procs are covered by this report */
+    prte_bitmap_t daemons;
+    prte_state_rollup_proc_t *abnormal;
+    int32_t nabnormal;
+    int32_t size;
+} prte_state_rollup_t;
+static void rcon(prte_state_rollup_t *p)
+{
+    PMIX_LOAD_NSPACE(p->nspace, NULL);
+    p->state = PRTE_PROC_STATE_UNDEF;
+    p->nexpected = 0;
+    p->nrecvd = 0;
+    p->nprocs = 0;
+    PRTE_CONSTRUCT(&p->daemons, prte_bitmap_t);
+    prte_bitmap_init(&p->daemons, (0 < prte_process_info.num_daemons) ?
+                                  (int)prte_process_info.num_daemons : 1);
+    p->abnormal = NULL;
+    p->nabnormal = 0;
+    p->size = 0;
+}
+static void rdes(prte_state_rollup_t *p)
+{
+    PRTE_DESTRUCT(&p->daemons);
+    if (NULL != p->abnormal) {
+        free(p->abnormal);
+    }
+}
+static PRTE_CLASS_INSTANCE(prte_state_rollup_t,
+                           prte_list_item_t,
+                           rcon, rdes);
+
+static prte_list_t rollups;
+static bool recv_posted = false;
+
+static void rollup_recv(int status, pmix_proc_t* sender,
+                        pmix_data_buffer_t* buffer, prte_rml_tag_t tag,
+                        void* cbdata);
+
+void prte_state_base_rollup_init(void)
+{
+    PRTE_CONSTRUCT(&rollups, prte_list_t);
+}
+
+void prte_state_base_rollup_start(void)
+{
+    if (!recv_posted) {
+        prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD, PRTE_RML_TAG_STATE_ROLLUP,
+                                PRTE_RML_PERSISTENT, rollup_recv, NULL);
+        recv_posted = true;
+    }
+}
+
+void prte_state_base_rollup_finalize(void)
+{
+    if (recv_posted) {
+        prte_rml.recv_cancel(PRTE_NAME_WILDCARD, PRTE_RML_TAG_STATE_ROLLUP);
+        recv_posted = false;
+    }
+    PRTE_LIST_DESTRUCT(&rollups);
+}
+
+static int add_abnormal(prte_state_rollup_t *r, pmix_rank_t rank, pid_t pid,
+                        prte_proc_state_t state, int32_t exit_code)
+{
+    prte_state_rollup_proc_t *tmp;
+
+    if (r->nabnormal == r->size) {
+        tmp = (prte_state_rollup_proc_t*)realloc(r->abnormal, (0 == r->size ? 8 : 2 * r->size) *
+                                                              sizeof(prte_state_rollup_proc_t));
+        if (NULL == tmp) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        r->abnormal = tmp;
+        r->size = (0 == r->size) ? 8 : 2 * r->size;
+    }
+    r->abnormal[r->nabnormal].rank = rank;
+    r->abnormal[r->nabnormal].pid = pid;
+    r->abnormal[r->nabnormal].state = state;
+    r->abnormal[r->nabnormal].exit_code = exit_code;
+    r->nabnormal++;
+    return PRTE_SUCCESS;
+}
+
+static bool node_hosts_job(prte_node_t *node, prte_job_t *jdata)
+{
+    prte_proc_t *pptr;
+    int i;
+
+    for (i=0; i < node->procs->size; i++) {
+        if (NULL != (pptr = (prte_proc_t*)prte_pointer_array_get_item(node->procs, i)) &&
+            PMIX_CHECK_NSPACE(pptr->name.nspace, jdata->nspace)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* count the reports we should receive for this job: one for our own
+ * procs, plus one from each child in the routing tree that leads to
+ * a daemon hosting procs of the job. Returns -1 if we cannot tell */
+static int32_t rollup_expected(prte_job_t *jdata)
+{
+    prte_list_t children;
+    prte_namelist_t *nm;
+    prte_bitmap_t kids, seen;
+    prte_node_t *node;
+    pmix_proc_t route;
+    int32_t n = 0, nkids = 0;
+    int i;
+
+    if (!prte_routing_is_enabled || prte_enable_ft ||
+        NULL == jdata || NULL == jdata->map) {
+        return -1;
+    }
+
+    PRTE_CONSTRUCT(&kids, prte_bitmap_t);
+    prte_bitmap_init(&kids, (0 < prte_process_info.num_daemons) ?
+                            (int)prte_process_info.num_daemons : 1);
+    PRTE_CONSTRUCT(&children, prte_list_t);
+    prte_routed.get_routing_list(&children);
+    while (NULL != (nm = (prte_namelist_t*)prte_list_remove_first(&children))) {
+        prte_bitmap_set_bit(&kids, nm->name.rank);
+        nkids++;
+        PRTE_RELEASE(nm);
+    }
+    PRTE_LIST_DESTRUCT(&children);
+
+    PRTE_CONSTRUCT(&seen, prte_bitmap_t);
+    prte_bitmap_init(&seen, (0 < prte_process_info.num_daemons) ?
+                            (int)prte_process_info.num_daemons : 1);
+    for (i=0; i < jdata->map->nodes->size; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, i)) ||
+            NULL == node->daemon || !node_hosts_job(node, jdata)) {
+            continue;
+        }
+        if (node->daemon->name.rank == PRTE_PROC_MY_NAME->rank) {
+            n++;
+            continue;
+        }
+        if (0 == nkids) {
+            continue;
+        }
+        route = prte_routed.get_route(&node->daemon->name);
+        if (PMIX_RANK_INVALID != route.rank &&
+            prte_bitmap_is_set_bit(&kids, route.rank) &&
+            !prte_bitmap_is_set_bit(&seen, route.rank)) {
+            prte_bitmap_set_bit(&seen, route.rank);
+            n++;
+        }
+    }
+    PRTE_DESTRUCT(&kids);
+    PRTE_DESTRUCT(&seen);
+
+    return n;
+}
+
+static prte_state_rollup_t* get_rollup(const pmix_nspace_t nspace, prte_proc_state_t state)
+{
+    prte_state_rollup_t *r;
+
+    PRTE_LIST_FOREACH(r, &rollups, prte_state_rollup_t) {
+        if (r->state == state && PMIX_CHECK_NSPACE(r->nspace, nspace)) {
+            return r;
+        }
+    }
+    r = PRTE_NEW(prte_state_rollup_t);
+    PMIX_LOAD_NSPACE(r->nspace, nspace);
+    r->state = state;
+    r->nexpected = rollup_expected(prte_get_job_data_object(nspace));
+    prte_list_append(&rollups, &r->super);
+
+    PRTE_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                         "%s state:base:rollup tracking %s for job %s expecting %d reports",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         prte_proc_state_to_str(state),
+                         PRTE_JOBID_PRINT(nspace), (int)r->nexpected));
+    return r;
+}
+
+static int pack_rollup(pmix_data_buffer_t *buf, prte_state_rollup_t *r)
+{
+    int32_t i, nwords;
+    pmix_status_t rc;
+
+#if PMIX_NUMERIC_VERSION < 0x00040100
+    char *tmp = NULL;
+    if (0 < strlen(r->nspace)) {
+        tmp = strdup(r->nspace);
+    }
+    rc = PMIx_Data_pack(NULL, buf, (void*)&tmp, 1, PMIX_STRING);
+    if (NULL != tmp) {
+        free(tmp);
+    }
+#else
+    rc = PMIx_Data_pack(NULL, buf, &r->nspace, 1, PMIX_PROC_NSPACE);
+#endif
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &r->state, 1, PMIX_UINT32)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &r->nprocs, 1, PMIX_INT32))) {
+        return rc;
+    }
+    nwords = r->daemons.array_size;
+    if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &nwords, 1, PMIX_INT32))) {
+        return rc;
+    }
+    if (0 < nwords &&
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, r->daemons.bitmap, nwords, PMIX_UINT64))) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &r->nabnormal, 1, PMIX_INT32))) {
+        return rc;
+    }
+    for (i=0; i < r->nabnormal; i++) {
+        if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &r->abnormal[i].rank, 1, PMIX_PROC_RANK)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &r->abnormal[i].pid, 1, PMIX_PID)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &r->abnormal[i].state, 1, PMIX_UINT32)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &r->abnormal[i].exit_code, 1, PMIX_INT32))) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* unpack a report and add it to the given rollup - the nspace and
+ * state have already been unpacked by the caller */
+static int unpack_rollup(pmix_data_buffer_t *buf, prte_state_rollup_t *r)
+{
+    int32_t cnt, i, nwords, nprocs, nabnormal;
+    uint64_t *words;
+    prte_state_rollup_proc_t p;
+    int bit;
+    pmix_status_t rc;
+
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buf, &nprocs, &cnt, PMIX_INT32))) {
+        return rc;
+    }
+    r->nprocs += nprocs;
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buf, &nwords, &cnt, PMIX_INT32))) {
+        return rc;
+    }
+    if (0 < nwords) {
+        words = (uint64_t*)malloc(nwords * sizeof(uint64_t));
+        if (NULL == words) {
+            return PMIX_ERR_NOMEM;
+        }
+        cnt = nwords;
+        if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buf, words, &cnt, PMIX_UINT64))) {
+            free(words);
+            return rc;
+        }
+        for (i=0; i < nwords; i++) {
+            if (i < r->daemons.array_size) {
+                r->daemons.bitmap[i] |= words[i];
+                continue;
+            }
+            for (bit=0; 0 != words[i] && bit < 64; bit++) {
+                if (words[i] & (1ULL << bit)) {
+                    prte_bitmap_set_bit(&r->daemons, i * 64 + bit);
+                }
+            }
+        }
+        free(words);
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buf, &nabnormal, &cnt, PMIX_INT32))) {
+        return rc;
+    }
+    for (i=0; i < nabnormal; i++) {
+        cnt = 1;
+        if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buf, &p.rank, &cnt, PMIX_PROC_RANK))) {
+            return rc;
+        }
+        cnt = 1;
+        if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buf, &p.pid, &cnt, PMIX_PID))) {
+            return rc;
+        }
+        cnt = 1;
+        if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buf, &p.state, &cnt, PMIX_UINT32))) {
+            return rc;
+        }
+        cnt = 1;
+        if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buf, &p.exit_code, &cnt, PMIX_INT32))) {
+            return rc;
+        }
+        if (PRTE_SUCCESS != add_abnormal(r, p.rank, p.pid, p.state, p.exit_code)) {
+            return PMIX_ERR_NOMEM;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* HNP: apply a report to the job in bulk */
+static void rollup_apply(prte_state_rollup_t *r)
+{
+    prte_job_t *jdata, *daemons;
+    prte_proc_t *dmn, *pptr;
+    prte_node_t *node;
+    prte_bitmap_t skip;
+    pmix_proc_t name;
+    int32_t i, n = 0;
+    int v, k;
+
+    if (NULL == (jdata = prte_get_job_data_object(r->nspace))) {
+        PRTE_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                             "%s state:base:rollup job %s not found",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_JOBID_PRINT(r->nspace)));
+        return;
+    }
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+
+    PRTE_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                         "%s state:base:rollup applying %s for job %s: %d procs %d abnormal",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         prte_proc_state_to_str(r->state),
+                         PRTE_JOBID_PRINT(r->nspace),
+                         (int)r->nprocs, (int)r->nabnormal));
+
+    /* the abnormal procs are passed thru the state machine individually
+     * so their transitions are handled as before - exclude them from
+     * the bulk update */
+    PRTE_CONSTRUCT(&skip, prte_bitmap_t);
+    for (i=0; i < r->nabnormal; i++) {
+        if (NULL != (pptr = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, r->abnormal[i].rank))) {
+            pptr->pid = r->abnormal[i].pid;
+            pptr->exit_code = r->abnormal[i].exit_code;
+        }
+        prte_bitmap_set_bit(&skip, r->abnormal[i].rank);
+    }
+
+    for (v=0; NULL != daemons && v < prte_bitmap_size(&r->daemons); v++) {
+        if (!prte_bitmap_is_set_bit(&r->daemons, v) ||
+            NULL == (dmn = (prte_proc_t*)prte_pointer_array_get_item(daemons->procs, v)) ||
+            NULL == (node = dmn->node)) {
+            continue;
+        }
+        for (k=0; k < node->procs->size; k++) {
+            if (NULL == (pptr = (prte_proc_t*)prte_pointer_array_get_item(node->procs, k)) ||
+                !PMIX_CHECK_NSPACE(pptr->name.nspace, jdata->nspace) ||
+                (0 < r->nabnormal && prte_bitmap_is_set_bit(&skip, pptr->name.rank))) {
+                continue;
+            }
+            if (PRTE_PROC_STATE_TERMINATED == r->state) {
+                if (PRTE_PROC_STATE_TERMINATED == pptr->state) {
+                    continue;
+                }
+                PRTE_FLAG_UNSET(pptr, PRTE_PROC_FLAG_ALIVE);
+            }
+            if (pptr->state < PRTE_PROC_STATE_TERMINATED) {
+                pptr->state = r->state;
+            }
+            n++;
+        }
+    }
+    PRTE_DESTRUCT(&skip);
+
+    if (n != r->nprocs) {
+        PRTE_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                             "%s state:base:rollup job %s reported %d procs but %d applied",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_JOBID_PRINT(r->nspace), (int)r->nprocs, (int)n));
+    }
+
+    if (PRTE_PROC_STATE_REGISTERED == r->state) {
+        jdata->num_reported += n;
+        if (0 < n && jdata->num_reported == jdata->num_procs) {
+            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_REGISTERED);
+        }
+    } else {
+        jdata->num_terminated += n;
+        if (0 < n && jdata->num_terminated == jdata->num_procs) {
+            /* if requested, check fd status for leaks */
+            if (prte_state_base_run_fdcheck) {
+                prte_state_base_check_fds(jdata);
+            }
+            /* if ompi-server is around, then notify it to purge
+             * any session-related info */
+            if (NULL != prte_data_server_uri) {
+                PMIX_LOAD_PROCID(&name, jdata->nspace, PMIX_RANK_WILDCARD);
+                prte_state_base_notify_data_server(&name);
+            }
+            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_TERMINATED);
+        }
+    }
+
+    /* NEVER update the state of the abnormal procs before activating
+     * the state machine - let the state cbfunc compare it against
+     * the prior proc state */
+    for (i=0; i < r->nabnormal; i++) {
+        PMIX_LOAD_PROCID(&name, jdata->nspace, r->abnormal[i].rank);
+        PRTE_ACTIVATE_PROC_STATE(&name, r->abnormal[i].state);
+    }
+}
+
+/* see if a rollup is complete and, if so, pass it on */
+static void check_complete(prte_state_rollup_t *r)
+{
+    pmix_data_buffer_t *buf;
+    prte_state_rollup_t *reg;
+    pmix_proc_t *dest;
+    int rc;
+
+    if (0 <= r->nexpected && r->nrecvd < r->nexpected) {
+        return;
+    }
+    prte_list_remove_item(&rollups, &r->super);
+
+    if (PRTE_PROC_IS_MASTER) {
+        rollup_apply(r);
+    } else {
+        /* under FT our parent may be gone, so don't depend on it */
+        dest = prte_enable_ft ? PRTE_PROC_MY_HNP : PRTE_PROC_MY_PARENT;
+        PRTE_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                             "%s state:base:rollup sending %s for job %s to %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             prte_proc_state_to_str(r->state),
+                             PRTE_JOBID_PRINT(r->nspace),
+                             PRTE_NAME_PRINT(dest)));
+        PMIX_DATA_BUFFER_CREATE(buf);
+        if (PMIX_SUCCESS != (rc = pack_rollup(buf, r))) {
+            PMIX_ERROR_LOG(rc);
+        } else if (PRTE_SUCCESS != (rc = prte_rml.send_buffer_nb(dest, buf,
+                                                                 PRTE_RML_TAG_STATE_ROLLUP,
+                                                                 prte_rml_send_callback, NULL))) {
+            PRTE_ERROR_LOG(rc);
+        }
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+
+    /* once a job has terminated, a registration rollup that is still
+     * waiting (e.g., procs that never registered) can never complete */
+    if (PRTE_PROC_STATE_TERMINATED == r->state) {
+        PRTE_LIST_FOREACH(reg, &rollups, prte_state_rollup_t) {
+            if (PRTE_PROC_STATE_REGISTERED == reg->state &&
+                PMIX_CHECK_NSPACE(reg->nspace, r->nspace)) {
+                prte_list_remove_item(&rollups, &reg->super);
+                PRTE_RELEASE(reg);
+                break;
+            }
+        }
+    }
+    PRTE_RELEASE(r);
+}
+
+int prte_state_base_rollup_contribute(prte_job_t *jdata, prte_proc_state_t state)
+{
+    prte_state_rollup_t *r;
+    prte_proc_t *child;
+    int i, rc;
+
+    r = get_rollup(jdata->nspace, state);
+    for (i=0; i < prte_local_children->size; i++) {
+        if (NULL == (child = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, i)) ||
+            !PMIX_CHECK_NSPACE(child->name.nspace, jdata->nspace)) {
+            continue;
+        }
+        if (PRTE_PROC_STATE_TERMINATED == state &&
+            (PRTE_PROC_STATE_TERMINATED != child->state || 0 != child->exit_code)) {
+            if (PRTE_SUCCESS != (rc = add_abnormal(r, child->name.rank, child->pid,
+                                                   child->state, child->exit_code))) {
+                PRTE_ERROR_LOG(rc);
+                return rc;
+            }
+        } else {
+            r->nprocs++;
+        }
+    }
+    prte_bitmap_set_bit(&r->daemons, PRTE_PROC_MY_NAME->rank);
+    r->nrecvd++;
+    check_complete(r);
+    return PRTE_SUCCESS;
+}
+
+static void rollup_recv(int status, pmix_proc_t* sender,
+                        pmix_data_buffer_t* buffer, prte_rml_tag_t tag,
+                        void* cbdata)
+{
+    prte_state_rollup_t *r;
+    pmix_nspace_t nspace;
+    prte_proc_state_t state;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    cnt = 1;
+#if PMIX_NUMERIC_VERSION < 0x00040100
+    char *tmp = NULL;
+    rc = PMIx_Data_unpack(NULL, buffer, &tmp, &cnt, PMIX_STRING);
+    PMIX_LOAD_NSPACE(nspace, tmp);
+    if (NULL != tmp) {
+        free(tmp);
+    }
+#else
+    rc = PMIx_Data_unpack(NULL, buffer, &nspace, &cnt, PMIX_PROC_NSPACE);
+#endif
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buffer, &state, &cnt, PMIX_UINT32))) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    PRTE_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                         "%s state:base:rollup recvd %s for job %s from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         prte_proc_state_to_str(state),
+                         PRTE_JOBID_PRINT(nspace),
+                         PRTE_NAME_PRINT(sender)));
+
+    if (PRTE_PROC_IS_MASTER) {
+        /* no need to aggregate - just apply it */
+        r = PRTE_NEW(prte_state_rollup_t);
+        PMIX_LOAD_NSPACE(r->nspace, nspace);
+        r->state = state;
+        if (PMIX_SUCCESS != (rc = unpack_rollup(buffer, r))) {
+            PMIX_ERROR_LOG(rc);
+            PRTE_RELEASE(r);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            return;
+        }
+        rollup_apply(r);
+        PRTE_RELEASE(r);
+        return;
+    }
+
+    r = get_rollup(nspace, state);
+    if (PMIX_SUCCESS != (rc = unpack_rollup(buffer, r))) {
+        PMIX_ERROR_LOG(rc);
+    }
+    r->nrecvd++;
+    check_complete(r);
+}
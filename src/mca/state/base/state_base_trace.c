@@ -0,0 +1,707 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "src/class/prte_list.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/sys/atomic.h"
+#include "src/util/error_strings.h"
+#include "src/util/name_fns.h"
+#include "src/util/output.h"
+#include "src/util/proc_info.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/grpcomm/grpcomm.h"
+#include "src/mca/odls/odls_types.h"
+#include "src/mca/rml/rml.h"
+#include "src/mca/routed/routed.h"
+#include "src/runtime/prte_globals.h"
+
+#include "src/mca/state/base/base.h"
+
+/*
+ * Each entry is a single state transition (start == end) or a
+ * completed stage. Entries are claimed with an atomic increment of
+ * the ring position so any thread can record without locking - a
+ * report taken while entries are being written may include a
+ * partially written entry, which is acceptable for diagnostics.
+ * Entries only carry the local jobid, which the DVM recycles, so a
+ * job's entries are cleared when the job is cleaned up and again
+ * when its jobid is handed out.
+ */
+#define PRTE_STATE_TRACE_JOB    1
+#define PRTE_STATE_TRACE_PROC   2
+#define PRTE_STATE_TRACE_STAGE  3
+
+typedef struct {
+    double start;
+    double end;
+    int32_t jobid;
+    pmix_rank_t rank;
+    uint16_t type;
+    uint16_t id;
+} prte_state_trace_event_t;
+
+static prte_state_trace_event_t *ring = NULL;
+static uint32_t ring_mask = 0;
+static prte_atomic_int32_t ring_next = 0;
+
+static const char *stage_names[PRTE_STATE_TRACE_NUM_STAGES] = {
+    "map",
+    "get_add_procs_data",
+    "xcast",
+    "construct_child_list",
+    "pmix_register",
+    "fork"
+};
+
+/* HNP-side tracking of a job's trace collection */
+typedef struct {
+    prte_list_item_t super;
+    pmix_nspace_t nspace;
+    int32_t jobid;
+    int32_t nexpected;
+    int32_t nreported;
+    bool first;
+    FILE *fp;
+    prte_event_t ev;
+    bool timer_active;
+} prte_state_trace_collector_t;
+static void ccon(prte_state_trace_collector_t *p)
+{
+    PMIX_LOAD_NSPACE(p->nspace, NULL);
+    p->jobid = -1;
+    p->nexpected = 0;
+    p->nreported = 0;
+    p->first = true;
+    p->fp = NULL;
+    p->timer_active = false;
+}
+static void cdes(prte_state_trace_collector_t *p)
+{
+    if (p->timer_active) {
+        prte_event_evtimer_del(&p->ev);
+    }
+    if (NULL != p->fp) {
+        fprintf(p->fp, "\n]}\n");
+        fclose(p->fp);
+    }
+}
+static PRTE_CLASS_INSTANCE(prte_state_trace_collector_t,
+                           prte_list_item_t,
+                           ccon, cdes);
+
+/* daemon-side merge of our own reply with those of our children in
+ * the routing tree */
+typedef struct {
+    prte_list_item_t super;
+    pmix_nspace_t nspace;
+    int32_t nexpected;
+    int32_t nrecvd;
+    int32_t nsections;
+    pmix_data_buffer_t sections;
+    prte_event_t ev;
+    bool timer_active;
+} prte_state_trace_agg_t;
+static void acon(prte_state_trace_agg_t *p)
+{
+    PMIX_LOAD_NSPACE(p->nspace, NULL);
+    p->nexpected = 1;
+    p->nrecvd = 0;
+    p->nsections = 0;
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->sections);
+    p->timer_active = false;
+}
+static void ades(prte_state_trace_agg_t *p)
+{
+    if (p->timer_active) {
+        prte_event_evtimer_del(&p->ev);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&p->sections);
+}
+static PRTE_CLASS_INSTANCE(prte_state_trace_agg_t,
+                           prte_list_item_t,
+                           acon, ades);
+
+static prte_list_t collectors;
+static prte_list_t aggregators;
+static bool recv_posted = false;
+
+static void trace_recv(int status, pmix_proc_t* sender,
+                       pmix_data_buffer_t* buffer, prte_rml_tag_t tag,
+                       void* cbdata);
+static void write_sections(prte_state_trace_collector_t *coll, int32_t nsections,
+                           pmix_data_buffer_t *buffer);
+
+int prte_state_base_trace_init(void)
+{
+    uint32_t size;
+
+    PRTE_CONSTRUCT(&collectors, prte_list_t);
+    PRTE_CONSTRUCT(&aggregators, prte_list_t);
+    if (0 >= prte_state_base_trace_size) {
+        return PRTE_SUCCESS;
+    }
+    /* round up to a power of two so the position can be masked */
+    size = 1;
+    while (size < (uint32_t)prte_state_base_trace_size && size < (1U << 30)) {
+        size <<= 1;
+    }
+    ring = (prte_state_trace_event_t*)calloc(size, sizeof(prte_state_trace_event_t));
+    if (NULL == ring) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    ring_mask = size - 1;
+    ring_next = 0;
+    return PRTE_SUCCESS;
+}
+
+void prte_state_base_trace_finalize(void)
+{
+    if (recv_posted) {
+        prte_rml.recv_cancel(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_TRACE);
+        recv_posted = false;
+    }
+    /* close out any traces that never completed */
+    PRTE_LIST_DESTRUCT(&collectors);
+    PRTE_LIST_DESTRUCT(&aggregators);
+    if (NULL != ring) {
+        free(ring);
+        ring = NULL;
+    }
+}
+
+double prte_state_base_trace_time(void)
+{
+    double t;
+
+    if (NULL == ring) {
+        return 0.0;
+    }
+    PRTE_STATE_GET_TIMESTAMP(t);
+    return t;
+}
+
+static void record(int32_t jobid, pmix_rank_t rank, uint16_t type,
+                   uint16_t id, double start, double end)
+{
+    prte_state_trace_event_t *ev;
+    uint32_t n;
+
+    n = (uint32_t)prte_atomic_fetch_add_32(&ring_next, 1);
+    ev = &ring[n & ring_mask];
+    ev->start = start;
+    ev->end = end;
+    ev->jobid = jobid;
+    ev->rank = rank;
+    ev->type = type;
+    ev->id = id;
+}
+
+void prte_state_base_trace_job_state(const pmix_nspace_t nspace,
+                                     prte_job_state_t state)
+{
+    double t;
+
+    if (NULL == ring) {
+        return;
+    }
+    if (PRTE_JOB_STATE_INIT_COMPLETE == state) {
+        /* the job was just given its jobid - drop anything left
+         * behind by an earlier job that had the same one */
+        prte_state_base_trace_purge(nspace);
+    }
+    PRTE_STATE_GET_TIMESTAMP(t);
+    record(PRTE_LOCAL_JOBID((char*)nspace), PMIX_RANK_WILDCARD,
+           PRTE_STATE_TRACE_JOB, (uint16_t)state, t, t);
+}
+
+void prte_state_base_trace_purge(const pmix_nspace_t nspace)
+{
+    uint32_t n, first, last;
+    int32_t jobid;
+
+    if (NULL == ring) {
+        return;
+    }
+    jobid = PRTE_LOCAL_JOBID((char*)nspace);
+    last = (uint32_t)ring_next;
+    first = (last > ring_mask + 1) ? last - (ring_mask + 1) : 0;
+    for (n = first; n < last; n++) {
+        if (ring[n & ring_mask].jobid == jobid) {
+            ring[n & ring_mask].jobid = -1;
+        }
+    }
+}
+
+void prte_state_base_trace_proc_state(const pmix_proc_t *proc,
+                                      prte_proc_state_t state)
+{
+    double t;
+
+    if (NULL == ring) {
+        return;
+    }
+    PRTE_STATE_GET_TIMESTAMP(t);
+    record(PRTE_LOCAL_JOBID((char*)proc->nspace), proc->rank,
+           PRTE_STATE_TRACE_PROC, (uint16_t)state, t, t);
+}
+
+void prte_state_base_trace_stage(const pmix_nspace_t nspace,
+                                 pmix_rank_t rank,
+                                 prte_state_trace_stage_t stage,
+                                 double start)
+{
+    double t;
+
+    if (NULL == ring) {
+        return;
+    }
+    PRTE_STATE_GET_TIMESTAMP(t);
+    record(PRTE_LOCAL_JOBID((char*)nspace), rank,
+           PRTE_STATE_TRACE_STAGE, (uint16_t)stage, start, t);
+}
+
+/*
+ * Replies are merged up the routing tree: each daemon waits for its
+ * own section plus one reply from each of its children, then sends
+ * them on to its parent as one message. When fault tolerance is
+ * enabled a child can be lost at any time, so every daemon replies
+ * straight to the HNP instead. Format:
+ *
+ *  nspace        the job
+ *  int32         number of sections
+ *  per section:  rank of the daemon, string nodename, int32 number
+ *                of entries, then per entry: double start, double end,
+ *                rank, uint16 type, uint16 id
+ */
+static int pack_nspace(pmix_data_buffer_t *buf, const pmix_nspace_t nspace)
+{
+    pmix_status_t rc;
+
+#if PMIX_NUMERIC_VERSION < 0x00040100
+    char *tmp = NULL;
+    if (0 < strlen(nspace)) {
+        tmp = strdup(nspace);
+    }
+    rc = PMIx_Data_pack(NULL, buf, (void*)&tmp, 1, PMIX_STRING);
+    if (NULL != tmp) {
+        free(tmp);
+    }
+#else
+    rc = PMIx_Data_pack(NULL, buf, (void*)nspace, 1, PMIX_PROC_NSPACE);
+#endif
+    return rc;
+}
+
+static prte_state_trace_collector_t* find_collector(const pmix_nspace_t nspace)
+{
+    prte_state_trace_collector_t *coll;
+
+    PRTE_LIST_FOREACH(coll, &collectors, prte_state_trace_collector_t) {
+        if (PMIX_CHECK_NSPACE(coll->nspace, nspace)) {
+            return coll;
+        }
+    }
+    return NULL;
+}
+
+static void agg_send(prte_state_trace_agg_t *agg)
+{
+    pmix_data_buffer_t *buf;
+    pmix_proc_t *dest;
+    int rc;
+
+    prte_list_remove_item(&aggregators, &agg->super);
+    dest = (prte_routing_is_enabled && !prte_enable_ft) ? PRTE_PROC_MY_PARENT : PRTE_PROC_MY_HNP;
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    if (PMIX_SUCCESS != (rc = pack_nspace(buf, agg->nspace)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, buf, &agg->nsections, 1, PMIX_INT32)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_copy_payload(buf, &agg->sections))) {
+        PMIX_ERROR_LOG(rc);
+    } else if (PRTE_SUCCESS != (rc = prte_rml.send_buffer_nb(dest, buf,
+                                                             PRTE_RML_TAG_LAUNCH_TRACE,
+                                                             prte_rml_send_callback, NULL))) {
+        PRTE_ERROR_LOG(rc);
+    }
+    PMIX_DATA_BUFFER_RELEASE(buf);
+    PRTE_RELEASE(agg);
+}
+
+static void agg_timeout(int fd, short args, void *cbdata)
+{
+    prte_state_trace_agg_t *agg = (prte_state_trace_agg_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(agg);
+    agg->timer_active = false;
+    PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                         "%s launch trace for job %s timed out with %d of %d replies",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         PRTE_JOBID_PRINT(agg->nspace),
+                         (int)agg->nrecvd, (int)agg->nexpected));
+    agg_send(agg);
+}
+
+static prte_state_trace_agg_t* get_agg(const pmix_nspace_t nspace)
+{
+    prte_state_trace_agg_t *agg;
+    struct timeval tv;
+
+    PRTE_LIST_FOREACH(agg, &aggregators, prte_state_trace_agg_t) {
+        if (PMIX_CHECK_NSPACE(agg->nspace, nspace)) {
+            return agg;
+        }
+    }
+    agg = PRTE_NEW(prte_state_trace_agg_t);
+    PMIX_LOAD_NSPACE(agg->nspace, nspace);
+    if (prte_routing_is_enabled && !prte_enable_ft) {
+        agg->nexpected += prte_routed.num_routes();
+    }
+    if (0 < prte_state_base_trace_timeout) {
+        /* give up on missing children in time for the HNP
+         * to still include the rest of our subtree */
+        tv.tv_sec = prte_state_base_trace_timeout / 2;
+        tv.tv_usec = (prte_state_base_trace_timeout % 2) * 500000;
+        prte_event_evtimer_set(prte_event_base, &agg->ev, agg_timeout, agg);
+        prte_event_evtimer_add(&agg->ev, &tv);
+        agg->timer_active = true;
+    }
+    prte_list_append(&aggregators, &agg->super);
+    return agg;
+}
+
+/* add sections to the job's merged reply and pass it on once
+ * everyone we are waiting for has replied */
+static void agg_add(const pmix_nspace_t nspace, int32_t nsections,
+                    pmix_data_buffer_t *buffer)
+{
+    prte_state_trace_agg_t *agg;
+    pmix_status_t rc;
+
+    agg = get_agg(nspace);
+    rc = PMIx_Data_copy_payload(&agg->sections, buffer);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    } else {
+        agg->nsections += nsections;
+    }
+    agg->nrecvd++;
+    if (agg->nrecvd >= agg->nexpected) {
+        agg_send(agg);
+    }
+}
+
+void prte_state_base_trace_report(const pmix_nspace_t nspace)
+{
+    pmix_data_buffer_t sec;
+    prte_state_trace_collector_t *coll;
+    prte_state_trace_event_t *evs = NULL, *ev;
+    uint32_t n, first, last;
+    int32_t jobid, cnt, i;
+    pmix_status_t rc;
+
+    jobid = PRTE_LOCAL_JOBID((char*)nspace);
+    /* take a snapshot of our entries for this job as other threads
+     * may continue to record while we pack. Our parent waits for a
+     * reply from us, so respond even if we have nothing to report */
+    cnt = 0;
+    if (NULL != ring) {
+        last = (uint32_t)ring_next;
+        first = (last > ring_mask + 1) ? last - (ring_mask + 1) : 0;
+        evs = (prte_state_trace_event_t*)malloc((last - first) * sizeof(prte_state_trace_event_t));
+        for (n = first; NULL != evs && n < last; n++) {
+            if (ring[n & ring_mask].jobid == jobid) {
+                evs[cnt++] = ring[n & ring_mask];
+            }
+        }
+    }
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&sec);
+    rc = PMIx_Data_pack(NULL, &sec, &PRTE_PROC_MY_NAME->rank, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &sec, &prte_process_info.nodename, 1, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &sec, &cnt, 1, PMIX_INT32);
+    }
+    for (i = 0; PMIX_SUCCESS == rc && i < cnt; i++) {
+        ev = &evs[i];
+        if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &sec, &ev->start, 1, PMIX_DOUBLE)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &sec, &ev->end, 1, PMIX_DOUBLE)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &sec, &ev->rank, 1, PMIX_PROC_RANK)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &sec, &ev->type, 1, PMIX_UINT16)) ||
+            PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, &sec, &ev->id, 1, PMIX_UINT16))) {
+            break;
+        }
+    }
+    if (NULL != evs) {
+        free(evs);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        /* still count ourselves so nobody waits on us */
+        PMIX_DATA_BUFFER_DESTRUCT(&sec);
+        PMIX_DATA_BUFFER_CONSTRUCT(&sec);
+        cnt = 0;
+    } else {
+        cnt = 1;
+    }
+
+    if (PRTE_PROC_IS_MASTER) {
+        if (NULL != (coll = find_collector(nspace))) {
+            write_sections(coll, cnt, &sec);
+        }
+    } else {
+        agg_add(nspace, cnt, &sec);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&sec);
+}
+
+static void collect_timeout(int fd, short args, void *cbdata)
+{
+    prte_state_trace_collector_t *coll = (prte_state_trace_collector_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(coll);
+    coll->timer_active = false;
+    prte_output(0, "%s launch trace for job %d is partial: %d of %d daemons reported",
+                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), coll->jobid,
+                (int)coll->nreported, (int)coll->nexpected);
+    /* closes the file */
+    prte_list_remove_item(&collectors, &coll->super);
+    PRTE_RELEASE(coll);
+}
+
+void prte_state_base_trace_start(void)
+{
+    if (!recv_posted) {
+        prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_TRACE,
+                                PRTE_RML_PERSISTENT, trace_recv, NULL);
+        recv_posted = true;
+    }
+}
+
+void prte_state_base_trace_collect(const pmix_nspace_t nspace)
+{
+    prte_state_trace_collector_t *coll;
+    prte_grpcomm_signature_t sig;
+    pmix_data_buffer_t *buf;
+    prte_daemon_cmd_flag_t command = PRTE_DAEMON_REPORT_TRACE_CMD;
+    struct timeval tv;
+    char *filename;
+    int rc;
+
+    if (NULL == prte_state_base_trace_output || !PRTE_PROC_IS_MASTER) {
+        return;
+    }
+
+    coll = PRTE_NEW(prte_state_trace_collector_t);
+    PMIX_LOAD_NSPACE(coll->nspace, nspace);
+    coll->jobid = PRTE_LOCAL_JOBID((char*)nspace);
+    coll->nexpected = prte_process_info.num_daemons;
+    if (0 > prte_asprintf(&filename, "%s.%d.json", prte_state_base_trace_output, coll->jobid)) {
+        PRTE_RELEASE(coll);
+        return;
+    }
+    coll->fp = fopen(filename, "w");
+    if (NULL == coll->fp) {
+        prte_output(0, "%s unable to open launch trace file %s",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), filename);
+        free(filename);
+        PRTE_RELEASE(coll);
+        return;
+    }
+    free(filename);
+    fprintf(coll->fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    prte_list_append(&collectors, &coll->super);
+
+    /* ask every daemon for its entries */
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &command, 1, PRTE_DAEMON_CMD);
+    if (PMIX_SUCCESS == rc) {
+        rc = pack_nspace(buf, nspace);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        prte_list_remove_item(&collectors, &coll->super);
+        PRTE_RELEASE(coll);
+        return;
+    }
+    PMIX_PROC_CREATE(sig.signature, 1);
+    PMIX_LOAD_PROCID(&sig.signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+    sig.sz = 1;
+    if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(&sig, PRTE_RML_TAG_DAEMON, buf))) {
+        PRTE_ERROR_LOG(rc);
+        prte_list_remove_item(&collectors, &coll->super);
+        PRTE_RELEASE(coll);
+    } else if (0 < prte_state_base_trace_timeout) {
+        /* don't wait forever on daemons that never reply */
+        tv.tv_sec = prte_state_base_trace_timeout;
+        tv.tv_usec = 0;
+        prte_event_evtimer_set(prte_event_base, &coll->ev, collect_timeout, coll);
+        prte_event_evtimer_add(&coll->ev, &tv);
+        coll->timer_active = true;
+    }
+    PMIX_DATA_BUFFER_RELEASE(buf);
+    PMIX_PROC_FREE(sig.signature, 1);
+}
+
+static void emit(prte_state_trace_collector_t *coll, const char *fmt, ...)
+{
+    va_list ap;
+
+    if (!coll->first) {
+        fputc(',', coll->fp);
+    }
+    coll->first = false;
+    fputs("\n  ", coll->fp);
+    va_start(ap, fmt);
+    vfprintf(coll->fp, fmt, ap);
+    va_end(ap);
+}
+
+/* HNP: write out the given number of sections, closing the trace
+ * once every daemon has been heard from */
+static void write_sections(prte_state_trace_collector_t *coll, int32_t nsections,
+                           pmix_data_buffer_t *buffer)
+{
+    prte_state_trace_event_t ev;
+    pmix_rank_t vpid;
+    int32_t cnt, n, i, s;
+    char *nodename;
+    unsigned int tid;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    for (s = 0; PMIX_SUCCESS == rc && s < nsections; s++) {
+        nodename = NULL;
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &vpid, &n, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == rc) {
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &nodename, &n, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS == rc) {
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &cnt, &n, PMIX_INT32);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            if (NULL != nodename) {
+                free(nodename);
+            }
+            break;
+        }
+
+        /* each daemon is shown as its own process, with thread 0 for
+         * the daemon itself and one thread per proc it hosts */
+        emit(coll, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %u, "
+                   "\"args\": {\"name\": \"%s %s\"}}",
+             vpid, PRTE_VPID_PRINT(vpid), (NULL == nodename) ? "" : nodename);
+        if (NULL != nodename) {
+            free(nodename);
+        }
+
+        for (i = 0; i < cnt; i++) {
+            n = 1;
+            if (PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buffer, &ev.start, &n, PMIX_DOUBLE)) ||
+                PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buffer, &ev.end, &n, PMIX_DOUBLE)) ||
+                PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buffer, &ev.rank, &n, PMIX_PROC_RANK)) ||
+                PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buffer, &ev.type, &n, PMIX_UINT16)) ||
+                PMIX_SUCCESS != (rc = PMIx_Data_unpack(NULL, buffer, &ev.id, &n, PMIX_UINT16))) {
+                PMIX_ERROR_LOG(rc);
+                break;
+            }
+            tid = (PMIX_RANK_WILDCARD == ev.rank) ? 0 : ev.rank + 1;
+            switch (ev.type) {
+                case PRTE_STATE_TRACE_JOB:
+                    emit(coll, "{\"name\": \"%s\", \"cat\": \"job\", \"ph\": \"i\", \"s\": \"p\", "
+                               "\"ts\": %.3f, \"pid\": %u, \"tid\": 0}",
+                         prte_job_state_to_str(ev.id), ev.start * 1000000.0, vpid);
+                    break;
+                case PRTE_STATE_TRACE_PROC:
+                    emit(coll, "{\"name\": \"%s\", \"cat\": \"proc\", \"ph\": \"i\", \"s\": \"t\", "
+                               "\"ts\": %.3f, \"pid\": %u, \"tid\": %u}",
+                         prte_proc_state_to_str(ev.id), ev.start * 1000000.0, vpid, tid);
+                    break;
+                case PRTE_STATE_TRACE_STAGE:
+                    if (PRTE_STATE_TRACE_NUM_STAGES <= ev.id) {
+                        break;
+                    }
+                    emit(coll, "{\"name\": \"%s\", \"cat\": \"stage\", \"ph\": \"X\", "
+                               "\"ts\": %.3f, \"dur\": %.3f, \"pid\": %u, \"tid\": %u}",
+                         stage_names[ev.id], ev.start * 1000000.0,
+                         (ev.end - ev.start) * 1000000.0, vpid, tid);
+                    break;
+                default:
+                    break;
+            }
+        }
+        coll->nreported++;
+    }
+
+    if (coll->nreported >= coll->nexpected) {
+        PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                             "%s launch trace for job %d complete",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), coll->jobid));
+        /* closes the file */
+        prte_list_remove_item(&collectors, &coll->super);
+        PRTE_RELEASE(coll);
+    }
+}
+
+static void trace_recv(int status, pmix_proc_t* sender,
+                       pmix_data_buffer_t* buffer, prte_rml_tag_t tag,
+                       void* cbdata)
+{
+    prte_state_trace_collector_t *coll;
+    pmix_nspace_t nspace;
+    int32_t nsections, n;
+    pmix_status_t rc;
+
+    n = 1;
+#if PMIX_NUMERIC_VERSION < 0x00040100
+    char *tmp = NULL;
+    rc = PMIx_Data_unpack(NULL, buffer, &tmp, &n, PMIX_STRING);
+    PMIX_LOAD_NSPACE(nspace, tmp);
+    if (NULL != tmp) {
+        free(tmp);
+    }
+#else
+    rc = PMIx_Data_unpack(NULL, buffer, &nspace, &n, PMIX_PROC_NSPACE);
+#endif
+    if (PMIX_SUCCESS == rc) {
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &nsections, &n, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    if (!PRTE_PROC_IS_MASTER) {
+        /* merge it with the rest of our subtree */
+        agg_add(nspace, nsections, buffer);
+        return;
+    }
+    if (NULL == (coll = find_collector(nspace))) {
+        /* collection was abandoned */
+        return;
+    }
+    write_sections(coll, nsections, buffer);
+}
@@ -687,7 +687,7 @@ static void check_complete(int fd, short args, void *cbdata)
     if (0 > prte_asprintf(&tmp, "%s/%u", prte_process_info.jobfam_session_dir, PRTE_LOCAL_JOBID(jdata->nspace))) {
         PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
     } else {
-        prte_os_dirpath_destroy(tmp, true, NULL);
+        prte_os_dirpath_destroy_tree(tmp);
         free(tmp);
     }
 
@@ -877,6 +877,12 @@ static void dvm_notify(int sd, short args, void *cbdata)
         PMIX_PROC_FREE(sig.signature, 1);
     }
 
+    /* if requested, gather the job's launch trace from all daemons */
+    if (!PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_DEBUGGER_DAEMON) &&
+        !PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_TOOL)) {
+        prte_state_base_trace_collect(jdata->nspace);
+    }
+
     /* now ensure that _all_ daemons know that this job has terminated so even
      * those that did not participate in it will know to cleanup the resources
      * they assigned to the job. This is necessary now that the mapping function
@@ -67,7 +67,6 @@ prte_state_base_module_t prte_state_prted_module = {
 /* Local functions */
 static void track_jobs(int fd, short argc, void *cbdata);
 static void track_procs(int fd, short argc, void *cbdata);
-static int pack_state_update(pmix_data_buffer_t *buf, prte_job_t *jdata);
 
 /* defined default state machines */
 static prte_job_state_t job_states[] = {
@@ -426,56 +425,8 @@ static void track_procs(int fd, short argc, void *cbdata)
                                  "%s state:prted: notifying HNP all local registered",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
 
-            PMIX_DATA_BUFFER_CREATE(alert);
-            /* pack registered command */
-            cmd = PRTE_PLM_REGISTERED_CMD;
-            rc = PMIx_Data_pack(NULL, alert, &cmd, 1, PMIX_UINT8);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                goto cleanup;
-            }
-            /* pack the jobid */
-#if PMIX_NUMERIC_VERSION < 0x00040100
-            char *tmp = NULL;
-            if (0 < strlen(proc->nspace)) {
-                tmp = strdup(proc->nspace);
-            }
-            rc = PMIx_Data_pack(NULL, alert, (void*)&tmp, 1, PMIX_STRING);
-            if (NULL != tmp) {
-                free(tmp);
-            }
-#else
-            rc = PMIx_Data_pack(NULL, alert, &proc->nspace, 1, PMIX_PROC_NSPACE);
-#endif
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                goto cleanup;
-            }
-
-            /* pack all the local child vpids */
-            for (i=0; i < prte_local_children->size; i++) {
-                if (NULL == (pptr = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, i))) {
-                    continue;
-                }
-                if (PMIX_CHECK_NSPACE(pptr->name.nspace, proc->nspace)) {
-                    rc = PMIx_Data_pack(NULL, alert, &pptr->name.rank, 1, PMIX_PROC_RANK);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_DATA_BUFFER_RELEASE(alert);
-                        goto cleanup;
-                    }
-                }
-            }
-            /* send it */
-            if (0 > (rc = prte_rml.send_buffer_nb(PRTE_PROC_MY_HNP, alert,
-                                                  PRTE_RML_TAG_PLM,
-                                                  prte_rml_send_callback, NULL))) {
+            if (PRTE_SUCCESS != (rc = prte_state_base_rollup_contribute(jdata, PRTE_PROC_STATE_REGISTERED))) {
                 PRTE_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-            } else {
-                rc = PRTE_SUCCESS;
             }
         }
     } else if (PRTE_PROC_STATE_IOF_COMPLETE == state) {
@@ -553,29 +504,13 @@ static void track_procs(int fd, short argc, void *cbdata)
         /* track job status */
         if (jdata->num_terminated == jdata->num_local_procs &&
             !prte_get_attribute(&jdata->attributes, PRTE_JOB_TERM_NOTIFIED, NULL, PMIX_BOOL)) {
-            /* pack update state command */
-            cmd = PRTE_PLM_UPDATE_PROC_STATE;
-            PMIX_DATA_BUFFER_CREATE(alert);
-            rc = PMIx_Data_pack(NULL, alert, &cmd, 1, PMIX_UINT8);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                goto cleanup;
-            }
-            /* pack the job info */
-            if (PRTE_SUCCESS != (rc = pack_state_update(alert, jdata))) {
-                PRTE_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                goto cleanup;
-            }
-            /* send it */
+            /* send it up the tree - this must be done before we release
+             * the local children and the map */
             PRTE_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
                                  "%s state:prted: SENDING JOB LOCAL TERMINATION UPDATE FOR JOB %s",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                  PRTE_JOBID_PRINT(jdata->nspace)));
-            if (0 > (rc = prte_rml.send_buffer_nb(PRTE_PROC_MY_HNP, alert,
-                                                  PRTE_RML_TAG_PLM,
-                                                  prte_rml_send_callback, NULL))) {
+            if (PRTE_SUCCESS != (rc = prte_state_base_rollup_contribute(jdata, PRTE_PROC_STATE_TERMINATED))) {
                 PRTE_ERROR_LOG(rc);
             }
             /* mark that we sent it so we ensure we don't do it again */
@@ -668,80 +603,3 @@ static void track_procs(int fd, short argc, void *cbdata)
   cleanup:
     PRTE_RELEASE(caddy);
 }
-
-static int pack_state_for_proc(pmix_data_buffer_t *alert, prte_proc_t *child)
-{
-    int rc;
-
-    /* pack the child's vpid */
-    rc = PMIx_Data_pack(NULL, alert, &child->name.rank, 1, PMIX_PROC_RANK);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    /* pack the pid */
-    rc = PMIx_Data_pack(NULL, alert, &child->pid, 1, PMIX_PID);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    /* pack its state */
-    rc = PMIx_Data_pack(NULL, alert, &child->state, 1, PMIX_UINT32);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    /* pack its exit code */
-    rc = PMIx_Data_pack(NULL, alert, &child->exit_code, 1, PMIX_INT32);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    return PRTE_SUCCESS;
-}
-
-static int pack_state_update(pmix_data_buffer_t *alert, prte_job_t *jdata)
-{
-    int i, rc;
-    prte_proc_t *child;
-    pmix_rank_t null=PMIX_RANK_INVALID;
-
-    /* pack the jobid */
-#if PMIX_NUMERIC_VERSION < 0x00040100
-    char *tmp = NULL;
-    if (0 < strlen(jdata->nspace)) {
-        tmp = strdup(jdata->nspace);
-    }
-    rc = PMIx_Data_pack(NULL, alert, (void*)&tmp, 1, PMIX_STRING);
-    if (NULL != tmp) {
-        free(tmp);
-    }
-#else
-    rc = PMIx_Data_pack(NULL, alert, &jdata->nspace, 1, PMIX_PROC_NSPACE);
-#endif
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    for (i=0; i < prte_local_children->size; i++) {
-        if (NULL == (child = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, i))) {
-            continue;
-        }
-        /* if this child is part of the job... */
-        if (PMIX_CHECK_NSPACE(child->name.nspace, jdata->nspace)) {
-            if (PRTE_SUCCESS != (rc = pack_state_for_proc(alert, child))) {
-                PRTE_ERROR_LOG(rc);
-                return rc;
-            }
-        }
-    }
-    /* flag that this job is complete so the receiver can know */
-    rc = PMIx_Data_pack(NULL, alert, &null, 1, PMIX_PROC_RANK);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    return PRTE_SUCCESS;
-}
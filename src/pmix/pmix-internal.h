@@ -456,6 +456,18 @@ pmix_proc_hton_intr(pmix_proc_t *name)
 
 #define PRTE_PMIX_SHOW_HELP    "prte.show.help"
 
+/* query the event profile of a daemon (string) - qualify with
+ * PRTE_QUERY_EVENT_PROFILE_TOP (uint32) to limit the number of
+ * callbacks reported */
+#define PRTE_QUERY_EVENT_PROFILE        "prte.qry.evprof"
+#define PRTE_QUERY_EVENT_PROFILE_TOP    "prte.qry.evprof.top"
+
+/* qualifiers for PMIX_QUERY_PROC_TABLE and PMIX_QUERY_LOCAL_PROC_TABLE
+ * that return only a page of the table: the index of the first entry
+ * (uint32) and the max number of entries to return (uint32) */
+#define PRTE_QUERY_PROC_TABLE_START     "prte.qry.ptbl.start"
+#define PRTE_QUERY_PROC_TABLE_COUNT     "prte.qry.ptbl.count"
+
 
 /* PRTE attribute */
 typedef uint16_t prte_attribute_key_t;
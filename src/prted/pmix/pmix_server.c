@@ -293,6 +293,22 @@ void pmix_server_register_params(void)
                                   PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
                                   PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
                                   &prte_pmix_server_globals.system_server);
+
+    /* number of spawn requests to forward to the HNP in a single message */
+    prte_pmix_server_globals.spawn_batch_size = 1;
+    (void) prte_mca_base_var_register ("prte", "pmix", NULL, "server_spawn_batch_size",
+                                  "Maximum number of spawn requests to forward to the DVM controller in a "
+                                  "single message (1 => forward each request as it arrives)",
+                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prte_pmix_server_globals.spawn_batch_size);
+    prte_pmix_server_globals.spawn_batch_window = 1000;
+    (void) prte_mca_base_var_register ("prte", "pmix", NULL, "server_spawn_batch_window",
+                                  "Maximum time (in microseconds) a spawn request can wait for others "
+                                  "to join its batch",
+                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prte_pmix_server_globals.spawn_batch_window);
 }
 
 static void eviction_cbfunc(struct prte_hotel_t *hotel,
@@ -386,6 +402,10 @@ void prte_pmix_server_clear(pmix_proc_t *pname)
             }
         }
     }
+    /* drop any cached proc table for the job */
+    if (PMIX_RANK_WILDCARD == pname->rank) {
+        pmix_server_query_clear_job(pname->nspace);
+    }
 }
 /*
  * Initialize global variables used w/in the server.
@@ -408,6 +428,7 @@ int pmix_server_init(void)
     /* setup the server's state variables */
     PRTE_CONSTRUCT(&prte_pmix_server_globals.reqs, prte_hotel_t);
     PRTE_CONSTRUCT(&prte_pmix_server_globals.psets, prte_list_t);
+    pmix_server_query_init();
 
     /* by the time we init the server, we should know how many nodes we
      * have in our environment - with the exception of mpirun. If the
@@ -688,6 +709,7 @@ void pmix_server_finalize(void)
     PRTE_DESTRUCT(&prte_pmix_server_globals.reqs);
     PRTE_LIST_DESTRUCT(&prte_pmix_server_globals.notifications);
     PRTE_LIST_DESTRUCT(&prte_pmix_server_globals.psets);
+    pmix_server_query_finalize();
 #ifdef PMIX_TOPOLOGY2
     free(mytopology.source);
 #endif
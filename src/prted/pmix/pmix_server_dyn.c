@@ -49,6 +49,7 @@
 #include "src/threads/threads.h"
 #include "src/runtime/prte_globals.h"
 #include "src/mca/rml/rml.h"
+#include "src/mca/plm/plm_types.h"
 
 #include "src/prted/pmix/pmix_server.h"
 #include "src/prted/pmix/pmix_server_internal.h"
@@ -124,6 +125,125 @@ void pmix_server_launch_resp(int status, pmix_proc_t* sender,
     PRTE_RELEASE(req);
 }
 
+/* spawn requests waiting to be forwarded to the HNP together */
+static pmix_data_buffer_t *spawn_batch = NULL;
+static int *spawn_batch_rooms = NULL;
+static int32_t spawn_batch_njobs = 0;
+static prte_event_t spawn_batch_ev;
+static bool spawn_batch_timer_active = false;
+
+static void spawn_batch_send(int sd, short args, void *cbdata)
+{
+    pmix_data_buffer_t *buf;
+    prte_plm_cmd_flag_t command;
+    pmix_server_req_t *req;
+    char nspace[PMIX_MAX_NSLEN+1];
+    pmix_status_t prc;
+    int rc, n;
+
+    spawn_batch_timer_active = false;
+    if (0 == spawn_batch_njobs) {
+        return;
+    }
+
+    prte_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s forwarding batch of %d spawn requests",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int)spawn_batch_njobs);
+
+    /* construct a spawn message */
+    PMIX_DATA_BUFFER_CREATE(buf);
+    command = PRTE_PLM_LAUNCH_JOBS_CMD;
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, buf, &command, 1, PMIX_UINT8)) ||
+        PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, buf, &spawn_batch_njobs, 1, PMIX_INT32)) ||
+        PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, buf, spawn_batch_rooms, spawn_batch_njobs, PMIX_INT)) ||
+        PMIX_SUCCESS != (prc = PMIx_Data_copy_payload(buf, spawn_batch))) {
+        PMIX_ERROR_LOG(prc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        rc = prte_pmix_convert_status(prc);
+        goto error;
+    }
+
+    /* send it to the HNP for processing - might be myself! */
+    if (PRTE_SUCCESS != (rc = prte_rml.send_buffer_nb(PRTE_PROC_MY_HNP, buf,
+                                                      PRTE_RML_TAG_PLM,
+                                                      prte_rml_send_callback, NULL))) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        goto error;
+    }
+    PMIX_DATA_BUFFER_RELEASE(spawn_batch);
+    spawn_batch_njobs = 0;
+    return;
+
+  error:
+    /* none of the requests in the batch are going to launch */
+    prc = prte_pmix_convert_rc(rc);
+    PMIX_LOAD_NSPACE(nspace, NULL);
+    for (n=0; n < spawn_batch_njobs; n++) {
+        prte_hotel_checkout_and_return_occupant(&prte_pmix_server_globals.reqs,
+                                                spawn_batch_rooms[n], (void**)&req);
+        if (NULL == req) {
+            continue;
+        }
+        if (NULL != req->spcbfunc) {
+            req->spcbfunc(prc, nspace, req->cbdata);
+        }
+        PRTE_RELEASE(req);
+    }
+    PMIX_DATA_BUFFER_RELEASE(spawn_batch);
+    spawn_batch_njobs = 0;
+}
+
+static int spawn_batch_add(pmix_server_req_t *req)
+{
+    pmix_data_buffer_t jbuf;
+    struct timeval tv;
+    pmix_status_t prc;
+    int rc;
+
+    if (NULL == spawn_batch_rooms) {
+        spawn_batch_rooms = (int*)malloc(prte_pmix_server_globals.spawn_batch_size * sizeof(int));
+        if (NULL == spawn_batch_rooms) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
+    /* pack the job separately so a failure cannot corrupt the batch */
+    PMIX_DATA_BUFFER_CONSTRUCT(&jbuf);
+    rc = prte_job_pack(&jbuf, req->jdata);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+        return rc;
+    }
+    if (NULL == spawn_batch) {
+        PMIX_DATA_BUFFER_CREATE(spawn_batch);
+    }
+    prc = PMIx_Data_copy_payload(spawn_batch, &jbuf);
+    PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        return prte_pmix_convert_status(prc);
+    }
+    spawn_batch_rooms[spawn_batch_njobs++] = req->room_num;
+
+    if (spawn_batch_njobs >= prte_pmix_server_globals.spawn_batch_size) {
+        /* the batch is full - send it now */
+        if (spawn_batch_timer_active) {
+            prte_event_evtimer_del(&spawn_batch_ev);
+        }
+        spawn_batch_send(0, 0, NULL);
+    } else if (!spawn_batch_timer_active) {
+        /* don't hold the first request in the batch too long */
+        tv.tv_sec = prte_pmix_server_globals.spawn_batch_window / 1000000;
+        tv.tv_usec = prte_pmix_server_globals.spawn_batch_window % 1000000;
+        prte_event_evtimer_set(prte_event_base, &spawn_batch_ev, spawn_batch_send, NULL);
+        prte_event_evtimer_add(&spawn_batch_ev, &tv);
+        spawn_batch_timer_active = true;
+    }
+    return PRTE_SUCCESS;
+}
+
 static void spawn(int sd, short args, void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t*)cbdata;
@@ -146,6 +266,15 @@ static void spawn(int sd, short args, void *cbdata)
     prte_set_attribute(&req->jdata->attributes, PRTE_JOB_ROOM_NUM,
                        PRTE_ATTR_GLOBAL, &req->room_num, PMIX_INT);
 
+    if (1 < prte_pmix_server_globals.spawn_batch_size) {
+        /* hold it so it can travel to the HNP with others */
+        if (PRTE_SUCCESS != (rc = spawn_batch_add(req))) {
+            prte_hotel_checkout(&prte_pmix_server_globals.reqs, req->room_num);
+            goto callback;
+        }
+        return;
+    }
+
     /* construct a spawn message */
     PMIX_DATA_BUFFER_CREATE(buf);
 
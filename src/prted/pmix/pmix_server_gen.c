@@ -775,6 +775,7 @@ void prte_pmix_server_tool_conn_complete(prte_job_t *jdata,
             node->name = strdup(req->operation);
             PRTE_FLAG_SET(node, PRTE_NODE_NON_USABLE);
             prte_pointer_array_add(prte_node_pool, node);
+            prte_node_index_names(node);
         }
     }
     if (NULL == node) {
@@ -235,8 +235,8 @@ PRTE_CLASS_DECLARATION(prte_pmix_mdx_caddy_t);
         _cd->nprocs = (pn);                                     \
         _cd->cbfunc = (cf);                                     \
         _cd->cbdata = (cb);                                     \
-        prte_event_set(prte_event_base, &(_cd->ev), -1,         \
-                       PRTE_EV_WRITE, (fn), _cd);               \
+        prte_event_shift_set(prte_event_base, &(_cd->ev),       \
+                             (fn), _cd);                        \
         prte_event_set_priority(&(_cd->ev), PRTE_MSG_PRI);      \
         PRTE_POST_OBJECT(_cd);                                  \
         prte_event_active(&(_cd->ev), PRTE_EV_WRITE, 1);        \
@@ -287,6 +287,9 @@ PRTE_EXPORT extern pmix_status_t pmix_server_notify_event(pmix_status_t code,
                                                            pmix_data_range_t range,
                                                            pmix_info_t info[], size_t ninfo,
                                                            pmix_op_cbfunc_t cbfunc, void *cbdata);
+PRTE_EXPORT extern void pmix_server_query_init(void);
+PRTE_EXPORT extern void pmix_server_query_finalize(void);
+PRTE_EXPORT extern void pmix_server_query_clear_job(const pmix_nspace_t nspace);
 PRTE_EXPORT extern pmix_status_t pmix_server_query_fn(pmix_proc_t *proct,
                                                        pmix_query_t *queries, size_t nqueries,
                                                        pmix_info_cbfunc_t cbfunc,
@@ -368,6 +371,8 @@ typedef struct {
     bool system_server;
     bool legacy;
     prte_list_t psets;
+    int spawn_batch_size;
+    int spawn_batch_window;
 } pmix_server_globals_t;
 
 extern pmix_server_globals_t prte_pmix_server_globals;
@@ -48,15 +48,256 @@
 #include "src/util/show_help.h"
 #include "src/threads/threads.h"
 #include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_progress_threads.h"
 #include "src/mca/rml/rml.h"
 #include "src/mca/plm/plm.h"
 #include "src/mca/plm/base/plm_private.h"
 
 #include "src/prted/pmix/pmix_server_internal.h"
 
+/* number of proc tables to retain */
+#define PMIX_SERVER_PTABLE_CACHE_SIZE   4
+
+/* A proc table is built once per job and retained so that
+ * concurrent attach requests, and a debugger paging through the
+ * table, are served by copying from it. Hostnames and executable
+ * names are deduplicated within the table, which owns a single copy
+ * of each string rather than one per proc. Tables are keyed by
+ * nspace and do not hold a reference to the job, so the job can be
+ * cleaned up while its table is cached */
+typedef struct {
+    prte_list_item_t super;
+    pmix_nspace_t nspace;
+    pmix_rank_t num_procs;
+    /* progress of the job when the table was built */
+    prte_job_state_t state;
+    pmix_rank_t num_launched;
+    pmix_rank_t num_reported;
+    pmix_rank_t num_terminated;
+    pmix_proc_info_t *table;
+    bool *local;
+    size_t ntable;
+    size_t nlocal;
+    /* the unique strings the table points to */
+    char **strings;
+} pmix_server_ptable_t;
+static void ptcon(pmix_server_ptable_t *p)
+{
+    PMIX_LOAD_NSPACE(p->nspace, NULL);
+    p->num_procs = 0;
+    p->table = NULL;
+    p->local = NULL;
+    p->ntable = 0;
+    p->nlocal = 0;
+    p->strings = NULL;
+}
+static void ptdes(pmix_server_ptable_t *p)
+{
+    if (NULL != p->table) {
+        free(p->table);
+    }
+    if (NULL != p->local) {
+        free(p->local);
+    }
+    if (NULL != p->strings) {
+        prte_argv_free(p->strings);
+    }
+}
+static PRTE_CLASS_INSTANCE(pmix_server_ptable_t,
+                           prte_list_item_t,
+                           ptcon, ptdes);
+
+static prte_list_t ptables;
+
+void pmix_server_query_init(void)
+{
+    PRTE_CONSTRUCT(&ptables, prte_list_t);
+}
+
+void pmix_server_query_finalize(void)
+{
+    PRTE_LIST_DESTRUCT(&ptables);
+}
+
+/* the job is being cleaned up, so release its proc table */
+void pmix_server_query_clear_job(const pmix_nspace_t nspace)
+{
+    pmix_server_ptable_t *pt;
+
+    PRTE_LIST_FOREACH(pt, &ptables, pmix_server_ptable_t) {
+        if (PMIX_CHECK_NSPACE(pt->nspace, nspace)) {
+            prte_list_remove_item(&ptables, &pt->super);
+            PRTE_RELEASE(pt);
+            return;
+        }
+    }
+}
+
+/* return the table's copy of a string, adding it if necessary */
+static char* intern(pmix_server_ptable_t *pt, prte_hash_table_t *names,
+                    const char *str)
+{
+    void *value;
+
+    if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(names, str, strlen(str), &value)) {
+        return (char*)value;
+    }
+    if (PRTE_SUCCESS != prte_argv_append_nosize(&pt->strings, str)) {
+        return NULL;
+    }
+    value = pt->strings[prte_argv_count(pt->strings) - 1];
+    prte_hash_table_set_value_ptr(names, str, strlen(str), value);
+    return (char*)value;
+}
+
+static pmix_server_ptable_t* get_ptable(prte_job_t *jdata)
+{
+    pmix_server_ptable_t *pt;
+    prte_proc_t *proct;
+    prte_node_t *node = NULL;
+    prte_app_context_t *app;
+    prte_app_idx_t app_idx = UINT32_MAX;
+    prte_hash_table_t names;
+    char *host = NULL, *exec = NULL;
+    size_t p;
+    int k;
+
+    PRTE_LIST_FOREACH(pt, &ptables, pmix_server_ptable_t) {
+        if (!PMIX_CHECK_NSPACE(pt->nspace, jdata->nspace)) {
+            continue;
+        }
+        prte_list_remove_item(&ptables, &pt->super);
+        if (pt->num_procs == jdata->num_procs &&
+            pt->state == jdata->state &&
+            pt->num_launched == jdata->num_launched &&
+            pt->num_reported == jdata->num_reported &&
+            pt->num_terminated == jdata->num_terminated) {
+            /* keep the most recently used tables at the front */
+            prte_list_prepend(&ptables, &pt->super);
+            return pt;
+        }
+        /* the job has progressed since this table was built */
+        PRTE_RELEASE(pt);
+        break;
+    }
+
+    pt = PRTE_NEW(pmix_server_ptable_t);
+    PMIX_LOAD_NSPACE(pt->nspace, jdata->nspace);
+    pt->num_procs = jdata->num_procs;
+    pt->state = jdata->state;
+    pt->num_launched = jdata->num_launched;
+    pt->num_reported = jdata->num_reported;
+    pt->num_terminated = jdata->num_terminated;
+    pt->table = (pmix_proc_info_t*)calloc(jdata->num_procs, sizeof(pmix_proc_info_t));
+    pt->local = (bool*)calloc(jdata->num_procs, sizeof(bool));
+    if (NULL == pt->table || NULL == pt->local) {
+        PRTE_RELEASE(pt);
+        return NULL;
+    }
+    PRTE_CONSTRUCT(&names, prte_hash_table_t);
+    prte_hash_table_init(&names, 64);
+    p = 0;
+    for (k=0; k < jdata->procs->size && p < jdata->num_procs; k++) {
+        if (NULL == (proct = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, k))) {
+            continue;
+        }
+        PMIX_LOAD_PROCID(&pt->table[p].proc, proct->name.nspace, proct->name.rank);
+        /* procs are generally grouped by node and app, so
+         * avoid looking up the same string again */
+        if (proct->node != node) {
+            node = proct->node;
+            host = (NULL == node || NULL == node->name) ? NULL : intern(pt, &names, node->name);
+        }
+        pt->table[p].hostname = host;
+        if (proct->app_idx != app_idx) {
+            app_idx = proct->app_idx;
+            app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, app_idx);
+            exec = (NULL == app || NULL == app->app) ? NULL : intern(pt, &names, app->app);
+        }
+        pt->table[p].executable_name = exec;
+        pt->table[p].pid = proct->pid;
+        pt->table[p].exit_code = proct->exit_code;
+        pt->table[p].state = prte_pmix_convert_state(proct->state);
+        if (PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_LOCAL)) {
+            pt->local[p] = true;
+            pt->nlocal++;
+        }
+        ++p;
+    }
+    pt->ntable = p;
+    PRTE_DESTRUCT(&names);
+
+    prte_list_prepend(&ptables, &pt->super);
+    while (PMIX_SERVER_PTABLE_CACHE_SIZE < prte_list_get_size(&ptables)) {
+        pt = (pmix_server_ptable_t*)prte_list_remove_last(&ptables);
+        PRTE_RELEASE(pt);
+    }
+    return (pmix_server_ptable_t*)prte_list_get_first(&ptables);
+}
+
+/* load the requested page of a proc table into the reply */
+static pmix_status_t load_ptable(prte_info_item_t *kv, pmix_server_ptable_t *pt,
+                                 bool local, size_t first, size_t count)
+{
+    pmix_data_array_t *darray;
+    pmix_proc_info_t *procinfo;
+    size_t n, p, total;
+
+    total = local ? pt->nlocal : pt->ntable;
+    if (first >= total) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (count > total - first) {
+        count = total - first;
+    }
+    PMIX_DATA_ARRAY_CREATE(darray, count, PMIX_PROC_INFO);
+    kv->info.value.type = PMIX_DATA_ARRAY;
+    kv->info.value.data.darray = darray;
+#if PMIX_NUMERIC_VERSION < 0x00030100
+    PMIX_PROC_INFO_CREATE(darray->array, count);
+#endif
+    procinfo = (pmix_proc_info_t*)darray->array;
+    if (!local) {
+        memcpy(procinfo, &pt->table[first], count * sizeof(pmix_proc_info_t));
+        return PMIX_SUCCESS;
+    }
+    p = 0;
+    for (n=0; n < pt->ntable && p < first + count; n++) {
+        if (!pt->local[n]) {
+            continue;
+        }
+        if (first <= p) {
+            memcpy(&procinfo[p - first], &pt->table[n], sizeof(pmix_proc_info_t));
+        }
+        ++p;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* the page loaded by load_ptable borrows the table's strings, so
+ * detach them before the result is destructed */
+static void unload_ptable(prte_info_item_t *kv)
+{
+    pmix_data_array_t *darray;
+    pmix_proc_info_t *procinfo;
+    size_t m;
+
+    if (PMIX_DATA_ARRAY != kv->info.value.type ||
+        NULL == (darray = kv->info.value.data.darray) ||
+        PMIX_PROC_INFO != darray->type) {
+        return;
+    }
+    procinfo = (pmix_proc_info_t*)darray->array;
+    for (m=0; m < darray->size; m++) {
+        procinfo[m].hostname = NULL;
+        procinfo[m].executable_name = NULL;
+    }
+}
+
 static void qrel(void *cbdata)
 {
     prte_pmix_server_op_caddy_t *cd = (prte_pmix_server_op_caddy_t*)cbdata;
+
     if (NULL != cd->info) {
         PMIX_INFO_FREE(cd->info, cd->ninfo);
     }
@@ -76,7 +317,7 @@ static void _query(int sd, short args, void *cbdata)
     int k, rc;
     prte_list_t results, stack;
     size_t m, n, p;
-    uint32_t key, nodeid;
+    uint32_t key, nodeid, first, count;
     char **nspaces, *hostname, *uri;
 #ifdef PMIX_QUERY_NAMESPACE_INFO
     char *cmdline;
@@ -88,6 +329,8 @@ static void _query(int sd, short args, void *cbdata)
     pmix_info_t *info;
     pmix_data_array_t *darray;
     prte_proc_t *proct;
+    pmix_server_ptable_t *ptable;
+    bool local;
 #if PMIX_NUMERIC_VERSION >= 0x00040000
     size_t sz;
 #endif
@@ -105,6 +348,8 @@ static void _query(int sd, short args, void *cbdata)
         q = &cd->queries[m];
         hostname = NULL;
         nodeid = UINT32_MAX;
+        first = 0;
+        count = UINT32_MAX;
         /* default to the requestor's jobid */
         PMIX_LOAD_NSPACE(jobid, cd->proct.nspace);
         /* see if they provided any qualifiers */
@@ -150,6 +395,10 @@ static void _query(int sd, short args, void *cbdata)
                     hostname = q->qualifiers[n].value.data.string;
                 } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_NODEID)) {
                     PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, nodeid, uint32_t);
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PRTE_QUERY_PROC_TABLE_START)) {
+                    PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, first, uint32_t);
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PRTE_QUERY_PROC_TABLE_COUNT)) {
+                    PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, count, uint32_t);
                 }
             }
         }
@@ -369,93 +618,32 @@ static void _query(int sd, short args, void *cbdata)
                 free(uri);
                 prte_list_append(&results, &kv->super);
     #ifdef PMIX_QUERY_PROC_TABLE
-            } else if (0 == strcmp(q->keys[n], PMIX_QUERY_PROC_TABLE)) {
+            } else if (0 == strcmp(q->keys[n], PMIX_QUERY_PROC_TABLE) ||
+                       0 == strcmp(q->keys[n], PMIX_QUERY_LOCAL_PROC_TABLE)) {
                 /* construct a list of values with prte_proc_info_t
-                 * entries for each proc in the indicated job */
+                 * entries for each (LOCAL) proc in the indicated job */
+                local = (0 == strcmp(q->keys[n], PMIX_QUERY_LOCAL_PROC_TABLE));
                 jdata = prte_get_job_data_object(jobid);
                 if (NULL == jdata) {
                     ret = PMIX_ERR_NOT_FOUND;
                     goto done;
                 }
-                /* Check if there are any entries in global proctable */
-                if (0 == jdata->num_procs) {
-                    ret = PMIX_ERR_NOT_FOUND;
-                    goto done;
-                }
-                /* setup the reply */
-                kv = PRTE_NEW(prte_info_item_t);
-                (void)strncpy(kv->info.key, PMIX_QUERY_PROC_TABLE, PMIX_MAX_KEYLEN);
-                prte_list_append(&results, &kv->super);
-                 /* cycle thru the job and create an entry for each proc */
-                PMIX_DATA_ARRAY_CREATE(darray, jdata->num_procs, PMIX_PROC_INFO);
-                kv->info.value.type = PMIX_DATA_ARRAY;
-                kv->info.value.data.darray = darray;
-        #if PMIX_NUMERIC_VERSION < 0x00030100
-                PMIX_PROC_INFO_CREATE(darray->array, jdata->num_local_procs);
-        #endif
-                procinfo = (pmix_proc_info_t*)darray->array;
-                p = 0;
-                for (k=0; k < jdata->procs->size; k++) {
-                    if (NULL == (proct = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, k))) {
-                        continue;
-                    }
-                    PMIX_LOAD_PROCID(&procinfo[p].proc, proct->name.nspace, proct->name.rank);
-                    if (NULL != proct->node && NULL != proct->node->name) {
-                        procinfo[p].hostname = strdup(proct->node->name);
-                    }
-                    app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, proct->app_idx);
-                    if (NULL != app && NULL != app->app) {
-                        procinfo[p].executable_name = strdup(app->app);
-                    }
-                    procinfo[p].pid = proct->pid;
-                    procinfo[p].exit_code = proct->exit_code;
-                    procinfo[p].state = prte_pmix_convert_state(proct->state);
-                    ++p;
-                }
-            } else if (0 == strcmp(q->keys[n], PMIX_QUERY_LOCAL_PROC_TABLE)) {
-                /* construct a list of values with prte_proc_info_t
-                 * entries for each LOCAL proc in the indicated job */
-                jdata = prte_get_job_data_object(jobid);
-                if (NULL == jdata) {
+                /* Check if there are any entries in the proctable */
+                if (0 == (local ? jdata->num_local_procs : jdata->num_procs)) {
                     ret = PMIX_ERR_NOT_FOUND;
                     goto done;
                 }
-                /* Check if there are any entries in local proctable */
-                if (0 == jdata->num_local_procs) {
-                    ret = PMIX_ERR_NOT_FOUND;
+                if (NULL == (ptable = get_ptable(jdata))) {
+                    ret = PMIX_ERR_NOMEM;
                     goto done;
                 }
                 /* setup the reply */
                 kv = PRTE_NEW(prte_info_item_t);
-                (void)strncpy(kv->info.key, PMIX_QUERY_LOCAL_PROC_TABLE, PMIX_MAX_KEYLEN);
+                (void)strncpy(kv->info.key, q->keys[n], PMIX_MAX_KEYLEN);
                 prte_list_append(&results, &kv->super);
-                /* cycle thru the job and create an entry for each proc */
-                PMIX_DATA_ARRAY_CREATE(darray, jdata->num_local_procs, PMIX_PROC_INFO);
-                kv->info.value.type = PMIX_DATA_ARRAY;
-                kv->info.value.data.darray = darray;
-        #if PMIX_NUMERIC_VERSION < 0x00030100
-                PMIX_PROC_INFO_CREATE(darray->array, jdata->num_local_procs);
-        #endif
-                procinfo = (pmix_proc_info_t*)darray->array;
-                p = 0;
-                for (k=0; k < jdata->procs->size; k++) {
-                    if (NULL == (proct = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, k))) {
-                        continue;
-                    }
-                    if (PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_LOCAL)) {
-                        PMIX_LOAD_PROCID(&procinfo[p].proc, proct->name.nspace, proct->name.rank);
-                        if (NULL != proct->node && NULL != proct->node->name) {
-                            procinfo[p].hostname = strdup(proct->node->name);
-                        }
-                        app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, proct->app_idx);
-                        if (NULL != app && NULL != app->app) {
-                            procinfo[p].executable_name = strdup(app->app);
-                        }
-                        procinfo[p].pid = proct->pid;
-                        procinfo[p].exit_code = proct->exit_code;
-                        procinfo[p].state = prte_pmix_convert_state(proct->state);
-                        ++p;
-                    }
+                ret = load_ptable(kv, ptable, local, first, count);
+                if (PMIX_SUCCESS != ret) {
+                    goto done;
                 }
     #endif
     #ifdef PMIX_QUERY_NUM_PSETS
@@ -490,6 +678,18 @@ static void _query(int sd, short args, void *cbdata)
                 key = jdata->num_procs;
                 PMIX_INFO_LOAD(&kv->info, PMIX_JOB_SIZE, &key, PMIX_UINT32);
                 prte_list_append(&results, &kv->super);
+            } else if (0 == strcmp(q->keys[n], PRTE_QUERY_EVENT_PROFILE)) {
+                key = 0;
+                for (p=0; p < q->nqual; p++) {
+                    if (PMIX_CHECK_KEY(&q->qualifiers[p], PRTE_QUERY_EVENT_PROFILE_TOP)) {
+                        PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[p].value, key, uint32_t);
+                    }
+                }
+                tmp = prte_event_profile_report(key);
+                kv = PRTE_NEW(prte_info_item_t);
+                PMIX_INFO_LOAD(&kv->info, PRTE_QUERY_EVENT_PROFILE, tmp, PMIX_STRING);
+                free(tmp);
+                prte_list_append(&results, &kv->super);
             } else {
                 fprintf(stderr, "Query for unrecognized attribute: %s\n", q->keys[n]);
             }
@@ -517,6 +717,10 @@ static void _query(int sd, short args, void *cbdata)
             }
         }
     }
+    /* the reply holds its own copies of any proc table strings */
+    PRTE_LIST_FOREACH(kv, &results, prte_info_item_t) {
+        unload_ptable(kv);
+    }
     PRTE_LIST_DESTRUCT(&results);
     cd->infocbfunc(ret, rcd->info, rcd->ninfo, cd->cbdata, qrel, rcd);
     PRTE_RELEASE(cd);
@@ -33,7 +33,12 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#include <errno.h>
 #include <fcntl.h>
+#include <string.h>
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
 #include <pmix_server.h>
 
 #include "prte_stdint.h"
@@ -56,14 +61,17 @@
 
 static void opcbfunc(pmix_status_t status, void *cbdata);
 
+/* the most values registered for any one proc */
+#define PRTE_PMIX_MAX_PROC_DATA     16
+
 /* stuff proc attributes for sending back to a proc */
 int prte_pmix_server_register_nspace(prte_job_t *jdata)
 {
     int rc;
     prte_proc_t *pptr;
     int i, k, n, p;
-    prte_list_t *info, *pmap, nodeinfo, appinfo;
-    prte_info_item_t *kv, *kptr;
+    prte_list_t *info, nodeinfo, appinfo;
+    prte_info_item_t *kv;
     prte_info_array_item_t *iarray;
     prte_node_t *node;
     pmix_rank_t vpid;
@@ -77,6 +85,7 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
     pmix_proc_t pproc;
     pmix_status_t ret;
     pmix_info_t *pinfo, *iptr;
+    pmix_info_t pdata[PRTE_PMIX_MAX_PROC_DATA];
     size_t ninfo;
     prte_pmix_lock_t lock;
     prte_list_t local_procs;
@@ -87,6 +96,8 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
     pmix_cpuset_t cpuset;
 #endif
     uint32_t ui32;
+    int jobdirfd;
+    char rankdir[16];
 
     prte_output_verbose(2, prte_pmix_server_globals.output,
                         "%s register nspace for %s",
@@ -348,10 +359,16 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
         PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
         return PRTE_ERR_OUT_OF_RESOURCE;
     }
-    if (PRTE_SUCCESS != (rc = prte_os_dirpath_create(prte_process_info.jobfam_session_dir, S_IRWXU))) {
+    if (PRTE_SUCCESS != (rc = prte_os_dirpath_create(tmp, S_IRWXU))) {
         PRTE_ERROR_LOG(rc);
+        free(tmp);
         return rc;
     }
+    /* hold the job-level directory open so the proc-level directories
+     * can be created relative to it instead of walking the full path
+     * for every local proc - if we cannot open it, we fall back to
+     * creating each proc directory by path */
+    jobdirfd = open(tmp, O_RDONLY | O_DIRECTORY);
     kv = PRTE_NEW(prte_info_item_t);
     PMIX_INFO_LOAD(&kv->info, PMIX_NSDIR, tmp, PMIX_STRING);
     free(tmp);
@@ -424,13 +441,13 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
             if (!PMIX_CHECK_NSPACE(pptr->name.nspace, jdata->nspace)) {
                 continue;
             }
-            /* setup the proc map object */
-            pmap = PRTE_NEW(prte_list_t);
+            /* the proc data is loaded directly into a fixed array so
+             * that registering a proc costs one allocation for its
+             * data array rather than one per value */
+            p = 0;
 
             /* must start with rank */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_RANK, &pptr->name.rank, PMIX_PROC_RANK);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&pdata[p++], PMIX_RANK, &pptr->name.rank, PMIX_PROC_RANK);
 
             /* location, for local procs */
             if (PRTE_PROC_MY_NAME->rank == node->daemon->name.rank) {
@@ -439,9 +456,7 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
                     NULL != tmp) {
 #if PMIX_NUMERIC_VERSION >= 0x00040000
                     /* provide the cpuset string for this proc */
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_CPUSET, tmp, PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
+                    PMIX_INFO_LOAD(&pdata[p++], PMIX_CPUSET, tmp, PMIX_STRING);
                     /* let PMIx generate the locality string */
                     PMIX_CPUSET_CONSTRUCT(&cpuset);
                     cpuset.source = "hwloc";
@@ -451,31 +466,28 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
                     ret = PMIx_server_generate_locality_string(&cpuset, &tmp);
                     if (PMIX_SUCCESS != ret) {
                         PMIX_ERROR_LOG(ret);
-                        PRTE_LIST_RELEASE(pmap);
+                        while (0 < p) {
+                            PMIX_INFO_DESTRUCT(&pdata[--p]);
+                        }
                         PRTE_LIST_DESTRUCT(&appinfo);
                         PRTE_LIST_RELEASE(info);
+                        if (0 <= jobdirfd) {
+                            close(jobdirfd);
+                        }
                         return prte_pmix_convert_status(ret);
                     }
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALITY_STRING, tmp, PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
+                    PMIX_INFO_LOAD(&pdata[p++], PMIX_LOCALITY_STRING, tmp, PMIX_STRING);
                     free(tmp);
 #else
                     /* generate the locality string ourselves */
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALITY_STRING, prte_hwloc_base_get_locality_string(prte_hwloc_topology, tmp), PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
+                    PMIX_INFO_LOAD(&pdata[p++], PMIX_LOCALITY_STRING, prte_hwloc_base_get_locality_string(prte_hwloc_topology, tmp), PMIX_STRING);
                     /* and also provide the cpuset string for this proc */
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_CPUSET, tmp, PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
+                    PMIX_INFO_LOAD(&pdata[p++], PMIX_CPUSET, tmp, PMIX_STRING);
                     free(tmp);
 #endif
                 } else {
                     /* the proc is not bound */
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
+                    PMIX_INFO_LOAD(&pdata[p++], PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
                 }
                 /* debugger daemons and tools don't get session directories */
                 if (!PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_DEBUGGER_DAEMON) &&
@@ -485,84 +497,78 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
                                            prte_process_info.jobfam_session_dir,
                                            PRTE_LOCAL_JOBID(jdata->nspace), pptr->name.rank)) {
                         PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+                        if (0 <= jobdirfd) {
+                            close(jobdirfd);
+                        }
                         return PRTE_ERR_OUT_OF_RESOURCE;
                     }
-                    if (PRTE_SUCCESS != (rc = prte_os_dirpath_create(tmp, S_IRWXU))) {
+                    if (0 <= jobdirfd) {
+                        snprintf(rankdir, sizeof(rankdir), "%u", pptr->name.rank);
+                        if (0 != mkdirat(jobdirfd, rankdir, S_IRWXU) && EEXIST != errno) {
+                            rc = PRTE_ERR_FILE_OPEN_FAILURE;
+                        } else {
+                            rc = PRTE_SUCCESS;
+                        }
+                    } else {
+                        rc = prte_os_dirpath_create(tmp, S_IRWXU);
+                    }
+                    if (PRTE_SUCCESS != rc) {
                         PRTE_ERROR_LOG(rc);
+                        free(tmp);
+                        if (0 <= jobdirfd) {
+                            close(jobdirfd);
+                        }
                         return rc;
                     }
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_PROCDIR, tmp, PMIX_STRING);
+                    PMIX_INFO_LOAD(&pdata[p++], PMIX_PROCDIR, tmp, PMIX_STRING);
                     free(tmp);
-                    prte_list_append(pmap, &kv->super);
                 }
             }
 
             /* global/univ rank */
-            kv = PRTE_NEW(prte_info_item_t);
             vpid = pptr->name.rank + jdata->offset;
-            PMIX_INFO_LOAD(&kv->info, PMIX_GLOBAL_RANK, &vpid, PMIX_PROC_RANK);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&pdata[p++], PMIX_GLOBAL_RANK, &vpid, PMIX_PROC_RANK);
 
             /* appnum */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_APPNUM, &pptr->app_idx, PMIX_UINT32);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&pdata[p++], PMIX_APPNUM, &pptr->app_idx, PMIX_UINT32);
 
             /* app rank */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_APP_RANK, &pptr->app_rank, PMIX_PROC_RANK);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&pdata[p++], PMIX_APP_RANK, &pptr->app_rank, PMIX_PROC_RANK);
 
             /* local rank */
             if (PRTE_LOCAL_RANK_INVALID != pptr->local_rank) {
-                kv = PRTE_NEW(prte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_LOCAL_RANK, &pptr->local_rank, PMIX_UINT16);
-                prte_list_append(pmap, &kv->super);
+                PMIX_INFO_LOAD(&pdata[p++], PMIX_LOCAL_RANK, &pptr->local_rank, PMIX_UINT16);
             }
 
             /* node rank */
             if (PRTE_NODE_RANK_INVALID != pptr->node_rank) {
-                kv = PRTE_NEW(prte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_NODE_RANK, &pptr->node_rank, PMIX_UINT16);
-                prte_list_append(pmap, &kv->super);
+                PMIX_INFO_LOAD(&pdata[p++], PMIX_NODE_RANK, &pptr->node_rank, PMIX_UINT16);
             }
 
             /* node ID */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_NODEID, &pptr->node->index, PMIX_UINT32);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&pdata[p++], PMIX_NODEID, &pptr->node->index, PMIX_UINT32);
 
 #if PMIX_NUMERIC_VERSION >= 0x00040000
             /* reincarnation number */
             ui32 = 0;  // we are starting this proc for the first time
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_REINCARNATION, &ui32, PMIX_UINT32);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&pdata[p++], PMIX_REINCARNATION, &ui32, PMIX_UINT32);
 #endif
 
             if (map->num_nodes < prte_hostname_cutoff) {
-                kv = PRTE_NEW(prte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_HOSTNAME, pptr->node->name, PMIX_STRING);
-                prte_list_append(pmap, &kv->super);
+                PMIX_INFO_LOAD(&pdata[p++], PMIX_HOSTNAME, pptr->node->name, PMIX_STRING);
             }
             kv = PRTE_NEW(prte_info_item_t);
             PMIX_LOAD_KEY(kv->info.key, PMIX_PROC_DATA);
             kv->info.value.type = PMIX_DATA_ARRAY;
-            ninfo = prte_list_get_size(pmap);
-            if (0 < ninfo) {
-                PMIX_DATA_ARRAY_CREATE(kv->info.value.data.darray, ninfo, PMIX_INFO);
-                pinfo = (pmix_info_t*)kv->info.value.data.darray->array;
-                p = 0;
-                while (NULL != (kptr = (prte_info_item_t*)prte_list_remove_first(pmap))) {
-                    PMIX_INFO_XFER(&pinfo[p], &kptr->info);
-                    PRTE_RELEASE(kptr);
-                    ++p;
-                }
-            }
+            /* the data array takes over the values loaded above */
+            PMIX_DATA_ARRAY_CREATE(kv->info.value.data.darray, p, PMIX_INFO);
+            memcpy(kv->info.value.data.darray->array, pdata, p * sizeof(pmix_info_t));
             prte_list_append(info, &kv->super);
         }
     }
+    if (0 <= jobdirfd) {
+        close(jobdirfd);
+    }
 
     /* mark the job as registered */
     prte_set_attribute(&jdata->attributes, PRTE_JOB_NSPACE_REGISTERED, PRTE_ATTR_LOCAL, NULL, PMIX_BOOL);
@@ -600,7 +606,10 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
         n = 0;
     }
     PRTE_LIST_FOREACH(kv, info, prte_info_item_t) {
-        PMIX_INFO_XFER(&pinfo[n], &kv->info);
+        /* move the value rather than copy it - the per-proc
+         * data arrays make up the bulk of the payload */
+        memcpy(&pinfo[n], &kv->info, sizeof(pmix_info_t));
+        PMIX_INFO_CONSTRUCT(&kv->info);
         ++n;
     }
     PRTE_LIST_RELEASE(info);
@@ -57,6 +57,7 @@
 #include "src/prted/pmix/pmix_server.h"
 
 #include "src/util/proc_info.h"
+#include "src/util/compress.h"
 #include "src/util/session_dir.h"
 #include "src/util/name_fns.h"
 #include "src/util/nidmap.h"
@@ -75,6 +76,7 @@
 #include "src/mca/routed/routed.h"
 #include "src/mca/ess/ess.h"
 #include "src/mca/state/state.h"
+#include "src/mca/state/base/base.h"
 
 #include "src/mca/odls/base/odls_private.h"
 
@@ -97,6 +99,51 @@ static void _notify_release(pmix_status_t status, void *cbdata)
     PRTE_PMIX_WAKEUP_THREAD(lk);
 }
 
+/* tracks the local procs of a job being cleaned up so they stay
+ * valid until the PMIx server has purged the nspace */
+typedef struct {
+    prte_object_t super;
+    prte_event_t ev;
+    prte_pointer_array_t procs;
+} prte_dvm_cleanup_t;
+static void dccon(prte_dvm_cleanup_t *p)
+{
+    PRTE_CONSTRUCT(&p->procs, prte_pointer_array_t);
+    prte_pointer_array_init(&p->procs, 8, INT_MAX, 8);
+}
+static void dcdes(prte_dvm_cleanup_t *p)
+{
+    int n;
+    prte_proc_t *proct;
+
+    for (n = 0; n < p->procs.size; n++) {
+        if (NULL != (proct = (prte_proc_t*)prte_pointer_array_get_item(&p->procs, n))) {
+            PRTE_RELEASE(proct);
+        }
+    }
+    PRTE_DESTRUCT(&p->procs);
+}
+static PRTE_CLASS_INSTANCE(prte_dvm_cleanup_t,
+                           prte_object_t,
+                           dccon, dcdes);
+
+static void _cleanup_complete(int fd, short args, void *cbdata)
+{
+    prte_dvm_cleanup_t *dc = (prte_dvm_cleanup_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(dc);
+    PRTE_RELEASE(dc);
+}
+
+static void _nspace_deregistered(pmix_status_t status, void *cbdata)
+{
+    prte_dvm_cleanup_t *dc = (prte_dvm_cleanup_t*)cbdata;
+
+    /* called from the PMIx progress thread - release the procs
+     * back in our event base */
+    PRTE_THREADSHIFT(dc, prte_event_base, _cleanup_complete, PRTE_MSG_PRI);
+}
+
 static prte_pointer_array_t *procs_prev_ordered_to_terminate = NULL;
 
 void prte_daemon_recv(int status, pmix_proc_t* sender,
@@ -112,7 +159,7 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
     pmix_data_buffer_t data, *answer;
     prte_job_t *jdata;
     pmix_proc_t proc;
-    int32_t i, num_replies;
+    int32_t i, num_replies, njobs;
     prte_pointer_array_t procarray;
     prte_proc_t *proct;
     char *cmd_str = NULL;
@@ -127,6 +174,7 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
     char string[256], *string_ptr = string;
     char *coprocessors;
     prte_job_map_t *map;
+    prte_dvm_cleanup_t *dc;
     prte_pmix_lock_t lk;
     pmix_proc_t pname;
     pmix_byte_object_t pbo;
@@ -271,6 +319,41 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
         }
         break;
 
+        /****    ADD_PROCS_BATCH   ****/
+    case PRTE_DAEMON_ADD_PROCS_BATCH_CMD:
+        if (prte_debug_daemons_flag) {
+            prte_output(0, "%s prted_cmd: received add_procs batch",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        }
+
+        /* get the number of jobs in the batch */
+        n = 1;
+        ret = PMIx_Data_unpack(NULL, buffer, &njobs, &n, PMIX_INT32);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            goto CLEANUP;
+        }
+        /* each entry is a complete add_procs command */
+        for (p=0; p < njobs; p++) {
+            n = 1;
+            ret = PMIx_Data_unpack(NULL, buffer, &pbo, &n, PMIX_BYTE_OBJECT);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                goto CLEANUP;
+            }
+            PMIX_DATA_BUFFER_CONSTRUCT(&data);
+            ret = PMIx_Data_load(&data, &pbo);
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                PMIX_DATA_BUFFER_DESTRUCT(&data);
+                goto CLEANUP;
+            }
+            prte_daemon_recv(status, sender, &data, tag, cbdata);
+            PMIX_DATA_BUFFER_DESTRUCT(&data);
+        }
+        break;
+
     case PRTE_DAEMON_ABORT_PROCS_CALLED:
         if (prte_debug_daemons_flag) {
             prte_output(0, "%s prted_cmd: received abort_procs report",
@@ -489,6 +572,9 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
             goto CLEANUP;
         }
 
+        /* the jobid may be reused, so forget its launch trace */
+        prte_state_base_trace_purge(job);
+
         /* look up job data object */
         if (NULL == (jdata = prte_get_job_data_object(job))) {
             /* we can safely ignore this request as the job
@@ -497,7 +583,10 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
         }
 
         /* release all resources (even those on other nodes) that we
-         * assigned to this job */
+         * assigned to this job. Only our own procs were registered
+         * as clients, and those are purged along with the nspace, so
+         * just hold them until the PMIx server is done with them */
+        dc = PRTE_NEW(prte_dvm_cleanup_t);
         if (NULL != jdata->map) {
             map = (prte_job_map_t*)jdata->map;
             for (n = 0; n < map->nodes->size; n++) {
@@ -516,15 +605,16 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
                         node->slots_inuse--;
                         node->num_procs--;
                     }
-                    /* deregister this proc - will be ignored if already done */
-                    PRTE_PMIX_CONSTRUCT_LOCK(&lk);
-                    PMIx_server_deregister_client(&proct->name, _notify_release, &lk);
-                    PRTE_PMIX_WAIT_THREAD(&lk);
-                    PRTE_PMIX_DESTRUCT_LOCK(&lk);
                     /* set the entry in the node array to NULL */
                     prte_pointer_array_set_item(node->procs, i, NULL);
-                    /* release the proc once for the map entry */
-                    PRTE_RELEASE(proct);
+                    if (NULL != node->daemon &&
+                        PRTE_PROC_MY_NAME->rank == node->daemon->name.rank) {
+                        /* hand the map's reference to the cleanup tracker */
+                        prte_pointer_array_add(&dc->procs, proct);
+                    } else {
+                        /* release the proc once for the map entry */
+                        PRTE_RELEASE(proct);
+                    }
                 }
                 /* set the node location to NULL */
                 prte_pointer_array_set_item(map->nodes, n, NULL);
@@ -536,10 +626,9 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
             PRTE_RELEASE(map);
             jdata->map = NULL;
         }
-        PRTE_PMIX_CONSTRUCT_LOCK(&lk);
-        PMIx_server_deregister_nspace(job, _notify_release, &lk);
-        PRTE_PMIX_WAIT_THREAD(&lk);
-        PRTE_PMIX_DESTRUCT_LOCK(&lk);
+        /* deregister the nspace and all of its clients in one
+         * operation - we don't need to wait for it to complete */
+        PMIx_server_deregister_nspace(job, _nspace_deregistered, dc);
 
         /* cleanup any pending server ops */
         PMIX_LOAD_PROCID(&pname, job, PMIX_RANK_WILDCARD);
@@ -549,13 +638,35 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
             ret = PRTE_ERR_OUT_OF_RESOURCE;
             goto CLEANUP;
         }
-        prte_os_dirpath_destroy(cmd_str, true, NULL);
+        prte_os_dirpath_destroy_tree(cmd_str);
         free(cmd_str);
         cmd_str = NULL;
         PRTE_RELEASE(jdata);
         break;
 
 
+        /****     REPORT LAUNCH TRACE COMMAND    ****/
+    case PRTE_DAEMON_REPORT_TRACE_CMD:
+        /* unpack the jobid */
+        n = 1;
+#if PMIX_NUMERIC_VERSION < 0x00040100
+        tmp = NULL;
+        ret = PMIx_Data_unpack(NULL, buffer, &tmp, &n, PMIX_STRING);
+        PMIX_LOAD_NSPACE(job, tmp);
+        if (NULL != tmp) {
+            free(tmp);
+        }
+#else
+        ret = PMIx_Data_unpack(NULL, buffer, &job, &n, PMIX_PROC_NSPACE);
+#endif
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            goto CLEANUP;
+        }
+        prte_state_base_trace_report(job);
+        break;
+
+
         /****     REPORT TOPOLOGY COMMAND    ****/
     case PRTE_DAEMON_REPORT_TOPOLOGY_CMD:
         PMIX_DATA_BUFFER_CONSTRUCT(&data);
@@ -595,8 +706,8 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
             free(coprocessors);
         }
         PMIX_DATA_BUFFER_CREATE(answer);
-        if (PMIx_Data_compress((uint8_t*)data.base_ptr, data.bytes_used,
-                               (uint8_t**)&pbo.bytes, &pbo.size)) {
+        if (prte_compress((uint8_t*)data.base_ptr, data.bytes_used,
+                          (uint8_t**)&pbo.bytes, &pbo.size)) {
             /* the data was compressed - mark that we compressed it */
             compressed = true;
         } else {
@@ -763,6 +874,9 @@ static char *get_prted_comm_cmd_str(int command)
     case PRTE_DAEMON_DVM_ADD_PROCS:
         return strdup("PRTE_DAEMON_DVM_ADD_PROCS");
 
+    case PRTE_DAEMON_ADD_PROCS_BATCH_CMD:
+        return strdup("PRTE_DAEMON_ADD_PROCS_BATCH_CMD");
+
     case PRTE_DAEMON_GET_STACK_TRACES:
         return strdup("PRTE_DAEMON_GET_STACK_TRACES");
 
@@ -772,6 +886,9 @@ static char *get_prted_comm_cmd_str(int command)
     case PRTE_DAEMON_DVM_CLEANUP_JOB_CMD:
         return strdup("PRTE_DAEMON_DVM_CLEANUP_JOB_CMD");
 
+    case PRTE_DAEMON_REPORT_TRACE_CMD:
+        return strdup("PRTE_DAEMON_REPORT_TRACE_CMD");
+
     default:
         return strdup("Unknown Command!");
     }
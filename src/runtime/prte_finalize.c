@@ -143,6 +143,8 @@ int prte_finalize(void)
     }
 }
     PRTE_RELEASE(prte_node_pool);
+    PRTE_RELEASE(prte_node_names);
+    prte_node_names = NULL;
 
     if (NULL != prte_fork_agent) {
         prte_argv_free(prte_fork_agent);
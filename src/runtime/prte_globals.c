@@ -43,6 +43,7 @@
 #include "src/threads/threads.h"
 
 #include "src/mca/errmgr/errmgr.h"
+#include "src/mca/plm/base/base.h"
 #include "src/mca/rmaps/rmaps.h"
 #include "src/mca/rml/rml.h"
 #include "src/util/proc_info.h"
@@ -120,6 +121,7 @@ int prte_stack_trace_wait_timeout = 30;
 /* global arrays for data storage */
 prte_pointer_array_t *prte_job_data = NULL;
 prte_pointer_array_t *prte_node_pool = NULL;
+prte_hash_table_t *prte_node_names = NULL;
 prte_pointer_array_t *prte_node_topologies = NULL;
 prte_pointer_array_t *prte_local_children = NULL;
 pmix_rank_t prte_total_procs = 0;
@@ -321,11 +323,9 @@ prte_node_rank_t prte_get_proc_node_rank(const pmix_proc_t *proc)
 
 bool prte_node_match(prte_node_t *n1, char *name)
 {
-    char **n2names = NULL;
-    char *n2alias = NULL;
     char **n1names = NULL;
     char *n1alias = NULL;
-    int i, m;
+    int i;
     prte_node_t *nptr;
 
     /* start with the simple check */
@@ -333,7 +333,22 @@ bool prte_node_match(prte_node_t *n1, char *name)
         return true;
     }
 
-    /* get the aliases for n1 and check those against "name" */
+    /* "name" might be one of our aliases */
+    if (NULL != (nptr = prte_node_lookup(name))) {
+        if (nptr == n1) {
+            return true;
+        }
+        /* or both names may refer to the same node in the pool */
+        if (nptr == prte_node_lookup(n1->name)) {
+            return true;
+        }
+    } else if (n1 == prte_node_lookup(n1->name)) {
+        /* all of an indexed node's unclaimed aliases are in the index */
+        return false;
+    }
+
+    /* n1 is not in the index (e.g., it came from a hostfile), or
+     * another node claimed "name" first - check n1's own aliases */
     if (prte_get_attribute(&n1->attributes, PRTE_NODE_ALIAS, (void**)&n1alias, PMIX_STRING)) {
         n1names = prte_argv_split(n1alias, ',');
         free(n1alias);
@@ -345,59 +360,82 @@ bool prte_node_match(prte_node_t *n1, char *name)
                 return true;
             }
         }
+        prte_argv_free(n1names);
     }
+    return false;
+}
 
-    /* "name" itself might be an alias, so find the node object for this name */
-    for (i=0; i < prte_node_pool->size; i++) {
-        if (NULL == (nptr = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, i))) {
-            continue;
-        }
-        if (prte_get_attribute(&nptr->attributes, PRTE_NODE_ALIAS, (void**)&n2alias, PMIX_STRING)) {
-            n2names = prte_argv_split(n2alias, ',');
-            free(n2alias);
-        }
-        if (NULL == n2names) {
-            continue;
-        }
-        /* no choice but an exhaustive search - fortunately, these lists are short! */
-        for (m=0; NULL != n2names[m]; m++) {
-            if (0 == strcmp(name, n2names[m])) {
-                /* this is the node! */
-                goto complete;
+static void node_unindex_names(prte_node_t *node)
+{
+    int i;
+    void *ptr;
+
+    if (NULL == node->indexed_names) {
+        return;
+    }
+    if (NULL != prte_node_names) {
+        for (i=0; NULL != node->indexed_names[i]; i++) {
+            if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(prte_node_names, node->indexed_names[i],
+                                                              strlen(node->indexed_names[i]), &ptr) &&
+                ptr == (void*)node) {
+                prte_hash_table_remove_value_ptr(prte_node_names, node->indexed_names[i],
+                                                 strlen(node->indexed_names[i]));
             }
         }
-        prte_argv_free(n2names);
-        n2names = NULL;
     }
-    return false;
+    prte_argv_free(node->indexed_names);
+    node->indexed_names = NULL;
+}
 
-  complete:
-    /* only get here is we found the node for "name" */
-    if (NULL == n1names) {
-        for (m=0; NULL != n2names[m]; m++) {
-            if (0 == strcmp(n1->name, n2names[m])) {
-                prte_argv_free(n2names);
-                return true;
-            }
-        }
-    } else {
-        for (i=0; NULL != n1names[i]; i++) {
-            for (m=0; NULL != n2names[m]; m++) {
-                if (0 == strcmp(n1->name, n2names[m])) {
-                    prte_argv_free(n1names);
-                    prte_argv_free(n2names);
-                    return true;
-                }
-            }
+static void node_index_name(prte_node_t *node, const char *name)
+{
+    void *ptr;
+
+    if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(prte_node_names, name, strlen(name), &ptr)) {
+        /* already claimed - either by us or by another node */
+        return;
+    }
+    prte_hash_table_set_value_ptr(prte_node_names, name, strlen(name), node);
+    prte_argv_append_nosize(&node->indexed_names, name);
+}
+
+void prte_node_index_names(prte_node_t *node)
+{
+    char *alias = NULL;
+    char **names;
+    int i;
+
+    if (NULL == prte_node_names) {
+        return;
+    }
+    /* drop any names we may have had before */
+    node_unindex_names(node);
+
+    if (NULL != node->name) {
+        node_index_name(node, node->name);
+    }
+    if (prte_get_attribute(&node->attributes, PRTE_NODE_ALIAS, (void**)&alias, PMIX_STRING) &&
+        NULL != alias) {
+        names = prte_argv_split(alias, ',');
+        free(alias);
+        for (i=0; NULL != names && NULL != names[i]; i++) {
+            node_index_name(node, names[i]);
         }
+        prte_argv_free(names);
     }
-    if (NULL != n1names) {
-        prte_argv_free(n1names);
+}
+
+prte_node_t* prte_node_lookup(const char *name)
+{
+    void *ptr;
+
+    if (NULL == prte_node_names || NULL == name) {
+        return NULL;
     }
-    if (NULL != n2names) {
-        prte_argv_free(n2names);
+    if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(prte_node_names, name, strlen(name), &ptr)) {
+        return NULL;
     }
-    return false;
+    return (prte_node_t*)ptr;
 }
 
 /*
@@ -580,6 +618,9 @@ static void prte_job_destruct(prte_job_t* job)
 
     PRTE_LIST_DESTRUCT(&job->children);
 
+    /* return the jobid for reuse */
+    prte_plm_base_release_jobid(job);
+
     if (NULL != prte_job_data && 0 <= job->index) {
         /* remove the job from the global array */
         prte_pointer_array_set_item(prte_job_data, job->index, NULL);
@@ -615,6 +656,7 @@ static void prte_node_construct(prte_node_t* node)
 
     node->flags = 0;
     PRTE_CONSTRUCT(&node->attributes, prte_list_t);
+    node->indexed_names = NULL;
 }
 
 static void prte_node_destruct(prte_node_t* node)
@@ -622,6 +664,8 @@ static void prte_node_destruct(prte_node_t* node)
     int i;
     prte_proc_t *proc;
 
+    node_unindex_names(node);
+
     if (NULL != node->name) {
         free(node->name);
         node->name = NULL;
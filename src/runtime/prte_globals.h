@@ -302,6 +302,9 @@ typedef struct {
     prte_node_flags_t flags;
     /* list of prte_attribute_t */
     prte_list_t attributes;
+    /* names (hostname and aliases) under which this node is
+     * registered in prte_node_names - NULL if not indexed */
+    char **indexed_names;
 } prte_node_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_node_t);
 
@@ -513,6 +516,15 @@ PRTE_EXPORT prte_node_rank_t prte_get_proc_node_rank(const pmix_proc_t *proc);
 /* check to see if two nodes match */
 PRTE_EXPORT bool prte_node_match(prte_node_t *n1, char *name);
 
+/* register the hostname and all aliases of a node in the global
+ * name table so it can be found with a single lookup. Must be
+ * called again whenever the name or the aliases change - a name
+ * already claimed by another node is left with that node */
+PRTE_EXPORT void prte_node_index_names(prte_node_t *node);
+
+/* find the node known by the given hostname or alias */
+PRTE_EXPORT prte_node_t* prte_node_lookup(const char *name);
+
 /* global variables used by RTE - instanced in prte_globals.c */
 PRTE_EXPORT extern bool prte_debug_daemons_flag;
 PRTE_EXPORT extern bool prte_debug_daemons_file_flag;
@@ -575,6 +587,7 @@ PRTE_EXPORT extern prte_timer_t *prte_mpiexec_timeout;
 /* global arrays for data storage */
 PRTE_EXPORT extern prte_pointer_array_t *prte_job_data;
 PRTE_EXPORT extern prte_pointer_array_t *prte_node_pool;
+PRTE_EXPORT extern prte_hash_table_t *prte_node_names;
 PRTE_EXPORT extern prte_pointer_array_t *prte_node_topologies;
 PRTE_EXPORT extern prte_pointer_array_t *prte_local_children;
 PRTE_EXPORT extern pmix_rank_t prte_total_procs;
@@ -300,6 +300,12 @@ int prte_init(int* pargc, char*** pargv, prte_proc_type_t flags)
         error = "setup node array";
         goto error;
     }
+    prte_node_names = PRTE_NEW(prte_hash_table_t);
+    if (PRTE_SUCCESS != (ret = prte_hash_table_init(prte_node_names, 1024))) {
+        PRTE_ERROR_LOG(ret);
+        error = "setup node name table";
+        goto error;
+    }
     prte_node_topologies = PRTE_NEW(prte_pointer_array_t);
     if (PRTE_SUCCESS != (ret = prte_pointer_array_init(prte_node_topologies,
                                PRTE_GLOBAL_ARRAY_BLOCK_SIZE,
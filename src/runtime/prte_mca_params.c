@@ -34,11 +34,13 @@
 #endif
 #include <signal.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "src/mca/base/prte_mca_base_var.h"
 #include "src/mca/prteinstalldirs/prteinstalldirs.h"
 #include "src/util/output.h"
 #include "src/util/argv.h"
+#include "src/util/compress.h"
 #include "src/util/printf.h"
 #include "src/util/prte_environ.h"
 
@@ -357,6 +359,14 @@ int prte_register_params(void)
                                   PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
                                   &prte_progress_thread_debug_level);
 
+    prte_event_profile_enabled = false;
+    (void) prte_mca_base_var_register ("prte", "prte", NULL, "event_profile",
+                                  "Record queue wait and run times of the callbacks shifted onto the main "
+                                  "event base, queryable via PMIx_Query [default: no]",
+                                  PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prte_event_profile_enabled);
+
     if (0 <= prte_progress_thread_debug_level) {
         prte_progress_thread_debug = prte_output_open(NULL);
         prte_output_set_verbosity(prte_progress_thread_debug,
@@ -635,6 +645,42 @@ int prte_register_params(void)
                                   PRTE_INFO_LVL_3, PRTE_MCA_BASE_VAR_SCOPE_ALL,
                                   &prte_data_server_uri);
 
+    /* compression of large internal payloads */
+    prte_compress_method = "zlib";
+    (void) prte_mca_base_var_register ("prte", "prte", NULL, "compress_method",
+                                  "Method used to compress large internal payloads such as launch messages and the nidmap [\"zlib\" (default) or \"none\"]",
+                                  PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prte_compress_method);
+    if (NULL != prte_compress_method &&
+        0 != strcmp(prte_compress_method, "zlib") &&
+        0 != strcmp(prte_compress_method, "none")) {
+        prte_output(0, "Unsupported value \"%s\" for prte_compress_method - must be \"zlib\" or \"none\"",
+                    prte_compress_method);
+        return PRTE_ERROR;
+    }
+
+    prte_compress_limit = 4096;
+    (void) prte_mca_base_var_register ("prte", "prte", NULL, "compress_limit",
+                                  "Payloads smaller than this many bytes are not compressed [default: 4096]",
+                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prte_compress_limit);
+
+    prte_compress_threads = 1;
+    (void) prte_mca_base_var_register ("prte", "prte", NULL, "compress_threads",
+                                  "Number of threads used to compress and decompress large payloads [default: 1]",
+                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                  &prte_compress_threads);
+
+    prte_compress_chunk_size = 4194304;
+    (void) prte_mca_base_var_register ("prte", "prte", NULL, "compress_chunk_size",
+                                  "Size in bytes of the pieces a large payload is split into when compressing with more than one thread [default: 4MB]",
+                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                  &prte_compress_chunk_size);
+
     prte_mca_base_var_register("prte", "prte", NULL, "pmix_verbose",
                           "Verbosity for PRTE-level PMIx code",
                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
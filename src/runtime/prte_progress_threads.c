@@ -14,13 +14,20 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#include <stdlib.h>
 #include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
 
 #include "src/class/prte_list.h"
 #include "src/event/event-internal.h"
+#include "src/sys/atomic.h"
 #include "src/threads/threads.h"
+#include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/fd.h"
+#include "src/util/printf.h"
 
 #include "src/runtime/prte_progress_threads.h"
 
@@ -436,3 +443,205 @@ int prte_progress_thread_resume(const char *name)
 
     return PRTE_ERR_NOT_FOUND;
 }
+
+/*
+ * Event profiler. Only events shifted onto prte_event_base are
+ * profiled, so the statistics are only ever updated from that
+ * base's thread and need no locking. The number of events posted
+ * is the only value touched by other threads.
+ */
+bool prte_event_profile_enabled = false;
+
+#define PRTE_EVPROF_MAX_SITES   512
+/* run time histogram buckets: <1us, <2us, <4us, ... */
+#define PRTE_EVPROF_NBUCKETS    24
+
+typedef struct {
+    event_callback_fn cbfn;
+    const char *site;
+    uint64_t count;
+    double run_total;
+    double run_max;
+    double wait_total;
+    double wait_max;
+    uint64_t hist[PRTE_EVPROF_NBUCKETS];
+} prte_evprof_site_t;
+
+typedef struct {
+    event_callback_fn cbfn;
+    void *cbdata;
+    const char *site;
+    double posted;
+} prte_evprof_caddy_t;
+
+static prte_evprof_site_t evprof_sites[PRTE_EVPROF_MAX_SITES];
+static int evprof_nsites = 0;
+static prte_atomic_int32_t evprof_posted = 0;
+static int32_t evprof_started = 0;
+static int32_t evprof_max_depth = 0;
+
+static double evprof_now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+}
+
+static prte_evprof_site_t *evprof_lookup(event_callback_fn cbfn, const char *site)
+{
+    size_t n, idx;
+
+    idx = ((uintptr_t)cbfn >> 4) % PRTE_EVPROF_MAX_SITES;
+    for (n = 0; n < PRTE_EVPROF_MAX_SITES; n++) {
+        if (evprof_sites[idx].cbfn == cbfn) {
+            return &evprof_sites[idx];
+        }
+        if (NULL == evprof_sites[idx].cbfn) {
+            evprof_sites[idx].cbfn = cbfn;
+            evprof_sites[idx].site = site;
+            ++evprof_nsites;
+            return &evprof_sites[idx];
+        }
+        idx = (idx + 1) % PRTE_EVPROF_MAX_SITES;
+    }
+    /* table is full */
+    return NULL;
+}
+
+static void evprof_cb(int fd, short flags, void *cbdata)
+{
+    prte_evprof_caddy_t *cd = (prte_evprof_caddy_t*)cbdata;
+    event_callback_fn cbfn = cd->cbfn;
+    void *arg = cd->cbdata;
+    const char *site = cd->site;
+    double start, wait, run;
+    prte_evprof_site_t *ps;
+    int32_t depth;
+    int b;
+
+    start = evprof_now();
+    wait = start - cd->posted;
+    /* the callback may reuse its event for another shift */
+    free(cd);
+
+    depth = evprof_posted - evprof_started;
+    ++evprof_started;
+    if (depth > evprof_max_depth) {
+        evprof_max_depth = depth;
+    }
+
+    cbfn(fd, flags, arg);
+
+    run = evprof_now() - start;
+    if (NULL == (ps = evprof_lookup(cbfn, site))) {
+        return;
+    }
+    ps->count++;
+    ps->run_total += run;
+    if (run > ps->run_max) {
+        ps->run_max = run;
+    }
+    ps->wait_total += wait;
+    if (wait > ps->wait_max) {
+        ps->wait_max = wait;
+    }
+    for (b = 0; b < PRTE_EVPROF_NBUCKETS - 1 && (run * 1000000.0) >= (double)(1 << b); b++);
+    ps->hist[b]++;
+}
+
+int prte_event_profile_assign(struct event *ev, prte_event_base_t *evbase,
+                              event_callback_fn cbfn, void *cbd,
+                              const char *site)
+{
+    prte_evprof_caddy_t *cd;
+
+    if (!prte_event_profile_enabled || evbase != prte_event_base ||
+        NULL == (cd = (prte_evprof_caddy_t*)malloc(sizeof(prte_evprof_caddy_t)))) {
+        return prte_event_assign(ev, evbase, -1, PRTE_EV_WRITE, cbfn, cbd);
+    }
+    cd->cbfn = cbfn;
+    cd->cbdata = cbd;
+    cd->site = site;
+    cd->posted = evprof_now();
+    (void)prte_atomic_fetch_add_32(&evprof_posted, 1);
+    return prte_event_assign(ev, evbase, -1, PRTE_EV_WRITE, evprof_cb, cd);
+}
+
+static int evprof_cmp(const void *a, const void *b)
+{
+    const prte_evprof_site_t *pa = *(const prte_evprof_site_t**)a;
+    const prte_evprof_site_t *pb = *(const prte_evprof_site_t**)b;
+
+    if (pa->run_total < pb->run_total) {
+        return 1;
+    }
+    if (pa->run_total > pb->run_total) {
+        return -1;
+    }
+    return 0;
+}
+
+char *prte_event_profile_report(int ntop)
+{
+    prte_evprof_site_t **sorted;
+    prte_evprof_site_t *ps;
+    char **lines = NULL, *line, *hist, *tmp, *result;
+    int n, k, b, last;
+
+    if (!prte_event_profile_enabled) {
+        return strdup("event profiling is disabled");
+    }
+
+    prte_asprintf(&line, "queued: %d max queued: %d callback sites: %d",
+                  (int)(evprof_posted - evprof_started), (int)evprof_max_depth,
+                  evprof_nsites);
+    prte_argv_append_nosize(&lines, line);
+    free(line);
+    if (0 == evprof_nsites) {
+        goto done;
+    }
+
+    sorted = (prte_evprof_site_t**)malloc(evprof_nsites * sizeof(prte_evprof_site_t*));
+    if (NULL == sorted) {
+        goto done;
+    }
+    for (n = 0, k = 0; n < PRTE_EVPROF_MAX_SITES && k < evprof_nsites; n++) {
+        if (NULL != evprof_sites[n].cbfn) {
+            sorted[k++] = &evprof_sites[n];
+        }
+    }
+    qsort(sorted, k, sizeof(prte_evprof_site_t*), evprof_cmp);
+    if (0 < ntop && ntop < k) {
+        k = ntop;
+    }
+
+    prte_argv_append_nosize(&lines, "site count run_total_us run_max_us "
+                                    "wait_mean_us wait_max_us run_hist_log2_us");
+    for (n = 0; n < k; n++) {
+        ps = sorted[n];
+        /* histogram up to the last non-empty bucket */
+        for (last = PRTE_EVPROF_NBUCKETS - 1; 0 < last && 0 == ps->hist[last]; last--);
+        hist = NULL;
+        for (b = 0; b <= last; b++) {
+            prte_asprintf(&tmp, "%s%s%llu", (NULL == hist) ? "" : hist,
+                          (NULL == hist) ? "" : ",", (unsigned long long)ps->hist[b]);
+            free(hist);
+            hist = tmp;
+        }
+        prte_asprintf(&line, "%s[%p] %llu %.0f %.0f %.1f %.0f [%s]",
+                      ps->site, (void*)ps->cbfn, (unsigned long long)ps->count,
+                      ps->run_total * 1000000.0, ps->run_max * 1000000.0,
+                      (0 == ps->count) ? 0.0 : (ps->wait_total / ps->count) * 1000000.0,
+                      ps->wait_max * 1000000.0, (NULL == hist) ? "" : hist);
+        free(hist);
+        prte_argv_append_nosize(&lines, line);
+        free(line);
+    }
+    free(sorted);
+
+  done:
+    result = prte_argv_join(lines, '\n');
+    prte_argv_free(lines);
+    return result;
+}
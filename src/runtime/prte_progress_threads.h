@@ -67,4 +67,15 @@ PRTE_EXPORT int prte_progress_thread_pause(const char *name);
  */
 PRTE_EXPORT int prte_progress_thread_resume(const char *name);
 
+/**
+ * Report the event profile of prte_event_base.
+ *
+ * Returns a newly allocated string describing the number of shifted
+ * events currently queued and, for the ntop callbacks (all if ntop is
+ * zero) that have consumed the most run time, the number of calls,
+ * run time, queue wait time and a log2 histogram of run times. The
+ * caller is responsible for freeing the string.
+ */
+PRTE_EXPORT char *prte_event_profile_report(int ntop);
+
 #endif
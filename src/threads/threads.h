@@ -68,7 +68,7 @@ typedef pthread_cond_t prte_condition_t;
 /* define a threadshift macro */
 #define PRTE_THREADSHIFT(x, eb, f, p)                                   \
     do {                                                                \
-        prte_event_set((eb), &((x)->ev), -1, PRTE_EV_WRITE, (f), (x));  \
+        prte_event_shift_set((eb), &((x)->ev), (f), (x));               \
         prte_event_set_priority(&((x)->ev), (p));                       \
         PRTE_POST_OBJECT((x));                                          \
         prte_event_active(&((x)->ev), PRTE_EV_WRITE, 1);                \
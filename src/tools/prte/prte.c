@@ -690,6 +690,9 @@ int prte(int argc, char *argv[])
      */
     prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DAEMON,
                             PRTE_RML_PERSISTENT, prte_daemon_recv, NULL);
+    /* setup to receive the job state rollups from the daemons */
+    prte_state_base_rollup_start();
+    prte_state_base_trace_start();
 
     /* setup to capture job-level info */
     PMIX_INFO_LIST_START(jinfo);
@@ -78,6 +78,7 @@
 #include "src/util/show_help.h"
 #include "src/util/proc_info.h"
 #include "src/util/session_dir.h"
+#include "src/util/compress.h"
 #include "src/util/name_fns.h"
 #include "src/util/nidmap.h"
 #include "src/util/parse_options.h"
@@ -126,7 +127,8 @@ static void node_regex_report(int status, pmix_proc_t* sender,
                               prte_rml_tag_t tag, void *cbdata);
 static void report_prted(void);
 
-static pmix_data_buffer_t *bucket, *mybucket = NULL;
+static prte_plm_rollup_t *collected = NULL;
+static bool mine_collected = false;
 static int ncollected = 0;
 static bool node_regex_waiting = false;
 static bool prted_abort = false;
@@ -255,14 +257,13 @@ int main(int argc, char *argv[])
     pmix_proc_t target;
     char *myuri;
     prte_value_t *pval;
-    int8_t flag;
-    uint8_t naliases, ni;
-    char **nonlocal = NULL;
+    char **nonlocal = NULL, *aliases;
+    prte_plm_rollup_t *myrollup;
+    pmix_byte_object_t uribo, invbo;
     int n;
     pmix_info_t info;
     size_t z1=1;
     pmix_value_t *vptr;
-    int32_t one=1;
     char **pargv;
     int pargc;
     prte_schizo_base_module_t *schizo;
@@ -278,7 +279,7 @@ int main(int argc, char *argv[])
     }
 
     /* initialize the globals */
-    PMIX_DATA_BUFFER_CREATE(bucket);
+    collected = PRTE_NEW(prte_plm_rollup_t);
 
     /* init the tiny part of PRTE we use */
     prte_init_util(PRTE_PROC_DAEMON);
@@ -499,6 +500,9 @@ int main(int argc, char *argv[])
     /* setup the primary daemon command receive function */
     prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DAEMON,
                             PRTE_RML_PERSISTENT, prte_daemon_recv, NULL);
+    /* and the receive for job state rollups from our children */
+    prte_state_base_rollup_start();
+    prte_state_base_trace_start();
 
     /* output a message indicating we are alive, our name, and our pid
      * for debugging purposes
@@ -607,14 +611,10 @@ int main(int argc, char *argv[])
      * can turn right around and begin issuing orders to us
      */
 
-    PMIX_DATA_BUFFER_CONSTRUCT(&buffer);  // zero-byte message
-    /* insert our name for rollup purposes */
-    prc = PMIx_Data_pack(NULL, &buffer, PRTE_PROC_MY_NAME, 1, PMIX_PROC);
-    if (PMIX_SUCCESS != prc) {
-        PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-        goto DONE;
-    }
+    /* start a rollup containing our own report */
+    myrollup = PRTE_NEW(prte_plm_rollup_t);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&uribo);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&invbo);
 
     /* get any connection info we may have pushed */
     if (PMIX_SUCCESS == PMIx_Get(&prte_process_info.myproc, PMIX_PROC_URI, NULL, 0, &vptr) && NULL != vptr) {
@@ -625,48 +625,25 @@ int main(int argc, char *argv[])
         if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &pbuf, &z1, 1, PMIX_SIZE))) {
             PMIX_ERROR_LOG(prc);
             ret = PRTE_ERROR;
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
             goto DONE;
         }
         if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &pbuf, &info, 1, PMIX_INFO))) {
             PMIX_ERROR_LOG(prc);
             ret = PRTE_ERROR;
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
             goto DONE;
         }
         PMIX_INFO_DESTRUCT(&info);
-        prc = PMIx_Data_unload(&pbuf, &pbo);
-        prc = PMIx_Data_pack(NULL, &buffer, &one, 1, PMIX_INT32);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            goto DONE;
-        }
-        prc = PMIx_Data_pack(NULL, &buffer, &pbo, 1, PMIX_BYTE_OBJECT);
-        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            goto DONE;
-        }
-    } else {
-        int32_t zero=0;
-        prc = PMIx_Data_pack(NULL, &buffer, &zero, 1, PMIX_INT32);
+        prc = PMIx_Data_unload(&pbuf, &uribo);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
         if (PMIX_SUCCESS != prc) {
             PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
+            ret = PRTE_ERROR;
             goto DONE;
         }
     }
 
-    /* include our node name */
-    prc = PMIx_Data_pack(NULL, &buffer, &prte_process_info.nodename, 1, PMIX_STRING);
-    if (PMIX_SUCCESS != prc) {
-        PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-        goto DONE;
-    }
-
     /* include any non-loopback aliases for this node */
     for (n=0; NULL != prte_process_info.aliases[n]; n++) {
         if (0 != strcmp(prte_process_info.aliases[n], "localhost") &&
@@ -674,40 +651,14 @@ int main(int argc, char *argv[])
             prte_argv_append_nosize(&nonlocal, prte_process_info.aliases[n]);
         }
     }
-    naliases = prte_argv_count(nonlocal);
-    prc = PMIx_Data_pack(NULL, &buffer, &naliases, 1, PMIX_UINT8);
-    if (PMIX_SUCCESS != prc) {
-        PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-        prte_argv_free(nonlocal);
-        goto DONE;
-    }
-    for (ni=0; ni < naliases; ni++) {
-        prc = PMIx_Data_pack(NULL, &buffer, &nonlocal[ni], 1, PMIX_STRING);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            prte_argv_free(nonlocal);
-            goto DONE;
-        }
-    }
+    aliases = prte_argv_join(nonlocal, ',');
     prte_argv_free(nonlocal);
 
-    /* always send back our topology signature - this is a small string
-     * and won't hurt anything */
-    prc = PMIx_Data_pack(NULL, &buffer, &prte_topo_signature, 1, PMIX_STRING);
-    if (PMIX_SUCCESS != prc) {
-        PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-        goto DONE;
-    }
-
     /* if we are rank=1, then send our topology back - otherwise, prte
      * will request it if necessary */
     if (1 == PRTE_PROC_MY_NAME->rank) {
         pmix_data_buffer_t data;
         pmix_topology_t ptopo;
-        bool compressed;
 
         /* setup an intermediate buffer */
         PMIX_DATA_BUFFER_CONSTRUCT(&data);
@@ -717,38 +668,23 @@ int main(int argc, char *argv[])
         prc = PMIx_Data_pack(NULL, &data, &ptopo, 1, PMIX_TOPO);
         if (PMIX_SUCCESS != prc) {
             PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
             PMIX_DATA_BUFFER_DESTRUCT(&data);
             goto DONE;
         }
-        if (PMIx_Data_compress((uint8_t*)data.base_ptr, data.bytes_used,
-                                (uint8_t**)&pbo.bytes, &pbo.size)) {
+        if (prte_compress((uint8_t*)data.base_ptr, data.bytes_used,
+                           (uint8_t**)&pbo.bytes, &pbo.size)) {
             /* the data was compressed - mark that we compressed it */
-            compressed = true;
+            myrollup->topo_compressed = true;
         } else {
-            compressed = false;
+            myrollup->topo_compressed = false;
             pbo.bytes = data.base_ptr;
             pbo.size = data.bytes_used;
             data.base_ptr = NULL;
             data.bytes_used = 0;
         }
         PMIX_DATA_BUFFER_DESTRUCT(&data);
-        prc = PMIx_Data_pack(NULL, &buffer, &compressed, 1, PMIX_BOOL);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            goto DONE;
-        }
-        /* pack the data */
-        prc = PMIx_Data_pack(NULL, &buffer, &pbo, 1, PMIX_BYTE_OBJECT);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            goto DONE;
-        }
-        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+        myrollup->topo = pbo;
+        myrollup->topo_included = true;
     }
 
     /* collect our network inventory */
@@ -761,55 +697,48 @@ int main(int argc, char *argv[])
     }
     PRTE_PMIX_WAIT_THREAD(&xfer.lock);
     if (NULL != xfer.info) {
-        /* pack a flag indicating that the inventory is included */
-        flag = 1;
-        prc = PMIx_Data_pack(NULL, &buffer, &flag, 1, PMIX_INT8);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            goto DONE;
-        }
         PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
         if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &pbuf, &xfer.ninfo, 1, PMIX_SIZE))) {
             PMIX_ERROR_LOG(prc);
             ret = PRTE_ERROR;
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
             PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
             goto DONE;
         }
         if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &pbuf, xfer.info, xfer.ninfo, PMIX_INFO))) {
             PMIX_ERROR_LOG(prc);
             ret = PRTE_ERROR;
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-            goto DONE;
-        }
-        prc = PMIx_Data_unload(&pbuf, &pbo);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-            goto DONE;
-        }
-        prc = PMIx_Data_pack(NULL, &buffer, &pbo, 1, PMIX_BYTE_OBJECT);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
             PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
             goto DONE;
         }
+        prc = PMIx_Data_unload(&pbuf, &invbo);
         PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-    } else {
-        /* pack a flag indicating no inventory was provided */
-        flag = 0;
-        prc = PMIx_Data_pack(NULL, &buffer, &flag, 1, PMIX_INT8);
         if (PMIX_SUCCESS != prc) {
             PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
             goto DONE;
         }
     }
 
+    /* always send back our topology signature - this is a small string
+     * and won't hurt anything */
+    ret = prte_plm_base_rollup_add(myrollup, PRTE_PROC_MY_NAME->rank,
+                                   prte_process_info.nodename, aliases,
+                                   prte_topo_signature, &uribo, &invbo);
+    if (NULL != aliases) {
+        free(aliases);
+    }
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        goto DONE;
+    }
+    PMIX_DATA_BUFFER_CONSTRUCT(&buffer);
+    ret = prte_plm_base_rollup_pack(&buffer, myrollup);
+    PRTE_RELEASE(myrollup);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_DESTRUCT(&buffer);
+        goto DONE;
+    }
+
     /* send it to the designated target */
     if (0 > (ret = prte_rml.send_buffer_nb(&target, &buffer,
                                            PRTE_RML_TAG_PRTED_CALLBACK,
@@ -941,85 +870,70 @@ static void rollup(int status, pmix_proc_t* sender,
                    pmix_data_buffer_t *buffer,
                    prte_rml_tag_t tag, void *cbdata)
 {
-    pmix_proc_t child;
-    int32_t flag, cnt;
-    pmix_byte_object_t bo;
+    prte_plm_rollup_entry_t *child;
     pmix_data_buffer_t pbkt;
     pmix_info_t *info;
     pmix_proc_t proc;
     pmix_status_t prc;
-    size_t ninfo;
+    size_t n, ninfo;
+    int32_t cnt;
+    int rc;
 
     ncollected++;
+    if (NULL == collected) {
+        collected = PRTE_NEW(prte_plm_rollup_t);
+    }
+
+    /* merge the contents into our rollup - the reports are
+     * combined into a single columnar rollup for our parent */
+    if (PRTE_SUCCESS != (rc = prte_plm_base_rollup_unpack(buffer, collected))) {
+        PRTE_ERROR_LOG(rc);
+        goto report;
+    }
 
-    /* if the sender is ourselves, then we save that buffer
-     * so we can insert it at the beginning */
     if (PMIX_CHECK_PROCID(sender, PRTE_PROC_MY_NAME)) {
-        PMIX_DATA_BUFFER_CREATE(mybucket);
-        prc = PMIx_Data_copy_payload(mybucket, buffer);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            goto report;
-        }
-    } else {
-       /* xfer the contents of the rollup to our bucket */
-        prc = PMIx_Data_copy_payload(bucket, buffer);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            goto report;
-        }
-        /* the first entry in the bucket will be from our
-         * direct child - harvest it for connection info */
-        cnt = 1;
-        prc = PMIx_Data_unpack(NULL, buffer, &child, &cnt, PMIX_PROC);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            goto report;
-        }
-        cnt = 1;
-        prc = PMIx_Data_unpack(NULL, buffer, &flag, &cnt, PMIX_INT32);
+        mine_collected = true;
+        goto report;
+    }
+
+    /* harvest the connection info of our direct child */
+    child = prte_plm_base_rollup_lookup(collected, sender->rank);
+    if (NULL == child || 0 == child->uri.size) {
+        goto report;
+    }
+    PMIX_LOAD_PROCID(&proc, prte_process_info.myproc.nspace, sender->rank);
+    /* it was packed using PMIx, so unpack it the same way - the
+     * rollup retains the bytes, so unpack from a copy */
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+    prc = PMIx_Data_embed(&pbkt, &child->uri);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        goto report;
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(&proc, &pbkt, &ninfo, &cnt, PMIX_SIZE))) {
+        PMIX_ERROR_LOG(prc);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        goto report;
+    }
+    PMIX_INFO_CREATE(info, ninfo);
+    cnt = ninfo;
+    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(&proc, &pbkt, (void*)info, &cnt, PMIX_INFO))) {
+        PMIX_ERROR_LOG(prc);
+        PMIX_INFO_FREE(info, ninfo);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        goto report;
+    }
+    for (n=0; n < ninfo; n++) {
+        prc = PMIx_Store_internal(&proc, PMIX_PROC_URI, &info[n].value);
         if (PMIX_SUCCESS != prc) {
             PMIX_ERROR_LOG(prc);
-            goto report;
-        }
-        if (0 < flag) {
-           PMIX_LOAD_PROCID(&proc, prte_process_info.myproc.nspace, sender->rank);
-            /* we have connection info */
-            cnt = 1;
-            prc = PMIx_Data_unpack(&proc, buffer, &bo, &cnt, PMIX_BYTE_OBJECT);
-            if (PMIX_SUCCESS != prc) {
-                PMIX_ERROR_LOG(prc);
-                goto report;
-            }
-            /* it was packed using PMIx, so unpack it the same way */
-            PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
-            prc = PMIx_Data_load(&pbkt, &bo);
-            cnt = 1;
-            if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(&proc, &pbkt, &ninfo, &cnt, PMIX_SIZE))) {
-                PMIX_ERROR_LOG(prc);
-                PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                goto report;
-            }
-            PMIX_INFO_CREATE(info, ninfo);
-            cnt = ninfo;
-            if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(&proc, &pbkt, (void*)info, &cnt, PMIX_INFO))) {
-                PMIX_ERROR_LOG(prc);
-                PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                goto report;
-            }
-            for (cnt=0; cnt < (int)ninfo; cnt++) {
-                prc = PMIx_Store_internal(&proc, PMIX_PROC_URI, &info[cnt].value);
-                if (PMIX_SUCCESS != prc) {
-                    PMIX_ERROR_LOG(prc);
-                    PMIX_INFO_FREE(info, (size_t)flag);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                    goto report;
-                }
-            }
-            PMIX_INFO_FREE(info, (size_t)flag);
-            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            break;
         }
     }
+    PMIX_INFO_FREE(info, ninfo);
+    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
 
   report:
     report_prted();
@@ -1028,22 +942,28 @@ static void rollup(int status, pmix_proc_t* sender,
 static void report_prted(void)
 {
     int nreqd, ret;
+    pmix_data_buffer_t *buf;
 
     /* get the number of children */
     nreqd = prte_routed.num_routes() + 1;
-    if (nreqd == ncollected && NULL != mybucket && !node_regex_waiting) {
-        /* add the collection of our children's buckets to ours */
-        ret = PMIx_Data_copy_payload(mybucket, bucket);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
+    if (nreqd == ncollected && mine_collected && !node_regex_waiting) {
+        /* pack the combined rollup of ourselves and our children */
+        PMIX_DATA_BUFFER_CREATE(buf);
+        ret = prte_plm_base_rollup_pack(buf, collected);
+        PRTE_RELEASE(collected);
+        collected = NULL;
+        mine_collected = false;
+        if (PRTE_SUCCESS != ret) {
+            PRTE_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_RELEASE(buf);
+            return;
         }
-        PMIX_DATA_BUFFER_RELEASE(bucket);
         /* relay this on to our parent */
-        if (0 > (ret = prte_rml.send_buffer_nb(PRTE_PROC_MY_PARENT, mybucket,
+        if (0 > (ret = prte_rml.send_buffer_nb(PRTE_PROC_MY_PARENT, buf,
                                                PRTE_RML_TAG_PRTED_CALLBACK,
                                                prte_rml_send_callback, NULL))) {
             PRTE_ERROR_LOG(ret);
-            PMIX_DATA_BUFFER_RELEASE(mybucket);
+            PMIX_DATA_BUFFER_RELEASE(buf);
         }
     }
 }
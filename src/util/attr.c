@@ -449,6 +449,8 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "JOB_NOINHERIT";
         case PRTE_JOB_FILE:
             return "JOB-FILE";
+        case PRTE_JOB_SPAWN_BATCH:
+            return "JOB-SPAWN-BATCH";
 
         case PRTE_PROC_NOBARRIER:
             return "PROC-NOBARRIER";
@@ -478,6 +480,8 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "PROC-CGROUP";
         case PRTE_PROC_NBEATS:
             return "PROC-NBEATS";
+        case PRTE_PROC_LAUNCH_START:
+            return "PROC-LAUNCH-START";
 
         case PRTE_RML_TRANSPORT_TYPE:
             return "RML-TRANSPORT-TYPE";
@@ -188,6 +188,7 @@ typedef uint16_t prte_job_flags_t;
 #define PRTE_JOB_PPR                    (PRTE_JOB_START_KEY + 81)    // char* - string specifying the procs-per-resource pattern
 #define PRTE_JOB_NOINHERIT              (PRTE_JOB_START_KEY + 82)    // bool do NOT inherit parent's mapping/ranking/binding policies
 #define PRTE_JOB_FILE                   (PRTE_JOB_START_KEY + 83)    // char* - file to use for sequential or rankfile mapping
+#define PRTE_JOB_SPAWN_BATCH            (PRTE_JOB_START_KEY + 84)    // bool - job arrived in a spawn batch and shares its launch xcast
 
 #define PRTE_JOB_MAX_KEY   300
 
@@ -227,6 +228,7 @@ typedef uint16_t prte_proc_flags_t;
 #define PRTE_PROC_NODENAME        (PRTE_PROC_START_KEY + 12)           // string - node where proc is located, used only by tools
 #define PRTE_PROC_CGROUP          (PRTE_PROC_START_KEY + 13)           // string - name of cgroup this proc shall be assigned to
 #define PRTE_PROC_NBEATS          (PRTE_PROC_START_KEY + 14)           // int32 - number of heartbeats in current window
+#define PRTE_PROC_LAUNCH_START    (PRTE_PROC_START_KEY + 15)           // timeval - time the launcher started this daemon
 
 #define PRTE_PROC_MAX_KEY   400
 
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+#ifdef HAVE_ARPA_INET_H
+#include <arpa/inet.h>
+#endif
+
+#include "src/pmix/pmix-internal.h"
+#include "src/sys/atomic.h"
+#include "src/threads/threads.h"
+
+#include "src/util/compress.h"
+
+char *prte_compress_method = NULL;
+int prte_compress_limit = 4096;
+int prte_compress_threads = 1;
+int prte_compress_chunk_size = 4194304;
+
+/*
+ * A compressed payload starts with the number of chunks, followed
+ * by the raw and stored size of each chunk, and then the chunks
+ * themselves. A chunk whose stored size equals its raw size was
+ * not compressible and is stored as-is. All header fields are
+ * uint32 in network byte order.
+ */
+
+typedef struct {
+    uint8_t *in;
+    size_t inlen;
+    uint8_t *out;
+    size_t outlen;
+    bool done;
+} chunk_t;
+
+typedef struct {
+    chunk_t *chunks;
+    int32_t nchunks;
+    prte_atomic_int32_t next;
+    bool compress;
+} chunk_tracker_t;
+
+static void chunk_loop(chunk_tracker_t *trk)
+{
+    chunk_t *c;
+    int32_t n;
+
+    while (1) {
+        n = prte_atomic_fetch_add_32(&trk->next, 1);
+        if (trk->nchunks <= n) {
+            break;
+        }
+        c = &trk->chunks[n];
+        if (c->done) {
+            /* stored as-is */
+            continue;
+        }
+        if (trk->compress) {
+            c->done = PMIx_Data_compress(c->in, c->inlen, &c->out, &c->outlen);
+        } else {
+            c->done = PMIx_Data_decompress(&c->out, &c->outlen, c->in, c->inlen);
+        }
+    }
+}
+
+static void* chunk_thread(prte_object_t *obj)
+{
+    prte_thread_t *t = (prte_thread_t*)obj;
+
+    chunk_loop((chunk_tracker_t*)t->t_arg);
+    return NULL;
+}
+
+/* process all the chunks in the tracker, fanning them out
+ * across threads if we were given any */
+static void run_chunks(chunk_tracker_t *trk)
+{
+    int i, nthreads;
+    prte_thread_t *threads;
+
+    trk->next = 0;
+    nthreads = prte_compress_threads;
+    if (trk->nchunks < nthreads) {
+        nthreads = trk->nchunks;
+    }
+    if (nthreads <= 1) {
+        chunk_loop(trk);
+        return;
+    }
+
+    threads = (prte_thread_t*)malloc(nthreads * sizeof(prte_thread_t));
+    if (NULL == threads) {
+        chunk_loop(trk);
+        return;
+    }
+    for (i=0; i < nthreads; i++) {
+        PRTE_CONSTRUCT(&threads[i], prte_thread_t);
+        threads[i].t_run = chunk_thread;
+        threads[i].t_arg = trk;
+        if (PRTE_SUCCESS != prte_thread_start(&threads[i])) {
+            /* just do the work with the threads we have */
+            PRTE_DESTRUCT(&threads[i]);
+            break;
+        }
+    }
+    nthreads = i;
+    if (0 == nthreads) {
+        /* couldn't start any threads, so do it ourselves */
+        chunk_loop(trk);
+    }
+    for (i=0; i < nthreads; i++) {
+        prte_thread_join(&threads[i], NULL);
+        PRTE_DESTRUCT(&threads[i]);
+    }
+    free(threads);
+}
+
+static void free_chunks(chunk_tracker_t *trk)
+{
+    int32_t n;
+
+    for (n=0; n < trk->nchunks; n++) {
+        if (NULL != trk->chunks[n].out) {
+            free(trk->chunks[n].out);
+        }
+    }
+    free(trk->chunks);
+}
+
+bool prte_compress(uint8_t *inbytes, size_t inlen,
+                   uint8_t **outbytes, size_t *outlen)
+{
+    chunk_tracker_t trk;
+    chunk_t *c;
+    size_t chunk, total, hdrlen;
+    uint32_t u32;
+    uint8_t *ptr, *dptr;
+    int32_t n;
+
+    *outbytes = NULL;
+    *outlen = 0;
+
+    if (NULL == inbytes ||
+        (NULL != prte_compress_method && 0 == strcmp(prte_compress_method, "none")) ||
+        inlen < (size_t)prte_compress_limit || UINT32_MAX < inlen) {
+        return false;
+    }
+
+    /* only break up the payload if there are threads to share it */
+    chunk = inlen;
+    if (1 < prte_compress_threads && 0 < prte_compress_chunk_size &&
+        (size_t)prte_compress_chunk_size < inlen) {
+        chunk = prte_compress_chunk_size;
+    }
+    trk.compress = true;
+    trk.nchunks = (inlen + chunk - 1) / chunk;
+    trk.chunks = (chunk_t*)calloc(trk.nchunks, sizeof(chunk_t));
+    if (NULL == trk.chunks) {
+        return false;
+    }
+    for (n=0; n < trk.nchunks; n++) {
+        trk.chunks[n].in = inbytes + (size_t)n * chunk;
+        trk.chunks[n].inlen = (n == trk.nchunks - 1) ? inlen - (size_t)n * chunk : chunk;
+    }
+
+    run_chunks(&trk);
+
+    hdrlen = sizeof(uint32_t) * (1 + 2 * trk.nchunks);
+    total = hdrlen;
+    for (n=0; n < trk.nchunks; n++) {
+        c = &trk.chunks[n];
+        if (c->done && c->inlen <= c->outlen) {
+            /* store this chunk as-is */
+            free(c->out);
+            c->out = NULL;
+            c->done = false;
+        }
+        total += c->done ? c->outlen : c->inlen;
+    }
+    /* if this didn't result in a smaller footprint,
+     * then don't use it */
+    if (total >= inlen || NULL == (ptr = (uint8_t*)malloc(total))) {
+        free_chunks(&trk);
+        return false;
+    }
+
+    u32 = htonl((uint32_t)trk.nchunks);
+    memcpy(ptr, &u32, sizeof(uint32_t));
+    dptr = ptr + hdrlen;
+    for (n=0; n < trk.nchunks; n++) {
+        c = &trk.chunks[n];
+        u32 = htonl((uint32_t)c->inlen);
+        memcpy(ptr + sizeof(uint32_t) * (1 + 2 * n), &u32, sizeof(uint32_t));
+        if (c->done) {
+            u32 = htonl((uint32_t)c->outlen);
+            memcpy(dptr, c->out, c->outlen);
+            dptr += c->outlen;
+        } else {
+            memcpy(dptr, c->in, c->inlen);
+            dptr += c->inlen;
+        }
+        memcpy(ptr + sizeof(uint32_t) * (2 + 2 * n), &u32, sizeof(uint32_t));
+    }
+    free_chunks(&trk);
+
+    *outbytes = ptr;
+    *outlen = total;
+    return true;
+}
+
+bool prte_decompress(uint8_t **outbytes, size_t *outlen,
+                     uint8_t *inbytes, size_t inlen)
+{
+    chunk_tracker_t trk;
+    chunk_t *c;
+    size_t hdrlen, offset, total, *rawlen;
+    uint32_t u32;
+    uint8_t *ptr;
+    int32_t n;
+    bool ret = false;
+
+    *outbytes = NULL;
+    *outlen = 0;
+
+    if (NULL == inbytes || inlen < sizeof(uint32_t)) {
+        return false;
+    }
+    memcpy(&u32, inbytes, sizeof(uint32_t));
+    trk.nchunks = ntohl(u32);
+    hdrlen = sizeof(uint32_t) * (1 + 2 * (size_t)trk.nchunks);
+    if (0 >= trk.nchunks || inlen < hdrlen) {
+        return false;
+    }
+    trk.compress = false;
+    trk.chunks = (chunk_t*)calloc(trk.nchunks, sizeof(chunk_t));
+    rawlen = (size_t*)calloc(trk.nchunks, sizeof(size_t));
+    if (NULL == trk.chunks || NULL == rawlen) {
+        goto cleanup;
+    }
+
+    offset = hdrlen;
+    total = 0;
+    for (n=0; n < trk.nchunks; n++) {
+        c = &trk.chunks[n];
+        memcpy(&u32, inbytes + sizeof(uint32_t) * (1 + 2 * n), sizeof(uint32_t));
+        rawlen[n] = ntohl(u32);
+        memcpy(&u32, inbytes + sizeof(uint32_t) * (2 + 2 * n), sizeof(uint32_t));
+        c->inlen = ntohl(u32);
+        if (inlen - offset < c->inlen) {
+            goto cleanup;
+        }
+        c->in = inbytes + offset;
+        c->done = (c->inlen == rawlen[n]);
+        offset += c->inlen;
+        total += rawlen[n];
+    }
+
+    run_chunks(&trk);
+
+    if (NULL == (ptr = (uint8_t*)malloc(total))) {
+        goto cleanup;
+    }
+    offset = 0;
+    for (n=0; n < trk.nchunks; n++) {
+        c = &trk.chunks[n];
+        if (c->inlen == rawlen[n]) {
+            memcpy(ptr + offset, c->in, c->inlen);
+        } else if (!c->done || c->outlen != rawlen[n]) {
+            free(ptr);
+            goto cleanup;
+        } else {
+            memcpy(ptr + offset, c->out, c->outlen);
+        }
+        offset += rawlen[n];
+    }
+    *outbytes = ptr;
+    *outlen = total;
+    ret = true;
+
+  cleanup:
+    if (NULL != trk.chunks) {
+        free_chunks(&trk);
+    }
+    if (NULL != rawlen) {
+        free(rawlen);
+    }
+    return ret;
+}
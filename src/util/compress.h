@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * Compression of large internal payloads - launch messages, the
+ * nidmap and the like. The method and the size below which we don't
+ * bother are selected by MCA params. Large payloads are split into
+ * chunks that can be compressed and decompressed by several threads.
+ */
+
+#ifndef PRTE_UTIL_COMPRESS_H
+#define PRTE_UTIL_COMPRESS_H
+
+#include "prte_config.h"
+
+#include <stdint.h>
+
+BEGIN_C_DECLS
+
+/* compression method - "zlib" or "none" */
+PRTE_EXPORT extern char *prte_compress_method;
+/* payloads smaller than this (in bytes) are sent as-is */
+PRTE_EXPORT extern int prte_compress_limit;
+/* number of threads to use on large payloads */
+PRTE_EXPORT extern int prte_compress_threads;
+/* size (in bytes) of the chunks handed to each thread */
+PRTE_EXPORT extern int prte_compress_chunk_size;
+
+/**
+ * Compress a payload
+ *
+ * Returns true if the payload was compressed, in which case
+ * *outbytes holds the compressed data and must be free'd by the
+ * caller. Returns false if the payload was not compressed - e.g.,
+ * because it was too small to be worth the effort - in which
+ * case the caller should send the original data.
+ */
+PRTE_EXPORT bool prte_compress(uint8_t *inbytes, size_t inlen,
+                               uint8_t **outbytes, size_t *outlen);
+
+/**
+ * Decompress a payload produced by prte_compress
+ *
+ * Returns true on success, in which case *outbytes holds the
+ * original data and must be free'd by the caller.
+ */
+PRTE_EXPORT bool prte_decompress(uint8_t **outbytes, size_t *outlen,
+                                 uint8_t *inbytes, size_t inlen);
+
+END_C_DECLS
+
+#endif
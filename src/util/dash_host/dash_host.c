@@ -29,6 +29,7 @@
 #include "constants.h"
 #include "types.h"
 
+#include "src/class/prte_hash_table.h"
 #include "src/util/show_help.h"
 #include "src/util/argv.h"
 #include "src/util/if.h"
@@ -39,9 +40,105 @@
 #include "src/mca/plm/plm_types.h"
 #include "src/mca/errmgr/errmgr.h"
 #include "src/runtime/prte_globals.h"
+#include "src/util/hostfile/hostfile.h"
 
 #include "dash_host.h"
 
+/* name -> node index of a list of nodes */
+static prte_hash_table_t* dash_host_index(prte_list_t *nodes)
+{
+    prte_hash_table_t *index;
+    prte_node_t *node;
+    void *ptr;
+
+    if (NULL == (index = PRTE_NEW(prte_hash_table_t))) {
+        return NULL;
+    }
+    prte_hash_table_init(index, 128);
+    if (NULL != nodes) {
+        PRTE_LIST_FOREACH(node, nodes, prte_node_t) {
+            if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(index, node->name,
+                                                              strlen(node->name), &ptr)) {
+                prte_hash_table_set_value_ptr(index, node->name, strlen(node->name), node);
+            }
+        }
+    }
+    return index;
+}
+
+static prte_node_t* dash_host_lookup(prte_hash_table_t *index, const char *name)
+{
+    void *node;
+
+    if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(index, name, strlen(name), &node)) {
+        return NULL;
+    }
+    return (prte_node_t*)node;
+}
+
+/* add a single host to the list, bumping the slot count
+ * if it is already there */
+static void dash_host_add_node(prte_list_t *adds, prte_hash_table_t *index,
+                               char *name, int slots, bool slots_given)
+{
+    prte_node_t *node;
+    char *ndname, *ptr;
+
+    /* check for local name */
+    if (prte_check_host_is_local(name)) {
+        ndname = prte_process_info.nodename;
+    } else {
+        ndname = name;
+
+        // Strip off the FQDN if present, ignore IP addresses
+        if( !prte_keep_fqdn_hostnames && !prte_net_isaddr(ndname) ) {
+            if (NULL != (ptr = strchr(ndname, '.'))) {
+                *ptr = '\0';
+            }
+        }
+    }
+    /* see if the node is already on the list */
+    if (NULL != (node = dash_host_lookup(index, ndname))) {
+        if (slots_given) {
+            node->slots += slots;
+            if (0 < slots) {
+                PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+            }
+        } else {
+            ++node->slots;
+            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+        }
+        PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
+                             "%s dashhost: node %s already on list - slots %d",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name, node->slots));
+        return;
+    }
+
+    /* If we didn't find it, add it to the list */
+    node = PRTE_NEW(prte_node_t);
+    node->name = strdup(ndname);
+    PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
+                         "%s dashhost: added node %s to list - slots %d",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name, slots));
+    node->state = PRTE_NODE_STATE_UP;
+    node->slots_inuse = 0;
+    node->slots_max = 0;
+    if (slots_given) {
+        node->slots = slots;
+        if (0 < slots) {
+            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+        }
+    } else if (slots < 0) {
+        node->slots = 0;
+        PRTE_FLAG_UNSET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+    } else {
+        node->slots = 1;
+        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+    }
+    prte_hash_table_set_value_ptr(index, node->name, strlen(node->name), node);
+    prte_list_append(adds, &node->super);
+}
+
 int prte_util_dash_host_compute_slots(prte_node_t *node, char *hosts)
 {
     char **specs, *cptr;
@@ -82,17 +179,18 @@ int prte_util_dash_host_compute_slots(prte_node_t *node, char *hosts)
 int prte_util_add_dash_host_nodes(prte_list_t *nodes,
                                   char *hosts, bool allocating)
 {
-    prte_list_item_t *item, *itm;
+    prte_list_item_t *item;
     int32_t i, j, k;
     int rc, nodeidx;
     char **host_argv=NULL;
-    char **mapped_nodes = NULL, **mini_map, *ndname;
+    char **mapped_nodes = NULL, **mini_map = NULL, *ndname;
     prte_node_t *node, *nd;
     prte_list_t adds;
-    bool found;
+    prte_hash_table_t *index = NULL;
+    prte_util_host_range_t range;
     int slots=0;
     bool slots_given;
-    char *cptr, *ptr;
+    char *cptr;
 
     PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                          "%s dashhost: parsing args %s",
@@ -114,6 +212,7 @@ int prte_util_add_dash_host_nodes(prte_list_t *nodes,
                 if (PRTE_SUCCESS != rc) {
                     prte_argv_free(host_argv);
                     prte_argv_free(mini_map);
+                    mini_map = NULL;
                     goto cleanup;
                 }
             }
@@ -218,6 +317,10 @@ int prte_util_add_dash_host_nodes(prte_list_t *nodes,
     /*  go through the names found and
         add them to the host list. If they're not unique, then
         bump the slots count for each duplicate */
+    if (NULL == (index = dash_host_index(NULL))) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
     for (i=0; NULL != mini_map[i]; i++) {
         PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                              "%s dashhost: working node %s",
@@ -238,99 +341,51 @@ int prte_util_add_dash_host_nodes(prte_list_t *nodes,
             }
         }
 
-        /* check for local name */
-        if (prte_check_host_is_local(mini_map[i])) {
-            ndname = prte_process_info.nodename;
-        } else {
-            ndname = mini_map[i];
-
-            // Strip off the FQDN if present, ignore IP addresses
-            if( !prte_keep_fqdn_hostnames && !prte_net_isaddr(ndname) ) {
-                if (NULL != (ptr = strchr(ndname, '.'))) {
-                    *ptr = '\0';
-                }
-            }
-        }
-        /* see if the node is already on the list */
-        found = false;
-        PRTE_LIST_FOREACH(node, &adds, prte_node_t) {
-            if (0 == strcmp(node->name, ndname)) {
-                found = true;
-                if (slots_given) {
-                    node->slots += slots;
-                    if (0 < slots) {
-                        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
-                    }
-                } else {
-                    ++node->slots;
-                    PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
-                }
-                PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
-                                     "%s dashhost: node %s already on list - slots %d",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name, node->slots));
-                break;
-            }
-        }
-
-        /* If we didn't find it, add it to the list */
-        if (!found) {
-            node = PRTE_NEW(prte_node_t);
-            if (NULL == node) {
-                prte_argv_free(mapped_nodes);
-                return PRTE_ERR_OUT_OF_RESOURCE;
+        if (NULL != strchr(mini_map[i], '[')) {
+            /* walk the range one name at a time rather than
+             * expanding it up front */
+            if (!prte_util_host_range_parse(&range, mini_map[i])) {
+                prte_show_help("help-dash-host.txt", "dash-host:invalid-range",
+                               true, mini_map[i]);
+                rc = PRTE_ERR_SILENT;
+                goto cleanup;
             }
-            node->name = strdup(ndname);
-            PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
-                                 "%s dashhost: added node %s to list - slots %d",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name, slots));
-            node->state = PRTE_NODE_STATE_UP;
-            node->slots_inuse = 0;
-            node->slots_max = 0;
-            if (slots_given) {
-                node->slots = slots;
-                if (0 < slots) {
-                    PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
-                }
-            } else if (slots < 0) {
-                node->slots = 0;
-                PRTE_FLAG_UNSET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
-            } else {
-                node->slots = 1;
-                PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+            while (NULL != (ndname = prte_util_host_range_next(&range))) {
+                dash_host_add_node(&adds, index, ndname, slots, slots_given);
+                free(ndname);
             }
-            prte_list_append(&adds, &node->super);
+            prte_util_host_range_destruct(&range);
+        } else {
+            dash_host_add_node(&adds, index, mini_map[i], slots, slots_given);
         }
     }
     prte_argv_free(mini_map);
+    mini_map = NULL;
+    PRTE_RELEASE(index);
 
     /* transfer across all unique nodes */
+    if (NULL == (index = dash_host_index(nodes))) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
     while (NULL != (item = prte_list_remove_first(&adds))) {
         nd = (prte_node_t*)item;
-        found = false;
-        for (itm = prte_list_get_first(nodes);
-             itm != prte_list_get_end(nodes);
-             itm = prte_list_get_next(itm)) {
-            node = (prte_node_t*)itm;
-            if (0 == strcmp(nd->name, node->name)) {
-                found = true;
-                PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
-                                     "%s dashhost: found existing node %s on input list - adding slots",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name));
-                if (PRTE_FLAG_TEST(nd, PRTE_NODE_FLAG_SLOTS_GIVEN)) {
-                    /* transfer across the number of slots */
-                    node->slots += nd->slots;
-                    PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
-                }
-                break;
+        if (NULL != (node = dash_host_lookup(index, nd->name))) {
+            PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
+                                 "%s dashhost: found existing node %s on input list - adding slots",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name));
+            if (PRTE_FLAG_TEST(nd, PRTE_NODE_FLAG_SLOTS_GIVEN)) {
+                /* transfer across the number of slots */
+                node->slots += nd->slots;
+                PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
             }
-        }
-        if (!found) {
+            PRTE_RELEASE(item);
+        } else {
             PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                                  "%s dashhost: adding node %s with %d slots to final list",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nd->name, nd->slots));
+            prte_hash_table_set_value_ptr(index, nd->name, strlen(nd->name), nd);
             prte_list_append(nodes, &nd->super);
-        } else {
-            PRTE_RELEASE(item);
         }
     }
 
@@ -340,27 +395,26 @@ int prte_util_add_dash_host_nodes(prte_list_t *nodes,
             if (NULL == (node_from_pool = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, i))) {
                 continue;
             }
-            for (itm = prte_list_get_first(nodes);
-               itm != prte_list_get_end(nodes);
-               itm = prte_list_get_next(itm)) {
-              node = (prte_node_t*) itm;
-              if (0 == strcmp(node_from_pool->name, node->name)) {
-                if(node->slots < node_from_pool -> slots) {
-                  node_from_pool->slots = node->slots;
-                }
-                break;
-              }
-              // There's no need to check that this host exists in the pool. That
-              // should have already been checked at this point.
-          }
-      }
-  }  
-  rc = PRTE_SUCCESS;
+            // There's no need to check that this host exists in the pool. That
+            // should have already been checked at this point.
+            if (NULL != (node = dash_host_lookup(index, node_from_pool->name)) &&
+                node->slots < node_from_pool->slots) {
+                node_from_pool->slots = node->slots;
+            }
+        }
+    }
+    rc = PRTE_SUCCESS;
 
  cleanup:
     if (NULL != mapped_nodes) {
         prte_argv_free(mapped_nodes);
     }
+    if (NULL != mini_map) {
+        prte_argv_free(mini_map);
+    }
+    if (NULL != index) {
+        PRTE_RELEASE(index);
+    }
     PRTE_LIST_DESTRUCT(&adds);
 
     return rc;
@@ -379,6 +433,7 @@ static int parse_dash_host(char ***mapped_nodes, char *hosts)
     int nodeidx;
     prte_node_t *node;
     char **host_argv=NULL;
+    prte_util_host_range_t range;
 
     host_argv = prte_argv_split(hosts, ',');
 
@@ -446,8 +501,18 @@ static int parse_dash_host(char ***mapped_nodes, char *hosts)
                 if (NULL != (cptr = strchr(mini_map[k], ':'))) {
                     *cptr = '\0';
                 }
-                /* check for local alias */
-                if (prte_check_host_is_local(mini_map[k])) {
+                /* ranges are kept as given and matched lazily */
+                if (NULL != strchr(mini_map[k], '[')) {
+                    if (!prte_util_host_range_parse(&range, mini_map[k])) {
+                        prte_show_help("help-dash-host.txt", "dash-host:invalid-range",
+                                       true, mini_map[k]);
+                        rc = PRTE_ERR_SILENT;
+                        goto cleanup;
+                    }
+                    prte_util_host_range_destruct(&range);
+                    prte_argv_append_nosize(mapped_nodes, mini_map[k]);
+                } else if (prte_check_host_is_local(mini_map[k])) {
+                    /* check for local alias */
                     prte_argv_append_nosize(mapped_nodes, prte_process_info.nodename);
                 } else {
                     prte_argv_append_nosize(mapped_nodes, mini_map[k]);
@@ -475,14 +540,18 @@ int prte_util_filter_dash_host_nodes(prte_list_t *nodes,
     prte_list_item_t* item;
     prte_list_item_t *next;
     int32_t i, j, len_mapped_node=0;
-    int rc, test;
+    int rc, test, nranges=0;
     char **mapped_nodes = NULL;
     prte_node_t *node;
     int num_empty=0;
     prte_list_t keep;
     bool want_all_empty=false;
-    char *cptr;
+    char *cptr, *name;
     size_t lst, lmn;
+    prte_hash_table_t *index = NULL, *last = NULL;
+    prte_util_host_range_t *ranges = NULL;
+    int *rpos = NULL;
+    void *ptr;
 
     /* if the incoming node list is empty, then there
      * is nothing to filter!
@@ -514,6 +583,35 @@ int prte_util_filter_dash_host_nodes(prte_list_t *nodes,
      */
     PRTE_CONSTRUCT(&keep, prte_list_t);
 
+    /* index the incoming nodes by name, and the -host entries
+     * by the last position at which each name appears, so that
+     * both matching a name and checking whether it is specified
+     * later become lookups rather than scans */
+    index = dash_host_index(nodes);
+    last = dash_host_index(NULL);
+    ranges = (prte_util_host_range_t*)calloc(len_mapped_node, sizeof(prte_util_host_range_t));
+    rpos = (int*)calloc(len_mapped_node, sizeof(int));
+    if (NULL == index || NULL == last || NULL == ranges || NULL == rpos) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    for (i = 0; i < len_mapped_node; ++i) {
+        /* remove any modifier */
+        if (NULL != (cptr = strchr(mapped_nodes[i], ':'))) {
+            *cptr = '\0';
+        }
+        if ('*' == mapped_nodes[i][0]) {
+            continue;
+        }
+        if (NULL != strchr(mapped_nodes[i], '[') &&
+            prte_util_host_range_parse(&ranges[i], mapped_nodes[i])) {
+            rpos[nranges++] = i;
+            continue;
+        }
+        prte_hash_table_set_value_ptr(last, mapped_nodes[i], strlen(mapped_nodes[i]),
+                                      (void*)(intptr_t)(i + 1));
+    }
+
     for (i = 0; i < len_mapped_node; ++i) {
         /* check if we are supposed to add some number of empty
          * nodes here
@@ -538,15 +636,22 @@ int prte_util_filter_dash_host_nodes(prte_list_t *nodes,
                 /* see if this node is empty */
                 if (0 == node->slots_inuse) {
                     /* check to see if it is specified later */
-                    for (j=i+1; j < len_mapped_node; j++) {
-                        if (0 == strcmp(mapped_nodes[j], node->name)) {
-                            /* specified later - skip this one */
+                    if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(last, node->name,
+                                                                      strlen(node->name), &ptr) &&
+                        i < (intptr_t)ptr - 1) {
+                        /* specified later - skip this one */
+                        goto skipnode;
+                    }
+                    for (j = 0; j < nranges; j++) {
+                        if (i < rpos[j] &&
+                            prte_util_host_range_contains(&ranges[rpos[j]], node->name)) {
                             goto skipnode;
                         }
                     }
                     if (remove) {
                         /* remove item from list */
                         prte_list_remove_item(nodes, item);
+                        prte_hash_table_remove_value_ptr(index, node->name, strlen(node->name));
                         /* xfer to keep list */
                         prte_list_append(&keep, item);
                     } else {
@@ -558,27 +663,56 @@ int prte_util_filter_dash_host_nodes(prte_list_t *nodes,
             skipnode:
                 item = next;
             }
-        } else {
-            /* remove any modifier */
-            if (NULL != (cptr = strchr(mapped_nodes[i], ':'))) {
-                *cptr = '\0';
+        } else if (NULL != ranges[i].prefix) {
+            /* take every node in the range, in range order - unless
+             * the range is larger than the list of nodes, in which
+             * case just test each node against it */
+            if (ranges[i].hi - ranges[i].lo < prte_list_get_size(nodes)) {
+                while (NULL != (name = prte_util_host_range_next(&ranges[i]))) {
+                    if (NULL != (node = dash_host_lookup(index, name))) {
+                        if (remove) {
+                            prte_list_remove_item(nodes, &node->super);
+                            prte_hash_table_remove_value_ptr(index, node->name, strlen(node->name));
+                            prte_list_append(&keep, &node->super);
+                        } else {
+                            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
+                        }
+                    }
+                    free(name);
+                }
+            } else {
+                item = prte_list_get_first(nodes);
+                while (item != prte_list_get_end(nodes)) {
+                    next = prte_list_get_next(item);  /* save this position */
+                    node = (prte_node_t*)item;
+                    if (prte_util_host_range_contains(&ranges[i], node->name)) {
+                        if (remove) {
+                            prte_list_remove_item(nodes, item);
+                            prte_hash_table_remove_value_ptr(index, node->name, strlen(node->name));
+                            prte_list_append(&keep, item);
+                        } else {
+                            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
+                        }
+                    }
+                    item = next;
+                }
             }
+        } else {
             /* we are looking for a specific node on the list. The
              * parser will have substituted our local name for any
-             * alias, so we only have to do a strcmp here. */
+             * alias, so we only have to do a lookup here. */
             cptr = NULL;
             lmn = strtoul(mapped_nodes[i], &cptr, 10);
-            item = prte_list_get_first(nodes);
-            while (item != prte_list_get_end(nodes)) {
-                next = prte_list_get_next(item);  /* save this position */
-                node = (prte_node_t*)item;
-                /* search -host list to see if this one is found */
-                if (prte_managed_allocation &&
-                    (NULL == cptr || 0 == strlen(cptr))) {
-                    /* if we are only given a number, then we test the
-                     * value against the number in the node name. This allows support for
-                     * launch_id-based environments. For example, a hostname
-                     * of "nid0015" can be referenced by "--host 15" */
+            if (prte_managed_allocation &&
+                (NULL == cptr || 0 == strlen(cptr))) {
+                /* if we are only given a number, then we test the
+                 * value against the number in the node name. This allows support for
+                 * launch_id-based environments. For example, a hostname
+                 * of "nid0015" can be referenced by "--host 15" */
+                item = prte_list_get_first(nodes);
+                while (item != prte_list_get_end(nodes)) {
+                    next = prte_list_get_next(item);  /* save this position */
+                    node = (prte_node_t*)item;
                     for (j=strlen(node->name)-1; 0 < j; j--) {
                         if (!isdigit(node->name[j])) {
                             j++;
@@ -591,22 +725,28 @@ int prte_util_filter_dash_host_nodes(prte_list_t *nodes,
                         lst = strtoul(&node->name[j], NULL, 10);
                         test = (lmn == lst) ? 0 : 1;
                     }
-                } else {
-                    test = strcmp(node->name, mapped_nodes[i]);
+                    if (0 == test) {
+                        break;
+                    }
+                    item = next;
                 }
-                if (0 == test) {
-                    if (remove) {
-                        /* remove item from list */
-                        prte_list_remove_item(nodes, item);
-                        /* xfer to keep list */
-                        prte_list_append(&keep, item);
-                    } else {
-                        /* mark the node as found */
-                        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
+                node = (item == prte_list_get_end(nodes)) ? NULL : (prte_node_t*)item;
+            } else {
+                node = dash_host_lookup(index, mapped_nodes[i]);
+            }
+            if (NULL != node) {
+                if (remove) {
+                    /* remove item from list */
+                    prte_list_remove_item(nodes, &node->super);
+                    if (node == dash_host_lookup(index, node->name)) {
+                        prte_hash_table_remove_value_ptr(index, node->name, strlen(node->name));
                     }
-                    break;
+                    /* xfer to keep list */
+                    prte_list_append(&keep, &node->super);
+                } else {
+                    /* mark the node as found */
+                    PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
                 }
-                item = next;
             }
         }
         /* done with the mapped entry */
@@ -657,10 +797,25 @@ cleanup:
             free(mapped_nodes[i]);
             mapped_nodes[i] = NULL;
         }
+        if (NULL != ranges) {
+            prte_util_host_range_destruct(&ranges[i]);
+        }
     }
     if (NULL != mapped_nodes) {
         free(mapped_nodes);
     }
+    if (NULL != ranges) {
+        free(ranges);
+    }
+    if (NULL != rpos) {
+        free(rpos);
+    }
+    if (NULL != index) {
+        PRTE_RELEASE(index);
+    }
+    if (NULL != last) {
+        PRTE_RELEASE(last);
+    }
 
     return rc;
 }
@@ -669,8 +824,9 @@ int prte_util_get_ordered_dash_host_list(prte_list_t *nodes,
                                          char *hosts)
 {
     int rc, i;
-    char **mapped_nodes = NULL;
+    char **mapped_nodes = NULL, *name;
     prte_node_t *node;
+    prte_util_host_range_t range;
 
     if (PRTE_SUCCESS != (rc = parse_dash_host(&mapped_nodes, hosts))) {
         PRTE_ERROR_LOG(rc);
@@ -678,6 +834,16 @@ int prte_util_get_ordered_dash_host_list(prte_list_t *nodes,
 
     /* for each entry, create a node entry on the list */
     for (i=0; NULL != mapped_nodes[i]; i++) {
+        if (NULL != strchr(mapped_nodes[i], '[') &&
+            prte_util_host_range_parse(&range, mapped_nodes[i])) {
+            while (NULL != (name = prte_util_host_range_next(&range))) {
+                node = PRTE_NEW(prte_node_t);
+                node->name = name;
+                prte_list_append(nodes, &node->super);
+            }
+            prte_util_host_range_destruct(&range);
+            continue;
+        }
         node = PRTE_NEW(prte_node_t);
         node->name = strdup(mapped_nodes[i]);
         prte_list_append(nodes, &node->super);
@@ -29,6 +29,7 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#include <ctype.h>
 #include <errno.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -114,18 +115,244 @@ static char *hostfile_parse_string(void)
     return strdup(prte_util_hostfile_value.sval);
 }
 
-static prte_node_t* hostfile_lookup(prte_list_t* nodes, const char* name)
+/* name -> node indices for the include and exclude lists of the
+ * hostfile currently being parsed */
+static prte_hash_table_t *updates_index = NULL;
+static prte_hash_table_t *exclude_index = NULL;
+
+static prte_hash_table_t* hostfile_index_create(prte_list_t* nodes)
 {
-    prte_list_item_t* item;
-    for(item =  prte_list_get_first(nodes);
-        item != prte_list_get_end(nodes);
-        item =  prte_list_get_next(item)) {
-        prte_node_t* node = (prte_node_t*)item;
-        if (strcmp(node->name, name) == 0) {
-            return node;
+    prte_hash_table_t *index;
+    prte_node_t *node;
+    void *ptr;
+
+    index = PRTE_NEW(prte_hash_table_t);
+    prte_hash_table_init(index, 128);
+    /* the lists may already hold nodes from a previous file - the
+     * first entry of a given name is the one that is found */
+    PRTE_LIST_FOREACH(node, nodes, prte_node_t) {
+        if (NULL != node->name &&
+            PRTE_SUCCESS != prte_hash_table_get_value_ptr(index, node->name,
+                                                          strlen(node->name), &ptr)) {
+            prte_hash_table_set_value_ptr(index, node->name, strlen(node->name), node);
         }
     }
-    return NULL;
+    return index;
+}
+
+static prte_node_t* hostfile_lookup(prte_hash_table_t* index, const char* name)
+{
+    void *node;
+
+    if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(index, name, strlen(name), &node)) {
+        return NULL;
+    }
+    return (prte_node_t*)node;
+}
+
+static void hostfile_append(prte_list_t* nodes, prte_hash_table_t* index,
+                            prte_node_t* node)
+{
+    void *ptr;
+
+    if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(index, node->name,
+                                                      strlen(node->name), &ptr)) {
+        prte_hash_table_set_value_ptr(index, node->name, strlen(node->name), node);
+    }
+    prte_list_append(nodes, &node->super);
+}
+
+bool prte_util_host_range_parse(prte_util_host_range_t *range, const char *spec)
+{
+    const char *lb;
+    char *end;
+
+    memset(range, 0, sizeof(prte_util_host_range_t));
+    if (NULL == (lb = strchr(spec, '[')) || !isdigit(lb[1])) {
+        return false;
+    }
+    range->lo = strtoul(lb + 1, &end, 10);
+    if ('-' != *end || !isdigit(end[1])) {
+        return false;
+    }
+    /* a leading zero on the lower bound fixes the field width */
+    if ('0' == lb[1] && 2 < end - lb) {
+        range->width = end - lb - 1;
+    }
+    range->hi = strtoul(end + 1, &end, 10);
+    /* only a single range per name is supported */
+    if (']' != *end || range->hi < range->lo || NULL != strchr(end + 1, '[')) {
+        return false;
+    }
+    range->prefix = strndup(spec, lb - spec);
+    range->suffix = strdup(end + 1);
+    range->next = range->lo;
+    return true;
+}
+
+char* prte_util_host_range_next(prte_util_host_range_t *range)
+{
+    char *name;
+
+    if (NULL == range->prefix || range->done) {
+        return NULL;
+    }
+    if (0 > asprintf(&name, "%s%0*lu%s", range->prefix, range->width,
+                     range->next, range->suffix)) {
+        return NULL;
+    }
+    if (range->next == range->hi) {
+        range->done = true;
+    } else {
+        range->next++;
+    }
+    return name;
+}
+
+bool prte_util_host_range_contains(prte_util_host_range_t *range, const char *name)
+{
+    size_t plen, slen, nlen, dlen;
+    unsigned long val;
+    char *end;
+
+    if (NULL == range->prefix) {
+        return false;
+    }
+    plen = strlen(range->prefix);
+    slen = strlen(range->suffix);
+    nlen = strlen(name);
+    if (nlen <= plen + slen ||
+        0 != strncmp(name, range->prefix, plen) ||
+        0 != strcmp(name + nlen - slen, range->suffix) ||
+        !isdigit(name[plen])) {
+        return false;
+    }
+    val = strtoul(name + plen, &end, 10);
+    if (end != name + nlen - slen || val < range->lo || range->hi < val) {
+        return false;
+    }
+    /* the name must be spelled the way the expansion would spell it */
+    dlen = end - (name + plen);
+    if ('0' == name[plen] && 1 < dlen) {
+        return (int)dlen == range->width;
+    }
+    return (int)dlen >= range->width;
+}
+
+void prte_util_host_range_destruct(prte_util_host_range_t *range)
+{
+    if (NULL != range->prefix) {
+        free(range->prefix);
+        range->prefix = NULL;
+    }
+    if (NULL != range->suffix) {
+        free(range->suffix);
+        range->suffix = NULL;
+    }
+}
+
+static int hostfile_exclude_range(prte_list_t* exclude, char* spec, char* username)
+{
+    prte_util_host_range_t range;
+    prte_node_t *node;
+    char *name;
+
+    if (!prte_util_host_range_parse(&range, spec)) {
+        prte_show_help("help-hostfile.txt", "parse_error_string",
+                       true, cur_hostfile_name, prte_util_hostfile_line,
+                       PRTE_HOSTFILE_RANGE, spec);
+        free(spec);
+        if (NULL != username) {
+            free(username);
+        }
+        return PRTE_ERROR;
+    }
+    free(spec);
+
+    while (NULL != (name = prte_util_host_range_next(&range))) {
+        /* see if this is another name for us */
+        if (prte_check_host_is_local(name)) {
+            free(name);
+            name = strdup(prte_process_info.nodename);
+        }
+        if (NULL != hostfile_lookup(exclude_index, name)) {
+            free(name);
+            continue;
+        }
+        node = PRTE_NEW(prte_node_t);
+        node->name = name;
+        if (NULL != username) {
+            prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username, PMIX_STRING);
+        }
+        hostfile_append(exclude, exclude_index, node);
+    }
+    prte_util_host_range_destruct(&range);
+    if (NULL != username) {
+        free(username);
+    }
+    return PRTE_SUCCESS;
+}
+
+/* replace the template node for a host range with one node per name
+ * in the range, streaming each name straight into the include index */
+static int hostfile_expand_range(prte_list_t* updates, prte_node_t* tmpl,
+                                 bool keep_all)
+{
+    prte_util_host_range_t range;
+    prte_node_t *node;
+    char *name, *username = NULL;
+    int port, *portptr = &port;
+    bool have_port;
+    int rc = PRTE_SUCCESS;
+
+    prte_list_remove_item(updates, &tmpl->super);
+    if (!prte_util_host_range_parse(&range, tmpl->name)) {
+        prte_show_help("help-hostfile.txt", "parse_error_string",
+                       true, cur_hostfile_name, prte_util_hostfile_line,
+                       PRTE_HOSTFILE_RANGE, tmpl->name);
+        PRTE_RELEASE(tmpl);
+        return PRTE_ERROR;
+    }
+    prte_get_attribute(&tmpl->attributes, PRTE_NODE_USERNAME, (void**)&username, PMIX_STRING);
+    have_port = prte_get_attribute(&tmpl->attributes, PRTE_NODE_PORT, (void**)&portptr, PMIX_INT);
+
+    while (NULL != (name = prte_util_host_range_next(&range))) {
+        if (keep_all || NULL == (node = hostfile_lookup(updates_index, name))) {
+            node = PRTE_NEW(prte_node_t);
+            node->name = name;
+            node->slots = tmpl->slots;
+            node->slots_max = tmpl->slots_max;
+            if (PRTE_FLAG_TEST(tmpl, PRTE_NODE_FLAG_SLOTS_GIVEN)) {
+                PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+            }
+            if (NULL != username) {
+                prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username, PMIX_STRING);
+            }
+            if (have_port) {
+                prte_set_attribute(&node->attributes, PRTE_NODE_PORT, PRTE_ATTR_LOCAL, &port, PMIX_INT);
+            }
+            hostfile_append(updates, updates_index, node);
+            continue;
+        }
+        /* treat it the same as a repeated line for this host */
+        if (PRTE_FLAG_TEST(tmpl, PRTE_NODE_FLAG_SLOTS_GIVEN)) {
+            prte_show_help("help-hostfile.txt", "slots-given",
+                           true, cur_hostfile_name, name);
+            free(name);
+            rc = PRTE_ERROR;
+            break;
+        }
+        node->slots++;
+        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+        free(name);
+    }
+
+    if (NULL != username) {
+        free(username);
+    }
+    prte_util_host_range_destruct(&range);
+    PRTE_RELEASE(tmpl);
+    return rc;
 }
 
 static int hostfile_parse_line(int token, prte_list_t* updates,
@@ -141,12 +368,14 @@ static int hostfile_parse_line(int token, prte_list_t* updates,
     int cnt;
     int number_of_slots = 0;
     char buff[64];
+    bool is_range = (PRTE_HOSTFILE_RANGE == token);
 
     if (PRTE_HOSTFILE_STRING == token ||
         PRTE_HOSTFILE_HOSTNAME == token ||
         PRTE_HOSTFILE_INT == token ||
         PRTE_HOSTFILE_IPV4 == token ||
-        PRTE_HOSTFILE_IPV6 == token) {
+        PRTE_HOSTFILE_IPV6 == token ||
+        PRTE_HOSTFILE_RANGE == token) {
 
         if(PRTE_HOSTFILE_INT == token) {
             snprintf(buff, 64, "%d", prte_util_hostfile_value.ival);
@@ -191,6 +420,10 @@ static int hostfile_parse_line(int token, prte_list_t* updates,
                                  "%s hostfile: node %s is being excluded",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node_name));
 
+            if (is_range) {
+                return hostfile_exclude_range(exclude, node_name, username);
+            }
+
             /* see if this is another name for us */
             if (prte_check_host_is_local(node_name)) {
                 /* Nodename has been allocated, that is for sure */
@@ -200,13 +433,13 @@ static int hostfile_parse_line(int token, prte_list_t* updates,
 
             /* Do we need to make a new node object?  First check to see
                if it's already in the exclude list */
-            if (NULL == (node = hostfile_lookup(exclude, node_name))) {
+            if (NULL == (node = hostfile_lookup(exclude_index, node_name))) {
                 node = PRTE_NEW(prte_node_t);
                 node->name = node_name;
                 if (NULL != username) {
                     prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username, PMIX_STRING);
                 }
-                prte_list_append(exclude, &node->super);
+                hostfile_append(exclude, exclude_index, node);
             } else {
                 free(node_name);
             }
@@ -222,8 +455,10 @@ static int hostfile_parse_line(int token, prte_list_t* updates,
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node_name,
                              keep_all ? "TRUE" : "FALSE"));
 
-        /* Do we need to make a new node object? */
-        if (keep_all || NULL == (node = hostfile_lookup(updates, node_name))) {
+        if (is_range) {
+            /* the line's attributes apply to every host in the range, so
+             * collect them on a template that is expanded once the line
+             * has been read */
             node = PRTE_NEW(prte_node_t);
             node->name = node_name;
             node->slots = 1;
@@ -231,6 +466,15 @@ static int hostfile_parse_line(int token, prte_list_t* updates,
                 prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username, PMIX_STRING);
             }
             prte_list_append(updates, &node->super);
+        } else if (keep_all || NULL == (node = hostfile_lookup(updates_index, node_name))) {
+            /* Do we need to make a new node object? */
+            node = PRTE_NEW(prte_node_t);
+            node->name = node_name;
+            node->slots = 1;
+            if (NULL != username) {
+                prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username, PMIX_STRING);
+            }
+            hostfile_append(updates, updates_index, node);
         } else {
             /* this node was already found once - add a slot and mark slots as "given" */
             node->slots++;
@@ -286,14 +530,14 @@ static int hostfile_parse_line(int token, prte_list_t* updates,
         }
 
         /* Do we need to make a new node object? */
-        if (NULL == (node = hostfile_lookup(updates, node_name))) {
+        if (NULL == (node = hostfile_lookup(updates_index, node_name))) {
             node = PRTE_NEW(prte_node_t);
             node->name = node_name;
             node->slots = 1;
             if (NULL != username) {
                 prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username, PMIX_STRING);
             }
-            prte_list_append(updates, &node->super);
+            hostfile_append(updates, updates_index, node);
         } else {
             /* add a slot */
             node->slots++;
@@ -431,23 +675,32 @@ static int hostfile_parse_line(int token, prte_list_t* updates,
         node->slots = node->slots_max;
         PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
     }
+    if (is_range) {
+        return hostfile_expand_range(updates, node, keep_all);
+    }
 
     return PRTE_SUCCESS;
 }
 
 
 /**
- * Parse the specified file into a node list.
+ * Parse the specified file into a node list. If requested, the
+ * name -> node indices built for the include and exclude lists
+ * are handed back to the caller so it can filter against them.
  */
 
 static int hostfile_parse(const char *hostfile, prte_list_t* updates,
-                          prte_list_t* exclude, bool keep_all)
+                          prte_list_t* exclude, bool keep_all,
+                          prte_hash_table_t **uindex,
+                          prte_hash_table_t **xindex)
 {
     int token;
     int rc = PRTE_SUCCESS;
 
 
     cur_hostfile_name = hostfile;
+    updates_index = hostfile_index_create(updates);
+    exclude_index = hostfile_index_create(exclude);
 
     prte_util_hostfile_done = false;
     prte_util_hostfile_in = fopen(hostfile, "r");
@@ -498,6 +751,7 @@ static int hostfile_parse(const char *hostfile, prte_list_t* updates,
         case PRTE_HOSTFILE_IPV6:
         case PRTE_HOSTFILE_RELATIVE:
         case PRTE_HOSTFILE_RANK:
+        case PRTE_HOSTFILE_RANGE:
             rc = hostfile_parse_line(token, updates, exclude, keep_all);
             if (PRTE_SUCCESS != rc) {
                 goto unlock;
@@ -515,11 +769,42 @@ static int hostfile_parse(const char *hostfile, prte_list_t* updates,
 
 unlock:
     cur_hostfile_name = NULL;
+    if (NULL != uindex && PRTE_SUCCESS == rc) {
+        *uindex = updates_index;
+    } else {
+        PRTE_RELEASE(updates_index);
+    }
+    updates_index = NULL;
+    if (NULL != xindex && PRTE_SUCCESS == rc) {
+        *xindex = exclude_index;
+    } else {
+        PRTE_RELEASE(exclude_index);
+    }
+    exclude_index = NULL;
 
     return rc;
 }
 
 
+/* drop every node on the list whose name is in the exclude index,
+ * keeping the include index (if given) in sync */
+static void hostfile_remove_excluded(prte_list_t* nodes, prte_hash_table_t* index,
+                                     prte_hash_table_t* xindex)
+{
+    prte_node_t *node, *next;
+
+    PRTE_LIST_FOREACH_SAFE(node, next, nodes, prte_node_t) {
+        if (NULL == hostfile_lookup(xindex, node->name)) {
+            continue;
+        }
+        if (NULL != index && node == hostfile_lookup(index, node->name)) {
+            prte_hash_table_remove_value_ptr(index, node->name, strlen(node->name));
+        }
+        prte_list_remove_item(nodes, &node->super);
+        PRTE_RELEASE(node);
+    }
+}
+
 /**
  * Parse the provided hostfile and add the nodes to the list.
  */
@@ -528,10 +813,10 @@ int prte_util_add_hostfile_nodes(prte_list_t *nodes,
                                  char *hostfile)
 {
     prte_list_t exclude, adds;
-    prte_list_item_t *item, *itm;
+    prte_list_item_t *item;
+    prte_hash_table_t *xindex = NULL, *nindex = NULL;
     int rc;
     prte_node_t *nd, *node;
-    bool found;
 
     PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                          "%s hostfile: checking hostfile %s for nodes",
@@ -541,7 +826,8 @@ int prte_util_add_hostfile_nodes(prte_list_t *nodes,
     PRTE_CONSTRUCT(&adds, prte_list_t);
 
     /* parse the hostfile and add any new contents to the list */
-    if (PRTE_SUCCESS != (rc = hostfile_parse(hostfile, &adds, &exclude, false))) {
+    if (PRTE_SUCCESS != (rc = hostfile_parse(hostfile, &adds, &exclude, false,
+                                             NULL, &xindex))) {
         goto cleanup;
     }
 
@@ -560,38 +846,14 @@ int prte_util_add_hostfile_nodes(prte_list_t *nodes,
     }
 
     /* remove from the list of nodes those that are in the exclude list */
-    while (NULL != (item = prte_list_remove_first(&exclude))) {
-        nd = (prte_node_t*)item;
-        /* check for matches on nodes */
-        for (itm = prte_list_get_first(&adds);
-             itm != prte_list_get_end(&adds);
-             itm = prte_list_get_next(itm)) {
-            node = (prte_node_t*)itm;
-            if (0 == strcmp(nd->name, node->name)) {
-                /* match - remove it */
-                prte_list_remove_item(&adds, itm);
-                PRTE_RELEASE(itm);
-                break;
-            }
-        }
-        PRTE_RELEASE(item);
-    }
+    hostfile_remove_excluded(&adds, NULL, xindex);
 
     /* transfer across all unique nodes */
+    nindex = hostfile_index_create(nodes);
     while (NULL != (item = prte_list_remove_first(&adds))) {
         nd = (prte_node_t*)item;
-        found = false;
-        for (itm = prte_list_get_first(nodes);
-             itm != prte_list_get_end(nodes);
-             itm = prte_list_get_next(itm)) {
-            node = (prte_node_t*)itm;
-            if (0 == strcmp(nd->name, node->name)) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            prte_list_append(nodes, &nd->super);
+        if (NULL == hostfile_lookup(nindex, nd->name)) {
+            hostfile_append(nodes, nindex, nd);
             PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                                  "%s hostfile: adding node %s slots %d",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nd->name, nd->slots));
@@ -603,6 +865,12 @@ int prte_util_add_hostfile_nodes(prte_list_t *nodes,
 cleanup:
     PRTE_LIST_DESTRUCT(&exclude);
     PRTE_LIST_DESTRUCT(&adds);
+    if (NULL != xindex) {
+        PRTE_RELEASE(xindex);
+    }
+    if (NULL != nindex) {
+        PRTE_RELEASE(nindex);
+    }
 
     return rc;
 }
@@ -616,14 +884,14 @@ int prte_util_filter_hostfile_nodes(prte_list_t *nodes,
                                     bool remove)
 {
     prte_list_t newnodes, exclude;
-    prte_list_item_t *item1, *item2, *next, *item3;
-    prte_node_t *node_from_list, *node_from_file, *node_from_pool, *node3;
+    prte_list_item_t *item1, *item2, *next;
+    prte_node_t *node_from_list, *node_from_file, *node_from_pool;
+    prte_hash_table_t *uindex = NULL, *xindex = NULL, *nindex = NULL;
     int rc = PRTE_SUCCESS;
     char *cptr;
     int num_empty, nodeidx;
     bool want_all_empty = false;
     prte_list_t keep;
-    bool found;
 
     PRTE_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                         "%s hostfile: filtering nodes through hostfile %s",
@@ -632,7 +900,8 @@ int prte_util_filter_hostfile_nodes(prte_list_t *nodes,
     /* parse the hostfile and create local list of findings */
     PRTE_CONSTRUCT(&newnodes, prte_list_t);
     PRTE_CONSTRUCT(&exclude, prte_list_t);
-    if (PRTE_SUCCESS != (rc = hostfile_parse(hostfile, &newnodes, &exclude, false))) {
+    if (PRTE_SUCCESS != (rc = hostfile_parse(hostfile, &newnodes, &exclude, false,
+                                             &uindex, &xindex))) {
         PRTE_DESTRUCT(&newnodes);
         PRTE_DESTRUCT(&exclude);
         return rc;
@@ -640,39 +909,36 @@ int prte_util_filter_hostfile_nodes(prte_list_t *nodes,
 
     /* if the hostfile was empty, then treat it as a no-op filter */
     if (0 == prte_list_get_size(&newnodes)) {
-        PRTE_DESTRUCT(&newnodes);
-        PRTE_DESTRUCT(&exclude);
+        PRTE_RELEASE(uindex);
+        PRTE_RELEASE(xindex);
+        PRTE_LIST_DESTRUCT(&newnodes);
+        PRTE_LIST_DESTRUCT(&exclude);
         /* indicate that the hostfile was empty */
         return PRTE_ERR_TAKE_NEXT_OPTION;
     }
 
     /* remove from the list of newnodes those that are in the exclude list
      * since we could have added duplicate names above due to the */
-    while (NULL != (item1 = prte_list_remove_first(&exclude))) {
-        node_from_file = (prte_node_t*)item1;
-        /* check for matches on nodes */
-        for (item2 = prte_list_get_first(&newnodes);
-             item2 != prte_list_get_end(&newnodes);
-             item2 = prte_list_get_next(item2)) {
-            prte_node_t *node = (prte_node_t*)item2;
-            if (0 == strcmp(node_from_file->name, node->name)) {
-                /* match - remove it */
-                prte_list_remove_item(&newnodes, item2);
-                PRTE_RELEASE(item2);
-                break;
-            }
-        }
-        PRTE_RELEASE(item1);
-    }
+    hostfile_remove_excluded(&newnodes, uindex, xindex);
+    PRTE_RELEASE(xindex);
+    PRTE_LIST_DESTRUCT(&exclude);
+
+    /* index the nodes we were given so each hostfile entry
+     * can be matched against them directly */
+    nindex = hostfile_index_create(nodes);
 
     /* now check our nodes and keep or mark those that match. We can
-     * destruct our hostfile list as we go since this won't be needed
+     * destruct our hostfile list as we go since this won't be needed.
+     * The include index only holds the entries still on the list,
+     * so it tells us if a node is explicitly called out later
      */
     PRTE_CONSTRUCT(&keep, prte_list_t);
     while (NULL != (item2 = prte_list_remove_first(&newnodes))) {
         node_from_file = (prte_node_t*)item2;
-
-        next = prte_list_get_next(item2);
+        if (node_from_file == hostfile_lookup(uindex, node_from_file->name)) {
+            prte_hash_table_remove_value_ptr(uindex, node_from_file->name,
+                                             strlen(node_from_file->name));
+        }
 
         /* see if this is a relative node syntax */
         if ('+' == node_from_file->name[0]) {
@@ -698,22 +964,15 @@ int prte_util_filter_hostfile_nodes(prte_list_t *nodes,
                 while (0 < num_empty && item1 != prte_list_get_end(nodes)) {
                     node_from_list = (prte_node_t*)item1;
                     next = prte_list_get_next(item1);  /* keep our place */
-                    if (0 == node_from_list->slots_inuse) {
-                        /* check to see if this node is explicitly called
-                         * out later - if so, don't use it here
-                         */
-                        for (item3 = prte_list_get_first(&newnodes);
-                             item3 != prte_list_get_end(&newnodes);
-                             item3 = prte_list_get_next(item3)) {
-                            node3 = (prte_node_t*)item3;
-                            if (0 == strcmp(node3->name, node_from_list->name)) {
-                                /* match - don't use it */
-                                goto skipnode;
-                            }
-                        }
+                    /* skip nodes that are in use or explicitly
+                     * called out later */
+                    if (0 == node_from_list->slots_inuse &&
+                        NULL == hostfile_lookup(uindex, node_from_list->name)) {
                         if (remove) {
                             /* remove item from list */
                             prte_list_remove_item(nodes, item1);
+                            prte_hash_table_remove_value_ptr(nindex, node_from_list->name,
+                                                             strlen(node_from_list->name));
                             /* xfer to keep list */
                             prte_list_append(&keep, item1);
                         } else {
@@ -722,13 +981,13 @@ int prte_util_filter_hostfile_nodes(prte_list_t *nodes,
                         }
                         --num_empty;
                     }
-                skipnode:
                     item1 = next;
                 }
                 /* did they get everything they wanted? */
                 if (!want_all_empty && 0 < num_empty) {
                     prte_show_help("help-hostfile.txt", "hostfile:not-enough-empty",
                                    true, num_empty);
+                    PRTE_RELEASE(item2);
                     rc = PRTE_ERR_SILENT;
                     goto cleanup;
                 }
@@ -742,104 +1001,91 @@ int prte_util_filter_hostfile_nodes(prte_list_t *nodes,
                     /* this is an error */
                     prte_show_help("help-hostfile.txt", "hostfile:relative-node-not-found",
                                    true, nodeidx, node_from_file->name);
+                    PRTE_RELEASE(item2);
                     rc = PRTE_ERR_SILENT;
                     goto cleanup;
                 }
-                /* search the list of nodes provided to us and find it */
-                for (item1 = prte_list_get_first(nodes);
-                     item1 != prte_list_get_end(nodes);
-                     item1 = prte_list_get_next(item1)) {
-                    node_from_list = (prte_node_t*)item1;
-                    if (prte_node_match(node_from_pool, node_from_list->name)) {
-                        if (remove) {
-                            /* match - remove item from list */
-                            prte_list_remove_item(nodes, item1);
-                            /* xfer to keep list */
-                            prte_list_append(&keep, item1);
-                        } else {
-                            /* mark as included */
-                            PRTE_FLAG_SET(node_from_list, PRTE_NODE_FLAG_MAPPED);
+                /* find it on the list of nodes provided to us - the
+                 * list may name it by one of its aliases */
+                node_from_list = hostfile_lookup(nindex, node_from_pool->name);
+                if (NULL == node_from_list) {
+                    PRTE_LIST_FOREACH(node_from_list, nodes, prte_node_t) {
+                        if (prte_node_match(node_from_pool, node_from_list->name)) {
+                            break;
                         }
-                        break;
+                    }
+                    if ((prte_list_item_t*)node_from_list == prte_list_get_end(nodes)) {
+                        node_from_list = NULL;
+                    }
+                }
+                if (NULL != node_from_list) {
+                    if (remove) {
+                        /* match - remove item from list */
+                        prte_list_remove_item(nodes, &node_from_list->super);
+                        if (node_from_list == hostfile_lookup(nindex, node_from_list->name)) {
+                            prte_hash_table_remove_value_ptr(nindex, node_from_list->name,
+                                                             strlen(node_from_list->name));
+                        }
+                        /* xfer to keep list */
+                        prte_list_append(&keep, &node_from_list->super);
+                    } else {
+                        /* mark as included */
+                        PRTE_FLAG_SET(node_from_list, PRTE_NODE_FLAG_MAPPED);
                     }
                 }
             } else {
                 /* invalid relative node syntax */
                 prte_show_help("help-hostfile.txt", "hostfile:invalid-relative-node-syntax",
                                true, node_from_file->name);
+                PRTE_RELEASE(item2);
                 rc = PRTE_ERR_SILENT;
                 goto cleanup;
             }
         } else {
-            /* we are looking for a specific node on the list
-             * search the provided list of nodes to see if this
-             * one is found
-             */
-            found = false;
-            for (item1 = prte_list_get_first(nodes);
-                 item1 != prte_list_get_end(nodes);
-                 item1 = prte_list_get_next(item1)) {
-                node_from_list = (prte_node_t*)item1;
-                /* we have converted all aliases for ourself
-                 * to our own detected nodename, so no need
-                 * to check for interfaces again - a simple
-                 * strcmp will suffice */
-                if (0 == strcmp(node_from_file->name, node_from_list->name)) {
-                    /* if the slot count here is less than the
-                     * total slots avail on this node, set it
-                     * to the specified count - this allows people
-                     * to subdivide an allocation
-                     */
-                    if (PRTE_FLAG_TEST(node_from_file, PRTE_NODE_FLAG_SLOTS_GIVEN) &&
-                        node_from_file->slots < node_from_list->slots) {
-                        node_from_list->slots = node_from_file->slots;
-                    }
-                    if (remove) {
-                        /* remove the node from the list */
-                        prte_list_remove_item(nodes, item1);
-                        /* xfer it to keep list */
-                        prte_list_append(&keep, item1);
-                    } else {
-                        /* mark as included */
-                        PRTE_FLAG_SET(node_from_list, PRTE_NODE_FLAG_MAPPED);
-                    }
-                    found = true;
-                    break;
-                }
-            }
+            /* we are looking for a specific node on the list. We
+             * have converted all aliases for ourself to our own
+             * detected nodename, so no need to check for interfaces
+             * again - a lookup on the name will suffice */
+            node_from_list = hostfile_lookup(nindex, node_from_file->name);
             /* if the host in the newnode list wasn't found,
              * then that is an error we need to report to the
              * user and abort
              */
-            if (!found) {
+            if (NULL == node_from_list) {
                 prte_show_help("help-hostfile.txt", "hostfile:extra-node-not-found",
                                true, hostfile, node_from_file->name);
+                PRTE_RELEASE(item2);
                 rc = PRTE_ERR_SILENT;
                 goto cleanup;
             }
+            /* if the slot count here is less than the
+             * total slots avail on this node, set it
+             * to the specified count - this allows people
+             * to subdivide an allocation
+             */
+            if (PRTE_FLAG_TEST(node_from_file, PRTE_NODE_FLAG_SLOTS_GIVEN) &&
+                node_from_file->slots < node_from_list->slots) {
+                node_from_list->slots = node_from_file->slots;
+            }
+            if (remove) {
+                /* remove the node from the list */
+                prte_list_remove_item(nodes, &node_from_list->super);
+                prte_hash_table_remove_value_ptr(nindex, node_from_list->name,
+                                                 strlen(node_from_list->name));
+                /* xfer it to keep list */
+                prte_list_append(&keep, &node_from_list->super);
+            } else {
+                /* mark as included */
+                PRTE_FLAG_SET(node_from_list, PRTE_NODE_FLAG_MAPPED);
+            }
         }
         /* cleanup the newnode list */
         PRTE_RELEASE(item2);
     }
 
-    /* if we still have entries on our hostfile list, then
-     * there were requested hosts that were not in our allocation.
-     * This is an error - report it to the user and return an error
-     */
-    if (0 != prte_list_get_size(&newnodes)) {
-        prte_show_help("help-hostfile.txt", "not-all-mapped-alloc",
-                       true, hostfile);
-        while (NULL != (item1 = prte_list_remove_first(&newnodes))) {
-            PRTE_RELEASE(item1);
-        }
-        PRTE_DESTRUCT(&newnodes);
-        return PRTE_ERR_SILENT;
-    }
-
     if (!remove) {
         /* all done */
-        PRTE_DESTRUCT(&newnodes);
-        return PRTE_SUCCESS;
+        goto cleanup;
     }
 
     /* clear the rest of the nodes list */
@@ -853,7 +1099,10 @@ int prte_util_filter_hostfile_nodes(prte_list_t *nodes,
     }
 
 cleanup:
-    PRTE_DESTRUCT(&newnodes);
+    PRTE_LIST_DESTRUCT(&newnodes);
+    PRTE_LIST_DESTRUCT(&keep);
+    PRTE_RELEASE(uindex);
+    PRTE_RELEASE(nindex);
 
     return rc;
 }
@@ -862,7 +1111,8 @@ int prte_util_get_ordered_host_list(prte_list_t *nodes,
                                     char *hostfile)
 {
     prte_list_t exclude;
-    prte_list_item_t *item, *itm, *item2, *item1;
+    prte_list_item_t *item2, *item1;
+    prte_hash_table_t *xindex = NULL;
     char *cptr;
     int num_empty, i, nodeidx, startempty=0;
     bool want_all_empty=false;
@@ -876,7 +1126,8 @@ int prte_util_get_ordered_host_list(prte_list_t *nodes,
     PRTE_CONSTRUCT(&exclude, prte_list_t);
 
     /* parse the hostfile and add the contents to the list, keeping duplicates */
-    if (PRTE_SUCCESS != (rc = hostfile_parse(hostfile, nodes, &exclude, true))) {
+    if (PRTE_SUCCESS != (rc = hostfile_parse(hostfile, nodes, &exclude, true,
+                                             NULL, &xindex))) {
         goto cleanup;
     }
 
@@ -1003,28 +1254,15 @@ int prte_util_get_ordered_host_list(prte_list_t *nodes,
         item2 = item1;
     }
 
-    /* remove from the list of nodes those that are in the exclude list */
-    while(NULL != (item = prte_list_remove_first(&exclude))) {
-        prte_node_t *exnode = (prte_node_t*)item;
-        /* check for matches on nodes */
-        for (itm = prte_list_get_first(nodes);
-             itm != prte_list_get_end(nodes);
-             itm = prte_list_get_next(itm)) {
-            prte_node_t *node=(prte_node_t*)itm;
-            if (0 == strcmp(exnode->name, node->name)) {
-                /* match - remove it */
-                prte_list_remove_item(nodes, itm);
-                PRTE_RELEASE(itm);
-                /* have to cycle through the entire list as we could
-                 * have duplicates
-                 */
-            }
-        }
-        PRTE_RELEASE(item);
-    }
+    /* remove from the list of nodes those that are in the exclude
+     * list - this catches every duplicate in a single pass */
+    hostfile_remove_excluded(nodes, NULL, xindex);
 
 cleanup:
-    PRTE_DESTRUCT(&exclude);
+    if (NULL != xindex) {
+        PRTE_RELEASE(xindex);
+    }
+    PRTE_LIST_DESTRUCT(&exclude);
 
     return rc;
 }
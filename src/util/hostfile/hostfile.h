@@ -42,6 +42,31 @@ PRTE_EXPORT int prte_util_filter_hostfile_nodes(prte_list_t *nodes,
 PRTE_EXPORT int prte_util_get_ordered_host_list(prte_list_t *nodes,
                                                   char *hostfile);
 
+/*
+ * Host ranges of the form "prefix[lo-hi]suffix" (e.g., node[0001-4096])
+ * are never expanded into a full list of names. The range is walked
+ * one name at a time with prte_util_host_range_next, or tested for
+ * membership with prte_util_host_range_contains. A leading zero on
+ * the lower bound sets the width of the numeric field.
+ */
+typedef struct {
+    char *prefix;
+    char *suffix;
+    unsigned long lo;
+    unsigned long hi;
+    unsigned long next;
+    int width;
+    bool done;
+} prte_util_host_range_t;
+
+PRTE_EXPORT bool prte_util_host_range_parse(prte_util_host_range_t *range,
+                                            const char *spec);
+/* returns a malloc'd name, or NULL when the range is exhausted */
+PRTE_EXPORT char* prte_util_host_range_next(prte_util_host_range_t *range);
+PRTE_EXPORT bool prte_util_host_range_contains(prte_util_host_range_t *range,
+                                               const char *name);
+PRTE_EXPORT void prte_util_host_range_destruct(prte_util_host_range_t *range);
+
 END_C_DECLS
 
 #endif
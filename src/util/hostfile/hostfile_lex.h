@@ -83,5 +83,7 @@ extern int prte_util_hostfile_lex_destroy (void );
 /* ensure we can handle a rank_file input */
 #define PRTE_HOSTFILE_RANK                  20
 #define PRTE_HOSTFILE_PORT                  21
+/* host range - node[0001-4096] */
+#define PRTE_HOSTFILE_RANGE                 22
 
 #endif
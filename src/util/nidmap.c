@@ -24,6 +24,7 @@
 #include <ctype.h>
 
 #include "src/util/argv.h"
+#include "src/util/compress.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/rmaps/base/base.h"
@@ -101,8 +102,8 @@ int prte_util_nidmap_create(prte_pointer_array_t *pool,
     /* construct the string of node names for compression */
     raw = prte_argv_join(names, ',');
     prte_argv_free(names);
-    if (PMIx_Data_compress((uint8_t*)raw, strlen(raw)+1,
-                           (uint8_t**)&bo.bytes, &sz)) {
+    if (prte_compress((uint8_t*)raw, strlen(raw)+1,
+                      (uint8_t**)&bo.bytes, &sz)) {
         /* mark that this was compressed */
         compressed = true;
         bo.size = sz;
@@ -132,8 +133,8 @@ int prte_util_nidmap_create(prte_pointer_array_t *pool,
     free(bo.bytes);
 
     /* compress the vpids */
-    if (PMIx_Data_compress((uint8_t*)vpids, nbytes,
-                           (uint8_t**)&bo.bytes, &sz)) {
+    if (prte_compress((uint8_t*)vpids, nbytes,
+                      (uint8_t**)&bo.bytes, &sz)) {
         /* mark that this was compressed */
         compressed = true;
         bo.size = sz;
@@ -222,8 +223,8 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
 
     /* if compressed, decompress */
     if (compressed) {
-        if (!PMIx_Data_decompress((uint8_t**)&raw, &sz,
-                                  (uint8_t*)pbo.bytes, pbo.size)) {
+        if (!prte_decompress((uint8_t**)&raw, &sz,
+                             (uint8_t*)pbo.bytes, pbo.size)) {
             PRTE_ERROR_LOG(PRTE_ERROR);
             PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
             rc = PRTE_ERROR;
@@ -257,8 +258,8 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
 
     /* if compressed, decompress */
     if (compressed) {
-        if (!PMIx_Data_decompress((uint8_t**)&vpid, &sz,
-                                  (uint8_t*)pbo.bytes, pbo.size)) {
+        if (!prte_decompress((uint8_t**)&vpid, &sz,
+                             (uint8_t*)pbo.bytes, pbo.size)) {
             PRTE_ERROR_LOG(PRTE_ERROR);
             PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
             rc = PRTE_ERROR;
@@ -308,6 +309,7 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
             prte_set_attribute(&nd->attributes, PRTE_NODE_ALIAS, PRTE_ATTR_LOCAL, raw, PMIX_STRING);
             free(raw);
         }
+        prte_node_index_names(nd);
         /* set the topology - always default to homogeneous
          * as that is the most common scenario */
         nd->topology = t;
@@ -419,8 +421,8 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
             goto cleanup;
         }
        /* send them along */
-        if (PMIx_Data_compress((uint8_t*)bucket.base_ptr, bucket.bytes_used,
-                               (uint8_t**)&bo.bytes, &sz)) {
+        if (prte_compress((uint8_t*)bucket.base_ptr, bucket.bytes_used,
+                          (uint8_t**)&bo.bytes, &sz)) {
             /* the data was compressed - mark that we compressed it */
             compressed = true;
             rc = PMIx_Data_pack(NULL, buffer, &compressed, 1, PMIX_BOOL);
@@ -510,8 +512,8 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
 
     /* deal with the topology assignments */
     if (prte_hetero_nodes) {
-        if (PMIx_Data_compress((uint8_t*)bucket.base_ptr, bucket.bytes_used,
-                               (uint8_t**)&bo.bytes, &sz)) {
+        if (prte_compress((uint8_t*)bucket.base_ptr, bucket.bytes_used,
+                          (uint8_t**)&bo.bytes, &sz)) {
             /* mark that this was compressed */
             compressed = true;
             bo.size = sz;
@@ -554,8 +556,8 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
             goto cleanup;
         }
     } else {
-        if (PMIx_Data_compress((uint8_t*)slots, nslots,
-                               (uint8_t**)&bo.bytes, &sz)) {
+        if (prte_compress((uint8_t*)slots, nslots,
+                          (uint8_t**)&bo.bytes, &sz)) {
             /* mark that this was compressed */
             i16 = 1;
             compressed = true;
@@ -601,8 +603,8 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
             goto cleanup;
         }
     } else {
-        if (PMIx_Data_compress(flags, nbitmap,
-                               (uint8_t**)&bo.bytes, &sz)) {
+        if (prte_compress(flags, nbitmap,
+                          (uint8_t**)&bo.bytes, &sz)) {
             /* mark that this was compressed */
             i8 = 2;
             compressed = true;
@@ -705,8 +707,8 @@ int prte_util_parse_node_info(pmix_data_buffer_t *buf)
 
         /* if compressed, decompress */
         if (compressed) {
-            if (!PMIx_Data_decompress((uint8_t**)&bytes, &sz,
-                                      (uint8_t*)pbo.bytes, pbo.size)) {
+            if (!prte_decompress((uint8_t**)&bytes, &sz,
+                                 (uint8_t*)pbo.bytes, pbo.size)) {
                 PRTE_ERROR_LOG(PRTE_ERROR);
                 PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
                 rc = PRTE_ERROR;
@@ -794,8 +796,8 @@ int prte_util_parse_node_info(pmix_data_buffer_t *buf)
         }
         /* if compressed, decompress */
         if (compressed) {
-            if (!PMIx_Data_decompress((uint8_t**)&bytes, &sz,
-                                      (uint8_t*)pbo.bytes, pbo.size)) {
+            if (!prte_decompress((uint8_t**)&bytes, &sz,
+                                 (uint8_t*)pbo.bytes, pbo.size)) {
                 PRTE_ERROR_LOG(PRTE_ERROR);
                 PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
                 rc = PRTE_ERROR;
@@ -882,8 +884,8 @@ int prte_util_parse_node_info(pmix_data_buffer_t *buf)
         }
         /* if compressed, decompress */
         if (1 == i16) {
-            if (!PMIx_Data_decompress((uint8_t**)&slots, &sz,
-                                      (uint8_t*)pbo.bytes, pbo.size)) {
+            if (!prte_decompress((uint8_t**)&slots, &sz,
+                                 (uint8_t*)pbo.bytes, pbo.size)) {
                 PRTE_ERROR_LOG(PRTE_ERROR);
                 PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
                 rc = PRTE_ERROR;
@@ -935,8 +937,8 @@ int prte_util_parse_node_info(pmix_data_buffer_t *buf)
         }
         /* if compressed, decompress */
         if (2 == i8) {
-            if (!PMIx_Data_decompress((uint8_t**)&flags, &sz,
-                                      (uint8_t*)pbo.bytes, pbo.size)) {
+            if (!prte_decompress((uint8_t**)&flags, &sz,
+                                 (uint8_t*)pbo.bytes, pbo.size)) {
                 PRTE_ERROR_LOG(PRTE_ERROR);
                 PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
                 rc = PRTE_ERROR;
@@ -1029,8 +1031,8 @@ int prte_util_generate_ppn(prte_job_t *jdata,
             }
         }
 
-        if (PMIx_Data_compress((uint8_t*)bucket.base_ptr, bucket.bytes_used,
-                               (uint8_t**)&bo.bytes, &sz)) {
+        if (prte_compress((uint8_t*)bucket.base_ptr, bucket.bytes_used,
+                          (uint8_t**)&bo.bytes, &sz)) {
             /* mark that this was compressed */
             compressed = true;
             bo.size = sz;
@@ -1114,8 +1116,8 @@ int prte_util_decode_ppn(prte_job_t *jdata,
 
         /* decompress if required */
         if (compressed) {
-            if (!PMIx_Data_decompress(&bytes, &sz,
-                                      (uint8_t*)bo.bytes, bo.size)) {
+            if (!prte_decompress(&bytes, &sz,
+                                 (uint8_t*)bo.bytes, bo.size)) {
                 PRTE_ERROR_LOG(PRTE_ERROR);
                 PMIX_BYTE_OBJECT_DESTRUCT(&bo);
                 return PRTE_ERROR;
@@ -38,6 +38,7 @@
 #ifdef HAVE_DIRENT_H
 #include <dirent.h>
 #endif  /* HAVE_DIRENT_H */
+#include <fcntl.h>
 
 #include "src/util/output.h"
 #include "src/util/os_dirpath.h"
@@ -264,6 +265,83 @@ int prte_os_dirpath_destroy(const char *path,
     return exit_status;
 }
 
+/* remove the contents of the directory referenced by dirfd - the
+ * fd is consumed (closed) by this function */
+static int destroy_tree_fd(int dirfd)
+{
+    DIR *dp;
+    struct dirent *ep;
+    int fd, exit_status = PRTE_SUCCESS;
+    bool is_dir;
+    struct stat buf;
+
+    dp = fdopendir(dirfd);
+    if (NULL == dp) {
+        close(dirfd);
+        return PRTE_ERROR;
+    }
+
+    while (NULL != (ep = readdir(dp))) {
+        if ((0 == strcmp(ep->d_name, ".")) ||
+            (0 == strcmp(ep->d_name, ".."))) {
+            continue;
+        }
+#ifdef DT_DIR
+        if (DT_UNKNOWN != ep->d_type) {
+            is_dir = (DT_DIR == ep->d_type);
+        } else
+#endif
+        {
+            if (0 > fstatat(dirfd, ep->d_name, &buf, AT_SYMLINK_NOFOLLOW)) {
+                /* entry was removed by someone else */
+                continue;
+            }
+            is_dir = S_ISDIR(buf.st_mode);
+        }
+
+        if (is_dir) {
+            fd = openat(dirfd, ep->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+            if (0 > fd) {
+                if (ENOENT != errno) {
+                    exit_status = PRTE_ERROR;
+                }
+                continue;
+            }
+            if (PRTE_SUCCESS != destroy_tree_fd(fd)) {
+                exit_status = PRTE_ERROR;
+            }
+            if (0 != unlinkat(dirfd, ep->d_name, AT_REMOVEDIR) && ENOENT != errno) {
+                exit_status = PRTE_ERROR;
+            }
+        } else if (0 != unlinkat(dirfd, ep->d_name, 0) && ENOENT != errno) {
+            exit_status = PRTE_ERROR;
+        }
+    }
+
+    /* closes dirfd as well */
+    closedir(dp);
+    return exit_status;
+}
+
+int prte_os_dirpath_destroy_tree(const char *path)
+{
+    int fd, rc;
+
+    if (NULL == path) {
+        return PRTE_ERROR;
+    }
+
+    fd = open(path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+    if (0 > fd) {
+        return (ENOENT == errno) ? PRTE_ERR_NOT_FOUND : PRTE_ERROR;
+    }
+    rc = destroy_tree_fd(fd);
+    if (0 != rmdir(path) && ENOENT != errno) {
+        rc = PRTE_ERROR;
+    }
+    return rc;
+}
+
 bool prte_os_dirpath_is_empty(const char *path ) {
     DIR *dp;
     struct dirent *ep;
@@ -115,6 +115,23 @@ PRTE_EXPORT int prte_os_dirpath_destroy(const char *path,
                                           bool recursive,
                                           prte_os_dirpath_destroy_callback_fn_t cbfunc);
 
+/**
+ * Destroy a directory tree
+ *
+ * Removes the directory and everything beneath it. Unlike
+ * prte_os_dirpath_destroy(), entries are unlinked relative to an open
+ * descriptor of their parent directory, so no pathnames are built and
+ * no per-entry path lookups are done. Entries removed concurrently by
+ * another process are silently skipped.
+ *
+ * @param path A pointer to a string that contains the path name to be destroyed
+ *
+ * @retval PRTE_SUCCESS If the directory was successfully removed
+ * @retval PRTE_ERR_NOT_FOUND If directory does not exist.
+ * @retval PRTE_ERROR If any part of the tree could not be removed
+ */
+PRTE_EXPORT int prte_os_dirpath_destroy_tree(const char *path);
+
 END_C_DECLS
 
 #endif